@@ -28,6 +28,12 @@ ChartsEndWorkoutForm {
         timer.startTimer(sendMail, 100);
     }
 
+    function chartPoints(chart)
+    {
+        // 4 points per pixel column (first, min, max, last), the chart may not be laid out yet
+        return Math.max(360, Math.round(chart.width)) * 4;
+    }
+
     function sendMail()
     {
         rootItem.sendMail()
@@ -38,16 +44,18 @@ ChartsEndWorkoutForm {
         headerToolbar.visible = true;
 
         //console.log("ChartsEndWorkoutForm completed " + rootItem.workout_sample_points)
-        for(var i=0;i<rootItem.workout_sample_points;i+=10)
-        {
-            //console.log("ChartsEndWorkoutForm completed " + i + " " + rootItem.workout_watt_points[i])
-            powerSeries.append(i * 1000, rootItem.workout_watt_points[i]);
-            heartSeries.append(i * 1000, rootItem.workout_heart_points[i]);
-            cadenceSeries.append(i * 1000, rootItem.workout_cadence_points[i]);
-            resistanceSeries.append(i * 1000, rootItem.workout_resistance_points[i]);
-            pelotonResistanceSeries.append(i * 1000, rootItem.workout_peloton_resistance_points[i]);
-        }
+        // the series are downsampled to a few points per pixel column, keeping the peaks
+        rootItem.update_chart_series(powerSeries, "watt", chartPoints(powerChart));
+        rootItem.update_chart_series(heartSeries, "heart", chartPoints(heartChart));
+        rootItem.update_chart_series(cadenceSeries, "cadence", chartPoints(cadenceChart));
+        rootItem.update_chart_series(resistanceSeries, "resistance", chartPoints(cadenceChart));
+        rootItem.update_chart_series(pelotonResistanceSeries, "peloton_resistance", chartPoints(cadenceChart));
         rootItem.update_chart_power(powerChart);
+        // best average power over each duration of the ladder, in seconds
+        var curveSeconds = rootItem.workout_power_curve_seconds;
+        var curveWatts = rootItem.workout_power_curve_watts;
+        for (var i = 0; i < curveSeconds.length; i++)
+            powerCurveSeries.append(curveSeconds[i], curveWatts[i]);
         //rootItem.update_axes(valueAxisX, valueAxisY);
         rootItem.update_chart_heart(heartChart);
         //rootItem.update_axes(valueAxisXHR, valueAxisYHR);
@@ -14,6 +14,8 @@ Item {
     property alias resistanceSeries: resistanceSeries
     property alias pelotonResistanceSeries: pelotonResistanceSeries
     property alias cadenceChart: cadenceChart
+    property alias powerCurveSeries: powerCurveSeries
+    property alias powerCurveChart: powerCurveChart
 
     Settings {
         id: settings
@@ -128,7 +130,7 @@ Item {
             anchors.right: parent.right
             anchors.top: instructor.bottom
             anchors.bottom: parent.bottom
-            contentHeight: powerChart.height+heartChart.height+cadenceChart.height
+            contentHeight: powerChart.height+heartChart.height+cadenceChart.height+powerCurveChart.height
 
             ChartView {
                 id: powerChart
@@ -286,6 +288,45 @@ Item {
                     width: 1
                 }
             }
+
+            ChartView {
+                id: powerCurveChart
+                height: 400
+                width: parent.width
+                antialiasing: true
+                legend.visible: false
+                anchors.top: cadenceChart.bottom
+                title: "Power Curve"
+                titleFont.pixelSize: 20
+
+                LogValueAxis {
+                    id: valueAxisXPowerCurve
+                    min: 1
+                    max: 3600
+                    base: 10
+                    labelFormat: "%.0f"
+                    gridVisible: false
+                    labelsFont.pixelSize: 10
+                }
+
+                ValueAxis {
+                    id: valueAxisYPowerCurve
+                    min: 0
+                    max: rootItem.wattMaxChart
+                    tickCount: 8
+                    labelFormat: "%.0f"
+                    labelsFont.pixelSize: 10
+                }
+
+                LineSeries {
+                    id: powerCurveSeries
+                    visible: true
+                    axisX: valueAxisXPowerCurve
+                    axisY: valueAxisYPowerCurve
+                    color: "black"
+                    width: 1
+                }
+            }
         }
     }
 }
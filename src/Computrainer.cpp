@@ -24,6 +24,12 @@
 
 #include "Computrainer.h"
 
+#include <QElapsedTimer>
+
+#ifndef WIN32
+#include <poll.h>
+#endif
+
 const static uint8_t ergo_command[56] =
     {
         //                        Ergo            various
@@ -58,15 +64,11 @@ const static uint8_t rrc_command[56] = {
  * ---------------------------------------------------------------------- */
 Computrainer::Computrainer(QObject *parent, QString devname) : QThread(parent) {
 
-    devicePower = deviceHeartRate = deviceCadence = deviceSpeed = deviceRRC = 0.00;
-    for (int i = 0; i < 24; spinScan[i++] = 0)
-        ;
+    deviceButtons = 0;
+    memset(ssValues, 0, sizeof(ssValues));
     mode = DEFAULT_MODE;
     load = DEFAULT_LOAD;
     gradient = DEFAULT_GRADIENT;
-    deviceCalibrated = false;
-    deviceHRConnected = false;
-    deviceCADConnected = false;
     setDevice(devname);
     deviceStatus = 0;
     this->parent = parent;
@@ -81,7 +83,11 @@ Computrainer::Computrainer(QObject *parent, QString devname) : QThread(parent) {
     memcpy(SS_Command, ss_command, 56);
 }
 
-Computrainer::~Computrainer() {}
+Computrainer::~Computrainer() {
+    // the thread sees it within a read timeout
+    stop();
+    wait();
+}
 
 /* ----------------------------------------------------------------------
  * SET
@@ -92,111 +98,74 @@ void Computrainer::setDevice(QString devname) {
 }
 
 void Computrainer::setMode(int mode, double load, double gradient) {
-    pvars.lock();
-    this->mode = mode;
     this->load = load;
     this->gradient = gradient;
-    pvars.unlock();
+    this->mode = mode;
 }
 
 void Computrainer::setLoad(double load) {
-    pvars.lock();
     if (load > 1500)
         load = 1500;
     if (load < 50)
         load = 50;
     this->load = load;
-    pvars.unlock();
 }
 
-void Computrainer::setGradient(double gradient) {
-    pvars.lock();
-    this->gradient = gradient;
-    pvars.unlock();
-}
+void Computrainer::setGradient(double gradient) { this->gradient = gradient; }
 
 /* ----------------------------------------------------------------------
  * GET
  * ---------------------------------------------------------------------- */
-bool Computrainer::isHRConnected() {
-    bool tmp;
-    pvars.lock();
-    tmp = deviceHRConnected;
-    pvars.unlock();
-
-    return tmp;
+ComputrainerTelemetry Computrainer::telemetry() const {
+    QMutexLocker locker(&pvars);
+    return published;
 }
 
-bool Computrainer::isCADConnected() {
-    bool tmp;
-    pvars.lock();
-    tmp = deviceCADConnected;
-    pvars.unlock();
+void Computrainer::publish(const ComputrainerTelemetry &telemetry) {
+    QMutexLocker locker(&pvars);
+    published = telemetry;
+}
 
-    return tmp;
+int Computrainer::takeButtons() {
+    // work around to ensure controller doesn't miss button press.
+    // The run thread will only set the button bits, they don't get
+    // reset until the ui reads the device state
+    //  Borrowed from: Fortius.cpp
+    return deviceButtons.exchange(0);
 }
 
-bool Computrainer::isCalibrated() {
-    bool tmp;
-    pvars.lock();
-    tmp = deviceCalibrated;
-    pvars.unlock();
+bool Computrainer::isHRConnected() { return telemetry().hrConnected; }
 
-    return tmp;
-}
+bool Computrainer::isCADConnected() { return telemetry().cadConnected; }
+
+bool Computrainer::isCalibrated() { return telemetry().calibrated; }
 
 void Computrainer::getTelemetry(double &power, double &heartrate, double &cadence, double &speed, double &RRC,
                                 bool &calibration, int &buttons, uint8_t *ss, int &status) {
 
-    pvars.lock();
-    power = devicePower;
-    heartrate = deviceHeartRate;
-    cadence = deviceCadence;
-    speed = deviceSpeed;
-    RRC = deviceRRC;
-    calibration = deviceCalibrated;
-    buttons = deviceButtons;
+    ComputrainerTelemetry t = telemetry();
+    power = t.power;
+    heartrate = t.heartRate;
+    cadence = t.cadence;
+    speed = t.speed;
+    RRC = t.RRC;
+    calibration = t.calibrated;
+    buttons = takeButtons();
     status = deviceStatus;
-    memcpy((void *)ss, (void *)spinScan, 24);
-
-    // work around to ensure controller doesn't miss button press.
-    // The run thread will only set the button bits, they don't get
-    // reset until the ui reads the device state
-    //  Borrowed from: Fortius.cpp
-    deviceButtons = 0;
-    pvars.unlock();
+    memcpy(ss, t.spinScan, 24);
 }
 
 void Computrainer::getSpinScan(double spinData[]) {
-    pvars.lock();
-    for (int i = 0; i < 24; spinData[i] = this->spinScan[i])
-        ;
-    pvars.unlock();
+    ComputrainerTelemetry t = telemetry();
+    for (int i = 0; i < 24; i++)
+        spinData[i] = t.spinScan[i];
 }
 
-int Computrainer::getMode() {
-    int tmp;
-    pvars.lock();
-    tmp = mode;
-    pvars.unlock();
-    return tmp;
-}
+int Computrainer::getMode() { return mode; }
 
-double Computrainer::getLoad() {
-    double tmp;
-    pvars.lock();
-    tmp = load;
-    pvars.unlock();
-    return tmp;
-}
+double Computrainer::getLoad() { return load; }
 
-double Computrainer::getGradient() {
-    double tmp;
-    pvars.lock();
-    tmp = gradient;
-    pvars.unlock();
-    return tmp;
-}
+double Computrainer::getGradient() { return gradient; }
 
 /*----------------------------------------------------------------------
  * COMPUTRAINER PROTOCOL DECODE/ENCODE ROUTINES
@@ -226,6 +195,7 @@ double Computrainer::getGradient() {
  *---------------------------------------------------------------------- */
 
 int Computrainer::start() {
+    deviceStatus = CT_RUNNING;
     QThread::start();
     return 0;
 }
@@ -309,10 +279,8 @@ void Computrainer::prepareCommand(int mode, double value) {
 int Computrainer::calcCRC(int value) { return (0xff & (107 - (value & 0xff) - (value >> 8))); }
 
 // funny, just a few lines of code. oh the pain to get this working :-)
-void Computrainer::unpackTelemetry(int &ss1, int &ss2, int &ss3, int &buttons, int &type, int &value8, int &value12) {
-    static uint8_t ss[24];
-    static int pos = 0;
-
+void Computrainer::unpackTelemetry(int &ss1, int &ss2, int &ss3, int &buttons, int &type, int &value8, int &value12,
+                                   uint8_t *spinScan) {
     // inbound data is in the 7 byte array Computrainer::buf[]
     // for code clarity they hjave been put into these holdiing
     // variables. the overhead is minimal and makes the code a
@@ -349,22 +317,22 @@ void Computrainer::unpackTelemetry(int &ss1, int &ss2, int &ss3, int &buttons, i
     value12 = value8 | (b1 & 7) << 9 | (b3 & 2) << 7;
 
     if (buttons & 64) {
-        memcpy((uint8_t *)spinScan, (uint8_t *)ss + 3, 21);
-        memcpy((uint8_t *)spinScan + 21, (uint8_t *)ss, 3);
+        memcpy(spinScan, ssValues + 3, 21);
+        memcpy(spinScan + 21, ssValues, 3);
         // for (pos=0; pos<24; pos++) fprintf(stderr, "%d, ", ss[pos]);
         // fprintf(stderr, "\n");
-        pos = 0;
+        ssPosition = 0;
     }
-    if (ss1 || ss2 || ss3) {
+    if ((ss1 || ss2 || ss3) && ssPosition < 24) {
 
         // we drop the msb and do a ones compliment, but
         // that looks eerily like a signed byte.
         // suspect there is more hidden in there?
         // but when decoded as a signed byte the numbers
         // are all over the place. investigate further!
-        ss[pos++] = 127 ^ (ss1 & 127);
-        ss[pos++] = 127 ^ (ss2 & 127);
-        ss[pos++] = 127 ^ (ss3 & 127);
+        ssValues[ssPosition++] = 127 ^ (ss1 & 127);
+        ssValues[ssPosition++] = 127 ^ (ss2 & 127);
+        ssValues[ssPosition++] = 127 ^ (ss3 & 127);
     }
 }
 
@@ -385,53 +353,29 @@ void Computrainer::unpackTelemetry(int &ss1, int &ss2, int &ss3, int &buttons, i
  *         when it is time to pause or stop altogether.
  * ---------------------------------------------------------------------- */
 int Computrainer::restart() {
-    int status;
+    int status = CT_RUNNING | CT_PAUSED;
 
-    // get current status
-    pvars.lock();
-    status = this->deviceStatus;
-    pvars.unlock();
     // what state are we in anyway?
-    if (status & CT_RUNNING && status & CT_PAUSED) {
-        status &= ~CT_PAUSED;
-        pvars.lock();
-        this->deviceStatus = status;
-        pvars.unlock();
+    if (deviceStatus.compare_exchange_strong(status, CT_RUNNING))
         return 0; // ok its running again!
-    }
     return 2;
 }
 
 int Computrainer::stop() {
-    // what state are we in anyway?
-    pvars.lock();
     deviceStatus = 0; // Terminate it!
-    pvars.unlock();
     return 0;
 }
 
 int Computrainer::pause() {
-    int status;
+    int status = CT_RUNNING;
 
-    // get current status
-    pvars.lock();
-    status = this->deviceStatus;
-    pvars.unlock();
-
-    if (status & CT_PAUSED)
+    // ok we're running and not paused so lets pause
+    if (deviceStatus.compare_exchange_strong(status, CT_RUNNING | CT_PAUSED))
+        return 0;
+    else if (status & CT_PAUSED)
         return 2; // already paused you muppet!
-    else if (!(status & CT_RUNNING))
+    else
         return 4; // not running anyway, fool!
-    else {
-
-        // ok we're running and not paused so lets pause
-        status |= CT_PAUSED;
-        pvars.lock();
-        this->deviceStatus = status;
-        pvars.unlock();
-
-        return 0;
-    }
 }
 
 // used by thread to set variables and emit event if needed
@@ -447,10 +391,11 @@ int Computrainer::quit(int code) {
  *----------------------------------------------------------------------*/
 void Computrainer::run() {
 
-    // locally cached settings - only update main class variables
-    //                           when they change
+    // locally cached settings - only send a command when they change
+    // or to keep the CT alive
 
-    int cmds = 0; // count loops with no command sent
+    int messages = 0;       // messages received since the last command
+    QElapsedTimer lastSent; // time since the last command
 
     // holders for unpacked telemetry
     int ss1, ss2, ss3, buttons, type, value8, value12;
@@ -464,37 +409,20 @@ void Computrainer::run() {
 
     // Cached current values
     // when new values are received from the device
-    // if they differ from current values we update
+    // if they differ from current values we publish
     // otherwise do nothing
     int curmode, curstatus;
     double curload, curgradient;
-    double curPower;      // current output power in Watts
-    double curHeartRate;  // current heartrate in BPM
-    double curCadence;    // current cadence in RPM
-    double curSpeed;      // current speed in KPH
-    double curRRC;        // calibrated Rolling Resistance
-    bool curhrconnected;  // is HR sensor connected?
-    bool curcadconnected; // is CAD sensor connected?
-    int curButtons;       // Button status
+    ComputrainerTelemetry current;
 
     // initialise local cache & main vars
-    pvars.lock();
-    this->deviceStatus = CT_RUNNING;
     curmode = this->mode;
     curload = this->load;
     curgradient = this->gradient;
-    curPower = this->devicePower = 0;
-    curHeartRate = this->deviceHeartRate = 0;
-    curCadence = this->deviceCadence = 0;
-    curSpeed = this->deviceSpeed = 0;
-    curButtons = this->deviceButtons = 0;
-    curRRC = this->deviceRRC = 0;
-    this->deviceCalibrated = false;
-    curhrconnected = false;
-    this->deviceHRConnected = false;
-    curcadconnected = false;
-    this->deviceCADConnected = false;
-    pvars.unlock();
+    this->deviceButtons = 0;
+    publish(current);
+    bufLength = 0;
+    rxLength = rxPosition = 0;
 
     // open the device
     int o = openPort();
@@ -514,44 +442,44 @@ void Computrainer::run() {
         quit(4);
         return; // couldn't write to the device
     }
+    lastSent.start();
 
     while (1) {
 
         if (isDeviceOpen == true) {
 
-            if (readMessage() > 0) {
+            // wait for the next message, but wake up in time to see
+            // the GUI commands and to keep the CT alive
+            int rc = readMessage(50);
+            if (rc > 0) {
 
                 //----------------------------------------------------------------
                 // UPDATE BASIC TELEMETRY (HR, CAD, SPD et al)
                 //----------------------------------------------------------------
 
-                unpackTelemetry(ss1, ss2, ss3, buttons, type, value8, value12);
+                unpackTelemetry(ss1, ss2, ss3, buttons, type, value8, value12, current.spinScan);
+                bool changed = (buttons & CT_SSS) != 0; // the spinscan values are complete
+                messages++;
 
                 switch (type) {
                 case CT_HEARTRATE:
-                    if (value8 != curHeartRate) {
-                        curHeartRate = value8;
-                        pvars.lock();
-                        this->deviceHeartRate = curHeartRate;
-                        pvars.unlock();
+                    if (value8 != current.heartRate) {
+                        current.heartRate = value8;
+                        changed = true;
                     }
                     break;
 
                 case CT_POWER:
-                    if (value12 != curPower) {
-                        curPower = value12;
-                        pvars.lock();
-                        this->devicePower = curPower;
-                        pvars.unlock();
+                    if (value12 != current.power) {
+                        current.power = value12;
+                        changed = true;
                     }
                     break;
 
                 case CT_CADENCE:
-                    if (value8 != curCadence) {
-                        curCadence = value8;
-                        pvars.lock();
-                        this->deviceCadence = curCadence;
-                        pvars.unlock();
+                    if (value8 != current.cadence) {
+                        current.cadence = value8;
+                        changed = true;
                     }
                     break;
 
@@ -561,10 +489,9 @@ void Computrainer::run() {
                     value12 /= 10; // it seems that compcs takes off 10% ????
                     newspeed = value12;
                     newspeed /= 1000;
-                    if (newspeed != curSpeed) {
-                        pvars.lock();
-                        this->deviceSpeed = curSpeed = newspeed;
-                        pvars.unlock();
+                    if (newspeed != current.speed) {
+                        current.speed = newspeed;
+                        changed = true;
                     }
                     break;
 
@@ -573,10 +500,9 @@ void Computrainer::run() {
                     newRRC = value12 & ~2048; // only use 11bits
                     newRRC /= 256;
 
-                    if (newRRC != curRRC) {
-                        pvars.lock();
-                        this->deviceRRC = curRRC = newRRC;
-                        pvars.unlock();
+                    if (newRRC != current.RRC) {
+                        current.RRC = newRRC;
+                        changed = true;
                     }
                     break;
 
@@ -584,11 +510,10 @@ void Computrainer::run() {
                     newcadconnected = value12 & 2048 ? true : false;
                     newhrconnected = value12 & 1024 ? true : false;
 
-                    if (newhrconnected != curhrconnected || newcadconnected != curcadconnected) {
-                        pvars.lock();
-                        this->deviceHRConnected = curhrconnected = newhrconnected;
-                        this->deviceCADConnected = curcadconnected = newcadconnected;
-                        pvars.unlock();
+                    if (newhrconnected != current.hrConnected || newcadconnected != current.cadConnected) {
+                        current.hrConnected = newhrconnected;
+                        current.cadConnected = newcadconnected;
+                        changed = true;
                     }
                     break;
 
@@ -596,39 +521,34 @@ void Computrainer::run() {
                     break;
                 }
 
+                if (changed)
+                    publish(current);
+
                 //----------------------------------------------------------------
                 // UPDATE BUTTONS
                 //----------------------------------------------------------------
-                if (buttons != curButtons) {
+                if (buttons) {
                     // let the gui workout what the deal is with silly button values!
-                    pvars.lock();
                     this->deviceButtons |= buttons; // Borrowed from Fortius.cpp: workaround to ensure controller
                                                     // doesn't miss button pushes
-                    pvars.unlock();
                 }
 
-                //----------------------------------------------------------------
-                // UPDATE SSCAN
-                //----------------------------------------------------------------
-                /* not yet implemented */
-
-            } else {
-                // no data
-                // how long to sleep for ... mmm save CPU cycles vs
-                //                           data overflow ?
-                CTsleeper::msleep(10); // lets try a tenth of a second
+            } else if (rc < 0) {
+                // the port is gone or in error, don't spin on it
+                msleep(10);
             }
+        } else {
+            // paused, nothing to read
+            msleep(50);
         }
 
         //----------------------------------------------------------------
         // LISTEN TO GUI CONTROL COMMANDS
         //----------------------------------------------------------------
-        pvars.lock();
         curstatus = this->deviceStatus;
         newmode = this->mode;
         newload = this->load;
-        curgradient = newgradient = this->gradient;
-        pvars.unlock();
+        newgradient = this->gradient;
 
         /* time to shut up shop */
         if (!(curstatus & CT_RUNNING)) {
@@ -652,6 +572,8 @@ void Computrainer::run() {
                 return; // open failed!
             }
             isDeviceOpen = true;
+            bufLength = 0;
+            rxLength = rxPosition = 0;
 
             // send first command to get computrainer ready
             prepareCommand(curmode, curmode == CT_ERGOMODE ? curload : curgradient);
@@ -662,13 +584,16 @@ void Computrainer::run() {
                 quit(4);
                 return; // couldn't write to the device
             }
+            messages = 0;
+            lastSent.restart();
         }
 
         //----------------------------------------------------------------
         // KEEP THE COMPUTRAINER CONTROL ALIVE
         //----------------------------------------------------------------
-        if (isDeviceOpen == true && !(cmds % 10)) {
-            cmds = 1;
+        if (isDeviceOpen == true && (messages >= CT_KEEPALIVE || lastSent.elapsed() >= CT_KEEPALIVETIMEOUT ||
+                                     newmode != curmode || newload != curload || newgradient != curgradient)) {
+            messages = 0;
             curmode = newmode;
             curload = newload;
             curgradient = newgradient;
@@ -679,17 +604,13 @@ void Computrainer::run() {
                 // send failed - ouch!
                 closePort(); // need to release that file handle!!
                 quit(4);
-                cmds = 20;
                 return; // couldn't write to the device
             }
-        } else {
-            cmds++;
+            lastSent.restart();
         }
     }
 }
 
-void CTsleeper::msleep(unsigned long msecs) { QThread::msleep(msecs); }
-
 /* ----------------------------------------------------------------------
  * LOW LEVEL DEVICE IO ROUTINES - PORT TO QIODEVICE REQUIRED BEFORE COMMIT
  *
@@ -697,11 +618,13 @@ void CTsleeper::msleep(unsigned long msecs) { QThread::msleep(msecs); }
  * HIGH LEVEL IO
  * int sendCommand()        - writes a command to the device
  * int readMessage()        - reads an inbound message
+ * bool syncMessage()       - frames the inbound bytes into messages
  *
  * LOW LEVEL IO
  * openPort() - opens serial device and configures it
  * closePort() - closes serial device and releases resources
- * rawRead() - non-blocking read of inbound data
+ * readAvailable() - waits for inbound data and reads what arrived
+ * rawRead() - reads a number of bytes, with timeout
  * rawWrite() - non-blocking write of outbound data
  * discover() - check if a ct is attached to the port specified
  * ---------------------------------------------------------------------- */
@@ -727,35 +650,42 @@ int Computrainer::sendCommand(int mode) // writes a command to the device
     }
 }
 
-int Computrainer::readMessage() {
-    int rc;
+int Computrainer::readMessage(int timeout) {
 
-    if ((rc = rawRead(buf, 7)) > 0 && (buf[6] & 128) == 0) {
-
-        // we got something but need to sync
-        while ((buf[6] & 128) == 0 && rc > 0) {
-            rc = rawRead(&buf[6], 1);
+    while (1) {
+        // bytes left from the previous read first
+        while (rxPosition < rxLength) {
+            if (syncMessage(rxBuffer[rxPosition++]))
+                return 7;
         }
 
-        // at this point we are synced, we may have a dodgy
-        // record but that is fair enough if we were out of
-        // sync anyway - the alternative is to keep going
-        // until we get a good message and that will
-        // lead to bigger issues (plus we may have a hw
-        // problem anyway).
-        //
-        // From experience, the need to sync is quite rare
-        // on a normally configured and working system
+        int rc = readAvailable(rxBuffer, sizeof(rxBuffer), timeout);
+        rxPosition = 0;
+        rxLength = rc > 0 ? rc : 0;
+        if (rc <= 0)
+            return rc;
+
+        // a partial message, take what is already there but don't wait for the rest
+        timeout = 0;
     }
+}
 
-#ifdef Q_OS_ANDROID
-    qDebug() << cleanFrame << QByteArray((const char *)buf, 7).toHex(' ');
+bool Computrainer::syncMessage(uint8_t byte) {
 
-    if (!cleanFrame)
-        return 0;
-#endif
+    // the last byte of a message is the only one that has to have the sync bit (128) set.
+    // When we are out of sync the oldest byte is dropped until one completes a message,
+    // from experience this is quite rare on a normally configured and working system
+    if (bufLength == 7) {
+        memmove(buf, buf + 1, 6);
+        bufLength = 6;
+    }
+    buf[bufLength++] = byte;
 
-    return rc;
+    if (bufLength == 7 && (byte & 128)) {
+        bufLength = 0;
+        return true;
+    }
+    return false;
 }
 
 int Computrainer::closePort() {
@@ -983,39 +913,22 @@ int Computrainer::rawRead(uint8_t bytes[], int size) {
     cleanFrame = true;
 
     return fullLen;
-#elif defined(WIN32)
-    Q_UNUSED(size);
-    // Readfile deals with timeouts and readyread issues
-    DWORD cBytes;
-    rc = ReadFile(devicePort, bytes, 7, &cBytes, NULL);
-    if (rc)
-        return (int)cBytes;
-    else
-        return (-1);
-
 #else
 
-    int timeout = 0, i = 0;
-    uint8_t byte;
+    int i = 0;
+    QElapsedTimer timer;
+    timer.start();
 
-    // read one byte at a time sleeping when no data ready
-    // until we timeout waiting then return error
-    for (i = 0; i < size; i++) {
-        timeout = 0;
-        rc = 0;
-        while (rc == 0 && timeout < CT_READTIMEOUT) {
-            rc = read(devicePort, &byte, 1);
-            if (rc == -1)
-                return -1; // error!
-            else if (rc == 0) {
-                msleep(50); // sleep for 1/20th of a second
-                timeout += 50;
-            } else {
-                bytes[i] = byte;
-            }
-        }
-        if (timeout >= CT_READTIMEOUT)
+    // collect what arrives until we have it all or we time out
+    while (i < size) {
+        int left = CT_READTIMEOUT - (int)timer.elapsed();
+        if (left <= 0)
             return -1; // we timed out!
+
+        rc = readAvailable(bytes + i, size - i, left);
+        if (rc == -1)
+            return -1; // error!
+        i += rc;
     }
 
     qDebug() << i << QString::fromLocal8Bit((const char *)bytes, i);
@@ -1025,6 +938,53 @@ int Computrainer::rawRead(uint8_t bytes[], int size) {
 #endif
 }
 
+int Computrainer::readAvailable(uint8_t *bytes, int size, int timeout) {
+#ifdef Q_OS_ANDROID
+    Q_UNUSED(timeout);
+
+    // the usb serial can't be waited on, it hands over whole frames
+    int rc = rawRead(bytes, qMin(size, 7));
+    qDebug() << cleanFrame << QByteArray((const char *)bytes, qMin(size, 7)).toHex(' ');
+
+    if (!cleanFrame) {
+        QThread::msleep(10);
+        return 0;
+    }
+    return rc;
+#elif defined(WIN32)
+    // return as soon as there is something, or after the timeout
+    COMMTIMEOUTS timeouts;
+    GetCommTimeouts(devicePort, &timeouts);
+    timeouts.ReadIntervalTimeout = MAXDWORD;
+    timeouts.ReadTotalTimeoutMultiplier = MAXDWORD;
+    timeouts.ReadTotalTimeoutConstant = timeout > 0 ? timeout : 1;
+    SetCommTimeouts(devicePort, &timeouts);
+
+    DWORD cBytes;
+    if (!ReadFile(devicePort, bytes, size, &cBytes, NULL))
+        return -1;
+    return (int)cBytes;
+#else
+    struct pollfd pfd;
+    pfd.fd = devicePort;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+
+    int rc = poll(&pfd, 1, timeout);
+    if (rc == 0 || (rc == -1 && errno == EINTR))
+        return 0; // nothing yet
+    if (rc == -1 || !(pfd.revents & POLLIN))
+        return -1; // error or hang up
+
+    rc = read(devicePort, bytes, size);
+    if (rc == -1 && (errno == EAGAIN || errno == EINTR))
+        return 0;
+    if (rc == 0)
+        return -1; // the port is gone
+    return rc;
+#endif
+}
+
 // check to see of there is a port at the device specified
 // returns true if the device exists and false if not
 bool Computrainer::discover(QString filename) {
@@ -35,6 +35,7 @@
 #include <QMutex>
 #include <QString>
 #include <QThread>
+#include <atomic>
 
 #ifdef WIN32
 #include <windows.h>
@@ -68,6 +69,11 @@
 #define CT_READTIMEOUT 1000
 #define CT_WRITETIMEOUT 2000
 
+/* the control commands are resent every CT_KEEPALIVE messages received, or after
+ * CT_KEEPALIVETIMEOUT milliseconds without one, to keep the CT in the current mode */
+#define CT_KEEPALIVE 10
+#define CT_KEEPALIVETIMEOUT 1000
+
 // message type
 #define CT_SPEED 0x01
 #define CT_POWER 0x02
@@ -104,6 +110,19 @@
 #define DEFAULT_LOAD 100.00
 #define DEFAULT_GRADIENT 2.00
 
+// A consistent copy of the telemetry, as published by the run() thread
+struct ComputrainerTelemetry {
+    double power = 0;          // current output power in Watts
+    double heartRate = 0;      // current heartrate in BPM
+    double cadence = 0;        // current cadence in RPM
+    double speed = 0;          // current speed in KPH
+    double RRC = 0;            // calibrated Rolling Resistance
+    bool calibrated = false;   // is it calibrated?
+    bool hrConnected = false;  // HR jack is connected
+    bool cadConnected = false; // Cadence jack is connected
+    uint8_t spinScan[24] = {}; // SS values only in SS_MODE
+};
+
 class Computrainer : public QThread {
 
   public:
@@ -129,8 +148,10 @@ class Computrainer : public QThread {
                  double gradient = DEFAULT_GRADIENT);
 
     // GET TELEMETRY AND STATUS
-    // direct access to class variables is not allowed because we need to use wait conditions
-    // to sync data read/writes between the run() thread and the main gui thread
+    // the run() thread publishes a new snapshot of the telemetry every time it changes, readers
+    // take a copy of it, the lock is only held for the copy so it never stalls the device thread
+    ComputrainerTelemetry telemetry() const;
+    int takeButtons(); // buttons pressed since the last call
     bool isCalibrated();
     bool isHRConnected();
     bool isCADConnected();
@@ -158,32 +179,35 @@ class Computrainer : public QThread {
     int calcCRC(int value);                      // calculates the checksum for the current command
 
     // Protocol decoding
-    int readMessage();
-    void unpackTelemetry(int &b1, int &b2, int &b3, int &buttons, int &type, int &value8, int &value12);
-
-    // Mutex for controlling accessing private data
-    QMutex pvars;
-
-    // INBOUND TELEMETRY - all volatile since it is updated by the run() thread
-    volatile double devicePower;      // current output power in Watts
-    volatile double deviceHeartRate;  // current heartrate in BPM
-    volatile double deviceCadence;    // current cadence in RPM
-    volatile double deviceSpeed;      // current speed in KPH
-    volatile double deviceRRC;        // calibrated Rolling Resistance
-    volatile bool deviceCalibrated;   // is it calibrated?
-    volatile uint8_t spinScan[24];    // SS values only in SS_MODE
-    volatile int deviceButtons;       // Button status
-    volatile bool deviceHRConnected;  // HR jack is connected
-    volatile bool deviceCADConnected; // Cadence jack is connected
-    volatile int deviceStatus;        // Device status running, paused, disconnected
-
-    // OUTBOUND COMMANDS - all volatile since it is updated by the GUI thread
-    volatile int mode;
-    volatile double load;
-    volatile double gradient;
+    int readMessage(int timeout); // waits up to timeout ms for a message
+    bool syncMessage(uint8_t byte); // adds a byte to buf, true when it completes a message
+    void unpackTelemetry(int &b1, int &b2, int &b3, int &buttons, int &type, int &value8, int &value12,
+                         uint8_t *spinScan);
+
+    // INBOUND TELEMETRY - written by the run() thread only, guarded by pvars
+    void publish(const ComputrainerTelemetry &telemetry);
+    mutable QMutex pvars;
+    ComputrainerTelemetry published;
+    std::atomic<int> deviceButtons; // Button status
+    std::atomic<int> deviceStatus;  // Device status running, paused, disconnected
+
+    // OUTBOUND COMMANDS - updated by the GUI thread
+    std::atomic<int> mode;
+    std::atomic<double> load;
+    std::atomic<double> gradient;
 
     // i/o message holder
     uint8_t buf[7];
+    int bufLength = 0;
+
+    // bytes read from the port and not framed yet
+    uint8_t rxBuffer[64];
+    int rxLength = 0;
+    int rxPosition = 0;
+
+    // spinscan values collected until the sync button bit
+    uint8_t ssValues[24];
+    int ssPosition = 0;
 
     // device port
     QString deviceFilename;
@@ -195,8 +219,9 @@ class Computrainer : public QThread {
     struct termios deviceSettings; // unix!!
 #endif
     // raw device utils
-    int rawWrite(uint8_t *bytes, int size); // unix!!
-    int rawRead(uint8_t *bytes, int size);  // unix!!
+    int rawWrite(uint8_t *bytes, int size);                   // unix!!
+    int rawRead(uint8_t *bytes, int size);                    // unix!!
+    int readAvailable(uint8_t *bytes, int size, int timeout); // waits up to timeout ms for data
 
 #ifdef Q_OS_ANDROID
     QList<jbyte> bufRX;
@@ -204,9 +229,4 @@ class Computrainer : public QThread {
 #endif
 };
 
-class CTsleeper : public QThread {
-  public:
-    static void msleep(unsigned long msecs); // inherited from QThread
-};
-
 #endif // _GC_Computrainer_h
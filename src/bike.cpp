@@ -1,6 +1,7 @@
 
 #include "bike.h"
 #include "qdebugfixup.h"
+#include "qzsettingscache.h"
 #include <QSettings>
 
 bike::bike() { elapsed.setType(metric::METRIC_ELAPSED); }
@@ -40,13 +41,26 @@ void bike::changeInclination(double grade, double percentage) {
 
 // originally made for renphobike, but i guess it could be very generic
 uint16_t bike::powerFromResistanceRequest(resistance_t requestResistance) {
-    // this bike has resistance level to N.m so the formula is Power (kW) = Torque (N.m) x Speed (RPM) / 9.5488
     double cadence = RequestedCadence.value();
     if (cadence <= 0)
         cadence = Cadence.value();
+    if (powerTable.hasModel()) {
+        powerTable.setRange(1, maxResistance());
+        return qMax(0.0, powerTable.watts(requestResistance, cadence));
+    }
+    // this bike has resistance level to N.m so the formula is Power (kW) = Torque (N.m) x Speed (RPM) / 9.5488
     return (requestResistance * cadence) / 9.5488;
 }
 
+resistance_t bike::resistanceFromPowerCurve(uint16_t power, double gain, double offset) {
+    // the range can change once the model of the bike is known
+    powerTable.setRange(1, maxResistance());
+    powerTable.setCorrection(gain, offset);
+    resistance_t r = powerTable.resistance(power, Cadence.value());
+    qDebug() << QStringLiteral("resistanceFromPowerCurve") << Cadence.value() << power << r;
+    return r;
+}
+
 void bike::changeRequestedPelotonResistance(int8_t resistance) { RequestedPelotonResistance = resistance; }
 void bike::changeCadence(int16_t cadence) { RequestedCadence = cadence; }
 void bike::changePower(int32_t power) {
@@ -93,21 +107,31 @@ void bike::setGears(double gears) {
 
 double bike::currentCrankRevolutions() { return CrankRevs; }
 uint16_t bike::lastCrankEventTime() { return LastCrankEventTime; }
-metric bike::lastRequestedResistance() { return RequestedResistance; }
-metric bike::lastRequestedPelotonResistance() { return RequestedPelotonResistance; }
-metric bike::lastRequestedCadence() { return RequestedCadence; }
-metric bike::lastRequestedPower() { return RequestedPower; }
-metric bike::currentResistance() { return Resistance; }
+const metric &bike::lastRequestedResistance() { return RequestedResistance; }
+const metric &bike::lastRequestedPelotonResistance() { return RequestedPelotonResistance; }
+const metric &bike::lastRequestedCadence() { return RequestedCadence; }
+const metric &bike::lastRequestedPower() { return RequestedPower; }
+const metric &bike::currentResistance() { return Resistance; }
 uint8_t bike::fanSpeed() { return FanSpeed; }
 bool bike::connected() { return false; }
 uint16_t bike::watts() { return 0; }
-metric bike::pelotonResistance() { return m_pelotonResistance; }
+const metric &bike::pelotonResistance() { return m_pelotonResistance; }
 resistance_t bike::pelotonToBikeResistance(int pelotonResistance) { return pelotonResistance; }
 resistance_t bike::resistanceFromPowerRequest(uint16_t power) { return power / 10; } // in order to have something
 void bike::cadenceSensor(uint8_t cadence) { Cadence.setValue(cadence); }
-void bike::powerSensor(uint16_t power) { m_watt.setValue(power, false); }
+void bike::powerSensor(uint16_t power) {
+    m_watt.setValue(power, false);
+    // the power meter tells what the resistance really gives at this cadence
+    powerTable.observe(Resistance.value(), Cadence.value(), power);
+}
 
 bluetoothdevice::BLUETOOTH_TYPE bike::deviceType() { return bluetoothdevice::BIKE; }
+void bike::setMetricColor(METRIC_COLOR which, const QString &color) {
+    if (which == PELOTON_RESISTANCE_COLOR)
+        m_pelotonResistance.setColor(color);
+    else
+        bluetoothdevice::setMetricColor(which, color);
+}
 
 void bike::clearStats() {
 
@@ -178,9 +202,7 @@ void bike::setLap() {
 
 uint8_t bike::metrics_override_heartrate() {
 
-    QSettings settings;
-    QString setting =
-        settings.value(QZSettings::peloton_heartrate_metric, QZSettings::default_peloton_heartrate_metric).toString();
+    const QString &setting = qzsettingscache::get().peloton_heartrate_metric;
     if (!setting.compare(QStringLiteral("Heart Rate"))) {
         return qRound(currentHeart().value());
     } else if (!setting.compare(QStringLiteral("Speed"))) {
@@ -2,6 +2,7 @@
 #define BIKE_H
 
 #include "bluetoothdevice.h"
+#include "ergtable.h"
 #include "virtualbike.h"
 #include <QObject>
 
@@ -14,11 +15,11 @@ class bike : public bluetoothdevice {
 
     virtualbike *VirtualBike();
 
-    metric lastRequestedResistance();
-    metric lastRequestedPelotonResistance();
-    metric lastRequestedCadence();
-    metric lastRequestedPower();
-    metric currentResistance() override;
+    const metric &lastRequestedResistance();
+    const metric &lastRequestedPelotonResistance();
+    const metric &lastRequestedCadence();
+    const metric &lastRequestedPower();
+    const metric &currentResistance() override;
     uint8_t fanSpeed() override;
     double currentCrankRevolutions() override;
     uint16_t lastCrankEventTime() override;
@@ -29,7 +30,8 @@ class bike : public bluetoothdevice {
     virtual uint16_t powerFromResistanceRequest(resistance_t requestResistance);
     virtual bool ergManagedBySS2K() { return false; }
     bluetoothdevice::BLUETOOTH_TYPE deviceType() override;
-    metric pelotonResistance();
+    void setMetricColor(METRIC_COLOR which, const QString &color) override;
+    const metric &pelotonResistance();
     void clearStats() override;
     void setLap() override;
     void setPaused(bool p) override;
@@ -40,11 +42,11 @@ class bike : public bluetoothdevice {
     double speedLimit() { return m_speedLimit; }
 
     /**
-     * @brief currentSteeringAngle Gets a metric object to get or set the current steering angle
+     * @brief currentSteeringAngle Gets the read-only metric of the current steering angle
      * for the Elite Sterzo or emulating device. Expected range -45 to +45 degrees.
      * @return A metric object.
      */
-    metric currentSteeringAngle() { return m_steeringAngle; }
+    const metric &currentSteeringAngle() { return m_steeringAngle; }
     virtual bool inclinationAvailableByHardware();
     bool ergModeSupportedAvailableByHardware() { return ergModeSupported; }
 
@@ -89,7 +91,28 @@ class bike : public bluetoothdevice {
 
     double m_speedLimit = 0;
 
+    /**
+     * @brief powerTable The cadence x resistance power table of the bikes that declare their curve with
+     * setPowerCurve(). The power sensor readings refine it, within ergtable::maxDrift of the curve, until it's built
+     * again: when maxResistance() changes, e.g. once the model of the bike is known, the learning starts over.
+     */
+    ergtable powerTable;
+
     uint16_t wattFromHR(bool useSpeedAndCadence);
+
+    /**
+     * @brief setPowerCurve Declares the power of the bike at a resistance level and a cadence, from 1 to
+     * maxResistance(). From then on the ERG lookups are answered from a table built once from it.
+     */
+    void setPowerCurve(const ergtable::model &watts) { powerTable.setModel(watts); }
+
+    /**
+     * @brief resistanceFromPowerCurve The resistance level for a power request at the current cadence, from the
+     * table. 1 if the power is below the curve, maxResistance() if it's above.
+     * @param gain The power of the curve is multiplied by it...
+     * @param offset ...and this is added, as the watt_gain and watt_offset settings do.
+     */
+    resistance_t resistanceFromPowerCurve(uint16_t power, double gain = 1.0, double offset = 0.0);
 };
 
 #endif // BIKE_H
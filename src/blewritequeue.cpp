@@ -0,0 +1,177 @@
+#include "blewritequeue.h"
+#include <QDebug>
+
+blewritequeue::blewritequeue(QObject *parent) : QObject(parent) {
+    m_timeout.setSingleShot(true);
+    connect(&m_timeout, &QTimer::timeout, this, &blewritequeue::timeout);
+}
+
+void blewritequeue::enqueue(QLowEnergyService *service, const QLowEnergyCharacteristic &characteristic,
+                            const QByteArray &data, const QString &info, bool disable_log, bool wait_for_response,
+                            int coalesceKey, completion_t done, WRITE_MODE mode) {
+    if (!service) {
+        qDebug() << QStringLiteral("blewritequeue: no service available") << info;
+        if (done)
+            done(false);
+        return;
+    }
+
+    watch(service);
+    append(service, characteristic, data, info, disable_log, wait_for_response, coalesceKey, done, mode);
+}
+
+void blewritequeue::append(QObject *target, const QLowEnergyCharacteristic &characteristic, const QByteArray &data,
+                           const QString &info, bool disable_log, bool wait_for_response, int coalesceKey,
+                           completion_t done, WRITE_MODE mode) {
+    // a newer setpoint replaces an unsent older one, it would be overwritten by the device anyway
+    if (coalesceKey >= 0) {
+        for (request &r : m_queue) {
+            if (r.coalesceKey == coalesceKey && r.service == target &&
+                r.characteristic.uuid() == characteristic.uuid()) {
+                if (r.done)
+                    r.done(false);
+                r.data = data;
+                r.info = info;
+                r.disable_log = disable_log;
+                r.wait_for_response = wait_for_response;
+                r.done = done;
+                r.mode = mode;
+                m_coalesced++;
+                return;
+            }
+        }
+    }
+
+    request r;
+    r.service = target;
+    r.characteristic = characteristic;
+    r.data = data;
+    r.info = info;
+    r.disable_log = disable_log;
+    r.wait_for_response = wait_for_response;
+    r.coalesceKey = coalesceKey;
+    r.done = done;
+    r.mode = mode;
+    r.queued.start();
+    m_queue.append(r);
+
+    if (depth() > m_maxDepth)
+        m_maxDepth = depth();
+
+    if (!m_inFlight)
+        sendNext();
+}
+
+void blewritequeue::clear() {
+    m_timeout.stop();
+    QList<request> dropped = m_queue;
+    m_queue.clear();
+    if (m_inFlight) {
+        dropped.prepend(m_current);
+        m_inFlight = false;
+        m_current = request();
+    }
+    for (const request &r : qAsConst(dropped)) {
+        if (r.done)
+            r.done(false);
+    }
+}
+
+void blewritequeue::watch(QLowEnergyService *service) {
+    for (const QPointer<QLowEnergyService> &s : qAsConst(m_watched)) {
+        if (s == service)
+            return;
+    }
+    m_watched.removeAll(QPointer<QLowEnergyService>());
+    m_watched.append(service);
+    connect(service, &QLowEnergyService::characteristicWritten, this, &blewritequeue::characteristicWritten);
+    connect(service, &QLowEnergyService::characteristicChanged, this, &blewritequeue::characteristicChanged);
+}
+
+void blewritequeue::sendNext() {
+    while (!m_inFlight && !m_queue.isEmpty()) {
+        m_current = m_queue.takeFirst();
+        if (!m_current.service) {
+            if (m_current.done)
+                m_current.done(false);
+            continue;
+        }
+
+        QLowEnergyService::WriteMode writeMode = QLowEnergyService::WriteWithResponse;
+        if (m_current.mode == WRITE_WITHOUT_RESPONSE ||
+            (m_current.mode == WRITE_AUTO &&
+             (m_current.characteristic.properties() & QLowEnergyCharacteristic::WriteNoResponse))) {
+            writeMode = QLowEnergyService::WriteWithoutResponse;
+        }
+
+        m_inFlight = true;
+        write(m_current.service.data(), m_current.characteristic, m_current.data, writeMode);
+
+        if (!m_current.disable_log) {
+            emit debug(QStringLiteral(" >> ") + m_current.data.toHex(' ') + QStringLiteral(" // ") + m_current.info);
+        }
+
+        if (writeMode == QLowEnergyService::WriteWithoutResponse && !m_current.wait_for_response) {
+            // no acknowledge will come back: pipeline the next request on the next event loop iteration
+            complete(true);
+            return;
+        }
+
+        m_timeout.start(m_timeoutMs);
+    }
+}
+
+void blewritequeue::complete(bool written) {
+    m_timeout.stop();
+    request r = m_current;
+    m_current = request();
+    m_inFlight = false;
+
+    qint64 latency = r.queued.isValid() ? r.queued.elapsed() : 0;
+    if (written) {
+        m_written++;
+        m_totalLatencyMs += latency;
+        if (latency > m_maxLatencyMs)
+            m_maxLatencyMs = latency;
+    } else {
+        m_timeouts++;
+    }
+
+    if (r.done)
+        r.done(written);
+
+    if (!m_queue.isEmpty())
+        QTimer::singleShot(0, this, &blewritequeue::sendNext);
+}
+
+void blewritequeue::write(QObject *target, const QLowEnergyCharacteristic &characteristic, const QByteArray &data,
+                          QLowEnergyService::WriteMode mode) {
+    QLowEnergyService *service = qobject_cast<QLowEnergyService *>(target);
+    if (service)
+        service->writeCharacteristic(characteristic, data, mode);
+}
+
+void blewritequeue::acknowledge(QObject *target, const QBluetoothUuid &uuid, bool notification) {
+    if (!m_inFlight || m_current.wait_for_response != notification || target != m_current.service.data())
+        return;
+    if (!notification && uuid != m_current.characteristic.uuid())
+        return;
+    complete(true);
+}
+
+void blewritequeue::characteristicWritten(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
+    Q_UNUSED(newValue)
+    acknowledge(sender(), characteristic.uuid(), false);
+}
+
+void blewritequeue::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
+    Q_UNUSED(newValue)
+    acknowledge(sender(), characteristic.uuid(), true);
+}
+
+void blewritequeue::timeout() {
+    if (!m_inFlight)
+        return;
+    qDebug() << QStringLiteral("blewritequeue: timeout") << m_current.info;
+    complete(false);
+}
@@ -0,0 +1,144 @@
+#ifndef BLEWRITEQUEUE_H
+#define BLEWRITEQUEUE_H
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+
+#include <QtBluetooth/qlowenergycharacteristic.h>
+#include <QtBluetooth/qlowenergyservice.h>
+
+#include <functional>
+
+/**
+ * @brief The blewritequeue class serializes the writes of a device driver toward its GATT characteristics
+ * without spinning a nested QEventLoop. A write is sent as soon as the previous one has been acknowledged
+ * (or timed out), so the GUI thread keeps running while a frame is in flight.
+ */
+class blewritequeue : public QObject {
+    Q_OBJECT
+
+  public:
+    /**
+     * @brief completion_t Invoked once per request. written is false when the request timed out, was replaced by a
+     * newer request with the same coalesce key, or was dropped by clear().
+     */
+    typedef std::function<void(bool written)> completion_t;
+
+    enum WRITE_MODE {
+        /**
+         * @brief Use WriteWithoutResponse when the characteristic supports it, otherwise WriteWithResponse.
+         */
+        WRITE_AUTO = 0,
+        WRITE_WITH_RESPONSE,
+        WRITE_WITHOUT_RESPONSE
+    };
+
+    explicit blewritequeue(QObject *parent = nullptr);
+
+    /**
+     * @brief enqueue Appends a write request to the queue.
+     * @param service The service owning the characteristic.
+     * @param characteristic The characteristic to write.
+     * @param data The payload.
+     * @param info A description used for the log line.
+     * @param disable_log True to skip the " >> " log line.
+     * @param wait_for_response True to wait for a notification on the service before sending the next request.
+     * @param coalesceKey When >= 0, an unsent request with the same characteristic and key is replaced by this one.
+     * @param done Optional completion callback.
+     * @param mode The GATT write type.
+     */
+    void enqueue(QLowEnergyService *service, const QLowEnergyCharacteristic &characteristic, const QByteArray &data,
+                 const QString &info, bool disable_log = false, bool wait_for_response = false, int coalesceKey = -1,
+                 completion_t done = nullptr, WRITE_MODE mode = WRITE_AUTO);
+
+    /**
+     * @brief clear Drops every pending request, e.g. when the device disconnects.
+     */
+    void clear();
+
+    /**
+     * @brief setTimeout Sets how long to wait for an acknowledge before moving to the next request. Units: ms
+     */
+    void setTimeout(int ms) { m_timeoutMs = ms; }
+
+    /**
+     * @brief depth Number of requests not yet completed, the one in flight included.
+     */
+    int depth() const { return m_queue.count() + (m_inFlight ? 1 : 0); }
+    int maxDepth() const { return m_maxDepth; }
+    quint64 written() const { return m_written; }
+    quint64 coalesced() const { return m_coalesced; }
+    quint64 timeouts() const { return m_timeouts; }
+
+    /**
+     * @brief averageLatency Average time from enqueue to completion. Units: ms
+     */
+    double averageLatency() const { return m_written ? (double)m_totalLatencyMs / (double)m_written : 0; }
+    qint64 maxLatency() const { return m_maxLatencyMs; }
+
+  Q_SIGNALS:
+    void debug(QString string);
+
+  protected:
+    /**
+     * @brief append Queues a request toward target, which has already been checked and watched. enqueue() passes
+     * the service; the tests, which have no GATT service, pass a plain QObject and override write().
+     */
+    void append(QObject *target, const QLowEnergyCharacteristic &characteristic, const QByteArray &data,
+                const QString &info, bool disable_log, bool wait_for_response, int coalesceKey, completion_t done,
+                WRITE_MODE mode);
+
+    /**
+     * @brief write Sends the payload of the request in flight.
+     */
+    virtual void write(QObject *target, const QLowEnergyCharacteristic &characteristic, const QByteArray &data,
+                       QLowEnergyService::WriteMode mode);
+
+    /**
+     * @brief acknowledge Completes the request in flight if target acknowledged it: notification is true for a
+     * characteristicChanged, false for a characteristicWritten of uuid.
+     */
+    void acknowledge(QObject *target, const QBluetoothUuid &uuid, bool notification);
+
+  private:
+    struct request {
+        QPointer<QObject> service;
+        QLowEnergyCharacteristic characteristic;
+        QByteArray data;
+        QString info;
+        bool disable_log = false;
+        bool wait_for_response = false;
+        int coalesceKey = -1;
+        completion_t done;
+        WRITE_MODE mode = WRITE_AUTO;
+        QElapsedTimer queued;
+    };
+
+    void sendNext();
+    void complete(bool written);
+    void watch(QLowEnergyService *service);
+
+    QList<request> m_queue;
+    request m_current;
+    bool m_inFlight = false;
+    QTimer m_timeout;
+    int m_timeoutMs = 300;
+    QList<QPointer<QLowEnergyService>> m_watched;
+
+    int m_maxDepth = 0;
+    quint64 m_written = 0;
+    quint64 m_coalesced = 0;
+    quint64 m_timeouts = 0;
+    qint64 m_totalLatencyMs = 0;
+    qint64 m_maxLatencyMs = 0;
+
+  private slots:
+    void characteristicWritten(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue);
+    void characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue);
+    void timeout();
+};
+
+#endif // BLEWRITEQUEUE_H
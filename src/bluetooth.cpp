@@ -1,4 +1,5 @@
 #include "bluetooth.h"
+#include "devicenamematcher.h"
 #include "homeform.h"
 #include <QBluetoothLocalDevice>
 #include <QDateTime>
@@ -39,6 +40,7 @@ bluetooth::bluetooth(bool logs, const QString &deviceName, bool noWriteResistanc
 
     if (settings.value(QZSettings::peloton_bike_ocr, QZSettings::default_peloton_bike_ocr).toBool() && !pelotonBike) {
         pelotonBike = new pelotonbike(noWriteResistance, noHeartService);
+        this->setActiveDevice(pelotonBike);
         emit deviceConnected(QBluetoothDeviceInfo());
         connect(pelotonBike, &bluetoothdevice::connectedAndDiscovered, this, &bluetooth::connectedAndDiscovered);
         connect(pelotonBike, &pelotonbike::debug, this, &bluetooth::debug);
@@ -101,7 +103,16 @@ bluetooth::~bluetooth() {
     }*/
 }
 
-void bluetooth::signalBluetoothDeviceConnected(bluetoothdevice *b) { emit this->bluetoothDeviceConnected(b); }
+void bluetooth::setActiveDevice(bluetoothdevice *b) {
+    if (activeDevice && activeDevice != b)
+        qDebug() << QStringLiteral("bluetooth::setActiveDevice replacing") << activeDevice->metaObject()->className();
+    activeDevice = b;
+}
+
+void bluetooth::signalBluetoothDeviceConnected(bluetoothdevice *b) {
+    setActiveDevice(b);
+    emit this->bluetoothDeviceConnected(b);
+}
 
 void bluetooth::finished() {
     debug(QStringLiteral("BTLE scanning finished"));
@@ -476,6 +487,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
             settings.value(QZSettings::bluetooth_lastdevice_address, QZSettings::default_bluetooth_lastdevice_address)
                 .toString()));
         // set name method doesn't exist
+        this->setActiveDevice(schwinnIC4Bike);
         emit(deviceConnected(bt));
         connect(schwinnIC4Bike, SIGNAL(connectedAndDiscovered()), this, SLOT(connectedAndDiscovered()));
         // connect(echelonConnectSport, SIGNAL(disconnected()), this, SLOT(restart()));
@@ -560,6 +572,13 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                          forceHeartBeltOffForTimeout;
 
     if (searchDevices) {
+        // these branches don't look at the advertised name, so every device has to go through the chain
+        bool namelessDevices = fake_bike || fakedevice_elliptical || fakedevice_rower || fakedevice_treadmill ||
+                               !proformtdf4ip.isEmpty() || !computrainerSerialPort.isEmpty() ||
+                               !csaferowerSerialPort.isEmpty() || !proformtreadmillip.isEmpty() ||
+                               !nordictrack_2950_ip.isEmpty() || !tdf_10_ip.isEmpty();
+        const devicenamematcher &driverNames = devicenamematcher::drivers();
+
         for (const QBluetoothDeviceInfo &b : qAsConst(devices)) {
 
             bool filter = true;
@@ -567,12 +586,27 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
 
                 filter = (b.name().compare(filterDevice, Qt::CaseInsensitive) == 0);
             }
+
+            // skip with a single trie walk the devices that no branch below can pick
+            if (!namelessDevices &&
+                (!filter ||
+                 (!driverNames.matches(b.name()) && !(csc_as_bike && b.name().startsWith(cscName)) &&
+                  !((power_as_bike || power_as_treadmill) && b.name().startsWith(powerSensorName)) &&
+                  !(ss2k_peloton && b.name().toUpper().startsWith(ftmsAccessoryName.toUpper())) &&
+                  b.name().compare(ftms_bike, Qt::CaseInsensitive) &&
+                  b.name().compare(ftms_treadmill, Qt::CaseInsensitive) &&
+                  b.name().compare(ftms_rower, Qt::CaseInsensitive) &&
+                  b.address() != QBluetoothAddress(QStringLiteral("C1:14:D9:9C:FB:01"))))) {
+                continue;
+            }
+
             if (b.name().startsWith(QStringLiteral("M3")) && !m3iBike && filter) {
 
                 if (m3ibike::isCorrectUnit(b)) {
                     this->setLastBluetoothDevice(b);
                     this->stopDiscovery();
                     m3iBike = new m3ibike(noWriteResistance, noHeartService);
+                    this->setActiveDevice(m3iBike);
                     emit deviceConnected(b);
                     connect(m3iBike, &bluetoothdevice::connectedAndDiscovered, this,
                             &bluetooth::connectedAndDiscovered);
@@ -587,6 +621,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
             } else if (fake_bike && !fakeBike) {
                 this->stopDiscovery();
                 fakeBike = new fakebike(noWriteResistance, noHeartService, false);
+                this->setActiveDevice(fakeBike);
                 emit deviceConnected(b);
                 connect(fakeBike, &bluetoothdevice::connectedAndDiscovered, this, &bluetooth::connectedAndDiscovered);
                 connect(fakeBike, &fakebike::inclinationChanged, this, &bluetooth::inclinationChanged);
@@ -600,6 +635,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
             } else if (fakedevice_elliptical && !fakeElliptical) {
                 this->stopDiscovery();
                 fakeElliptical = new fakeelliptical(noWriteResistance, noHeartService, false);
+                this->setActiveDevice(fakeElliptical);
                 emit deviceConnected(b);
                 connect(fakeElliptical, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -614,6 +650,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
             } else if (fakedevice_rower && !fakeRower) {
                 this->stopDiscovery();
                 fakeRower = new fakerower(noWriteResistance, noHeartService, false);
+                this->setActiveDevice(fakeRower);
                 emit deviceConnected(b);
                 connect(fakeRower, &bluetoothdevice::connectedAndDiscovered, this, &bluetooth::connectedAndDiscovered);
                 connect(fakeRower, &fakerower::inclinationChanged, this, &bluetooth::inclinationChanged);
@@ -627,6 +664,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
             } else if (fakedevice_treadmill && !fakeTreadmill) {
                 this->stopDiscovery();
                 fakeTreadmill = new faketreadmill(noWriteResistance, noHeartService, false);
+                this->setActiveDevice(fakeTreadmill);
                 emit deviceConnected(b);
                 connect(fakeTreadmill, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -643,6 +681,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 proformWifiBike =
                     new proformwifibike(noWriteResistance, noHeartService, bikeResistanceOffset, bikeResistanceGain);
+                this->setActiveDevice(proformWifiBike);
                 emit deviceConnected(b);
                 connect(proformWifiBike, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -659,6 +698,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 computrainerBike =
                     new computrainerbike(noWriteResistance, noHeartService, bikeResistanceOffset, bikeResistanceGain);
+                this->setActiveDevice(computrainerBike);
                 emit deviceConnected(b);
                 connect(computrainerBike, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -673,6 +713,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
             } else if (!csaferowerSerialPort.isEmpty() && !csafeRower) {
                 this->stopDiscovery();
                 csafeRower = new csaferower(noWriteResistance, noHeartService, false);
+                this->setActiveDevice(csafeRower);
                 emit deviceConnected(b);
                 connect(csafeRower, &bluetoothdevice::connectedAndDiscovered, this, &bluetooth::connectedAndDiscovered);
                 // connect(cscBike, SIGNAL(disconnected()), this, SLOT(restart()));
@@ -688,6 +729,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 proformWifiTreadmill = new proformwifitreadmill(noWriteResistance, noHeartService, bikeResistanceOffset,
                                                                 bikeResistanceGain);
+                this->setActiveDevice(proformWifiTreadmill);
                 emit deviceConnected(b);
                 connect(proformWifiTreadmill, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -702,6 +744,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
             } else if (!nordictrack_2950_ip.isEmpty() && !nordictrackifitadbTreadmill) {
                 this->stopDiscovery();
                 nordictrackifitadbTreadmill = new nordictrackifitadbtreadmill(noWriteResistance, noHeartService);
+                this->setActiveDevice(nordictrackifitadbTreadmill);
                 emit deviceConnected(b);
                 connect(nordictrackifitadbTreadmill, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -716,6 +759,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 nordictrackifitadbBike = new nordictrackifitadbbike(noWriteResistance, noHeartService,
                                                                     bikeResistanceOffset, bikeResistanceGain);
+                this->setActiveDevice(nordictrackifitadbBike);
                 emit deviceConnected(b);
                 connect(nordictrackifitadbBike, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -732,6 +776,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
                 cscBike = new cscbike(noWriteResistance, noHeartService, false);
+                this->setActiveDevice(cscBike);
                 emit deviceConnected(b);
                 connect(cscBike, &bluetoothdevice::connectedAndDiscovered, this, &bluetooth::connectedAndDiscovered);
                 // connect(cscBike, SIGNAL(disconnected()), this, SLOT(restart()));
@@ -746,6 +791,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
                 powerBike = new stagesbike(noWriteResistance, noHeartService, false);
+                this->setActiveDevice(powerBike);
                 emit deviceConnected(b);
                 connect(powerBike, &bluetoothdevice::connectedAndDiscovered, this, &bluetooth::connectedAndDiscovered);
                 // connect(cscBike, SIGNAL(disconnected()), this, SLOT(restart()));
@@ -762,6 +808,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
                 powerTreadmill = new strydrunpowersensor(noWriteResistance, noHeartService, false);
+                this->setActiveDevice(powerTreadmill);
                 emit deviceConnected(b);
                 connect(powerTreadmill, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -779,6 +826,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 domyosRower = new domyosrower(noWriteResistance, noHeartService, testResistance, bikeResistanceOffset,
                                               bikeResistanceGain);
+                this->setActiveDevice(domyosRower);
                 emit deviceConnected(b);
                 connect(domyosRower, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -796,6 +844,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 domyosBike = new domyosbike(noWriteResistance, noHeartService, testResistance, bikeResistanceOffset,
                                             bikeResistanceGain);
+                this->setActiveDevice(domyosBike);
                 emit deviceConnected(b);
                 connect(domyosBike, &bluetoothdevice::connectedAndDiscovered, this, &bluetooth::connectedAndDiscovered);
                 // connect(domyosBike, SIGNAL(disconnected()), this, SLOT(restart()));
@@ -812,6 +861,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 domyosElliptical = new domyoselliptical(noWriteResistance, noHeartService, testResistance,
                                                         bikeResistanceOffset, bikeResistanceGain);
+                this->setActiveDevice(domyosElliptical);
                 emit deviceConnected(b);
                 connect(domyosElliptical, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -828,6 +878,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 ypooElliptical =
                     new ypooelliptical(noWriteResistance, noHeartService, bikeResistanceOffset, bikeResistanceGain);
+                this->setActiveDevice(ypooElliptical);
                 emit deviceConnected(b);
                 connect(ypooElliptical, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -846,6 +897,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 nautilusElliptical = new nautiluselliptical(noWriteResistance, noHeartService, testResistance,
                                                             bikeResistanceOffset, bikeResistanceGain);
+                this->setActiveDevice(nautilusElliptical);
                 emit deviceConnected(b);
                 connect(nautilusElliptical, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -862,6 +914,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 nautilusBike = new nautilusbike(noWriteResistance, noHeartService, testResistance, bikeResistanceOffset,
                                                 bikeResistanceGain);
+                this->setActiveDevice(nautilusBike);
                 emit deviceConnected(b);
                 connect(nautilusBike, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -876,6 +929,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
                 proformElliptical = new proformelliptical(noWriteResistance, noHeartService);
+                this->setActiveDevice(proformElliptical);
                 emit deviceConnected(b);
                 connect(proformElliptical, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -891,6 +945,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 nordictrackElliptical = new nordictrackelliptical(noWriteResistance, noHeartService,
                                                                   bikeResistanceOffset, bikeResistanceGain);
+                this->setActiveDevice(nordictrackElliptical);
                 emit deviceConnected(b);
                 connect(nordictrackElliptical, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -907,6 +962,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 proformEllipticalTrainer = new proformellipticaltrainer(noWriteResistance, noHeartService,
                                                                         bikeResistanceOffset, bikeResistanceGain);
+                this->setActiveDevice(proformEllipticalTrainer);
                 emit deviceConnected(b);
                 connect(proformEllipticalTrainer, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -922,6 +978,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
                 proformRower = new proformrower(noWriteResistance, noHeartService);
+                this->setActiveDevice(proformRower);
                 emit deviceConnected(b);
                 connect(proformRower, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -937,6 +994,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 bhFitnessElliptical = new bhfitnesselliptical(noWriteResistance, noHeartService, bikeResistanceOffset,
                                                               bikeResistanceGain);
+                this->setActiveDevice(bhFitnessElliptical);
                 emit deviceConnected(b);
                 connect(bhFitnessElliptical, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -960,6 +1018,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 soleElliptical = new soleelliptical(noWriteResistance, noHeartService, testResistance,
                                                     bikeResistanceOffset, bikeResistanceGain);
+                this->setActiveDevice(soleElliptical);
                 emit deviceConnected(b);
                 connect(soleElliptical, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -977,8 +1036,9 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 domyos = new domyostreadmill(this->pollDeviceTime, noConsole, noHeartService);
 #if !defined(Q_OS_ANDROID) && !defined(Q_OS_IOS)
-                stateFileRead();
+                stateFileRead(domyos);
 #endif
+                this->setActiveDevice(domyos);
                 emit deviceConnected(b);
                 connect(domyos, &bluetoothdevice::connectedAndDiscovered, this, &bluetooth::connectedAndDiscovered);
                 // connect(domyos, SIGNAL(disconnected()), this, SLOT(restart()));
@@ -1008,8 +1068,9 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 kingsmithR2Treadmill = new kingsmithr2treadmill(this->pollDeviceTime, noConsole, noHeartService);
 #if !defined(Q_OS_ANDROID) && !defined(Q_OS_IOS)
-                stateFileRead();
+                stateFileRead(kingsmithR2Treadmill);
 #endif
+                this->setActiveDevice(kingsmithR2Treadmill);
                 emit deviceConnected(b);
                 connect(kingsmithR2Treadmill, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -1038,8 +1099,9 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 kingsmithR1ProTreadmill = new kingsmithr1protreadmill(this->pollDeviceTime, noConsole, noHeartService);
 #if !defined(Q_OS_ANDROID) && !defined(Q_OS_IOS)
-                stateFileRead();
+                stateFileRead(kingsmithR1ProTreadmill);
 #endif
+                this->setActiveDevice(kingsmithR1ProTreadmill);
                 emit deviceConnected(b);
                 connect(kingsmithR1ProTreadmill, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -1060,8 +1122,9 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 shuaA5Treadmill = new shuaa5treadmill(noWriteResistance, noHeartService);
 #if !defined(Q_OS_ANDROID) && !defined(Q_OS_IOS)
-                stateFileRead();
+                stateFileRead(shuaA5Treadmill);
 #endif
+                this->setActiveDevice(shuaA5Treadmill);
                 emit deviceConnected(b);
                 connect(shuaA5Treadmill, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -1081,8 +1144,9 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 trueTreadmill = new truetreadmill(noWriteResistance, noHeartService);
 #if !defined(Q_OS_ANDROID) && !defined(Q_OS_IOS)
-                stateFileRead();
+                stateFileRead(trueTreadmill);
 #endif
+                this->setActiveDevice(trueTreadmill);
                 emit deviceConnected(b);
                 connect(trueTreadmill, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -1106,8 +1170,9 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 soleF80 = new solef80treadmill(noWriteResistance, noHeartService);
 #if !defined(Q_OS_ANDROID) && !defined(Q_OS_IOS)
-                stateFileRead();
+                stateFileRead(soleF80);
 #endif
+                this->setActiveDevice(soleF80);
                 emit deviceConnected(b);
                 connect(soleF80, &bluetoothdevice::connectedAndDiscovered, this, &bluetooth::connectedAndDiscovered);
                 // connect(soleF80, SIGNAL(disconnected()), this, SLOT(restart()));
@@ -1130,8 +1195,9 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 lifefitnessTreadmill = new lifefitnesstreadmill(noWriteResistance, noHeartService);
 #if !defined(Q_OS_ANDROID) && !defined(Q_OS_IOS)
-                stateFileRead();
+                stateFileRead(lifefitnessTreadmill);
 #endif
+                this->setActiveDevice(lifefitnessTreadmill);
                 emit deviceConnected(b);
                 connect(lifefitnessTreadmill, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -1184,8 +1250,9 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 horizonTreadmill = new horizontreadmill(noWriteResistance, noHeartService);
 #if !defined(Q_OS_ANDROID) && !defined(Q_OS_IOS)
-                stateFileRead();
+                stateFileRead(horizonTreadmill);
 #endif
+                this->setActiveDevice(horizonTreadmill);
                 emit deviceConnected(b);
                 connect(horizonTreadmill, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -1221,8 +1288,9 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                     technogymmyrunTreadmill = new technogymmyruntreadmill(noWriteResistance, noHeartService);
                     this->setLastBluetoothDevice(b);
 #if !defined(Q_OS_ANDROID) && !defined(Q_OS_IOS)
-                    stateFileRead();
+                    stateFileRead(technogymmyrunTreadmill);
 #endif
+                    this->setActiveDevice(technogymmyrunTreadmill);
                     emit deviceConnected(b);
                     connect(technogymmyrunTreadmill, &bluetoothdevice::connectedAndDiscovered, this,
                             &bluetooth::connectedAndDiscovered);
@@ -1245,8 +1313,9 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 else {
                     technogymmyrunrfcommTreadmill = new technogymmyruntreadmillrfcomm();
 #if !defined(Q_OS_ANDROID) && !defined(Q_OS_IOS)
-                    stateFileRead();
+                    stateFileRead(technogymmyrunrfcommTreadmill);
 #endif
+                    this->setActiveDevice(technogymmyrunrfcommTreadmill);
                     emit deviceConnected(b);
                     connect(technogymmyrunrfcommTreadmill, &bluetoothdevice::connectedAndDiscovered, this,
                             &bluetooth::connectedAndDiscovered);
@@ -1275,6 +1344,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 tacxneo2Bike = new tacxneo2(noWriteResistance, noHeartService);
                 // stateFileRead();
+                this->setActiveDevice(tacxneo2Bike);
                 emit(deviceConnected(b));
                 connect(tacxneo2Bike, SIGNAL(connectedAndDiscovered()), this, SLOT(connectedAndDiscovered()));
                 // connect(tacxneo2Bike, SIGNAL(disconnected()), this, SLOT(restart()));
@@ -1293,6 +1363,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 npeCableBike = new npecablebike(noWriteResistance, noHeartService);
                 // stateFileRead();
+                this->setActiveDevice(npeCableBike);
                 emit deviceConnected(b);
                 connect(npeCableBike, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -1334,6 +1405,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
                 ftmsBike = new ftmsbike(noWriteResistance, noHeartService, bikeResistanceOffset, bikeResistanceGain);
+                this->setActiveDevice(ftmsBike);
                 emit deviceConnected(b);
                 connect(ftmsBike, &bluetoothdevice::connectedAndDiscovered, this, &bluetooth::connectedAndDiscovered);
                 // connect(trxappgateusb, SIGNAL(disconnected()), this, SLOT(restart()));
@@ -1348,6 +1420,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 wahooKickrSnapBike =
                     new wahookickrsnapbike(noWriteResistance, noHeartService, bikeResistanceOffset, bikeResistanceGain);
+                this->setActiveDevice(wahooKickrSnapBike);
                 emit deviceConnected(b);
                 connect(wahooKickrSnapBike, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -1362,6 +1435,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 horizonGr7Bike =
                     new horizongr7bike(noWriteResistance, noHeartService, bikeResistanceOffset, bikeResistanceGain);
+                this->setActiveDevice(horizonGr7Bike);
                 emit deviceConnected(b);
                 connect(horizonGr7Bike, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -1377,6 +1451,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 stagesBike = new stagesbike(noWriteResistance, noHeartService, false);
                 // stateFileRead();
+                this->setActiveDevice(stagesBike);
                 emit deviceConnected(b);
                 connect(stagesBike, &bluetoothdevice::connectedAndDiscovered, this, &bluetooth::connectedAndDiscovered);
                 // connect(stagesBike, SIGNAL(disconnected()), this, SLOT(restart()));
@@ -1391,6 +1466,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 smartrowRower =
                     new smartrowrower(noWriteResistance, noHeartService, bikeResistanceOffset, bikeResistanceGain);
                 // stateFileRead();
+                this->setActiveDevice(smartrowRower);
                 emit deviceConnected(b);
                 connect(smartrowRower, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -1407,6 +1483,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 concept2Skierg = new concept2skierg(noWriteResistance, noHeartService);
                 // stateFileRead();
+                this->setActiveDevice(concept2Skierg);
                 emit deviceConnected(b);
                 connect(concept2Skierg, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -1432,6 +1509,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 ftmsRower = new ftmsrower(noWriteResistance, noHeartService);
                 // stateFileRead();
+                this->setActiveDevice(ftmsRower);
                 emit deviceConnected(b);
                 connect(ftmsRower, &bluetoothdevice::connectedAndDiscovered, this, &bluetooth::connectedAndDiscovered);
                 // connect(ftmsRower, SIGNAL(disconnected()), this, SLOT(restart()));
@@ -1449,6 +1527,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 echelonStride = new echelonstride(this->pollDeviceTime, noConsole, noHeartService);
                 // stateFileRead();
+                this->setActiveDevice(echelonStride);
                 emit deviceConnected(b);
                 connect(echelonStride, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -1463,6 +1542,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 octaneElliptical = new octaneelliptical(this->pollDeviceTime, noConsole, noHeartService);
                 // stateFileRead();
+                this->setActiveDevice(octaneElliptical);
                 emit deviceConnected(b);
                 connect(octaneElliptical, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -1479,6 +1559,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 octaneTreadmill = new octanetreadmill(this->pollDeviceTime, noConsole, noHeartService);
                 // stateFileRead();
+                this->setActiveDevice(octaneTreadmill);
                 emit deviceConnected(b);
                 connect(octaneTreadmill, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -1493,6 +1574,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 ziproTreadmill = new ziprotreadmill(this->pollDeviceTime, noConsole, noHeartService);
                 // stateFileRead();
+                this->setActiveDevice(ziproTreadmill);
                 emit deviceConnected(b);
                 connect(ziproTreadmill, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -1511,6 +1593,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 echelonRower =
                     new echelonrower(noWriteResistance, noHeartService, bikeResistanceOffset, bikeResistanceGain);
                 // stateFileRead();
+                this->setActiveDevice(echelonRower);
                 emit deviceConnected(b);
                 connect(echelonRower, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -1527,6 +1610,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 echelonConnectSport = new echelonconnectsport(noWriteResistance, noHeartService, bikeResistanceOffset,
                                                               bikeResistanceGain);
                 // stateFileRead();
+                this->setActiveDevice(echelonConnectSport);
                 emit deviceConnected(b);
                 connect(echelonConnectSport, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -1542,6 +1626,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 apexBike = new apexbike(noWriteResistance, noHeartService, bikeResistanceOffset, bikeResistanceGain);
                 // stateFileRead();
+                this->setActiveDevice(apexBike);
                 emit deviceConnected(b);
                 connect(apexBike, &bluetoothdevice::connectedAndDiscovered, this, &bluetooth::connectedAndDiscovered);
                 apexBike->deviceDiscovered(b);
@@ -1551,6 +1636,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 bkoolBike = new bkoolbike(noWriteResistance, noHeartService);
                 // stateFileRead();
+                this->setActiveDevice(bkoolBike);
                 emit deviceConnected(b);
                 connect(bkoolBike, &bluetoothdevice::connectedAndDiscovered, this, &bluetooth::connectedAndDiscovered);
                 connect(bkoolBike, &bkoolbike::debug, this, &bluetooth::debug);
@@ -1562,6 +1648,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 mepanelBike =
                     new mepanelbike(noWriteResistance, noHeartService, bikeResistanceOffset, bikeResistanceGain);
                 // stateFileRead();
+                this->setActiveDevice(mepanelBike);
                 emit deviceConnected(b);
                 connect(mepanelBike, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -1574,6 +1661,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 schwinn170Bike =
                     new schwinn170bike(noWriteResistance, noHeartService, bikeResistanceOffset, bikeResistanceGain);
                 // stateFileRead();
+                this->setActiveDevice(schwinn170Bike);
                 emit deviceConnected(b);
                 connect(schwinn170Bike, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -1592,6 +1680,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 schwinnIC4Bike = new schwinnic4bike(noWriteResistance, noHeartService);
                 // stateFileRead();
+                this->setActiveDevice(schwinnIC4Bike);
                 emit deviceConnected(b);
                 connect(schwinnIC4Bike, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -1607,6 +1696,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 sportsTechBike = new sportstechbike(noWriteResistance, noHeartService);
                 // stateFileRead();
+                this->setActiveDevice(sportsTechBike);
                 emit deviceConnected(b);
                 connect(sportsTechBike, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -1625,6 +1715,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 sportsPlusBike = new sportsplusbike(noWriteResistance, noHeartService);
                 // stateFileRead();
+                this->setActiveDevice(sportsPlusBike);
                 emit deviceConnected(b);
                 connect(sportsPlusBike, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -1641,6 +1732,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 yesoulBike =
                     new yesoulbike(noWriteResistance, noHeartService, bikeResistanceOffset, bikeResistanceGain);
                 // stateFileRead();
+                this->setActiveDevice(yesoulBike);
                 emit deviceConnected(b);
                 connect(yesoulBike, &bluetoothdevice::connectedAndDiscovered, this, &bluetooth::connectedAndDiscovered);
                 // connect(yesoulBike, SIGNAL(disconnected()), this, SLOT(restart()));
@@ -1657,6 +1749,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 proformBike =
                     new proformbike(noWriteResistance, noHeartService, bikeResistanceOffset, bikeResistanceGain);
                 // stateFileRead();
+                this->setActiveDevice(proformBike);
                 emit deviceConnected(b);
                 connect(proformBike, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -1672,6 +1765,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 proformTreadmill = new proformtreadmill(noWriteResistance, noHeartService);
                 // stateFileRead();
+                this->setActiveDevice(proformTreadmill);
                 emit deviceConnected(b);
                 connect(proformTreadmill, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -1687,6 +1781,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 eslinkerTreadmill = new eslinkertreadmill(this->pollDeviceTime, noConsole, noHeartService);
                 // stateFileRead();
+                this->setActiveDevice(eslinkerTreadmill);
                 emit deviceConnected(b);
                 connect(eslinkerTreadmill, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -1703,6 +1798,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 pafersTreadmill = new paferstreadmill(this->pollDeviceTime, noConsole, noHeartService);
                 // stateFileRead();
+                this->setActiveDevice(pafersTreadmill);
                 emit deviceConnected(b);
                 connect(pafersTreadmill, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -1718,6 +1814,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 bowflexT216Treadmill = new bowflext216treadmill(this->pollDeviceTime, noConsole, noHeartService);
                 // stateFileRead();
+                this->setActiveDevice(bowflexT216Treadmill);
                 emit deviceConnected(b);
                 connect(bowflexT216Treadmill, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -1733,6 +1830,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 nautilusTreadmill = new nautilustreadmill(this->pollDeviceTime, noConsole, noHeartService);
                 // stateFileRead();
+                this->setActiveDevice(nautilusTreadmill);
                 emit deviceConnected(b);
                 connect(nautilusTreadmill, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -1752,6 +1850,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 flywheelBike = new flywheelbike(noWriteResistance, noHeartService);
                 // stateFileRead();
+                this->setActiveDevice(flywheelBike);
                 emit deviceConnected(b);
                 connect(flywheelBike, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -1767,6 +1866,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 mcfBike = new mcfbike(noWriteResistance, noHeartService, bikeResistanceOffset, bikeResistanceGain);
                 // stateFileRead();
+                this->setActiveDevice(mcfBike);
                 emit deviceConnected(b);
                 connect(mcfBike, &bluetoothdevice::connectedAndDiscovered, this, &bluetooth::connectedAndDiscovered);
                 // connect(mcfBike, SIGNAL(disconnected()), this, SLOT(restart()));
@@ -1780,6 +1880,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
                 toorx = new toorxtreadmill();
+                this->setActiveDevice(toorx);
                 emit deviceConnected(b);
                 connect(toorx, &bluetoothdevice::connectedAndDiscovered, this, &bluetooth::connectedAndDiscovered);
                 // connect(toorx, SIGNAL(disconnected()), this, SLOT(restart()));
@@ -1791,6 +1892,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
                 iConceptBike = new iconceptbike();
+                this->setActiveDevice(iConceptBike);
                 emit deviceConnected(b);
                 connect(iConceptBike, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -1804,6 +1906,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 iConceptElliptical =
                     new iconceptelliptical(noWriteResistance, noHeartService, bikeResistanceOffset, bikeResistanceGain);
+                this->setActiveDevice(iConceptElliptical);
                 emit deviceConnected(b);
                 connect(iConceptElliptical, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -1819,6 +1922,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
                 spiritTreadmill = new spirittreadmill();
+                this->setActiveDevice(spiritTreadmill);
                 emit deviceConnected(b);
                 connect(spiritTreadmill, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -1831,6 +1935,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
                 activioTreadmill = new activiotreadmill();
+                this->setActiveDevice(activioTreadmill);
                 emit deviceConnected(b);
                 connect(activioTreadmill, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -1852,6 +1957,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
                 trxappgateusb = new trxappgateusbtreadmill();
+                this->setActiveDevice(trxappgateusb);
                 emit deviceConnected(b);
                 connect(trxappgateusb, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -1875,6 +1981,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 trxappgateusbBike =
                     new trxappgateusbbike(noWriteResistance, noHeartService, bikeResistanceOffset, bikeResistanceGain);
+                this->setActiveDevice(trxappgateusbBike);
                 emit deviceConnected(b);
                 connect(trxappgateusbBike, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -1887,6 +1994,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 ultraSportBike =
                     new ultrasportbike(noWriteResistance, noHeartService, bikeResistanceOffset, bikeResistanceGain);
+                this->setActiveDevice(ultraSportBike);
                 emit deviceConnected(b);
                 connect(ultraSportBike, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -1898,6 +2006,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
                 keepBike = new keepbike(noWriteResistance, noHeartService, bikeResistanceOffset, bikeResistanceGain);
+                this->setActiveDevice(keepBike);
                 emit deviceConnected(b);
                 connect(keepBike, &bluetoothdevice::connectedAndDiscovered, this, &bluetooth::connectedAndDiscovered);
                 // connect(keepBike, SIGNAL(disconnected()), this, SLOT(restart()));
@@ -1910,6 +2019,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
                 soleBike = new solebike(noWriteResistance, noHeartService, bikeResistanceOffset, bikeResistanceGain);
+                this->setActiveDevice(soleBike);
                 emit deviceConnected(b);
                 connect(soleBike, &bluetoothdevice::connectedAndDiscovered, this, &bluetooth::connectedAndDiscovered);
                 // connect(soleBike, SIGNAL(disconnected()), this, SLOT(restart()));
@@ -1923,6 +2033,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 skandikaWiriBike =
                     new skandikawiribike(noWriteResistance, noHeartService, bikeResistanceOffset, bikeResistanceGain);
+                this->setActiveDevice(skandikaWiriBike);
                 emit deviceConnected(b);
                 connect(skandikaWiriBike, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -1938,6 +2049,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
                 renphoBike = new renphobike(noWriteResistance, noHeartService);
+                this->setActiveDevice(renphoBike);
                 emit(deviceConnected(b));
                 connect(renphoBike, SIGNAL(connectedAndDiscovered()), this, SLOT(connectedAndDiscovered()));
                 // connect(trxappgateusb, SIGNAL(disconnected()), this, SLOT(restart()));
@@ -1949,6 +2061,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 pafersBike =
                     new pafersbike(noWriteResistance, noHeartService, bikeResistanceOffset, bikeResistanceGain);
+                this->setActiveDevice(pafersBike);
                 emit(deviceConnected(b));
                 connect(pafersBike, SIGNAL(connectedAndDiscovered()), this, SLOT(connectedAndDiscovered()));
                 // connect(pafersBike, SIGNAL(disconnected()), this, SLOT(restart()));
@@ -1963,6 +2076,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
                 snodeBike = new snodebike(noWriteResistance, noHeartService);
+                this->setActiveDevice(snodeBike);
                 emit deviceConnected(b);
                 connect(snodeBike, &bluetoothdevice::connectedAndDiscovered, this, &bluetooth::connectedAndDiscovered);
                 // connect(trxappgateusb, SIGNAL(disconnected()), this, SLOT(restart()));
@@ -1976,6 +2090,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 fitPlusBike =
                     new fitplusbike(noWriteResistance, noHeartService, bikeResistanceOffset, bikeResistanceGain);
+                this->setActiveDevice(fitPlusBike);
                 emit deviceConnected(b);
                 connect(fitPlusBike, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -1994,6 +2109,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
                 fitshowTreadmill = new fitshowtreadmill(this->pollDeviceTime, noConsole, noHeartService);
+                this->setActiveDevice(fitshowTreadmill);
                 emit deviceConnected(b);
                 connect(fitshowTreadmill, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -2009,8 +2125,9 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 inspireBike = new inspirebike(noWriteResistance, noHeartService);
 #if !defined(Q_OS_ANDROID) && !defined(Q_OS_IOS)
-                stateFileRead();
+                stateFileRead(inspireBike);
 #endif
+                this->setActiveDevice(inspireBike);
                 emit deviceConnected(b);
                 connect(inspireBike, &bluetoothdevice::connectedAndDiscovered, this,
                         &bluetooth::connectedAndDiscovered);
@@ -2031,8 +2148,9 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->stopDiscovery();
                 chronoBike = new chronobike(noWriteResistance, noHeartService);
 #if !defined(Q_OS_ANDROID) && !defined(Q_OS_IOS)
-                stateFileRead();
+                stateFileRead(chronoBike);
 #endif
+                this->setActiveDevice(chronoBike);
                 emit deviceConnected(b);
                 connect(chronoBike, &bluetoothdevice::connectedAndDiscovered, this, &bluetooth::connectedAndDiscovered);
                 connect(chronoBike, &chronobike::debug, this, &bluetooth::debug);
@@ -2080,14 +2198,14 @@ void bluetooth::connectedAndDiscovered() {
         settings.value(QZSettings::fitmetria_fanfit_enable, QZSettings::default_fitmetria_fanfit_enable).toBool();
 
     // only at the first very connection, setting the user default resistance
-    if (device() && firstConnected && device()->deviceType() == bluetoothdevice::BIKE &&
+    if (bikeDevice() && firstConnected &&
         settings.value(QZSettings::bike_resistance_start, QZSettings::default_bike_resistance_start).toUInt() != 1) {
-        qobject_cast<bike *>(device())->changeResistance(
+        bikeDevice()->changeResistance(
             settings.value(QZSettings::bike_resistance_start, QZSettings::default_bike_resistance_start).toUInt());
-    } else if (device() && firstConnected && device()->deviceType() == bluetoothdevice::ELLIPTICAL &&
+    } else if (ellipticalDevice() && firstConnected &&
                settings.value(QZSettings::bike_resistance_start, QZSettings::default_bike_resistance_start).toUInt() !=
                    1) {
-        qobject_cast<elliptical *>(device())->changeResistance(
+        ellipticalDevice()->changeResistance(
             settings.value(QZSettings::bike_resistance_start, QZSettings::default_bike_resistance_start).toUInt());
     }
 
@@ -2405,6 +2523,7 @@ void bluetooth::restart() {
     devices.clear();
 
     emit this->bluetoothDeviceDisconnected();
+    activeDevice.clear();
 
     if (domyos) {
 
@@ -2905,190 +3024,41 @@ void bluetooth::restart() {
     this->startDiscovery();
 }
 
-bluetoothdevice *bluetooth::device() {
-    if (domyos) {
+bike *bluetooth::bikeDevice() {
+    if (activeDevice && activeDevice->deviceType() == bluetoothdevice::BIKE)
+        return qobject_cast<bike *>(activeDevice.data());
+    return nullptr;
+}
 
-        return domyos;
-    } else if (domyosBike) {
-        return domyosBike;
-    } else if (domyosRower) {
-        return domyosRower;
-    } else if (fitshowTreadmill) {
-        return fitshowTreadmill;
-    } else if (domyosElliptical) {
-        return domyosElliptical;
-    } else if (ypooElliptical) {
-        return ypooElliptical;
-    } else if (soleElliptical) {
-        return soleElliptical;
-    } else if (nautilusElliptical) {
-        return nautilusElliptical;
-    } else if (nautilusBike) {
-        return nautilusBike;
-    } else if (bhFitnessElliptical) {
-        return bhFitnessElliptical;
-    } else if (cscBike) {
-        return cscBike;
-    } else if (proformWifiBike) {
-        return proformWifiBike;
-    } else if (proformWifiTreadmill) {
-        return proformWifiTreadmill;
-    } else if (nordictrackifitadbTreadmill) {
-        return nordictrackifitadbTreadmill;
-    } else if (nordictrackifitadbBike) {
-        return nordictrackifitadbBike;
-    } else if (powerBike) {
-        return powerBike;
-    } else if (powerTreadmill) {
-        return powerTreadmill;
-    } else if (fakeBike) {
-        return fakeBike;
-    } else if (fakeElliptical) {
-        return fakeElliptical;
-    } else if (fakeRower) {
-        return fakeRower;
-    } else if (fakeTreadmill) {
-        return fakeTreadmill;
-    } else if (npeCableBike) {
-        return npeCableBike;
-    } else if (tacxneo2Bike) {
-        return tacxneo2Bike;
-    } else if (stagesBike) {
-        return stagesBike;
-    } else if (toorx) {
-        return toorx;
-    } else if (iConceptBike) {
-        return iConceptBike;
-    } else if (iConceptElliptical) {
-        return iConceptElliptical;
-    } else if (spiritTreadmill) {
-        return spiritTreadmill;
-    } else if (activioTreadmill) {
-        return activioTreadmill;
-    } else if (trxappgateusb) {
-        return trxappgateusb;
-    } else if (trxappgateusbBike) {
-        return trxappgateusbBike;
-    } else if (soleBike) {
-        return soleBike;
-    } else if (keepBike) {
-        return keepBike;
-    } else if (apexBike) {
-        return apexBike;
-    } else if (bkoolBike) {
-        return bkoolBike;
-    } else if (ultraSportBike) {
-        return ultraSportBike;
-    } else if (horizonTreadmill) {
-        return horizonTreadmill;
-    } else if (lifefitnessTreadmill) {
-        return lifefitnessTreadmill;
-    } else if (technogymmyrunTreadmill) {
-        return technogymmyrunTreadmill;
-#ifndef Q_OS_IOS
-    } else if (technogymmyrunrfcommTreadmill) {
-        return technogymmyrunrfcommTreadmill;
-#endif
-    } else if (soleF80) {
-        return soleF80;
-    } else if (kingsmithR2Treadmill) {
-        return kingsmithR2Treadmill;
-    } else if (kingsmithR1ProTreadmill) {
-        return kingsmithR1ProTreadmill;
-    } else if (shuaA5Treadmill) {
-        return shuaA5Treadmill;
-    } else if (trueTreadmill) {
-        return trueTreadmill;
-    } else if (mepanelBike) {
-        return mepanelBike;
-    } else if (echelonConnectSport) {
-        return echelonConnectSport;
-    } else if (echelonRower) {
-        return echelonRower;
-    } else if (echelonStride) {
-        return echelonStride;
-    } else if (octaneTreadmill) {
-        return octaneTreadmill;
-    } else if (ziproTreadmill) {
-        return ziproTreadmill;
-    } else if (octaneElliptical) {
-        return octaneElliptical;
-    } else if (ftmsRower) {
-        return ftmsRower;
-    } else if (concept2Skierg) {
-        return concept2Skierg;
-    } else if (smartrowRower) {
-        return smartrowRower;
-    } else if (yesoulBike) {
-        return yesoulBike;
-    } else if (proformBike) {
-        return proformBike;
-    } else if (proformTreadmill) {
-        return proformTreadmill;
-    } else if (proformElliptical) {
-        return proformElliptical;
-    } else if (nordictrackElliptical) {
-        return nordictrackElliptical;
-    } else if (proformEllipticalTrainer) {
-        return proformEllipticalTrainer;
-    } else if (proformRower) {
-        return proformRower;
-    } else if (eslinkerTreadmill) {
-        return eslinkerTreadmill;
-    } else if (bowflexTreadmill) {
-        return bowflexTreadmill;
-    } else if (bowflexT216Treadmill) {
-        return bowflexT216Treadmill;
-    } else if (pafersTreadmill) {
-        return pafersTreadmill;
-    } else if (nautilusTreadmill) {
-        return nautilusTreadmill;
-    } else if (flywheelBike) {
-        return flywheelBike;
-    } else if (mcfBike) {
-        return mcfBike;
-    } else if (schwinnIC4Bike) {
-        return schwinnIC4Bike;
-    } else if (schwinn170Bike) {
-        return schwinn170Bike;
-    } else if (sportsTechBike) {
-        return sportsTechBike;
-    } else if (sportsPlusBike) {
-        return sportsPlusBike;
-    } else if (inspireBike) {
-        return inspireBike;
-    } else if (chronoBike) {
-        return chronoBike;
-    } else if (m3iBike) {
-        return m3iBike;
-    } else if (snodeBike) {
-        return snodeBike;
-    } else if (ftmsBike) {
-        return ftmsBike;
-    } else if (wahooKickrSnapBike) {
-        return wahooKickrSnapBike;
-    } else if (horizonGr7Bike) {
-        return horizonGr7Bike;
-    } else if (renphoBike) {
-        return renphoBike;
-    } else if (pafersBike) {
-        return pafersBike;
-    } else if (fitPlusBike) {
-        return fitPlusBike;
-    } else if (pelotonBike) {
-        return pelotonBike;
-    } else if (skandikaWiriBike) {
-        return skandikaWiriBike;
-#ifndef Q_OS_IOS
-    } else if (computrainerBike) {
-        return computrainerBike;
-    } else if (csafeRower) {
-        return csafeRower;
-#endif
-    }
+treadmill *bluetooth::treadmillDevice() {
+    if (activeDevice && activeDevice->deviceType() == bluetoothdevice::TREADMILL)
+        return qobject_cast<treadmill *>(activeDevice.data());
+    return nullptr;
+}
+
+rower *bluetooth::rowerDevice() {
+    if (activeDevice && activeDevice->deviceType() == bluetoothdevice::ROWING)
+        return qobject_cast<rower *>(activeDevice.data());
+    return nullptr;
+}
+
+elliptical *bluetooth::ellipticalDevice() {
+    if (activeDevice && activeDevice->deviceType() == bluetoothdevice::ELLIPTICAL)
+        return qobject_cast<elliptical *>(activeDevice.data());
     return nullptr;
 }
 
+QList<bluetoothdevice *> bluetooth::sensors() const {
+    QList<bluetoothdevice *> list;
+    const QList<bluetoothdevice *> all = {heartRateBelt,  ftmsAccessory, cadenceSensor,   powerSensor,
+                                          powerSensorRun, eliteRizer,    eliteSterzoSmart};
+    for (bluetoothdevice *d : all) {
+        if (d)
+            list.append(d);
+    }
+    return list;
+}
+
 bool bluetooth::handleSignal(int signal) {
     if (signal == SIGNALS::SIG_INT) {
         qDebug() << QStringLiteral("SIGINT");
@@ -3099,8 +3069,8 @@ bool bluetooth::handleSignal(int signal) {
     return false;
 }
 
-void bluetooth::stateFileRead() {
-    if (!device()) {
+void bluetooth::stateFileRead(bluetoothdevice *device) {
+    if (!device) {
         return;
     }
 
@@ -3130,8 +3100,8 @@ void bluetooth::stateFileRead() {
             double speed = machine.attribute(QStringLiteral("Speed"), QStringLiteral("0.0")).toDouble();
             double inclination = machine.attribute(QStringLiteral("Incline"), QStringLiteral("0.0")).toDouble();
 
-            qobject_cast<treadmill *>(device())->setLastSpeed(speed);
-            qobject_cast<treadmill *>(device())->setLastInclination(inclination);
+            qobject_cast<treadmill *>(device)->setLastSpeed(speed);
+            qobject_cast<treadmill *>(device)->setLastInclination(inclination);
         }
 
         // Next component
@@ -4,6 +4,7 @@
 #include <QBluetoothDeviceDiscoveryAgent>
 #include <QFile>
 #include <QObject>
+#include <QPointer>
 #include <QtBluetooth/qlowenergyadvertisingdata.h>
 #include <QtBluetooth/qlowenergyadvertisingparameters.h>
 #include <QtBluetooth/qlowenergycharacteristic.h>
@@ -140,13 +141,51 @@ class bluetooth : public QObject, public SignalHandler {
                        bool testResistance = false, uint8_t bikeResistanceOffset = 4, double bikeResistanceGain = 1.0,
                        bool startDiscovery = true);
     ~bluetooth();
-    bluetoothdevice *device();
+
+    /**
+     * @brief device The active fitness device, or nullptr if none is connected. The handle is set when the device is
+     * created in deviceDiscovered and released in restart(), so this is a plain member read.
+     */
+    bluetoothdevice *device() { return activeDevice; }
+
+    /**
+     * @brief bikeDevice The active device if it's a bike, nullptr otherwise.
+     */
+    bike *bikeDevice();
+
+    /**
+     * @brief treadmillDevice The active device if it's a treadmill, nullptr otherwise.
+     */
+    treadmill *treadmillDevice();
+
+    /**
+     * @brief rowerDevice The active device if it's a rower, nullptr otherwise.
+     */
+    rower *rowerDevice();
+
+    /**
+     * @brief ellipticalDevice The active device if it's an elliptical, nullptr otherwise.
+     */
+    elliptical *ellipticalDevice();
+
+    /**
+     * @brief sensors The auxiliary sensors connected next to the active device: heart rate belt, SmartSpin2k,
+     * cadence and power sensors, Elite Rizer and Sterzo.
+     */
+    QList<bluetoothdevice *> sensors() const;
+
     bluetoothdevice *externalInclination() { return eliteRizer; }
     bluetoothdevice *heartRateDevice() { return heartRateBelt; }
     QList<QBluetoothDeviceInfo> devices;
     bool onlyDiscover = false;
 
   private:
+    /**
+     * @brief activeDevice The fitness device the session is running on. It's owned by the typed member it was
+     * created into; the QPointer drops it as soon as that one is deleted.
+     */
+    QPointer<bluetoothdevice> activeDevice;
+
     bool useDiscovery = false;
     QFile *debugCommsLog = nullptr;
     QBluetoothDeviceDiscoveryAgent *discoveryAgent = nullptr;
@@ -274,7 +313,7 @@ class bluetooth : public QObject, public SignalHandler {
 
     bool handleSignal(int signal) override;
     void stateFileUpdate();
-    void stateFileRead();
+    void stateFileRead(bluetoothdevice *device);
     bool heartRateBeltAvaiable();
     bool ftmsAccessoryAvaiable();
     bool cscSensorAvaiable();
@@ -297,6 +336,11 @@ class bluetooth : public QObject, public SignalHandler {
      * @param b The bluetooth device info.
      */
     void setLastBluetoothDevice(const QBluetoothDeviceInfo &b);
+
+    /**
+     * @brief setActiveDevice Makes the device just created in deviceDiscovered the active one.
+     */
+    void setActiveDevice(bluetoothdevice *b);
     void signalBluetoothDeviceConnected(bluetoothdevice *b);
   signals:
     void deviceConnected(QBluetoothDeviceInfo b);
@@ -1,4 +1,5 @@
 #include "bluetoothdevice.h"
+#include "qzsettingscache.h"
 
 #include <QFile>
 #include <QSettings>
@@ -11,7 +12,13 @@
 #include "ios/lockscreen.h"
 #endif
 
-bluetoothdevice::bluetoothdevice() {}
+bluetoothdevice::bluetoothdevice() {
+    // rolling windows read by the web templates
+    m_watt.addWindow(3000);
+    m_watt.addWindow(10000);
+    m_watt.addWindow(30000);
+    Heart.addWindow(60000);
+}
 
 bluetoothdevice::~bluetoothdevice() {
     if(this->virtualDevice) {
@@ -21,15 +28,33 @@ bluetoothdevice::~bluetoothdevice() {
 }
 
 bluetoothdevice::BLUETOOTH_TYPE bluetoothdevice::deviceType() { return bluetoothdevice::UNKNOWN; }
+void bluetoothdevice::setMetricColor(METRIC_COLOR which, const QString &color) {
+    switch (which) {
+    case SPEED_COLOR:
+        Speed.setColor(color);
+        break;
+    case CADENCE_COLOR:
+        Cadence.setColor(color);
+        break;
+    case WATT_COLOR:
+        m_watt.setColor(color);
+        break;
+    case HEART_COLOR:
+        Heart.setColor(color);
+        break;
+    default:
+        break;
+    }
+}
 void bluetoothdevice::start() { requestStart = 1; }
 void bluetoothdevice::stop(bool pause) {
     requestStop = 1;
     if (pause)
         requestPause = 1;
 }
-metric bluetoothdevice::currentHeart() { return Heart; }
-metric bluetoothdevice::currentSpeed() { return Speed; }
-metric bluetoothdevice::currentInclination() { return Inclination; }
+const metric &bluetoothdevice::currentHeart() { return Heart; }
+const metric &bluetoothdevice::currentSpeed() { return Speed; }
+const metric &bluetoothdevice::currentInclination() { return Inclination; }
 QTime bluetoothdevice::movingTime() {
     int hours = (int)(moving.value() / 3600.0);
     return QTime(hours, (int)(moving.value() - ((double)hours * 3600.0)) / 60.0, ((uint32_t)moving.value()) % 60, 0);
@@ -44,8 +69,8 @@ QTime bluetoothdevice::lapElapsedTime() {
                  ((uint32_t)elapsed.lapValue()) % 60, 0);
 }
 
-metric bluetoothdevice::currentResistance() { return Resistance; }
-metric bluetoothdevice::currentCadence() { return Cadence; }
+const metric &bluetoothdevice::currentResistance() { return Resistance; }
+const metric &bluetoothdevice::currentCadence() { return Cadence; }
 double bluetoothdevice::currentCrankRevolutions() { return 0; }
 uint16_t bluetoothdevice::lastCrankEventTime() { return 0; }
 
@@ -57,8 +82,7 @@ void bluetoothdevice::changeInclination(double grade, double percentage) {}
 void bluetoothdevice::offsetElapsedTime(int offset) { elapsed += offset; }
 
 QTime bluetoothdevice::currentPace() {
-    QSettings settings;
-    bool miles = settings.value(QZSettings::miles_unit, QZSettings::default_miles_unit).toBool();
+    bool miles = qzsettingscache::get().miles_unit;
     double unit_conversion = 1.0;
     if (miles) {
         unit_conversion = 0.621371;
@@ -73,9 +97,7 @@ QTime bluetoothdevice::currentPace() {
 }
 
 QTime bluetoothdevice::averagePace() {
-
-    QSettings settings;
-    bool miles = settings.value(QZSettings::miles_unit, QZSettings::default_miles_unit).toBool();
+    bool miles = qzsettingscache::get().miles_unit;
     double unit_conversion = 1.0;
     if (miles) {
         unit_conversion = 0.621371;
@@ -90,9 +112,7 @@ QTime bluetoothdevice::averagePace() {
 }
 
 QTime bluetoothdevice::maxPace() {
-
-    QSettings settings;
-    bool miles = settings.value(QZSettings::miles_unit, QZSettings::default_miles_unit).toBool();
+    bool miles = qzsettingscache::get().miles_unit;
     double unit_conversion = 1.0;
     if (miles) {
         unit_conversion = 0.621371;
@@ -107,8 +127,8 @@ QTime bluetoothdevice::maxPace() {
 }
 
 double bluetoothdevice::odometer() { return Distance.value(); }
-metric bluetoothdevice::calories() { return KCal; }
-metric bluetoothdevice::jouls() { return m_jouls; }
+const metric &bluetoothdevice::calories() { return KCal; }
+const metric &bluetoothdevice::jouls() { return m_jouls; }
 uint8_t bluetoothdevice::fanSpeed() { return FanSpeed; };
 bool bluetoothdevice::changeFanSpeed(uint8_t speed) {
     // managing underflow
@@ -129,14 +149,17 @@ bool bluetoothdevice::changeFanSpeed(uint8_t speed) {
     return false;
 }
 bool bluetoothdevice::connected() { return false; }
-metric bluetoothdevice::elevationGain() { return elevationAcc; }
+const metric &bluetoothdevice::elevationGain() { return elevationAcc; }
 void bluetoothdevice::heartRate(uint8_t heart) { Heart.setValue(heart); }
 void bluetoothdevice::disconnectBluetooth() {
+    if (m_writeQueue) {
+        m_writeQueue->clear();
+    }
     if (m_control) {
         m_control->disconnectFromDevice();
     }
 }
-metric bluetoothdevice::wattsMetric() { return m_watt; }
+const metric &bluetoothdevice::wattsMetric() { return m_watt; }
 void bluetoothdevice::setDifficult(double d) { m_difficult = d; }
 double bluetoothdevice::difficult() { return m_difficult; }
 void bluetoothdevice::setInclinationDifficult(double d) { m_inclination_difficult = d; }
@@ -152,6 +175,13 @@ void bluetoothdevice::instantaneousStrideLengthSensor(double length) { Q_UNUSED(
 void bluetoothdevice::groundContactSensor(double groundContact) { Q_UNUSED(groundContact); }
 void bluetoothdevice::verticalOscillationSensor(double verticalOscillation) { Q_UNUSED(verticalOscillation); }
 
+blewritequeue *bluetoothdevice::writeQueue() {
+    if (!m_writeQueue) {
+        m_writeQueue = new blewritequeue(this);
+    }
+    return m_writeQueue;
+}
+
 bool bluetoothdevice::hasVirtualDevice() { return this->virtualDevice!=nullptr; }
 
 double bluetoothdevice::calculateMETS() { return ((0.048 * m_watt.value()) + 1.19); }
@@ -172,22 +202,13 @@ void bluetoothdevice::update_metrics(bool watt_calc, const double watts) {
 
     QDateTime current = QDateTime::currentDateTime();
     double deltaTime = (((double)_lastTimeUpdate.msecsTo(current)) / ((double)1000.0));
-    QSettings settings;
-    QString heartRateBeltName =
-        settings.value(QZSettings::heart_rate_belt_name, QZSettings::default_heart_rate_belt_name).toString();
-    bool power_as_bike =
-        settings.value(QZSettings::power_sensor_as_bike, QZSettings::default_power_sensor_as_bike).toBool();
-    bool power_as_treadmill =
-        settings.value(QZSettings::power_sensor_as_treadmill, QZSettings::default_power_sensor_as_treadmill).toBool();
-
-    if (settings.value(QZSettings::power_sensor_name, QZSettings::default_power_sensor_name)
-                .toString()
-                .startsWith(QStringLiteral("Disabled")) == false &&
-        !power_as_bike && !power_as_treadmill)
+    const qzsettingscache::snapshot &settings = qzsettingscache::get();
+
+    if (!settings.power_sensor_disabled && !settings.power_sensor_as_bike && !settings.power_sensor_as_treadmill)
         watt_calc = false;
 
     if (!_firstUpdate && !paused) {
-        if (currentSpeed().value() > 0.0 || settings.value(QZSettings::continuous_moving, true).toBool()) {
+        if (currentSpeed().value() > 0.0 || settings.continuous_moving) {
 
             elapsed += deltaTime;
         }
@@ -199,7 +220,7 @@ void bluetoothdevice::update_metrics(bool watt_calc, const double watts) {
             if (watt_calc) {
                 m_watt = watts;
             }
-            WattKg = m_watt.value() / settings.value(QZSettings::weight, QZSettings::default_weight).toFloat();
+            WattKg = m_watt.value() / settings.weight;
         } else if (m_watt.value() > 0) {
 
             if (watt_calc) {
@@ -207,13 +228,12 @@ void bluetoothdevice::update_metrics(bool watt_calc, const double watts) {
             }
             WattKg = 0;
         }
-    } else if (paused && settings.value(QZSettings::instant_power_on_pause, QZSettings::default_instant_power_on_pause)
-                             .toBool()) {
+    } else if (paused && settings.instant_power_on_pause) {
         // useful for FTP test
         if (watt_calc) {
             m_watt = watts;
         }
-        WattKg = m_watt.value() / settings.value(QZSettings::weight, QZSettings::default_weight).toFloat();
+        WattKg = m_watt.value() / settings.weight;
     } else if (m_watt.value() > 0) {
 
         m_watt = 0;
@@ -341,11 +361,15 @@ QStringList bluetoothdevice::metrics() {
 
 resistance_t bluetoothdevice::maxResistance() { return 100; }
 
+bool bluetoothdevice::replayNotification(const QBluetoothUuid &uuid, const QByteArray &value) {
+    Q_UNUSED(uuid);
+    Q_UNUSED(value);
+    return false;
+}
+
 uint8_t bluetoothdevice::metrics_override_heartrate() {
 
-    QSettings settings;
-    QString setting =
-        settings.value(QZSettings::peloton_heartrate_metric, QZSettings::default_peloton_heartrate_metric).toString();
+    const QString &setting = qzsettingscache::get().peloton_heartrate_metric;
     if (!setting.compare(QStringLiteral("Heart Rate"))) {
         return currentHeart().value();
     } else if (!setting.compare(QStringLiteral("Speed"))) {
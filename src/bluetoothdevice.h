@@ -1,6 +1,7 @@
 #ifndef BLUETOOTHDEVICE_H
 #define BLUETOOTHDEVICE_H
 
+#include "blewritequeue.h"
 #include "definitions.h"
 #include "metric.h"
 #include "qzsettings.h"
@@ -57,14 +58,14 @@ class bluetoothdevice : public QObject {
     ~bluetoothdevice() override;
 
     /**
-     * @brief currentHeart Gets a metric object for getting and setting the current heart rate. Units: beats per minute
+     * @brief currentHeart Gets the read-only metric of the current heart rate. Units: beats per minute
      */
-    virtual metric currentHeart();
+    virtual const metric &currentHeart();
 
     /**
-     * @brief currentSpeed Gets a metric object for getting and setting the speed. Units: km/h
+     * @brief currentSpeed Gets the read-only metric of the speed. Units: km/h
      */
-    virtual metric currentSpeed();
+    virtual const metric &currentSpeed();
 
     /**
      * @brief currentPace Gets the current pace. Units: time per km
@@ -76,7 +77,7 @@ class bluetoothdevice : public QObject {
      * Units: Percentage vertical to horizontal
      * Expected range: Depends on device.
      */
-    virtual metric currentInclination();
+    virtual const metric &currentInclination();
 
     /**
      * @brief setInclination Set the protected Inclination metric, which could be different from that
@@ -102,17 +103,17 @@ class bluetoothdevice : public QObject {
     virtual double odometer();
 
     /**
-     * @brief calories Gets a metric object to get and set the amount of energy expended.
+     * @brief calories Gets the read-only metric of the amount of energy expended.
      * Default implementation returns the protected KCal property. Units: kcal
      * Other implementations could have different units.
      * @return
      */
-    virtual metric calories();
+    virtual const metric &calories();
 
     /**
-     * @brief jouls Gets a metric object to get and set the number of joules expended. Units: joules
+     * @brief jouls Gets the read-only metric of the number of joules expended. Units: joules
      */
-    metric jouls();
+    const metric &jouls();
 
     /**
      * @brief fanSpeed Gets the current fan speed. Units: depends on device
@@ -147,15 +148,15 @@ class bluetoothdevice : public QObject {
     virtual bool connected();
 
     /**
-     * @brief currentResistance Gets a metric object to get or set the currently requested resistance.
+     * @brief currentResistance Gets the read-only metric of the currently requested resistance.
      * Expected range: 0 to maxResistance()
      */
-    virtual metric currentResistance();
+    virtual const metric &currentResistance();
 
     /**
-     * @brief currentCadence Gets a metric object to get and set the current cadence. Units: revolutions per minute
+     * @brief currentCadence Gets the read-only metric of the current cadence. Units: revolutions per minute
      */
-    virtual metric currentCadence();
+    virtual const metric &currentCadence();
 
     /**
      * @brief currentCrankRevolutions Gets the current total number of crank revolutions.
@@ -207,9 +208,9 @@ class bluetoothdevice : public QObject {
     uint16_t watts(double weight);
 
     /**
-     * @brief wattsMetric Gets a metric object to get or set the amount of power used.  Units: watts
+     * @brief wattsMetric Gets the read-only metric of the amount of power used.  Units: watts
      */
-    metric wattsMetric();
+    const metric &wattsMetric();
 
     /**
      * @brief changeFanSpeed Tries to change the fan speed.
@@ -218,9 +219,9 @@ class bluetoothdevice : public QObject {
     virtual bool changeFanSpeed(uint8_t speed);
 
     /**
-     * @brief elevationGain Gets a metric object to get and set the elevation gain. Units: ?
+     * @brief elevationGain Gets the read-only metric of the elevation gain. Units: ?
      */
-    virtual metric elevationGain();
+    virtual const metric &elevationGain();
 
     /**
      * @brief clearStats Clear the statistics.
@@ -319,36 +320,36 @@ class bluetoothdevice : public QObject {
     double weightLoss() { return WeightLoss.value(); }
 
     /**
-     * @brief wattKg Gets a metric object to get and set the watt kg of something. Units: watt kg
+     * @brief wattKg Gets the read-only metric of the watt kg of something. Units: watt kg
      * @return
      */
-    metric wattKg() { return WattKg; }
+    const metric &wattKg() { return WattKg; }
 
     /**
-     * @brief currentMETS Gets a metric object to get and set the current METS (Metabolic Equivalent of Tasks)
+     * @brief currentMETS Gets the read-only metric of the current METS (Metabolic Equivalent of Tasks)
      * Units: METs (1 MET is approximately 3.5mL of Oxygen consumed per kg of body weight per minute)
      */
-    metric currentMETS() { return METS; }
+    const metric &currentMETS() { return METS; }
 
     /**
-     * @brief currentHeartZone Gets a metric object to get or set the current heart zone. Units: depends on
+     * @brief currentHeartZone Gets the read-only metric of the current heart zone. Units: depends on
      * implementation.
      */
-    metric currentHeartZone() { return HeartZone; }
+    const metric &currentHeartZone() { return HeartZone; }
 
     /**
-     * @brief currentPowerZone Gets a metric object to get or set the current power zome. Units: depends on
+     * @brief currentPowerZone Gets the read-only metric of the current power zome. Units: depends on
      * implementation.
      * @return
      */
-    metric currentPowerZone() { return PowerZone; }
+    const metric &currentPowerZone() { return PowerZone; }
 
     /**
-     * @brief currentPowerZone Gets a metric object to get or set the current power zome. Units: depends on
+     * @brief currentPowerZone Gets the read-only metric of the current power zome. Units: depends on
      * implementation.
      * @return
      */
-    metric targetPowerZone() { return TargetPowerZone; }
+    const metric &targetPowerZone() { return TargetPowerZone; }
 
     /**
      * @brief setGPXFile Sets the file for GPS data exchange.
@@ -392,6 +393,14 @@ class bluetoothdevice : public QObject {
      */
     virtual BLUETOOTH_TYPE deviceType();
 
+    enum METRIC_COLOR { SPEED_COLOR = 0, CADENCE_COLOR, WATT_COLOR, HEART_COLOR, PELOTON_RESISTANCE_COLOR };
+
+    /**
+     * @brief setMetricColor Sets the color the UI shows a metric of this device with, which the web templates and
+     * the floating window report. The metric getters are read-only, so the color is set through the device.
+     */
+    virtual void setMetricColor(METRIC_COLOR which, const QString &color);
+
     /**
      * @brief metrics Gets a list of available metrics.
      * @return
@@ -409,6 +418,13 @@ class bluetoothdevice : public QObject {
      */
     virtual resistance_t maxResistance();
 
+    /**
+     * @brief replayNotification Feeds a recorded notification to the driver as if the characteristic with this uuid
+     * had changed. The replay tests use it to run a driver's parser without a QLowEnergyService.
+     * @return false if the driver doesn't support the replay.
+     */
+    virtual bool replayNotification(const QBluetoothUuid &uuid, const QByteArray &value);
+
   public Q_SLOTS:
     virtual void start();
     virtual void stop(bool pause);
@@ -688,6 +704,12 @@ class bluetoothdevice : public QObject {
      */
     QByteArray *writeBuffer = nullptr;
 
+    /**
+     * @brief writeQueue The non-blocking write queue of the device, created on first use. Drivers should enqueue
+     * their frames here instead of waiting on a nested QEventLoop.
+     */
+    blewritequeue *writeQueue();
+
   private:
     /**
      * @brief Indicates the way the virtual device is being used.
@@ -696,6 +718,8 @@ class bluetoothdevice : public QObject {
      */
     VIRTUAL_DEVICE_MODE virtualDeviceMode = VIRTUAL_DEVICE_MODE::NONE;
     virtualdevice *virtualDevice = nullptr;
+
+    blewritequeue *m_writeQueue = nullptr;
 };
 
 #endif // BLUETOOTHDEVICE_H
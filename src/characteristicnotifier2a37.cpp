@@ -1,10 +1,13 @@
 #include "characteristicnotifier2a37.h"
+#include "gattlayout.h"
+
+// flags (8 bit heart rate value), heart rate
+typedef gattlayout<uint8_t, uint8_t> heartRateMeasurement;
 
 CharacteristicNotifier2A37::CharacteristicNotifier2A37(bluetoothdevice *Bike, QObject *parent)
     : CharacteristicNotifier(0x2a37, parent), Bike(Bike) {}
 
 int CharacteristicNotifier2A37::notify(QByteArray &valueHR) {
-    valueHR.append(char(0));                                  // Flags that specify the format of the value.
-    valueHR.append(char(Bike->metrics_override_heartrate())); // Actual value.
+    heartRateMeasurement::append(valueHR, 0x00, Bike->metrics_override_heartrate());
     return CN_OK;
 }
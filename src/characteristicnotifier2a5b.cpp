@@ -1,6 +1,12 @@
 #include "characteristicnotifier2a5b.h"
+#include "gattlayout.h"
 #include <QSettings>
 
+// flags, cumulative crank revolutions, last crank event time
+typedef gattlayout<uint8_t, uint16_t, uint16_t> cscMeasurement;
+// flags, cumulative wheel revolutions, last wheel event time, cumulative crank revolutions, last crank event time
+typedef gattlayout<uint8_t, uint32_t, uint16_t, uint16_t, uint16_t> cscMeasurementWithWheel;
+
 CharacteristicNotifier2A5B::CharacteristicNotifier2A5B(bluetoothdevice *Bike, QObject *parent)
     : CharacteristicNotifier(0x2a5b, parent), Bike(Bike) {
     QSettings settings;
@@ -8,29 +14,20 @@ CharacteristicNotifier2A5B::CharacteristicNotifier2A5B(bluetoothdevice *Bike, QO
 }
 
 int CharacteristicNotifier2A5B::notify(QByteArray &value) {
+    uint16_t crankRevs = (uint16_t)Bike->currentCrankRevolutions();
+    uint16_t crankTime = Bike->lastCrankEventTime();
     if (!bike_wheel_revs) {
-        value.append((char)0x02); // crank data present
+        cscMeasurement::append(value, 0x02, crankRevs, crankTime); // crank data present
     } else {
-
-        value.append((char)0x03); // crank and wheel data present
-
-        if (Bike->currentSpeed().value()) {
+        double speed = Bike->currentSpeed().value();
+        if (speed) {
 
             const double wheelCircumference = 2000.0; // millimeters
             wheelRevs++;
-            lastWheelTime +=
-                (uint16_t)(1024.0 / ((Bike->currentSpeed().value() / 3.6) / (wheelCircumference / 1000.0)));
+            lastWheelTime += (uint16_t)(1024.0 / ((speed / 3.6) / (wheelCircumference / 1000.0)));
         }
-        value.append((char)((wheelRevs & 0xFF)));        // wheel count
-        value.append((char)((wheelRevs >> 8) & 0xFF));   // wheel count
-        value.append((char)((wheelRevs >> 16) & 0xFF));  // wheel count
-        value.append((char)((wheelRevs >> 24) & 0xFF));  // wheel count
-        value.append((char)(lastWheelTime & 0xff));      // eventtime
-        value.append((char)(lastWheelTime >> 8) & 0xFF); // eventtime
+        // crank and wheel data present
+        cscMeasurementWithWheel::append(value, 0x03, wheelRevs, lastWheelTime, crankRevs, crankTime);
     }
-    value.append((char)(((uint16_t)Bike->currentCrankRevolutions()) & 0xFF));      // revs count
-    value.append((char)(((uint16_t)Bike->currentCrankRevolutions()) >> 8) & 0xFF); // revs count
-    value.append((char)(Bike->lastCrankEventTime() & 0xff));                       // eventtime
-    value.append((char)(Bike->lastCrankEventTime() >> 8) & 0xFF);                  // eventtime
     return CN_OK;
 }
@@ -1,47 +1,27 @@
 #include "characteristicnotifier2acd.h"
-#include "treadmill.h"
+#include "gattlayout.h"
 #include <qmath.h>
 
+// flags, speed, inclination, ramp angle setting, heart rate
+typedef gattlayout<uint16_t, uint16_t, int16_t, int16_t, uint8_t> treadmillData;
+static const uint16_t treadmillDataFlags = 0x0108; // inclination, heart rate
+
 CharacteristicNotifier2ACD::CharacteristicNotifier2ACD(bluetoothdevice *Bike, QObject *parent)
     : CharacteristicNotifier(0x2acd, parent), Bike(Bike) {}
 
 int CharacteristicNotifier2ACD::notify(QByteArray &value) {
     bluetoothdevice::BLUETOOTH_TYPE dt = Bike->deviceType();
     if (dt == bluetoothdevice::TREADMILL || dt == bluetoothdevice::ELLIPTICAL) {
-        value.append(0x08);       // Inclination available
-        value.append((char)0x01); // heart rate available
-
         uint16_t normalizeSpeed = (uint16_t)qRound(Bike->currentSpeed().value() * 100);
-        char a = (normalizeSpeed >> 8) & 0XFF;
-        char b = normalizeSpeed & 0XFF;
-        QByteArray speedBytes;
-        speedBytes.append(b);
-        speedBytes.append(a);
-        uint16_t normalizeIncline = 0;
-        if (dt == bluetoothdevice::TREADMILL)
-            normalizeIncline = (uint32_t)qRound(((treadmill *)Bike)->currentInclination().value() * 10);
-        a = (normalizeIncline >> 8) & 0XFF;
-        b = normalizeIncline & 0XFF;
-        QByteArray inclineBytes;
-        inclineBytes.append(b);
-        inclineBytes.append(a);
-        double ramp = 0;
-        if (dt == bluetoothdevice::TREADMILL)
-            ramp = qRadiansToDegrees(qAtan(((treadmill *)Bike)->currentInclination().value() / 100));
-        int16_t normalizeRamp = (int32_t)qRound(ramp * 10);
-        a = (normalizeRamp >> 8) & 0XFF;
-        b = normalizeRamp & 0XFF;
-        QByteArray rampBytes;
-        rampBytes.append(b);
-        rampBytes.append(a);
-
-        value.append(speedBytes); // Actual value.
-
-        value.append(inclineBytes); // incline
-
-        value.append(rampBytes); // ramp angle
-
-        value.append(Bike->currentHeart().value()); // current heart rate
+        int16_t normalizeIncline = 0;
+        int16_t normalizeRamp = 0;
+        if (dt == bluetoothdevice::TREADMILL) {
+            double inclination = Bike->currentInclination().value();
+            normalizeIncline = (int16_t)qRound(inclination * 10);
+            normalizeRamp = (int16_t)qRound(qRadiansToDegrees(qAtan(inclination / 100)) * 10);
+        }
+        treadmillData::append(value, treadmillDataFlags, normalizeSpeed, normalizeIncline, normalizeRamp,
+                              (uint8_t)(int)Bike->currentHeart().value());
         return CN_OK;
     } else
         return CN_INVALID;
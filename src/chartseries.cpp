@@ -0,0 +1,80 @@
+#include "chartseries.h"
+
+#include <algorithm>
+
+void chartseries::append(double value) {
+    int i = m_values.size();
+    m_values.append(value);
+
+    // a new level once the last one has more than a bucket, made of the buckets of the last one two by two
+    if (m_levels.isEmpty() || m_levels.last().size() > 1) {
+        QVector<bucket> level;
+        if (!m_levels.isEmpty()) {
+            const QVector<bucket> &finer = m_levels.last();
+            for (int b = 0; b < finer.size(); b += 2) {
+                bucket merged = finer.at(b);
+                if (b + 1 < finer.size()) {
+                    const bucket &next = finer.at(b + 1);
+                    if (m_values.at(next.min) < m_values.at(merged.min))
+                        merged.min = next.min;
+                    if (m_values.at(next.max) > m_values.at(merged.max))
+                        merged.max = next.max;
+                }
+                level.append(merged);
+            }
+        }
+        m_levels.append(level);
+    }
+
+    for (int k = 0; k < m_levels.size(); k++) {
+        QVector<bucket> &level = m_levels[k];
+        int b = i >> (k + 1);
+        if (b == level.size()) {
+            bucket first = {i, i};
+            level.append(first);
+        } else {
+            bucket &current = level[b];
+            if (value < m_values.at(current.min))
+                current.min = i;
+            if (value > m_values.at(current.max))
+                current.max = i;
+        }
+    }
+}
+
+void chartseries::clear() {
+    m_values.clear();
+    m_levels.clear();
+}
+
+QVector<QPointF> chartseries::points(int maxPoints, double xScale) const {
+    QVector<QPointF> out;
+    int n = m_values.size();
+    // the coarsest level can have 2 buckets
+    maxPoints = std::max(maxPoints, 8);
+    if (n <= maxPoints) {
+        out.reserve(n);
+        for (int i = 0; i < n; i++)
+            out.append(QPointF(i * xScale, m_values.at(i)));
+        return out;
+    }
+
+    int k = 0;
+    while (k < m_levels.size() - 1 && m_levels.at(k).size() * 4 > maxPoints)
+        k++;
+    const QVector<bucket> &level = m_levels.at(k);
+    int width = 1 << (k + 1);
+
+    out.reserve(level.size() * 4);
+    for (int b = 0; b < level.size(); b++) {
+        int first = b * width;
+        int last = std::min(first + width, n) - 1;
+        int indexes[4] = {first, level.at(b).min, level.at(b).max, last};
+        std::sort(indexes, indexes + 4);
+        for (int j = 0; j < 4; j++) {
+            if (j == 0 || indexes[j] != indexes[j - 1])
+                out.append(QPointF(indexes[j] * xScale, m_values.at(indexes[j])));
+        }
+    }
+    return out;
+}
@@ -0,0 +1,37 @@
+#ifndef CHARTSERIES_H
+#define CHARTSERIES_H
+
+#include <QPointF>
+#include <QVector>
+
+/**
+ * @brief The chartseries class keeps a workout series ready to be plotted at any width, updated while it's recorded.
+ * Level k splits the samples in buckets of 2^(k+1) and keeps the sample with the minimum and the one with the maximum
+ * of each bucket, so append() costs O(log n). points() picks the finest level that fits the points asked for and
+ * gives the first, minimum, maximum and last sample of each bucket (the M4 aggregation): the peaks are never lost,
+ * however long the workout, and a chart gets a few points per pixel column instead of every sample.
+ */
+class chartseries {
+  public:
+    void append(double value);
+    void clear();
+
+    int size() const { return m_values.size(); }
+
+    /**
+     * @brief points The series to plot with at most maxPoints points (8 or more), x = index of the sample * xScale.
+     * All the samples if they fit. maxPoints should be about 4 times the pixel width of the chart.
+     */
+    QVector<QPointF> points(int maxPoints, double xScale = 1.0) const;
+
+  private:
+    struct bucket {
+        int min;
+        int max;
+    };
+
+    QVector<double> m_values;
+    QVector<QVector<bucket>> m_levels;
+};
+
+#endif // CHARTSERIES_H
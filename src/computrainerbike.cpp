@@ -24,6 +24,8 @@ computrainerbike::computrainerbike(bool noWriteResistance, bool noHeartService,
     this->noHeartService = noHeartService;
     this->bikeResistanceGain = bikeResistanceGain;
     this->bikeResistanceOffset = bikeResistanceOffset;
+    setPowerCurve(
+        [this](double resistance, double cadence) { return wattsFromResistance((resistance_t)resistance, cadence); });
     initDone = false;
     connect(refresh, &QTimer::timeout, this, &computrainerbike::update);
     refresh->start(50ms);
@@ -82,94 +84,86 @@ resistance_t computrainerbike::resistanceFromPowerRequest(uint16_t power) {
     double watt_gain = settings.value(QZSettings::watt_gain, QZSettings::default_watt_gain).toDouble();
     double watt_offset = settings.value(QZSettings::watt_offset, QZSettings::default_watt_offset).toDouble();
 
-    for (resistance_t i = 1; i < max_resistance; i++) {
-        if (((wattsFromResistance(i) * watt_gain) + watt_offset) <= power &&
-            ((wattsFromResistance(i + 1) * watt_gain) + watt_offset) >= power) {
-            qDebug() << QStringLiteral("resistanceFromPowerRequest")
-                     << ((wattsFromResistance(i) * watt_gain) + watt_offset)
-                     << ((wattsFromResistance(i + 1) * watt_gain) + watt_offset) << power;
-            return i;
-        }
-    }
-    if (power < ((wattsFromResistance(1) * watt_gain) + watt_offset))
-        return 1;
-    else
-        return max_resistance;
+    return resistanceFromPowerCurve(power, watt_gain, watt_offset);
 }
 
-uint16_t computrainerbike::wattsFromResistance(resistance_t resistance) {
+double computrainerbike::wattsFromResistance(resistance_t resistance, double cadence) {
 
-    if (currentCadence().value() == 0)
+    if (cadence == 0)
         return 0;
 
     switch (resistance) {
     case 0:
     case 1:
         // -13.5 + 0.999x + 0.00993x²
-        return (-13.5 + (0.999 * currentCadence().value()) + (0.00993 * pow(currentCadence().value(), 2)));
+        return (-13.5 + (0.999 * cadence) + (0.00993 * pow(cadence, 2)));
     case 2:
         // -17.7 + 1.2x + 0.0116x²
-        return (-17.7 + (1.2 * currentCadence().value()) + (0.0116 * pow(currentCadence().value(), 2)));
+        return (-17.7 + (1.2 * cadence) + (0.0116 * pow(cadence, 2)));
 
     case 3:
         // -17.5 + 1.24x + 0.014x²
-        return (-17.5 + (1.24 * currentCadence().value()) + (0.014 * pow(currentCadence().value(), 2)));
+        return (-17.5 + (1.24 * cadence) + (0.014 * pow(cadence, 2)));
 
     case 4:
         // -20.9 + 1.43x + 0.016x²
-        return (-20.9 + (1.43 * currentCadence().value()) + (0.016 * pow(currentCadence().value(), 2)));
+        return (-20.9 + (1.43 * cadence) + (0.016 * pow(cadence, 2)));
 
     case 5:
         // -27.9 + 1.75x+0.0172x²
-        return (-27.9 + (1.75 * currentCadence().value()) + (0.0172 * pow(currentCadence().value(), 2)));
+        return (-27.9 + (1.75 * cadence) + (0.0172 * pow(cadence, 2)));
 
     case 6:
         // -26.7 + 1.9x + 0.0201x²
-        return (-26.7 + (1.9 * currentCadence().value()) + (0.0201 * pow(currentCadence().value(), 2)));
+        return (-26.7 + (1.9 * cadence) + (0.0201 * pow(cadence, 2)));
 
     case 7:
         // -33.5 + 2.23x + 0.0225x²
-        return (-33.5 + (2.23 * currentCadence().value()) + (0.0225 * pow(currentCadence().value(), 2)));
+        return (-33.5 + (2.23 * cadence) + (0.0225 * pow(cadence, 2)));
 
     case 8:
         // -36.5+2.5x+0.0262x²
-        return (-36.5 + (2.5 * currentCadence().value()) + (0.0262 * pow(currentCadence().value(), 2)));
+        return (-36.5 + (2.5 * cadence) + (0.0262 * pow(cadence, 2)));
 
     case 9:
         // -38+2.62x+0.0305x²
-        return (-38.0 + (2.62 * currentCadence().value()) + (0.0305 * pow(currentCadence().value(), 2)));
+        return (-38.0 + (2.62 * cadence) + (0.0305 * pow(cadence, 2)));
 
     case 10:
         // -41.2+2.85x+0.0327x²
-        return (-41.2 + (2.85 * currentCadence().value()) + (0.0327 * pow(currentCadence().value(), 2)));
+        return (-41.2 + (2.85 * cadence) + (0.0327 * pow(cadence, 2)));
 
     case 11:
         // -43.4+3.01x+0.0359x²
-        return (-43.4 + (3.01 * currentCadence().value()) + (0.0359 * pow(currentCadence().value(), 2)));
+        return (-43.4 + (3.01 * cadence) + (0.0359 * pow(cadence, 2)));
 
     case 12:
         // -46.8+3.23x+0.0364x²
-        return (-46.8 + (3.23 * currentCadence().value()) + (0.0364 * pow(currentCadence().value(), 2)));
+        return (-46.8 + (3.23 * cadence) + (0.0364 * pow(cadence, 2)));
 
     case 13:
         // -49+3.39x+0.0371x²
-        return (-49.0 + (3.39 * currentCadence().value()) + (0.0371 * pow(currentCadence().value(), 2)));
+        return (-49.0 + (3.39 * cadence) + (0.0371 * pow(cadence, 2)));
 
     case 14:
         // -53.4+3.55x+0.0383x²
-        return (-53.4 + (3.55 * currentCadence().value()) + (0.0383 * pow(currentCadence().value(), 2)));
+        return (-53.4 + (3.55 * cadence) + (0.0383 * pow(cadence, 2)));
 
     case 15:
         // -49.9+3.37x+0.0429x²
-        return (-49.9 + (3.37 * currentCadence().value()) + (0.0429 * pow(currentCadence().value(), 2)));
+        return (-49.9 + (3.37 * cadence) + (0.0429 * pow(cadence, 2)));
 
     case 16:
     default:
         // -47.1+3.25x+0.0464x²
-        return (-47.1 + (3.25 * currentCadence().value()) + (0.0464 * pow(currentCadence().value(), 2)));
+        return (-47.1 + (3.25 * cadence) + (0.0464 * pow(cadence, 2)));
     }
 }
 
+uint16_t computrainerbike::wattsFromResistance(resistance_t resistance) {
+    return wattsFromResistance(resistance, currentCadence().value());
+}
+
 // must be double because it's an inclination
 void computrainerbike::forceResistance(double requestResistance) {
     if(myComputrainer->getMode() != CT_SSMODE)
@@ -230,26 +224,23 @@ void computrainerbike::update() {
         bool disable_hr_frommachinery =
             settings.value(QZSettings::heart_ignore_builtin, QZSettings::default_heart_ignore_builtin).toBool();
 
-        int Buttons, Status;
-        bool calibration;
-        double Power, HeartRate, cadence, speed, RRC, Load, Gradient;
-        uint8_t ss[24];
-        // get latest telemetry
-        myComputrainer->getTelemetry(Power, HeartRate, cadence, speed, RRC, calibration, Buttons, ss, Status);
+        // get latest telemetry, a snapshot published by the Computrainer thread
+        ComputrainerTelemetry telemetry = myComputrainer->telemetry();
+        double Gradient = myComputrainer->getGradient();
 
-        Speed = speed;
+        Speed = telemetry.speed;
         emit debug(QStringLiteral("Current Speed: ") + QString::number(Speed.value()));
         Distance += ((Speed.value() / 3600000.0) *
                      ((double)lastRefreshCharacteristicChanged.msecsTo(QDateTime::currentDateTime())));
         emit debug("Current Distance: " + QString::number(Distance.value()));
-        Cadence = cadence;
+        Cadence = telemetry.cadence;
         emit debug(QStringLiteral("Current Cadence: ") + QString::number(Cadence.value()));
         if (Cadence.value() > 0) {
             CrankRevs++;
             LastCrankEventTime += (uint16_t)(1024.0 / (((double)(Cadence.value())) / 60.0));
         }
 
-        m_watt = Power;
+        m_watt = telemetry.power;
         emit debug(QStringLiteral("Current Watt: ") + QString::number(watts()));
 
         Inclination = Gradient;
@@ -269,7 +260,7 @@ void computrainerbike::update() {
                                                                   emit resistanceRead(Resistance.value());    */
 
         if (!disable_hr_frommachinery) {
-            Heart = HeartRate;
+            Heart = telemetry.heartRate;
             emit debug(QStringLiteral("Current Heart: ") + QString::number(Heart.value()));
         }
 
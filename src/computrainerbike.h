@@ -44,6 +44,7 @@ class computrainerbike : public bike {
     resistance_t max_resistance = 100;
     resistance_t min_resistance = -20;
     uint16_t wattsFromResistance(resistance_t resistance);
+    double wattsFromResistance(resistance_t resistance, double cadence);
     double GetDistanceFromPacket(QByteArray packet);
     QTime GetElapsedFromPacket(QByteArray packet);
     void btinit();
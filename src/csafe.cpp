@@ -1,445 +1,488 @@
-#include "csafe.h" // Include the header file containing csafe_dic definitions
-#include <QList>
-#include <QMap>
-
-csafe::csafe() {
-
+#include "csafe.h"
+#include <QDebug>
+#include <cstring>
+
+namespace {
+
+struct commandinfo {
+    const char *name;
+    quint8 id;
+    quint8 argCount;
+    quint8 argBytes[3];
+    quint8 wrapper;
+};
+
+struct responseinfo {
+    int id;
+    const char *name;
+    int fieldCount;
+    // byte count of each field, a negative count is an ascii field
+    qint8 fields[17];
+};
+
+// cmds['COMMAND_NAME'] = [0xCmd_Id, [Bytes, ...], wrapper], in the order of csafe::command
+constexpr commandinfo commands[] = {
     // Short Commands
-    /*
-    cmds["CSAFE_GETSTATUS_CMD"] = QList<int>() << 0x80 << QList<int>();
-    cmds["CSAFE_RESET_CMD"] = QList<int>() << 0x81 << QList<int>();
-    cmds["CSAFE_GOIDLE_CMD"] = QList<int>() << 0x82 << QList<int>();
-    cmds["CSAFE_GOHAVEID_CMD"] = QList<int>() << 0x83 << QList<int>();
-    cmds["CSAFE_GOINUSE_CMD"] = QList<int>() << 0x85 << QList<int>();
-    cmds["CSAFE_GOFINISHED_CMD"] = QList<int>() << 0x86 << QList<int>();
-    cmds["CSAFE_GOREADY_CMD"] = QList<int>() << 0x87 << QList<int>();
-    cmds["CSAFE_BADID_CMD"] = QList<int>() << 0x88 << QList<int>();
-    cmds["CSAFE_GETVERSION_CMD"] = QList<int>() << 0x91 << QList<int>();
-    cmds["CSAFE_GETID_CMD"] = QList<int>() << 0x92 << QList<int>();
-    cmds["CSAFE_GETUNITS_CMD"] = QList<int>() << 0x93 << QList<int>();
-    cmds["CSAFE_GETSERIAL_CMD"] = QList<int>() << 0x94 << QList<int>();
-    cmds["CSAFE_GETODOMETER_CMD"] = QList<int>() << 0x9B << QList<int>();
-    cmds["CSAFE_GETERRORCODE_CMD"] = QList<int>() << 0x9C << QList<int>();
-    cmds["CSAFE_GETTWORK_CMD"] = QList<int>() << 0xA0 << QList<int>();
-    cmds["CSAFE_GETHORIZONTAL_CMD"] = QList<int>() << 0xA1 << QList<int>();
-    cmds["CSAFE_GETCALORIES_CMD"] = QList<int>() << 0xA3 << QList<int>();
-    cmds["CSAFE_GETPROGRAM_CMD"] = QList<int>() << 0xA4 << QList<int>();
-    cmds["CSAFE_GETPACE_CMD"] = QList<int>() << 0xA6 << QList<int>();
-    cmds["CSAFE_GETCADENCE_CMD"] = QList<int>() << 0xA7 << QList<int>();
-    cmds["CSAFE_GETUSERINFO_CMD"] = QList<int>() << 0xAB << QList<int>();
-    cmds["CSAFE_GETHRCUR_CMD"] = QList<int>() << 0xB0 << QList<int>();
-    cmds["CSAFE_GETPOWER_CMD"] = QList<int>() << 0xB4 << QList<int>();
+    {"CSAFE_GETSTATUS_CMD", 0x80, 0, {}, 0},
+    {"CSAFE_RESET_CMD", 0x81, 0, {}, 0},
+    {"CSAFE_GOIDLE_CMD", 0x82, 0, {}, 0},
+    {"CSAFE_GOHAVEID_CMD", 0x83, 0, {}, 0},
+    {"CSAFE_GOINUSE_CMD", 0x85, 0, {}, 0},
+    {"CSAFE_GOFINISHED_CMD", 0x86, 0, {}, 0},
+    {"CSAFE_GOREADY_CMD", 0x87, 0, {}, 0},
+    {"CSAFE_BADID_CMD", 0x88, 0, {}, 0},
+    {"CSAFE_GETVERSION_CMD", 0x91, 0, {}, 0},
+    {"CSAFE_GETID_CMD", 0x92, 0, {}, 0},
+    {"CSAFE_GETUNITS_CMD", 0x93, 0, {}, 0},
+    {"CSAFE_GETSERIAL_CMD", 0x94, 0, {}, 0},
+    {"CSAFE_GETODOMETER_CMD", 0x9B, 0, {}, 0},
+    {"CSAFE_GETERRORCODE_CMD", 0x9C, 0, {}, 0},
+    {"CSAFE_GETTWORK_CMD", 0xA0, 0, {}, 0},
+    {"CSAFE_GETHORIZONTAL_CMD", 0xA1, 0, {}, 0},
+    {"CSAFE_GETCALORIES_CMD", 0xA3, 0, {}, 0},
+    {"CSAFE_GETPROGRAM_CMD", 0xA4, 0, {}, 0},
+    {"CSAFE_GETPACE_CMD", 0xA6, 0, {}, 0},
+    {"CSAFE_GETCADENCE_CMD", 0xA7, 0, {}, 0},
+    {"CSAFE_GETUSERINFO_CMD", 0xAB, 0, {}, 0},
+    {"CSAFE_GETHRCUR_CMD", 0xB0, 0, {}, 0},
+    {"CSAFE_GETPOWER_CMD", 0xB4, 0, {}, 0},
     // Long Commands
-    cmds["CSAFE_AUTOUPLOAD_CMD"] = QList<int>() << 0x01 << QList<int>() << 1;
-    cmds["CSAFE_IDDIGITS_CMD"] = QList<int>() << 0x10 << QList<int>() << 1;
-    cmds["CSAFE_SETTIME_CMD"] = QList<int>() << 0x11 << QList<int>() << 1 << 1 << 1;
-    cmds["CSAFE_SETDATE_CMD"] = QList<int>() << 0x12 << QList<int>() << 1 << 1 << 1;
-    cmds["CSAFE_SETTIMEOUT_CMD"] = QList<int>() << 0x13 << QList<int>() << 1;
-    cmds["CSAFE_SETUSERCFG1_CMD"] = QList<int>() << 0x1A << QList<int>() << 0;
-    cmds["CSAFE_SETTWORK_CMD"] = QList<int>() << 0x20 << QList<int>() << 1 << 1 << 1;
-    cmds["CSAFE_SETHORIZONTAL_CMD"] = QList<int>() << 0x21 << QList<int>() << 2 << 1;
-    cmds["CSAFE_SETCALORIES_CMD"] = QList<int>() << 0x23 << QList<int>() << 2;
-    cmds["CSAFE_SETPROGRAM_CMD"] = QList<int>() << 0x24 << QList<int>() << 1 << 1;
-    cmds["CSAFE_SETPOWER_CMD"] = QList<int>() << 0x34 << QList<int>() << 2 << 1;
-    cmds["CSAFE_GETCAPS_CMD"] = QList<int>() << 0x70 << QList<int>() << 1;
-
+    {"CSAFE_AUTOUPLOAD_CMD", 0x01, 1, {1}, 0},
+    {"CSAFE_IDDIGITS_CMD", 0x10, 1, {1}, 0},
+    {"CSAFE_SETTIME_CMD", 0x11, 3, {1, 1, 1}, 0},
+    {"CSAFE_SETDATE_CMD", 0x12, 3, {1, 1, 1}, 0},
+    {"CSAFE_SETTIMEOUT_CMD", 0x13, 1, {1}, 0},
+    {"CSAFE_SETUSERCFG1_CMD", 0x1A, 1, {0}, 0},
+    {"CSAFE_SETTWORK_CMD", 0x20, 3, {1, 1, 1}, 0},
+    {"CSAFE_SETHORIZONTAL_CMD", 0x21, 2, {2, 1}, 0},
+    {"CSAFE_SETCALORIES_CMD", 0x23, 1, {2}, 0},
+    {"CSAFE_SETPROGRAM_CMD", 0x24, 2, {1, 1}, 0},
+    {"CSAFE_SETPOWER_CMD", 0x34, 2, {2, 1}, 0},
+    {"CSAFE_GETCAPS_CMD", 0x70, 1, {1}, 0},
     // PM3 Specific Short Commands
-    cmds["CSAFE_PM_GET_WORKOUTTYPE"] = QList<int>() << 0x89 << QList<int>() << 0x1A;
-    cmds["CSAFE_PM_GET_DRAGFACTOR"] = QList<int>() << 0xC1 << QList<int>() << 0x1A;
-    cmds["CSAFE_PM_GET_STROKESTATE"] = QList<int>() << 0xBF << QList<int>() << 0x1A;
-    cmds["CSAFE_PM_GET_WORKTIME"] = QList<int>() << 0xA0 << QList<int>() << 0x1A;
-    cmds["CSAFE_PM_GET_WORKDISTANCE"] = QList<int>() << 0xA3 << QList<int>() << 0x1A;
-    cmds["CSAFE_PM_GET_ERRORVALUE"] = QList<int>() << 0xC9 << QList<int>() << 0x1A;
-    cmds["CSAFE_PM_GET_WORKOUTSTATE"] = QList<int>() << 0x8D << QList<int>() << 0x1A;
-    cmds["CSAFE_PM_GET_WORKOUTINTERVALCOUNT"] = QList<int>() << 0x9F << QList<int>() << 0x1A;
-    cmds["CSAFE_PM_GET_INTERVALTYPE"] = QList<int>() << 0x8E << QList<int>() << 0x1A;
-    cmds["CSAFE_PM_GET_RESTTIME"] = QList<int>() << 0xCF << QList<int>() << 0x1A;
-
+    {"CSAFE_PM_GET_WORKOUTTYPE", 0x89, 0, {}, 0x1A},
+    {"CSAFE_PM_GET_DRAGFACTOR", 0xC1, 0, {}, 0x1A},
+    {"CSAFE_PM_GET_STROKESTATE", 0xBF, 0, {}, 0x1A},
+    {"CSAFE_PM_GET_WORKTIME", 0xA0, 0, {}, 0x1A},
+    {"CSAFE_PM_GET_WORKDISTANCE", 0xA3, 0, {}, 0x1A},
+    {"CSAFE_PM_GET_ERRORVALUE", 0xC9, 0, {}, 0x1A},
+    {"CSAFE_PM_GET_WORKOUTSTATE", 0x8D, 0, {}, 0x1A},
+    {"CSAFE_PM_GET_WORKOUTINTERVALCOUNT", 0x9F, 0, {}, 0x1A},
+    {"CSAFE_PM_GET_INTERVALTYPE", 0x8E, 0, {}, 0x1A},
+    {"CSAFE_PM_GET_RESTTIME", 0xCF, 0, {}, 0x1A},
     // PM3 Specific Long Commands
-    cmds["CSAFE_PM_SET_SPLITDURATION"] = QList<int>() << 0x05 << QList<int>() << 1 << 4 << 0x1A;
-    cmds["CSAFE_PM_GET_FORCEPLOTDATA"] = QList<int>() << 0x6B << QList<int>() << 1 << 0x1A;
-    cmds["CSAFE_PM_SET_SCREENERRORMODE"] = QList<int>() << 0x27 << QList<int>() << 1 << 0x1A;
-    cmds["CSAFE_PM_GET_HEARTBEATDATA"] = QList<int>() << 0x6C << QList<int>() << 1 << 0x1A;*/
-
-    cmds["CSAFE_PM_GET_WORKTIME"] = populateCmd(0xa0, QList<int>(), 0x1a);
-    cmds["CSAFE_PM_GET_WORKDISTANCE"] = populateCmd(0xa3, QList<int>(), 0x1a);
+    {"CSAFE_PM_SET_SPLITDURATION", 0x05, 2, {1, 4}, 0x1A},
+    {"CSAFE_PM_GET_FORCEPLOTDATA", 0x6B, 1, {1}, 0x1A},
+    {"CSAFE_PM_SET_SCREENERRORMODE", 0x27, 1, {1}, 0x1A},
+    {"CSAFE_PM_GET_HEARTBEATDATA", 0x6C, 1, {1}, 0x1A},
+};
 
-    cmds["CSAFE_GETCALORIES_CMD"] = populateCmd(0xa3, QList<int>());
-    cmds["CSAFE_GETCADENCE_CMD"] = populateCmd(0xa7, QList<int>());
-    cmds["CSAFE_GETHRCUR_CMD"] = populateCmd(0xb0, QList<int>());
-    cmds["CSAFE_GETPOWER_CMD"] = populateCmd(0xb4, QList<int>());
+static_assert(sizeof(commands) / sizeof(commands[0]) == csafe::commandCount,
+              "the command table doesn't match csafe::command");
 
+constexpr responseinfo responses[] = {
     // Response Data to Short Commands
-    resp[0x80] = qMakePair(QString("CSAFE_GETSTATUS_CMD"), QList<int>() << 0);
-    resp[0x81] = qMakePair(QString("CSAFE_RESET_CMD"), QList<int>() << 0);
-    resp[0x82] = qMakePair(QString("CSAFE_GOIDLE_CMD"), QList<int>() << 0);
-    resp[0x83] = qMakePair(QString("CSAFE_GOHAVEID_CMD"), QList<int>() << 0);
-    resp[0x85] = qMakePair(QString("CSAFE_GOINUSE_CMD"), QList<int>() << 0);
-    resp[0x86] = qMakePair(QString("CSAFE_GOFINISHED_CMD"), QList<int>() << 0);
-    resp[0x87] = qMakePair(QString("CSAFE_GOREADY_CMD"), QList<int>() << 0);
-    resp[0x88] = qMakePair(QString("CSAFE_BADID_CMD"), QList<int>() << 0);
-    resp[0x91] = qMakePair(QString("CSAFE_GETVERSION_CMD"), QList<int>() << 1 << 1 << 1 << 2 << 2);
-    resp[0x92] = qMakePair(QString("CSAFE_GETID_CMD"), QList<int>() << -5);
-    resp[0x93] = qMakePair(QString("CSAFE_GETUNITS_CMD"), QList<int>() << 1);
-    resp[0x94] = qMakePair(QString("CSAFE_GETSERIAL_CMD"), QList<int>() << -9);
-    resp[0x9B] = qMakePair(QString("CSAFE_GETODOMETER_CMD"), QList<int>() << 4 << 1);
-    resp[0x9C] = qMakePair(QString("CSAFE_GETERRORCODE_CMD"), QList<int>() << 3);
-    resp[0xA0] = qMakePair(QString("CSAFE_GETTWORK_CMD"), QList<int>() << 1 << 1 << 1);
-    resp[0xA1] = qMakePair(QString("CSAFE_GETHORIZONTAL_CMD"), QList<int>() << 2 << 1);
-    resp[0xA3] = qMakePair(QString("CSAFE_GETCALORIES_CMD"), QList<int>() << 2);
-    resp[0xA4] = qMakePair(QString("CSAFE_GETPROGRAM_CMD"), QList<int>() << 1);
-    resp[0xA6] = qMakePair(QString("CSAFE_GETPACE_CMD"), QList<int>() << 2 << 1);
-    resp[0xA7] = qMakePair(QString("CSAFE_GETCADENCE_CMD"), QList<int>() << 2 << 1);
-    resp[0xAB] = qMakePair(QString("CSAFE_GETUSERINFO_CMD"), QList<int>() << 2 << 1 << 1 << 1);
-    resp[0xB0] = qMakePair(QString("CSAFE_GETHRCUR_CMD"), QList<int>() << 1);
-    resp[0xB4] = qMakePair(QString("CSAFE_GETPOWER_CMD"), QList<int>() << 2 << 1);
+    {0x80, "CSAFE_GETSTATUS_CMD", 1, {0}},
+    {0x81, "CSAFE_RESET_CMD", 1, {0}},
+    {0x82, "CSAFE_GOIDLE_CMD", 1, {0}},
+    {0x83, "CSAFE_GOHAVEID_CMD", 1, {0}},
+    {0x85, "CSAFE_GOINUSE_CMD", 1, {0}},
+    {0x86, "CSAFE_GOFINISHED_CMD", 1, {0}},
+    {0x87, "CSAFE_GOREADY_CMD", 1, {0}},
+    {0x88, "CSAFE_BADID_CMD", 1, {0}},
+    {0x91, "CSAFE_GETVERSION_CMD", 5, {1, 1, 1, 2, 2}},
+    {0x92, "CSAFE_GETID_CMD", 1, {-5}},
+    {0x93, "CSAFE_GETUNITS_CMD", 1, {1}},
+    {0x94, "CSAFE_GETSERIAL_CMD", 1, {-9}},
+    {0x9B, "CSAFE_GETODOMETER_CMD", 2, {4, 1}},
+    {0x9C, "CSAFE_GETERRORCODE_CMD", 1, {3}},
+    {0xA0, "CSAFE_GETTWORK_CMD", 3, {1, 1, 1}},
+    {0xA1, "CSAFE_GETHORIZONTAL_CMD", 2, {2, 1}},
+    {0xA3, "CSAFE_GETCALORIES_CMD", 1, {2}},
+    {0xA4, "CSAFE_GETPROGRAM_CMD", 1, {1}},
+    {0xA6, "CSAFE_GETPACE_CMD", 2, {2, 1}},
+    {0xA7, "CSAFE_GETCADENCE_CMD", 2, {2, 1}},
+    {0xAB, "CSAFE_GETUSERINFO_CMD", 4, {2, 1, 1, 1}},
+    {0xB0, "CSAFE_GETHRCUR_CMD", 1, {1}},
+    {0xB4, "CSAFE_GETPOWER_CMD", 2, {2, 1}},
 
     // Response Data to Long Commands
-    resp[0x01] = qMakePair(QString("CSAFE_AUTOUPLOAD_CMD"), QList<int>() << 0);
-    resp[0x10] = qMakePair(QString("CSAFE_IDDIGITS_CMD"), QList<int>() << 0);
-    resp[0x11] = qMakePair(QString("CSAFE_SETTIME_CMD"), QList<int>() << 0);
-    resp[0x12] = qMakePair(QString("CSAFE_SETDATE_CMD"), QList<int>() << 0);
-    resp[0x13] = qMakePair(QString("CSAFE_SETTIMEOUT_CMD"), QList<int>() << 0);
-    resp[0x1A] = qMakePair(QString("CSAFE_SETUSERCFG1_CMD"), QList<int>() << 0);
-    resp[0x20] = qMakePair(QString("CSAFE_SETTWORK_CMD"), QList<int>() << 0);
-    resp[0x21] = qMakePair(QString("CSAFE_SETHORIZONTAL_CMD"), QList<int>() << 0);
-    resp[0x23] = qMakePair(QString("CSAFE_SETCALORIES_CMD"), QList<int>() << 0);
-    resp[0x24] = qMakePair(QString("CSAFE_SETPROGRAM_CMD"), QList<int>() << 0);
-    resp[0x34] = qMakePair(QString("CSAFE_SETPOWER_CMD"), QList<int>() << 0);
-    resp[0x70] = qMakePair(QString("CSAFE_GETCAPS_CMD"), QList<int>() << 11);
+    {0x01, "CSAFE_AUTOUPLOAD_CMD", 1, {0}},
+    {0x10, "CSAFE_IDDIGITS_CMD", 1, {0}},
+    {0x11, "CSAFE_SETTIME_CMD", 1, {0}},
+    {0x12, "CSAFE_SETDATE_CMD", 1, {0}},
+    {0x13, "CSAFE_SETTIMEOUT_CMD", 1, {0}},
+    {0x1A, "CSAFE_SETUSERCFG1_CMD", 1, {0}},
+    {0x20, "CSAFE_SETTWORK_CMD", 1, {0}},
+    {0x21, "CSAFE_SETHORIZONTAL_CMD", 1, {0}},
+    {0x23, "CSAFE_SETCALORIES_CMD", 1, {0}},
+    {0x24, "CSAFE_SETPROGRAM_CMD", 1, {0}},
+    {0x34, "CSAFE_SETPOWER_CMD", 1, {0}},
+    {0x70, "CSAFE_GETCAPS_CMD", 1, {11}},
 
     // Response Data to PM3 Specific Short Commands
-    resp[0x1A89] = qMakePair(QString("CSAFE_PM_GET_WORKOUTTYPE"), QList<int>() << 1);
-    resp[0x1AC1] = qMakePair(QString("CSAFE_PM_GET_DRAGFACTOR"), QList<int>() << 1);
-    resp[0x1ABF] = qMakePair(QString("CSAFE_PM_GET_STROKESTATE"), QList<int>() << 1);
-    resp[0x1AA0] = qMakePair(QString("CSAFE_PM_GET_WORKTIME"), QList<int>() << 4 << 1);
-    resp[0x1AA3] = qMakePair(QString("CSAFE_PM_GET_WORKDISTANCE"), QList<int>() << 4 << 1);
-    resp[0x1AC9] = qMakePair(QString("CSAFE_PM_GET_ERRORVALUE"), QList<int>() << 2);
-    resp[0x1A8D] = qMakePair(QString("CSAFE_PM_GET_WORKOUTSTATE"), QList<int>() << 1);
-    resp[0x1A9F] = qMakePair(QString("CSAFE_PM_GET_WORKOUTINTERVALCOUNT"), QList<int>() << 1);
-    resp[0x1A8E] = qMakePair(QString("CSAFE_PM_GET_INTERVALTYPE"), QList<int>() << 1);
-    resp[0x1ACF] = qMakePair(QString("CSAFE_PM_GET_RESTTIME"), QList<int>() << 2);
+    {0x1A89, "CSAFE_PM_GET_WORKOUTTYPE", 1, {1}},
+    {0x1AC1, "CSAFE_PM_GET_DRAGFACTOR", 1, {1}},
+    {0x1ABF, "CSAFE_PM_GET_STROKESTATE", 1, {1}},
+    {0x1AA0, "CSAFE_PM_GET_WORKTIME", 2, {4, 1}},
+    {0x1AA3, "CSAFE_PM_GET_WORKDISTANCE", 2, {4, 1}},
+    {0x1AC9, "CSAFE_PM_GET_ERRORVALUE", 1, {2}},
+    {0x1A8D, "CSAFE_PM_GET_WORKOUTSTATE", 1, {1}},
+    {0x1A9F, "CSAFE_PM_GET_WORKOUTINTERVALCOUNT", 1, {1}},
+    {0x1A8E, "CSAFE_PM_GET_INTERVALTYPE", 1, {1}},
+    {0x1ACF, "CSAFE_PM_GET_RESTTIME", 1, {2}},
 
     // Response Data to PM3 Specific Long Commands
-    resp[0x1A05] = qMakePair(QString("CSAFE_PM_SET_SPLITDURATION"), QList<int>() << 0);
-    resp[0x1A6B] =
-        qMakePair(QString("CSAFE_PM_GET_FORCEPLOTDATA"),
-                  QList<int>() << 1 << 2 << 2 << 2 << 2 << 2 << 2 << 2 << 2 << 2 << 2 << 2 << 2 << 2 << 2 << 2 << 2);
-    resp[0x1A27] = qMakePair(QString("CSAFE_PM_SET_SCREENERRORMODE"), QList<int>() << 0);
-    resp[0x1A6C] =
-        qMakePair(QString("CSAFE_PM_GET_HEARTBEATDATA"),
-                  QList<int>() << 1 << 2 << 2 << 2 << 2 << 2 << 2 << 2 << 2 << 2 << 2 << 2 << 2 << 2 << 2 << 2 << 2);
-}
-
-QList<QList<int>> csafe::populateCmd(int First, QList<int> Second, int Third) {
-    QList<QList<int>> ret;
-    QList<int> first;
-    QList<int> second;
-    QList<int> third;
-    first.clear();
-    second.clear();
-    third.clear();
-    first.append(First);
-    foreach (int a, Second) { second.append(a); }
-    third.append(Third);
-    ret.append(first);
-    ret.append(second);
-    ret.append(third);
-    return ret;
-}
-
-QList<QList<int>> csafe::populateCmd(int First, QList<int> Second) {
-    QList<QList<int>> ret;
-    QList<int> first;
-    QList<int> second;
-    first.clear();
-    second.clear();
-    first.append(First);
-    foreach (int a, Second) { second.append(a); }
-    ret.append(first);
-    ret.append(second);
-    return ret;
-}
-
-QVector<quint8> csafe::int2bytes(int numbytes, int integer) {
-    if (!(0 <= integer && integer <= (1 << (8 * numbytes)))) {
-        qWarning("Integer is outside the allowable range");
-    }
-
-    QVector<quint8> byte;
-    for (int k = 0; k < numbytes; ++k) {
-        int calcbyte = (integer >> (8 * k)) & 0xFF;
-        byte.append(calcbyte);
+    {0x1A05, "CSAFE_PM_SET_SPLITDURATION", 1, {0}},
+    {0x1A6B, "CSAFE_PM_GET_FORCEPLOTDATA", 17, {1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2}},
+    {0x1A27, "CSAFE_PM_SET_SCREENERRORMODE", 1, {0}},
+    {0x1A6C, "CSAFE_PM_GET_HEARTBEATDATA", 17, {1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2}},
+};
+
+const responseinfo *findResponse(int id) {
+    for (const responseinfo &r : responses) {
+        if (r.id == id)
+            return &r;
     }
-
-    return byte;
+    return nullptr;
 }
 
-int csafe::bytes2int(const QVector<quint8> &raw_bytes) {
-    int num_bytes = raw_bytes.size();
-    int integer = 0;
-
-    for (int k = 0; k < num_bytes; ++k) {
-        integer = (raw_bytes[k] << (8 * k)) | integer;
-    }
+int responseId(csafe::command c) { return commands[c].id | (commands[c].wrapper << 8); }
 
-    return integer;
+int responseBytes(int id) {
+    const responseinfo *r = findResponse(id);
+    if (!r)
+        return 0;
+    int sum = 0;
+    for (int i = 0; i < r->fieldCount; i++)
+        sum += r->fields[i];
+    return sum;
 }
 
-QString csafe::bytes2ascii(const QVector<quint8> &raw_bytes) {
-    QString word;
-    for (quint8 letter : raw_bytes) {
-        word += QChar(letter);
-    }
+} // namespace
 
-    return word;
-}
+const char *csafe::name(command c) { return commands[c].name; }
 
-QByteArray csafe::write(const QStringList &arguments) {
-    int i = 0;
-    QVector<quint8> message;
+int csafe::encode(const command *cmds, int count, quint8 *buffer, int capacity, const int *arguments) {
+    quint8 message[maxFrameSize];
+    int size = 0;
+    quint8 wrapped[maxFrameSize];
+    int wrappedSize = 0;
     int wrapper = 0;
-    QVector<quint8> wrapped;
     int maxresponse = 3; // start & stop flag & status
-
-    while (i < arguments.size()) {
-        QString arg = arguments[i];
-        const auto &cmdprop = cmds[arg];
-        QVector<quint8> command;
-
-        if (cmdprop.at(1).size() != 0) // Long Command
-        {
-            for (int a = 0; a < (int)cmdprop.at(1).size(); a++) {
-                ++i;
-                int intvalue = arguments[i].toInt();
-                QVector<quint8> value = int2bytes(cmdprop.at(1).at(a), intvalue);
-                command.append(value);
+    int argument = 0;
+
+    auto closeWrapper = [&]() {
+        if (size + wrappedSize + 2 > maxFrameSize)
+            return false;
+        message[size++] = wrapper;     // wrapper command id
+        message[size++] = wrappedSize; // data byte count for wrapper
+        memcpy(message + size, wrapped, wrappedSize);
+        size += wrappedSize;
+        wrappedSize = 0;
+        wrapper = 0;
+        return true;
+    };
+
+    for (int i = 0; i < count; i++) {
+        const commandinfo &cmdprop = commands[cmds[i]];
+        quint8 cmd[16];
+        int commandSize = 0;
+
+        cmd[commandSize++] = cmdprop.id; // add command id
+        if (cmdprop.argCount) {              // Long Command
+            int cmdbytes = 0;
+            for (int a = 0; a < cmdprop.argCount; a++)
+                cmdbytes += cmdprop.argBytes[a];
+            cmd[commandSize++] = cmdbytes; // data byte count
+            for (int a = 0; a < cmdprop.argCount; a++) {
+                int intvalue = arguments ? arguments[argument++] : 0;
+                for (int k = 0; k < cmdprop.argBytes[a]; k++)
+                    cmd[commandSize++] = (intvalue >> (8 * k)) & 0xFF;
             }
-
-            int cmdbytes = command.size();
-            command.prepend(cmdbytes); // data byte count
         }
 
-        command.prepend(cmdprop.at(0).at(0)); // add command id
-
-        if (!wrapped.isEmpty() && (cmdprop.size() < 3 || cmdprop.at(2).at(0) != wrapper)) {
-            wrapped.prepend(wrapped.size()); // data byte count for wrapper
-            wrapped.prepend(wrapper);        // wrapper command id
-            message.append(wrapped);         // adds wrapper to message
-            wrapped.clear();
-            wrapper = 0;
-        }
+        if (wrappedSize && cmdprop.wrapper != wrapper && !closeWrapper())
+            return 0;
 
-        if (cmdprop.size() == 3) // checks if command needs a wrapper
-        {
-            if (wrapper == cmdprop.at(2).at(0)) // checks if currently in the same wrapper
-            {
-                wrapped.append(command);
-            } else // creating a new wrapper
-            {
-                wrapped = command;
-                wrapper = cmdprop.at(2).at(0);
+        if (cmdprop.wrapper) {                 // checks if command needs a wrapper
+            if (wrapper != cmdprop.wrapper) { // creating a new wrapper
+                wrapper = cmdprop.wrapper;
                 maxresponse += 2;
             }
-
-            command.clear(); // clear command to prevent it from getting into message
-        }
-
-        int cmdid = cmdprop[0].at(0) | (wrapper << 8); // max message length
-        int sum = 0;
-        for (int aa = 0; aa < resp[cmdid].second.size(); aa++) {
-            sum += resp[cmdid].second.at(aa);
+            if (wrappedSize + commandSize > maxFrameSize)
+                return 0;
+            memcpy(wrapped + wrappedSize, cmd, commandSize);
+            wrappedSize += commandSize;
+            commandSize = 0; // the command is in the wrapper, not in the message
         }
-        maxresponse += qAbs(sum) * 2 + 1; // double return to account for stuffing
 
-        message.append(command); // add completed command to final message
+        maxresponse += qAbs(responseBytes(cmdprop.id | (wrapper << 8))) * 2 + 1; // double return to account for stuffing
 
-        ++i;
+        if (size + commandSize > maxFrameSize)
+            return 0;
+        memcpy(message + size, cmd, commandSize); // add completed command to final message
+        size += commandSize;
     }
 
-    if (!wrapped.isEmpty()) // closes wrapper if message ended on it
-    {
-        wrapped.prepend(wrapped.size()); // data byte count for wrapper
-        wrapped.prepend(wrapper);        // wrapper command id
-        message.append(wrapped);         // adds wrapper to message
-    }
+    if (wrappedSize && !closeWrapper()) // closes wrapper if message ended on it
+        return 0;
 
+    // report id, start flag, the message with its stuffing, checksum and stop flag
+    quint8 frame[maxFrameSize * 2 + 4];
+    int frameSize = 1;
     int checksum = 0;
-    int j = 0;
-
-    while (j < message.size()) // checksum and byte stuffing
-    {
-        checksum ^= message[j]; // calculate checksum
-
-        if (0xF0 <= message[j] && message[j] <= 0xF3) // byte stuffing
-        {
-            message.insert(j, Byte_Stuffing_Flag);
-            ++j;
-            message[j] = message[j] & 0x3;
+    frame[frameSize++] = Standard_Frame_Start_Flag;
+    for (int j = 0; j < size; j++) {
+        checksum ^= message[j];
+        if (0xF0 <= message[j] && message[j] <= 0xF3) { // byte stuffing
+            frame[frameSize++] = Byte_Stuffing_Flag;
+            frame[frameSize++] = message[j] & 0x3;
+        } else {
+            frame[frameSize++] = message[j];
         }
-
-        ++j;
-    }
-
-    message.append(checksum);                   // add checksum to end of message
-    message.prepend(Standard_Frame_Start_Flag); // start frame
-    message.append(Stop_Frame_Flag);            // stop frame
-
-    if (message.size() > 96) // check for frame size (96 bytes)
-    {
-        qWarning("Message is too long: %d", message.size());
     }
+    frame[frameSize++] = checksum;
+    frame[frameSize++] = Stop_Frame_Flag;
 
-    int maxmessage = qMax(message.size() + 1, maxresponse); // report IDs
+    int messageSize = frameSize - 1;
+    if (messageSize > 96) // check for frame size (96 bytes)
+        qWarning("Message is too long: %d", messageSize);
 
+    int maxmessage = qMax(messageSize + 1, maxresponse); // report IDs
+    int reportSize;
     if (maxmessage <= 21) {
-        message.prepend(0x01);
-        message.append(QVector<quint8>(21 - message.size()));
+        frame[0] = 0x01;
+        reportSize = 21;
     } else if (maxmessage <= 63) {
-        message.prepend(0x04);
-        message.append(QVector<quint8>(63 - message.size()));
-    } else if ((message.size() + 1) <= 121) {
-        message.prepend(0x02);
-        message.append(QVector<quint8>(121 - message.size()));
-        if (maxresponse > 121) {
+        frame[0] = 0x04;
+        reportSize = 63;
+    } else if ((messageSize + 1) <= 121) {
+        frame[0] = 0x02;
+        reportSize = 121;
+        if (maxresponse > 121)
             qWarning("Response may be too long to receive. Max possible length: %d", maxresponse);
-        }
     } else {
-        qWarning("Message too long. Message length: %d", message.size());
-        message.clear();
+        qWarning("Message too long. Message length: %d", messageSize);
+        return 0;
     }
 
-    QByteArray ret;
-    foreach (int a, message) { ret.append(a); }
-    return ret;
+    if (capacity < reportSize)
+        return 0;
+    memcpy(buffer, frame, frameSize);
+    memset(buffer + frameSize, 0, reportSize - frameSize);
+    return reportSize;
 }
 
-QVector<quint8> csafe::check_message(QVector<quint8> message) {
-    int i = 0;
-    int checksum = 0;
-
-    while (i < message.size()) // checksum and unstuff
-    {
-        if (message[i] == Byte_Stuffing_Flag) // byte unstuffing
-        {
-            quint8 stuffvalue = message.takeAt(i + 1);
-            message[i] = 0xF0 | stuffvalue;
-        }
-
-        checksum ^= message[i]; // calculate checksum
-
-        ++i;
-    }
-
-    if (checksum != 0) // checks checksum
-    {
-        qWarning("Checksum error");
-        message.clear();
-    } else {
-        message.removeLast(); // remove checksum from end of message
-    }
-
-    return message;
-}
+bool csafe::decode(const quint8 *transmission, int size, response &out) {
+    out.status = -1;
+    out.count = 0;
 
-QVariantMap csafe::read(const QVector<quint8> &transmission) {
-    QVector<quint8> message;
-    bool stopfound = false;
-
-    int startflag = transmission[1];
+    if (size < 2)
+        return false;
 
     int j = 0;
+    int startflag = transmission[1];
     if (startflag == Extended_Frame_Start_Flag) {
         j = 4;
     } else if (startflag == Standard_Frame_Start_Flag) {
         j = 2;
     } else {
         qWarning("No Start Flag found.");
-        return QVariantMap();
+        return false;
     }
 
-    while (j < transmission.size()) {
-        if (transmission[j] == Stop_Frame_Flag) {
+    // unstuff the message into the response while looking for the stop flag
+    int length = 0;
+    int checksum = 0;
+    bool stopfound = false;
+    for (; j < size; j++) {
+        quint8 b = transmission[j];
+        if (b == Stop_Frame_Flag) {
             stopfound = true;
             break;
         }
-        message.append(transmission[j]);
-        ++j;
+        if (b == Byte_Stuffing_Flag && j + 1 < size)
+            b = 0xF0 | transmission[++j];
+        if (length == maxFrameSize)
+            return false;
+        out.data[length++] = b;
+        checksum ^= b;
     }
 
     if (!stopfound) {
         qWarning("No Stop Flag found.");
-        return QVariantMap();
+        return false;
     }
+    if (checksum != 0 || length < 2) {
+        qWarning("Checksum error");
+        return false;
+    }
+    length--; // remove checksum from end of message
 
-    message = check_message(message);
-    int status = message.takeFirst();
-
-    QVariantMap response;
-    response["CSAFE_GETSTATUS_CMD"] = QVariantList() << status;
+    out.status = out.data[0];
 
-    int k = 0;
+    int k = 1;
     int wrapend = -1;
     int wrapper = 0x0;
-
-    while (k < message.size()) // loop through complete frames
-    {
-        QVariantList result;
-
-        int msgcmd = message[k];
-        if (k <= wrapend) {
+    while (k + 1 < length) { // loop through complete frames
+        int msgcmd = out.data[k];
+        if (k <= wrapend)
             msgcmd = wrapper | msgcmd;
-        }
-        auto &msgprop = resp[msgcmd];
         ++k;
-
-        int bytecount = message[k];
+        int bytecount = out.data[k];
         ++k;
 
-        if (msgprop.first == "CSAFE_SETUSERCFG1_CMD") // if wrapper command
-        {
-            wrapper = message[k - 2] << 8;
+        if (msgcmd == 0x1A) { // if wrapper command
+            wrapper = out.data[k - 2] << 8;
             wrapend = k + bytecount - 1;
             if (bytecount != 0) {
-                msgcmd = wrapper | message[k];
-                const auto &wrapper_msgprop = resp[msgcmd];
-                msgprop.second = wrapper_msgprop.second;
+                if (k + 1 >= length)
+                    break;
+                msgcmd = wrapper | out.data[k];
                 ++k;
-                bytecount = message[k];
+                bytecount = out.data[k];
                 ++k;
             }
         }
 
-        if (msgprop.first == "CSAFE_GETCAPS_CMD") // special case for capability code
-        {
-            // msgprop.second = QList<int>(bytecount, 1);
-        }
+        if (k + bytecount > length)
+            break;
 
-        if (msgprop.first == "CSAFE_GETID_CMD") // special case for get id
-        {
-            // msgprop.second = QList<int>(1, -bytecount);
+        int expected = qAbs(responseBytes(msgcmd));
+        if (expected != 0 && bytecount != expected)
+            qWarning("Warning: bytecount is an unexpected length");
+
+        if (out.count < maxReadings) {
+            reading &r = out.readings[out.count++];
+            r.id = msgcmd;
+            r.offset = k;
+            r.size = bytecount;
         }
+        k += bytecount;
+    }
 
-        if (abs(std::accumulate(msgprop.second.begin(), msgprop.second.end(), 0)) != 0 &&
-            bytecount != abs(std::accumulate(msgprop.second.begin(), msgprop.second.end(), 0))) {
-            qWarning("Warning: bytecount is an unexpected length");
+    return true;
+}
+
+const csafe::reading *csafe::response::find(command c) const {
+    int id = responseId(c);
+    for (int i = 0; i < count; i++) {
+        if (readings[i].id == id)
+            return &readings[i];
+    }
+    return nullptr;
+}
+
+int csafe::response::value(command c, int field, int fallback) const {
+    const reading *r = find(c);
+    const responseinfo *info = findResponse(responseId(c));
+    if (!r || !info || field >= info->fieldCount || info->fields[field] < 0)
+        return fallback;
+
+    int offset = 0;
+    for (int i = 0; i < field; i++)
+        offset += qAbs(info->fields[i]);
+    if (offset + info->fields[field] > r->size)
+        return fallback;
+    return bytes2int(data + r->offset + offset, info->fields[field]);
+}
+
+int csafe::bytes2int(const quint8 *raw_bytes, int size) {
+    int integer = 0;
+    for (int k = 0; k < size; ++k) {
+        integer = (raw_bytes[k] << (8 * k)) | integer;
+    }
+    return integer;
+}
+
+QString csafe::bytes2ascii(const quint8 *raw_bytes, int size) {
+    QString word;
+    for (int k = 0; k < size; ++k) {
+        word += QChar(raw_bytes[k]);
+    }
+    return word;
+}
+
+QByteArray csafe::write(const QStringList &arguments) {
+    command cmds[maxFrameSize];
+    int values[maxFrameSize];
+    int count = 0;
+    int valueCount = 0;
+
+    for (int i = 0; i < arguments.size() && count < maxFrameSize; i++) {
+        int c = 0;
+        while (c < commandCount && arguments[i] != QLatin1String(commands[c].name))
+            c++;
+        if (c == commandCount) {
+            qWarning() << "Unknown CSAFE command" << arguments[i];
+            continue;
         }
+        cmds[count++] = (command)c;
+        for (int a = 0; a < commands[c].argCount && valueCount < maxFrameSize; a++)
+            values[valueCount++] = ++i < arguments.size() ? arguments[i].toInt() : 0;
+    }
+
+    quint8 frame[maxFrameSize];
+    int size = encode(cmds, count, frame, sizeof(frame), values);
+    return QByteArray((const char *)frame, size);
+}
+
+QVector<quint8> csafe::check_message(QVector<quint8> message) {
+    int i = 0;
+    int checksum = 0;
 
-        for (int numbytes : msgprop.second) // extract values
+    while (i < message.size()) // checksum and unstuff
+    {
+        if (message[i] == Byte_Stuffing_Flag) // byte unstuffing
         {
-            QVector<quint8> raw_bytes = message.mid(k, abs(numbytes));
-            QVariant value;
-            if (numbytes >= 0) {
-                value = bytes2int(raw_bytes);
-            } else {
-                value = bytes2ascii(raw_bytes);
-            }
-            result.append(value);
-            k += abs(numbytes);
+            quint8 stuffvalue = message.takeAt(i + 1);
+            message[i] = 0xF0 | stuffvalue;
         }
 
-        response[msgprop.first] = result;
+        checksum ^= message[i]; // calculate checksum
+
+        ++i;
+    }
+
+    if (checksum != 0) // checks checksum
+    {
+        qWarning("Checksum error");
+        message.clear();
+    } else {
+        message.removeLast(); // remove checksum from end of message
+    }
+
+    return message;
+}
+
+QVariantMap csafe::read(const QVector<quint8> &transmission) {
+    response r;
+    if (!decode(transmission.constData(), transmission.size(), r))
+        return QVariantMap();
+
+    QVariantMap map;
+    map[QStringLiteral("CSAFE_GETSTATUS_CMD")] = QVariantList() << r.status;
+
+    for (int i = 0; i < r.count; i++) {
+        const reading &reading = r.readings[i];
+        const responseinfo *info = findResponse(reading.id);
+        if (!info)
+            continue;
+
+        QVariantList result;
+        int offset = reading.offset;
+        for (int f = 0; f < info->fieldCount; f++) { // extract values
+            int numbytes = info->fields[f];
+            int available = qBound(0, reading.offset + reading.size - offset, qAbs(numbytes));
+            if (numbytes >= 0)
+                result.append(bytes2int(r.data + offset, available));
+            else
+                result.append(bytes2ascii(r.data + offset, available));
+            offset += qAbs(numbytes);
+        }
+        map[QLatin1String(info->name)] = result;
     }
 
-    return response;
+    return map;
 }
@@ -6,37 +6,139 @@
 #include <QByteArray>
 
 #include <QList>
-#include <QObject>
 #include <QString>
-#include <stdexcept>
-
-#include <QBuffer>
-#include <QMap>
 
+/**
+ * @brief The csafe class encodes and decodes CSAFE frames for the Concept2 Performance Monitors.
+ * The commands and the layout of their responses are described by a constant table (see csafe.cpp), and encode() /
+ * decode() work on caller supplied buffers, so a polling loop can build and parse its frames without allocating.
+ * write() and read() are the string based interface on top of them.
+ */
 class csafe {
-  private:
-    QVector<quint8> int2bytes(int numbytes, int integer);
-    int bytes2int(const QVector<quint8> &raw_bytes);
-    QString bytes2ascii(const QVector<quint8> &raw_bytes);
+  public:
+    /**
+     * @brief The command enum The commands of the table, the values index it.
+     */
+    enum command {
+        // Short Commands
+        CSAFE_GETSTATUS_CMD,
+        CSAFE_RESET_CMD,
+        CSAFE_GOIDLE_CMD,
+        CSAFE_GOHAVEID_CMD,
+        CSAFE_GOINUSE_CMD,
+        CSAFE_GOFINISHED_CMD,
+        CSAFE_GOREADY_CMD,
+        CSAFE_BADID_CMD,
+        CSAFE_GETVERSION_CMD,
+        CSAFE_GETID_CMD,
+        CSAFE_GETUNITS_CMD,
+        CSAFE_GETSERIAL_CMD,
+        CSAFE_GETODOMETER_CMD,
+        CSAFE_GETERRORCODE_CMD,
+        CSAFE_GETTWORK_CMD,
+        CSAFE_GETHORIZONTAL_CMD,
+        CSAFE_GETCALORIES_CMD,
+        CSAFE_GETPROGRAM_CMD,
+        CSAFE_GETPACE_CMD,
+        CSAFE_GETCADENCE_CMD,
+        CSAFE_GETUSERINFO_CMD,
+        CSAFE_GETHRCUR_CMD,
+        CSAFE_GETPOWER_CMD,
+        // Long Commands
+        CSAFE_AUTOUPLOAD_CMD,
+        CSAFE_IDDIGITS_CMD,
+        CSAFE_SETTIME_CMD,
+        CSAFE_SETDATE_CMD,
+        CSAFE_SETTIMEOUT_CMD,
+        CSAFE_SETUSERCFG1_CMD,
+        CSAFE_SETTWORK_CMD,
+        CSAFE_SETHORIZONTAL_CMD,
+        CSAFE_SETCALORIES_CMD,
+        CSAFE_SETPROGRAM_CMD,
+        CSAFE_SETPOWER_CMD,
+        CSAFE_GETCAPS_CMD,
+        // PM3 Specific Short Commands
+        CSAFE_PM_GET_WORKOUTTYPE,
+        CSAFE_PM_GET_DRAGFACTOR,
+        CSAFE_PM_GET_STROKESTATE,
+        CSAFE_PM_GET_WORKTIME,
+        CSAFE_PM_GET_WORKDISTANCE,
+        CSAFE_PM_GET_ERRORVALUE,
+        CSAFE_PM_GET_WORKOUTSTATE,
+        CSAFE_PM_GET_WORKOUTINTERVALCOUNT,
+        CSAFE_PM_GET_INTERVALTYPE,
+        CSAFE_PM_GET_RESTTIME,
+        // PM3 Specific Long Commands
+        CSAFE_PM_SET_SPLITDURATION,
+        CSAFE_PM_GET_FORCEPLOTDATA,
+        CSAFE_PM_SET_SCREENERRORMODE,
+        CSAFE_PM_GET_HEARTBEATDATA,
+        commandCount
+    };
 
-    // Unique Frame Flags
-    const int Extended_Frame_Start_Flag = 0xF0;
-    const int Standard_Frame_Start_Flag = 0xF1;
-    const int Stop_Frame_Flag = 0xF2;
-    const int Byte_Stuffing_Flag = 0xF3;
+    // the largest frame a report can carry
+    static const int maxFrameSize = 121;
+    static const int maxReadings = 24;
 
-    // cmds['COMMAND_NAME'] = [0xCmd_Id, [Bytes, ...]]
-    QMap<QString, QList<QList<int>>> cmds;
-    QMap<int, QPair<QString, QList<int>>> resp;
+    /**
+     * @brief The reading struct One command of a decoded response.
+     */
+    struct reading {
+        /**
+         * @brief id The response id. The commands sent inside a wrapper have it in the high byte (e.g. 0x1AA0).
+         */
+        int id;
+        int offset;
+        int size;
+    };
 
-    QList<QList<int>> populateCmd(int First, QList<int> Second, int Third);
-    QList<QList<int>> populateCmd(int First, QList<int> Second);
+    /**
+     * @brief The response struct A decoded frame. The data bytes are kept unstuffed in the struct itself.
+     */
+    struct response {
+        int status = -1;
+        int count = 0;
+        reading readings[maxReadings];
+        quint8 data[maxFrameSize];
+
+        const reading *find(command c) const;
+
+        /**
+         * @brief value The integer value of a field of the response to a command.
+         * @param fallback Returned if the frame doesn't have the command or the field.
+         */
+        int value(command c, int field = 0, int fallback = -1) const;
+    };
+
+    /**
+     * @brief encode Builds the frame, report id and padding included, that sends the commands.
+     * @param arguments The values of the long commands arguments, in order.
+     * @return The size of the frame, 0 if it doesn't fit in the buffer or in a report.
+     */
+    static int encode(const command *commands, int count, quint8 *buffer, int capacity,
+                      const int *arguments = nullptr);
+
+    /**
+     * @brief decode Parses a frame received from the monitor, report id included.
+     * @return false if the frame is incomplete or its checksum is wrong.
+     */
+    static bool decode(const quint8 *transmission, int size, response &out);
+
+    static const char *name(command c);
 
-  public:
-    csafe();
     QByteArray write(const QStringList &arguments);
     QVector<quint8> check_message(QVector<quint8> message);
     QVariantMap read(const QVector<quint8> &transmission);
+
+  private:
+    static int bytes2int(const quint8 *raw_bytes, int size);
+    static QString bytes2ascii(const quint8 *raw_bytes, int size);
+
+    // Unique Frame Flags
+    static const int Extended_Frame_Start_Flag = 0xF0;
+    static const int Standard_Frame_Start_Flag = 0xF1;
+    static const int Stop_Frame_Flag = 0xF2;
+    static const int Byte_Stuffing_Flag = 0xF3;
 };
 
 #endif // CSAFE_H
@@ -72,41 +72,36 @@ void csaferowerThread::run() {
         settings.value(QZSettings::computrainer_serialport, QZSettings::default_computrainer_serialport).toString();*/
 
     openPort();
-    csafe *aa = new csafe();
+    static const csafe::command poll[] = {csafe::CSAFE_PM_GET_WORKTIME, csafe::CSAFE_PM_GET_WORKDISTANCE,
+                                          csafe::CSAFE_GETCADENCE_CMD,  csafe::CSAFE_GETPOWER_CMD,
+                                          csafe::CSAFE_GETCALORIES_CMD, csafe::CSAFE_GETHRCUR_CMD};
+    // the poll never changes, so the frame is built once
+    uint8_t frame[csafe::maxFrameSize];
+    int frameSize = csafe::encode(poll, sizeof(poll) / sizeof(poll[0]), frame, sizeof(frame));
+    csafe::response f;
     while (1) {
-        QStringList command;
-        command << "CSAFE_PM_GET_WORKTIME";
-        command << "CSAFE_PM_GET_WORKDISTANCE";
-        command << "CSAFE_GETCADENCE_CMD";
-        command << "CSAFE_GETPOWER_CMD";
-        command << "CSAFE_GETCALORIES_CMD";
-        command << "CSAFE_GETHRCUR_CMD";
-        QByteArray ret = aa->write(command);
-
-        qDebug() << " >> " << ret.toHex(' ');
-        rawWrite((uint8_t *)ret.data(), ret.length());
+        qDebug() << " >> " << QByteArray::fromRawData((const char *)frame, frameSize).toHex(' ');
+        rawWrite(frame, frameSize);
         static uint8_t rx[100];
         rawRead(rx, 100);
         qDebug() << " << " << QByteArray::fromRawData((const char *)rx, 64).toHex(' ');
 
-        QVector<quint8> v;
-        for (int i = 0; i < 64; i++)
-            v.append(rx[i]);
-        QVariantMap f = aa->read(v);
-        if (f["CSAFE_GETCADENCE_CMD"].isValid()) {
-            emit onCadence(f["CSAFE_GETCADENCE_CMD"].value<QVariantList>()[0].toDouble());
-        }
-        if (f["CSAFE_GETPOWER_CMD"].isValid()) {
-            emit onPower(f["CSAFE_GETPOWER_CMD"].value<QVariantList>()[0].toDouble());
-        }
-        if (f["CSAFE_GETHRCUR_CMD"].isValid()) {
-            emit onHeart(f["CSAFE_GETHRCUR_CMD"].value<QVariantList>()[0].toDouble());
-        }
-        if (f["CSAFE_GETCALORIES_CMD"].isValid()) {
-            emit onCalories(f["CSAFE_GETCALORIES_CMD"].value<QVariantList>()[0].toDouble());
-        }
-        if (f["CSAFE_PM_GET_WORKDISTANCE"].isValid()) {
-            emit onDistance(f["CSAFE_PM_GET_WORKDISTANCE"].value<QVariantList>()[0].toDouble());
+        if (csafe::decode(rx, 64, f)) {
+            if (f.find(csafe::CSAFE_GETCADENCE_CMD)) {
+                emit onCadence(f.value(csafe::CSAFE_GETCADENCE_CMD));
+            }
+            if (f.find(csafe::CSAFE_GETPOWER_CMD)) {
+                emit onPower(f.value(csafe::CSAFE_GETPOWER_CMD));
+            }
+            if (f.find(csafe::CSAFE_GETHRCUR_CMD)) {
+                emit onHeart(f.value(csafe::CSAFE_GETHRCUR_CMD));
+            }
+            if (f.find(csafe::CSAFE_GETCALORIES_CMD)) {
+                emit onCalories(f.value(csafe::CSAFE_GETCALORIES_CMD));
+            }
+            if (f.find(csafe::CSAFE_PM_GET_WORKDISTANCE)) {
+                emit onDistance(f.value(csafe::CSAFE_PM_GET_WORKDISTANCE));
+            }
         }
 
         memset(rx, 0x00, sizeof(rx));
@@ -0,0 +1,99 @@
+#include "devicenamematcher.h"
+
+// prefixes of the name based branches of bluetooth::deviceDiscovered, upper case
+static const char *const driverPrefixes[] = {
+    ">CABLE", "ADIDAS ", "AFG SPORT", "ASSAULT TREADMILL ", "ASSAULTRUNNER", "ASSIOMA", "B01_", "B94", "BF70", "BFCP",
+    "BH DUALKIT", "BIKE", "BKOOLSMARTPRO", "BOWFLEX T", "C7-", "C9/C10", "CARDIOFIT", "CHRONO ", "CR 00", "CT800",
+    "CTM", "D2RIDE", "DBF", "DFIT-L-R", "DHZ-", "DI", "DIRETO XR", "DK", "DKN MOTION", "DKN RUN", "DOMYOS",
+    "DOMYOS-BIKE", "DOMYOS-EL", "DOMYOS-ROW", "DOMYOSBR", "DOMYOSBRIDGE", "DS25-", "DT-", "DYNAMAX", "E25", "E35",
+    "E55", "E95", "E95S", "E98", "E98S", "ECH", "ECH-ROW", "ESANGLINKER", "ESLINKER", "EW-BK", "EW-JS-", "F63", "F65",
+    "F80", "F85", "FITHIWAY", "FLXCY-", "FLYWHEEL", "FS-", "HAMMER ", "HORIZON", "HT", "I-CONSOIE+", "I-CONSOLE+",
+    "I-ROWER", "I-RUNNING", "IBIKING+", "IC", "IC BIKE", "ICONSOLE+", "INRIDE", "I_EB", "I_EL", "I_FS", "I_IT", "I_RW",
+    "I_SB", "I_TL", "I_VE", "JFIC", "JFTM", "JFTMPARAGON", "JOROTO-BK-", "K80_", "KAYAKPRO", "KEEP_BIKE_",
+    "KETTLER TREADMILL", "KICKR BIKE", "KICKR CORE", "KICKR ROLLR", "KICKR SNAP", "KINGSMITH", "KS-BLC", "KS-H",
+    "KS-HC-R1AA", "KS-HC-R1AC", "KS-HDSC-X21C", "KS-HDSY-X21C", "KS-NACH-X21C", "KS-NGCH-X21C", "KS-R1AC",
+    "KS-ST-K12PRO", "KS-WLT", "KS-X21", "LCB", "LF", "M3", "MAGNUS ", "MATRIXTF50", "MCF-", "MD", "MEPANEL",
+    "MERACH-U3", "MKSM", "MOBVOI TM", "MRK-", "MX-TM ", "MYRUN ", "NAUTILUS B", "NAUTILUS E", "NAUTILUS T",
+    "NOBLEPRO CONNECT", "PAFERS_", "PARAGON X", "PM5", "Q37", "QB-WC01", "R-Q", "R1 PRO", "R92", "REEBOK", "ROW-S",
+    "ROWSPORT-", "RQ", "RUNNERT", "RZ_TREADMIL", "S4 COMMS", "S77", "SCH130", "SCHWINN 170/270", "SCHWINN 510T",
+    "SF-RW", "SMARTROW", "SMB1", "ST90", "STAGES ", "STAGES BIKE", "SUITO", "SW", "T01_", "T218_", "T318_", "TACX ",
+    "TACX SMART BIKE", "TF-", "THINK X", "TOORX", "TREADMILL", "TRUE", "TRX ROUTE KEY", "TRX3500", "TRX4500", "TT8",
+    "TUN ", "UBIKE FTMS", "URSB", "V-RUN", "VIFHTR2.1", "WAHOO KICKR", "WALKINGPAD", "WHIPR", "WINFITA", "WLT2541",
+    "WLT8266BM", "X-BIKE", "XBR55", "XG400", "XS08-", "XT385", "XT485", "XT800", "XT900", "YPOO-U3-", "YS_C1_",
+    "YS_G1_", "ZR7", "ZR8", "ZUMO", "ZW-", "ZWIFT HUB", "ZWIFT RUNPOD",
+    "YESOUL", // yesoulbike::bluetoothName
+};
+
+devicenamematcher::devicenamematcher() { m_nodes.append(node()); }
+
+int devicenamematcher::child(int n, QChar c) const {
+    for (const QPair<QChar, int> &e : m_nodes.at(n).children) {
+        if (e.first == c)
+            return e.second;
+    }
+    return -1;
+}
+
+void devicenamematcher::addPrefix(const QString &prefix) {
+    const QString p = prefix.toUpper();
+    int n = 0;
+    for (const QChar c : p) {
+        int next = child(n, c);
+        if (next < 0) {
+            next = m_nodes.size();
+            m_nodes.append(node());
+            m_nodes[n].children.append(qMakePair(c, next));
+        }
+        n = next;
+    }
+    m_nodes[n].terminal = true;
+}
+
+void devicenamematcher::addSuffix(const QString &suffix) { m_suffixes.append(suffix.toUpper()); }
+
+void devicenamematcher::addSubstring(const QString &substring) { m_substrings.append(substring.toUpper()); }
+
+void devicenamematcher::addExact(const QString &name) { m_exacts.append(name.toUpper()); }
+
+bool devicenamematcher::matches(const QString &name) const {
+    const QString upper = name.toUpper();
+
+    int n = 0;
+    if (m_nodes.at(n).terminal)
+        return true;
+    for (const QChar c : upper) {
+        n = child(n, c);
+        if (n < 0)
+            break;
+        if (m_nodes.at(n).terminal)
+            return true;
+    }
+
+    for (const QString &s : m_suffixes) {
+        if (upper.endsWith(s))
+            return true;
+    }
+    for (const QString &s : m_substrings) {
+        if (upper.contains(s))
+            return true;
+    }
+    for (const QString &s : m_exacts) {
+        if (upper == s)
+            return true;
+    }
+    return false;
+}
+
+const devicenamematcher &devicenamematcher::drivers() {
+    static const devicenamematcher matcher = []() {
+        devicenamematcher m;
+        for (const char *prefix : driverPrefixes)
+            m.addPrefix(QString::fromLatin1(prefix));
+        m.addSuffix(QStringLiteral("ROW"));
+        m.addSubstring(QStringLiteral("CARE"));
+        m.addSubstring(QStringLiteral("CR011R"));
+        m.addExact(QStringLiteral("RE"));
+        return m;
+    }();
+    return matcher;
+}
@@ -0,0 +1,51 @@
+#ifndef DEVICENAMEMATCHER_H
+#define DEVICENAMEMATCHER_H
+
+#include <QChar>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+/**
+ * @brief The devicenamematcher class tells, with a single walk of the advertised name, if a BLE device could be
+ * picked by one of the name based branches of bluetooth::deviceDiscovered. Prefixes are stored in a trie, so the
+ * cost doesn't grow with the number of supported devices; the few suffix, substring and exact rules are checked
+ * after it. Names are compared upper case, so the matcher is a superset of the case sensitive rules of the chain.
+ */
+class devicenamematcher {
+  public:
+    devicenamematcher();
+
+    void addPrefix(const QString &prefix);
+    void addSuffix(const QString &suffix);
+    void addSubstring(const QString &substring);
+    void addExact(const QString &name);
+
+    /**
+     * @brief matches True if the name starts with, ends with, contains or is equal to one of the registered rules.
+     */
+    bool matches(const QString &name) const;
+
+    /**
+     * @brief drivers The rules of every name based branch of bluetooth::deviceDiscovered. When a new device is added
+     * to the chain, its name rule must be added to the table in devicenamematcher.cpp too: the
+     * DeviceNameMatcherTestSuite reads the rules of the chain from bluetooth.cpp and fails on the missing ones.
+     */
+    static const devicenamematcher &drivers();
+
+  private:
+    struct node {
+        QVector<QPair<QChar, int>> children;
+        bool terminal = false;
+    };
+
+    int child(int n, QChar c) const;
+
+    QVector<node> m_nodes;
+    QStringList m_suffixes;
+    QStringList m_substrings;
+    QStringList m_exacts;
+};
+
+#endif // DEVICENAMEMATCHER_H
@@ -175,15 +175,21 @@ DirconManager::DirconManager(bluetoothdevice *Bike, uint8_t bikeResistanceOffset
         bikeTimer.start(1s);
 }
 
+// the value of each characteristic is read and encoded once per tick, all the processors write the same packet
 #define DM_CHAR_NOTIF_NOTIF1_OP(UUID, P1, P2, P3)                                                                      \
-    QByteArray all##UUID;                                                                                              \
-    int rv##UUID = notif##UUID->notify(all##UUID);
+    QByteArray all##UUID, pkt##UUID;                                                                                   \
+    if (notif##UUID->notify(all##UUID) == CN_OK)                                                                       \
+        pkt##UUID = DirconPacket::encodeNotification(0x##UUID, all##UUID);
 
 #define DM_CHAR_NOTIF_NOTIF2_OP(UUID, P1, P2, P3)                                                                      \
-    if (rv##UUID == CN_OK)                                                                                             \
-        P1->sendCharacteristicNotification(0x##UUID, all##UUID);
+    if (!pkt##UUID.isEmpty())                                                                                          \
+        P1->sendEncodedNotification(0x##UUID, pkt##UUID);
 
 void DirconManager::bikeProvider() {
+    bool clients = false;
+    foreach (DirconProcessor *processor, processors) { clients = clients || processor->hasClients(); }
+    if (!clients)
+        return;
     DM_CHAR_NOTIF_OP(DM_CHAR_NOTIF_NOTIF1_OP, 0, 0, 0)
     foreach (DirconProcessor *processor, processors) { DM_CHAR_NOTIF_OP(DM_CHAR_NOTIF_NOTIF2_OP, processor, 0, 0) }
 }
@@ -213,3 +213,12 @@ QByteArray DirconPacket::encode(int last_seq_number) {
     }
     return byteout;
 }
+
+QByteArray DirconPacket::encodeNotification(quint16 uuid, const QByteArray &data) {
+    DirconPacket pkt;
+    pkt.additional_data = data;
+    pkt.Identifier = DPKT_MSGID_UNSOLICITED_CHARACTERISTIC_NOTIFICATION;
+    pkt.ResponseCode = DPKT_RESPCODE_SUCCESS_REQUEST;
+    pkt.uuid = uuid;
+    return pkt.encode(0);
+}
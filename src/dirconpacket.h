@@ -45,6 +45,12 @@ class DirconPacket {
     DirconPacket(const DirconPacket &cp);
     DirconPacket &operator=(const DirconPacket &cp);
     QByteArray encode(int last_seq_number);
+
+    /**
+     * @brief encodeNotification Builds the unsolicited notification of a characteristic value. The result doesn't depend
+     * on the client, so it can be encoded once and written to all the subscribers.
+     */
+    static QByteArray encodeNotification(quint16 uuid, const QByteArray &data);
     int parse(const QByteArray &buf, int last_seq_number);
     operator QString() const;
 
@@ -8,7 +8,9 @@ DirconProcessor::DirconProcessor(const QList<DirconProcessorService *> &my_servi
                                  quint16 serv_port, const QString &serv_sn, const QString &my_mac, QObject *parent)
     : QObject(parent), services(my_services), mac(my_mac), serverPort(serv_port), serialN(serv_sn),
       serverName(serv_name) {
+    QSettings settings;
     qDebug() << "In the constructor of dircon processor for" << serverName;
+    notifyAll = !settings.value(QZSettings::wahoo_rgt_dircon, QZSettings::default_wahoo_rgt_dircon).toBool();
     foreach (DirconProcessorService *my_service, my_services) { my_service->setParent(this); }
 }
 
@@ -66,14 +68,14 @@ void DirconProcessor::initAdvertising() {
     }
 }
 
-bool DirconProcessor::init() {
+bool DirconProcessor::init(bool advertise) {
     qDebug() << "Dircon Processor init for" << serverName;
     bool rv = initServer();
     qDebug() << "Dircon TCP Server RV" << rv;
-    if (rv)
-        initAdvertising();
-    else
+    if (!rv)
         qDebug() << "Cannot init dircon TCP server at port" << serverPort;
+    else if (advertise)
+        initAdvertising();
     return rv;
 }
 
@@ -83,6 +85,9 @@ void DirconProcessor::tcpNewConnection() {
              << " uuid = " << serverName;
     connect(socket, SIGNAL(disconnected()), this, SLOT(tcpDisconnected()));
     connect(socket, SIGNAL(readyRead()), this, SLOT(tcpDataAvailable()));
+    connect(socket, SIGNAL(bytesWritten(qint64)), this, SLOT(tcpBytesWritten()));
+    // the notifications are small and time sensitive, don't let them wait for the ack of the previous one
+    socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
     DirconProcessorClient *client = new DirconProcessorClient(socket);
     clientsMap.insert(socket, client);
 }
@@ -198,30 +203,57 @@ DirconPacket DirconProcessor::processPacket(DirconProcessorClient *client, const
 }
 
 bool DirconProcessor::sendCharacteristicNotification(quint16 uuid, const QByteArray &data) {
-    DirconPacket pkt;
-    QTcpSocket *socket;
+    return sendEncodedNotification(uuid, DirconPacket::encodeNotification(uuid, data));
+}
+
+bool DirconProcessor::sendEncodedNotification(quint16 uuid, const QByteArray &packet) {
     DirconProcessorClient *client;
-    QSettings settings;
-    bool rv = true, rvs;
-    pkt.additional_data = data;
-    pkt.Identifier = DPKT_MSGID_UNSOLICITED_CHARACTERISTIC_NOTIFICATION;
-    pkt.ResponseCode = DPKT_RESPCODE_SUCCESS_REQUEST;
-    pkt.uuid = uuid;
+    bool rv = true;
+    int sent = 0;
     for (QHash<QTcpSocket *, DirconProcessorClient *>::iterator i = clientsMap.begin(); i != clientsMap.end(); ++i) {
         client = i.value();
-        if (client->char_notify.indexOf(uuid) >= 0 || !settings.value(QZSettings::wahoo_rgt_dircon, QZSettings::default_wahoo_rgt_dircon).toBool()) {
-            socket = i.key();
-            rvs = socket->write(pkt.encode(0)) < 0;
-            if (rvs)
+        if (notifyAll || client->char_notify.indexOf(uuid) >= 0) {
+            if (!writeNotification(client, uuid, packet))
                 rv = false;
-            qDebug() << serverName << "sending to" << socket->peerAddress().toString() << ":" << socket->peerPort()
-                     << " notification for uuid = " << QString(QStringLiteral("%1")).arg(uuid, 4, 16, QLatin1Char('0'))
-                     << "rv=" << (!rvs) << data.toHex(' ');
+            sent++;
         }
     }
+    if (sent)
+        qDebug() << serverName << "sending to" << sent << "clients notification for uuid ="
+                 << QString(QStringLiteral("%1")).arg(uuid, 4, 16, QLatin1Char('0')) << "rv=" << rv
+                 << packet.mid(DPKT_MESSAGE_HEADER_LENGTH + 16).toHex(' ');
     return rv;
 }
 
+bool DirconProcessor::writeNotification(DirconProcessorClient *client, quint16 uuid, const QByteArray &packet) {
+    if (client->sock->bytesToWrite() > DP_CLIENT_MAX_BACKLOG) {
+        // a newer value replaces the one still waiting, so a slow client doesn't fall further behind
+        if (client->pending.contains(uuid))
+            client->coalesced++;
+        client->pending.insert(uuid, packet);
+        return true;
+    }
+    client->pending.remove(uuid);
+    return client->sock->write(packet) >= 0;
+}
+
+void DirconProcessor::flushPending(DirconProcessorClient *client) {
+    while (!client->pending.isEmpty() && client->sock->bytesToWrite() <= DP_CLIENT_MAX_BACKLOG) {
+        QMap<quint16, QByteArray>::iterator first = client->pending.begin();
+        QByteArray packet = first.value();
+        client->pending.erase(first);
+        if (client->sock->write(packet) < 0)
+            break;
+    }
+}
+
+void DirconProcessor::tcpBytesWritten() {
+    QTcpSocket *socket = qobject_cast<QTcpSocket *>(sender());
+    DirconProcessorClient *client = clientsMap.value(socket);
+    if (client)
+        flushPending(client);
+}
+
 void DirconProcessor::tcpDataAvailable() {
     QTcpSocket *socket = qobject_cast<QTcpSocket *>(sender());
     DirconProcessorClient *client = clientsMap.value(socket);
@@ -246,7 +278,7 @@ void DirconProcessor::tcpDataAvailable() {
             } else
                 rembuf = -1;
             if (rembuf >= 0)
-                client->buffer = client->buffer.mid(rembuf);
+                client->buffer.remove(0, rembuf);
             if (buflimit > 0) {
                 DirconPacket resp = processPacket(client, pkt);
                 qDebug() << "Sending resp for uuid" << serverName << ":" << resp;
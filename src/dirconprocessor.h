@@ -8,6 +8,7 @@
 #include "qmdnsengine/server.h"
 #include "qmdnsengine/service.h"
 #include <QHash>
+#include <QMap>
 #include <QObject>
 #include <QTcpServer>
 #include <QTcpSocket>
@@ -58,6 +59,9 @@ class DirconProcessorService : public QObject {
 };
 
 #define DP_BASE_UUID "0000u-0000-1000-8000-00805F9B34FB"
+// above this many bytes waiting to be sent, the notifications to a client are held back and only the latest value of
+// each characteristic is kept
+#define DP_CLIENT_MAX_BACKLOG 4096
 // QString("%1").arg(iTest & 0xFFFF, 4, 16);
 
 class DirconProcessorClient : public QObject {
@@ -67,6 +71,9 @@ class DirconProcessorClient : public QObject {
     QList<quint16> char_notify;
     QTcpSocket *sock;
     QByteArray buffer;
+    // the notifications held back by the backlog, by characteristic. They share the data of the encoded packets.
+    QMap<quint16, QByteArray> pending;
+    quint32 coalesced = 0;
 };
 
 class DirconProcessor : public QObject {
@@ -81,18 +88,30 @@ class DirconProcessor : public QObject {
     QMdnsEngine::Provider *mdnsProvider = 0;
     QMdnsEngine::Hostname *mdnsHostname = 0;
     QHash<QTcpSocket *, DirconProcessorClient *> clientsMap;
+    bool notifyAll = false;
     bool initServer();
     void initAdvertising();
     DirconPacket processPacket(DirconProcessorClient *client, const DirconPacket &pkt);
+    bool writeNotification(DirconProcessorClient *client, quint16 uuid, const QByteArray &packet);
+    void flushPending(DirconProcessorClient *client);
 
   public:
     ~DirconProcessor();
     explicit DirconProcessor(const QList<DirconProcessorService *> &services, const QString &serv_name,
                              quint16 serv_port, const QString &serv_sn, const QString &mac, QObject *parent = nullptr);
     bool sendCharacteristicNotification(quint16 uuid, const QByteArray &data);
-    bool init();
+
+    /**
+     * @brief sendEncodedNotification Writes a notification built by DirconPacket::encodeNotification to the clients
+     * that subscribed to the characteristic. A client that is behind gets the latest value once its backlog is sent.
+     */
+    bool sendEncodedNotification(quint16 uuid, const QByteArray &packet);
+    bool hasClients() const { return !clientsMap.isEmpty(); }
+    quint16 port() const { return server && server->isListening() ? server->serverPort() : serverPort; }
+    bool init(bool advertise = true);
   private slots:
     void tcpDataAvailable();
+    void tcpBytesWritten();
     void tcpDisconnected();
     void tcpNewConnection();
   signals:
@@ -1,6 +1,7 @@
 #include "domyosbike.h"
 #ifdef Q_OS_ANDROID
 #include "keepawakehelper.h"
+#include "qzsettingscache.h"
 #endif
 #include "virtualbike.h"
 #include <QBluetoothLocalDevice>
@@ -24,6 +25,16 @@ domyosbike::domyosbike(bool noWriteResistance, bool noHeartService, bool testRes
     this->noHeartService = noHeartService;
     this->bikeResistanceGain = bikeResistanceGain;
     this->bikeResistanceOffset = bikeResistanceOffset;
+    setPowerCurve([this](double resistance, double cadence) { return wattsFromResistance(resistance, cadence); });
+    // the curve depends on the profile: the table is built again when it's changed
+    profileV1 = qzsettingscache::get().domyos_bike_500_profile_v1;
+    connect(qzsettingscache::instance(), &qzsettingscache::changed, this, [this]() {
+        bool v1 = qzsettingscache::get().domyos_bike_500_profile_v1;
+        if (v1 != profileV1) {
+            profileV1 = v1;
+            powerTable.invalidate();
+        }
+    });
 
     initDone = false;
     connect(refresh, &QTimer::timeout, this, &domyosbike::update);
@@ -655,46 +666,39 @@ resistance_t domyosbike::pelotonToBikeResistance(int pelotonResistance) {
 resistance_t domyosbike::resistanceFromPowerRequest(uint16_t power) {
     qDebug() << QStringLiteral("resistanceFromPowerRequest") << currentCadence().value();
 
-    for (resistance_t i = 1; i < max_resistance; i++) {
-        if (wattsFromResistance(i) <= power && wattsFromResistance(i + 1) >= power) {
-            return i;
-        }
-    }
-    if (power < wattsFromResistance(1))
-        return 1;
-    else
-        return max_resistance;
+    return resistanceFromPowerCurve(power);
 }
 
-uint16_t domyosbike::wattsFromResistance(double resistance) {
-    QSettings settings;
-    if (!settings.value(QZSettings::domyos_bike_500_profile_v1, QZSettings::default_domyos_bike_500_profile_v1)
-             .toBool() ||
-        resistance < 8)
-        return ((10.39 + 1.45 * (resistance - 1.0)) * (exp(0.028 * (currentCadence().value()))));
+double domyosbike::wattsFromResistance(double resistance, double cadence) {
+    if (!profileV1 || resistance < 8)
+        return ((10.39 + 1.45 * (resistance - 1.0)) * (exp(0.028 * cadence)));
     else {
         switch ((int)resistance) {
         case 8:
-            return (13.6 * Cadence.value()) / 9.5488;
+            return (13.6 * cadence) / 9.5488;
         case 9:
-            return (15.3 * Cadence.value()) / 9.5488;
+            return (15.3 * cadence) / 9.5488;
         case 10:
-            return (17.3 * Cadence.value()) / 9.5488;
+            return (17.3 * cadence) / 9.5488;
         case 11:
-            return (19.8 * Cadence.value()) / 9.5488;
+            return (19.8 * cadence) / 9.5488;
         case 12:
-            return (22.5 * Cadence.value()) / 9.5488;
+            return (22.5 * cadence) / 9.5488;
         case 13:
-            return (25.6 * Cadence.value()) / 9.5488;
+            return (25.6 * cadence) / 9.5488;
         case 14:
-            return (28.4 * Cadence.value()) / 9.5488;
+            return (28.4 * cadence) / 9.5488;
         case 15:
-            return (35.9 * Cadence.value()) / 9.5488;
+            return (35.9 * cadence) / 9.5488;
         }
-        return ((10.39 + 1.45 * (resistance - 1.0)) * (exp(0.028 * (currentCadence().value()))));
+        return ((10.39 + 1.45 * (resistance - 1.0)) * (exp(0.028 * cadence)));
     }
 }
 
+uint16_t domyosbike::wattsFromResistance(double resistance) {
+    return wattsFromResistance(resistance, currentCadence().value());
+}
+
 uint16_t domyosbike::watts() {
     double v = 0;
     // const resistance_t max_resistance = 15;
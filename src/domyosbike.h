@@ -50,6 +50,7 @@ class domyosbike : public bike {
     double GetKcalFromPacket(const QByteArray &packet);
     double GetDistanceFromPacket(const QByteArray &packet);
     uint16_t wattsFromResistance(double resistance);
+    double wattsFromResistance(double resistance, double cadence);
     void forceResistance(resistance_t requestResistance);
     void updateDisplay(uint16_t elapsed);
     void btinit_changyow(bool startTape);
@@ -60,6 +61,7 @@ class domyosbike : public bike {
     uint16_t watts() override;
 
     const resistance_t max_resistance = 15;
+    bool profileV1 = false;
     QTimer *refresh;
     uint8_t firstVirtual = 0;
     uint8_t firstStateChanged = 0;
@@ -95,8 +95,8 @@ void elliptical::changeInclination(double grade, double inclination) {
 }
 double elliptical::currentCrankRevolutions() { return CrankRevs; }
 uint16_t elliptical::lastCrankEventTime() { return LastCrankEventTime; }
-metric elliptical::currentResistance() { return Resistance; }
-metric elliptical::currentInclination() { return Inclination; }
+const metric &elliptical::currentResistance() { return Resistance; }
+const metric &elliptical::currentInclination() { return Inclination; }
 uint8_t elliptical::fanSpeed() { return FanSpeed; }
 bool elliptical::connected() { return false; }
 
@@ -156,8 +156,8 @@ void elliptical::changeSpeed(double speed) {
     if (autoResistanceEnable)
         requestSpeed = speed;
 }
-metric elliptical::lastRequestedCadence() { return RequestedCadence; }
-metric elliptical::pelotonResistance() { return m_pelotonResistance; }
-metric elliptical::lastRequestedPelotonResistance() { return RequestedPelotonResistance; }
-metric elliptical::lastRequestedResistance() { return RequestedResistance; }
+const metric &elliptical::lastRequestedCadence() { return RequestedCadence; }
+const metric &elliptical::pelotonResistance() { return m_pelotonResistance; }
+const metric &elliptical::lastRequestedPelotonResistance() { return RequestedPelotonResistance; }
+const metric &elliptical::lastRequestedResistance() { return RequestedResistance; }
 bool elliptical::inclinationAvailableByHardware() { return true; }
@@ -8,19 +8,19 @@ class elliptical : public bluetoothdevice {
 
   public:
     elliptical();
-    metric lastRequestedPelotonResistance();
+    const metric &lastRequestedPelotonResistance();
     void update_metrics(bool watt_calc, const double watts);
-    metric lastRequestedCadence();
-    metric lastRequestedResistance();
-    metric lastRequestedSpeed() { return RequestedSpeed; }
-    metric currentInclination() override;
-    metric currentResistance() override;
+    const metric &lastRequestedCadence();
+    const metric &lastRequestedResistance();
+    const metric &lastRequestedSpeed() { return RequestedSpeed; }
+    const metric &currentInclination() override;
+    const metric &currentResistance() override;
     virtual double requestedSpeed();
     uint8_t fanSpeed() override;
     double currentCrankRevolutions() override;
     uint16_t lastCrankEventTime() override;
     bool connected() override;
-    metric pelotonResistance();
+    const metric &pelotonResistance();
     virtual int pelotonToEllipticalResistance(int pelotonResistance);
     virtual bool inclinationAvailableByHardware();
     bluetoothdevice::BLUETOOTH_TYPE deviceType() override;
@@ -0,0 +1,140 @@
+#include "ergtable.h"
+
+#include <algorithm>
+#include <cmath>
+
+ergtable::ergtable(double maxCadence, double cadenceStep) : maxCadence(maxCadence), cadenceStep(cadenceStep) {}
+
+void ergtable::setModel(const model &watts) {
+    curve = watts;
+    built = false;
+}
+
+void ergtable::setRange(resistance_t minResistance, resistance_t maxResistance) {
+    if (maxResistance < minResistance)
+        maxResistance = minResistance;
+    if (minResistance == this->minResistance && maxResistance == this->maxResistance)
+        return;
+    this->minResistance = minResistance;
+    this->maxResistance = maxResistance;
+    built = false;
+}
+
+void ergtable::setCorrection(double gain, double offset) {
+    // a gain of 0 or less would turn the curve upside down
+    this->gain = gain > 0 ? gain : 1.0;
+    this->offset = offset;
+}
+
+bool ergtable::build() {
+    if (built)
+        return true;
+    if (!curve)
+        return false;
+
+    rows = (int)std::round(maxCadence / cadenceStep) + 1;
+    columns = maxResistance - minResistance + 1;
+    table.resize(rows * columns);
+    for (int r = 0; r < rows; r++) {
+        double cadence = r * cadenceStep;
+        for (int c = 0; c < columns; c++) {
+            double w = curve(minResistance + c, cadence);
+            if (!std::isfinite(w) || w < 0)
+                w = 0;
+            // a level never gives less power than the one before
+            if (c > 0 && w < at(r, c - 1))
+                w = at(r, c - 1);
+            at(r, c) = w;
+        }
+    }
+    curveTable = table;
+    built = true;
+    return true;
+}
+
+void ergtable::position(double cadence, int &row, double &fraction) const {
+    double p = cadence / cadenceStep;
+    if (!(p > 0)) {
+        row = 0;
+        fraction = 0;
+    } else if (p >= rows - 1) {
+        row = rows - 1;
+        fraction = 0;
+    } else {
+        row = (int)p;
+        fraction = p - row;
+    }
+}
+
+double ergtable::interpolated(int row, double fraction, int column) const {
+    double w = at(row, column);
+    if (fraction > 0)
+        w += (at(row + 1, column) - w) * fraction;
+    return w;
+}
+
+double ergtable::watts(resistance_t resistance, double cadence) {
+    if (!build())
+        return 0;
+    if (resistance < minResistance)
+        resistance = minResistance;
+    else if (resistance > maxResistance)
+        resistance = maxResistance;
+    int row;
+    double fraction;
+    position(cadence, row, fraction);
+    return (interpolated(row, fraction, resistance - minResistance) * gain) + offset;
+}
+
+resistance_t ergtable::resistance(double watts, double cadence) {
+    if (!build())
+        return minResistance;
+    int row;
+    double fraction;
+    position(cadence, row, fraction);
+    double w = (watts - offset) / gain;
+
+    // the first level that reaches the watts: the one before is the answer
+    int lo = 1, hi = columns;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (interpolated(row, fraction, mid) >= w)
+            hi = mid;
+        else
+            lo = mid + 1;
+    }
+    if (lo == columns)
+        return maxResistance;
+    return minResistance + lo - 1;
+}
+
+void ergtable::observe(resistance_t resistance, double cadence, double watts, double weight) {
+    if (!built || cadence <= 0 || resistance < minResistance || resistance > maxResistance)
+        return;
+    int row;
+    double fraction;
+    position(cadence, row, fraction);
+    int column = resistance - minResistance;
+    double error = ((watts - offset) / gain) - interpolated(row, fraction, column);
+
+    // the two rows around the cadence share the correction as they share the interpolation, scaled so that the
+    // interpolated power moves by weight * error
+    double step = error * weight / (((1.0 - fraction) * (1.0 - fraction)) + (fraction * fraction));
+    learn(row, column, step * (1.0 - fraction));
+    if (fraction > 0)
+        learn(row + 1, column, step * fraction);
+}
+
+void ergtable::learn(int row, int column, double step) {
+    // the curve is monotonic along a row, so are the bounds: keepMonotonic() can't push a cell out of its own
+    double curve = curveTable[row * columns + column];
+    at(row, column) = std::min(std::max(at(row, column) + step, curve * (1.0 - maxDrift)), curve * (1.0 + maxDrift));
+    keepMonotonic(row, column);
+}
+
+void ergtable::keepMonotonic(int row, int column) {
+    for (int c = column + 1; c < columns && at(row, c) < at(row, c - 1); c++)
+        at(row, c) = at(row, c - 1);
+    for (int c = column - 1; c >= 0 && at(row, c) > at(row, c + 1); c--)
+        at(row, c) = at(row, c + 1);
+}
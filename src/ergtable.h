@@ -0,0 +1,102 @@
+#ifndef ERGTABLE_H
+#define ERGTABLE_H
+
+#include "definitions.h"
+#include <QVector>
+#include <functional>
+
+/**
+ * @brief The ergtable class answers the ERG lookups of a bike from a cadence x resistance power table.
+ *
+ * The driver declares its curve once, the watts at a resistance level and a cadence, and the table is built from it
+ * the first time it's needed, every cadenceStep rpm up to maxCadence. The lookups interpolate between the two cadence
+ * rows around the current cadence, and the resistance for a power is a binary search in that row, so they don't
+ * evaluate the curve anymore. Along a row the power never decreases with the resistance: the table is built that
+ * way, whatever the curve. The readings of a power meter can refine the table with observe(), within maxDrift of
+ * the curve.
+ * What observe() learned is kept only as long as the table: setRange() with other levels, setModel() and invalidate()
+ * build it again from the curve.
+ */
+class ergtable {
+
+  public:
+    typedef std::function<double(double resistance, double cadence)> model;
+
+    /**
+     * @param maxCadence The last row of the table, the lookups above use it. Unit: rpm
+     * @param cadenceStep The cadence between two rows. Unit: rpm
+     */
+    explicit ergtable(double maxCadence = 200.0, double cadenceStep = 5.0);
+
+    /**
+     * @brief setModel Declares the curve. The table is built again on the next lookup.
+     */
+    void setModel(const model &watts);
+    bool hasModel() const { return (bool)curve; }
+
+    /**
+     * @brief setRange The resistance levels of the bike. The table is built again if they change, and what observe()
+     * learned is lost.
+     */
+    void setRange(resistance_t minResistance, resistance_t maxResistance);
+
+    /**
+     * @brief setCorrection The watts the lookups deal with are the ones of the curve * gain + offset, like the
+     * watt_gain and watt_offset settings do with the power of the bike.
+     */
+    void setCorrection(double gain, double offset);
+
+    /**
+     * @brief watts The power at a resistance level and a cadence.
+     */
+    double watts(resistance_t resistance, double cadence);
+
+    /**
+     * @brief resistance The level whose power, at this cadence, is the closest below the watts requested. The lowest
+     * level if the watts are below the curve, the highest one if they are above.
+     */
+    resistance_t resistance(double watts, double cadence);
+
+    /**
+     * @brief observe Moves the table towards the power measured at a resistance level and a cadence. A cell never
+     * goes further than maxDrift from the curve, so a power meter that reads wrong, or a resistance the bike didn't
+     * apply yet, can't drag the table away.
+     * @param weight How much of the difference is corrected, from 0 to 1.
+     */
+    void observe(resistance_t resistance, double cadence, double watts, double weight = 0.1);
+
+    /**
+     * @brief invalidate Builds the table again on the next lookup, e.g. when a setting the curve depends on changes.
+     * What observe() learned is lost.
+     */
+    void invalidate() { built = false; }
+
+    /**
+     * @brief maxDrift How far observe() can move a cell from the curve: 0.5 is from half to one and a half times it.
+     */
+    static constexpr double maxDrift = 0.5;
+
+  private:
+    bool build();
+    double at(int row, int column) const { return table[row * columns + column]; }
+    double &at(int row, int column) { return table[row * columns + column]; }
+    void position(double cadence, int &row, double &fraction) const;
+    double interpolated(int row, double fraction, int column) const;
+    void keepMonotonic(int row, int column);
+    void learn(int row, int column, double step);
+
+    model curve;
+    double maxCadence;
+    double cadenceStep;
+    double gain = 1.0;
+    double offset = 0.0;
+    resistance_t minResistance = 1;
+    resistance_t maxResistance = 1;
+    int rows = 0;
+    int columns = 0;
+    bool built = false;
+    QVector<double> table;
+    QVector<double> curveTable;
+};
+
+#endif // ERGTABLE_H
@@ -36,6 +36,7 @@ fitplusbike::fitplusbike(bool noWriteResistance, bool noHeartService, uint8_t bi
     this->noHeartService = noHeartService;
     this->bikeResistanceGain = bikeResistanceGain;
     this->bikeResistanceOffset = bikeResistanceOffset;
+    setPowerCurve([this](double resistance, double cadence) { return wattsFromResistance(resistance, cadence); });
     initDone = false;
     connect(refresh, &QTimer::timeout, this, &fitplusbike::update);
     refresh->start(200ms);
@@ -980,7 +981,7 @@ void fitplusbike::controllerStateChanged(QLowEnergyController::ControllerState s
     }
 }
 
-uint16_t fitplusbike::wattsFromResistance(double resistance) {
+double fitplusbike::wattsFromResistance(double resistance, double cadence) {
     // https://github.com/cagnulein/qdomyos-zwift/issues/62#issuecomment-736913564
     /*if(currentCadence().value() < 90)
         return (uint16_t)((3.59 * exp(0.0217 * (double)(currentCadence().value()))) * exp(0.095 *
@@ -1019,12 +1020,12 @@ uint16_t fitplusbike::wattsFromResistance(double resistance) {
             level = wattTableFirstDimension - 1;
         }
         double *watts_of_level = wattTable[level];
-        int watt_setp = (Cadence.value() / 10.0);
+        int watt_setp = (cadence / 10.0);
         if (watt_setp >= 10) {
-            return (((double)Cadence.value()) / 100.0) * watts_of_level[wattTableSecondDimension - 1];
+            return (cadence / 100.0) * watts_of_level[wattTableSecondDimension - 1];
         }
         double watt_base = watts_of_level[watt_setp];
-        return (((watts_of_level[watt_setp + 1] - watt_base) / 10.0) * ((double)(((int)(Cadence.value())) % 10))) +
+        return (((watts_of_level[watt_setp + 1] - watt_base) / 10.0) * ((double)(((int)cadence) % 10))) +
                watt_base;
     } else {
         // VirtuFit Etappe 2.0i Spinbike ERG Table #1526
@@ -1065,31 +1066,25 @@ uint16_t fitplusbike::wattsFromResistance(double resistance) {
             level = wattTableFirstDimension - 1;
         }
         double *watts_of_level = wattTable[level];
-        int watt_setp = (Cadence.value() / 10.0);
+        int watt_setp = (cadence / 10.0);
         if (watt_setp >= 10) {
-            return (((double)Cadence.value()) / 100.0) * watts_of_level[wattTableSecondDimension - 1];
+            return (cadence / 100.0) * watts_of_level[wattTableSecondDimension - 1];
         }
         double watt_base = watts_of_level[watt_setp];
-        return (((watts_of_level[watt_setp + 1] - watt_base) / 10.0) * ((double)(((int)(Cadence.value())) % 10))) +
+        return (((watts_of_level[watt_setp + 1] - watt_base) / 10.0) * ((double)(((int)cadence) % 10))) +
                watt_base;
     }
 }
 
+uint16_t fitplusbike::wattsFromResistance(double resistance) {
+    return wattsFromResistance(resistance, currentCadence().value());
+}
+
 resistance_t fitplusbike::resistanceFromPowerRequest(uint16_t power) {
     qDebug() << QStringLiteral("resistanceFromPowerRequest") << Cadence.value();
 
     if (Cadence.value() == 0)
         return 1;
 
-    for (resistance_t i = 1; i < max_resistance; i++) {
-        if (wattsFromResistance(i) <= power && wattsFromResistance(i + 1) >= power) {
-            qDebug() << QStringLiteral("resistanceFromPowerRequest") << wattsFromResistance(i)
-                     << wattsFromResistance(i + 1) << power;
-            return i;
-        }
-    }
-    if (power < wattsFromResistance(1))
-        return 1;
-    else
-        return max_resistance;
+    return resistanceFromPowerCurve(power);
 }
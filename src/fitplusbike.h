@@ -51,6 +51,7 @@ class fitplusbike : public bike {
     void sendPoll();
     uint16_t watts() override;
     uint16_t wattsFromResistance(double resistance);
+    double wattsFromResistance(double resistance, double cadence);
 
     QTimer *refresh;
 
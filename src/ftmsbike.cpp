@@ -1,4 +1,5 @@
 #include "ftmsbike.h"
+#include "qzsettingscache.h"
 #include "virtualbike.h"
 #include <QBluetoothLocalDevice>
 #include <QDateTime>
@@ -32,38 +33,21 @@ ftmsbike::ftmsbike(bool noWriteResistance, bool noHeartService, uint8_t bikeResi
     this->bikeResistanceOffset = bikeResistanceOffset;
     initDone = false;
     connect(refresh, &QTimer::timeout, this, &ftmsbike::update);
+    connect(writeQueue(), &blewritequeue::debug, this, &ftmsbike::debug);
     refresh->start(200ms);
 }
 
 void ftmsbike::writeCharacteristic(uint8_t *data, uint8_t data_len, const QString &info, bool disable_log,
                                    bool wait_for_response) {
-    QEventLoop loop;
-    QTimer timeout;
-    if (wait_for_response) {
-        connect(gattFTMSService, &QLowEnergyService::characteristicChanged, &loop, &QEventLoop::quit);
-        timeout.singleShot(300ms, &loop, &QEventLoop::quit);
-    } else {
-        connect(gattFTMSService, &QLowEnergyService::characteristicWritten, &loop, &QEventLoop::quit);
-        timeout.singleShot(300ms, &loop, &QEventLoop::quit);
-    }
-
-    if (writeBuffer) {
-        delete writeBuffer;
-    }
-    writeBuffer = new QByteArray((const char *)data, data_len);
-
-    if (gattWriteCharControlPointId.properties() & QLowEnergyCharacteristic::WriteNoResponse) {
-        gattFTMSService->writeCharacteristic(gattWriteCharControlPointId, *writeBuffer,
-                                             QLowEnergyService::WriteWithoutResponse);
-    } else {
-        gattFTMSService->writeCharacteristic(gattWriteCharControlPointId, *writeBuffer);
-    }
-
-    if (!disable_log) {
-        emit debug(QStringLiteral(" >> ") + writeBuffer->toHex(' ') + QStringLiteral(" // ") + info);
+    // a newer setpoint of the same kind replaces the one still waiting in the queue
+    int coalesceKey = -1;
+    if (data_len > 0 && (data[0] == FTMS_SET_INDOOR_BIKE_SIMULATION_PARAMS || data[0] == FTMS_SET_TARGET_POWER ||
+                         data[0] == FTMS_SET_TARGET_RESISTANCE_LEVEL)) {
+        coalesceKey = data[0];
     }
 
-    loop.exec();
+    writeQueue()->enqueue(gattFTMSService, gattWriteCharControlPointId, QByteArray((const char *)data, data_len), info,
+                          disable_log, wait_for_response, coalesceKey);
 }
 
 void ftmsbike::init() {
@@ -192,19 +176,25 @@ void ftmsbike::serviceDiscovered(const QBluetoothUuid &gatt) {
 
 void ftmsbike::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
-    Q_UNUSED(characteristic);
-    QSettings settings;
-    QString heartRateBeltName =
-        settings.value(QZSettings::heart_rate_belt_name, QZSettings::default_heart_rate_belt_name).toString();
-    bool disable_hr_frommachinery =
-        settings.value(QZSettings::heart_ignore_builtin, QZSettings::default_heart_ignore_builtin).toBool();
+    parseNotification(characteristic.uuid(), newValue);
+}
+
+bool ftmsbike::replayNotification(const QBluetoothUuid &uuid, const QByteArray &value) {
+    parseNotification(uuid, value);
+    return true;
+}
+
+void ftmsbike::parseNotification(const QBluetoothUuid &uuid, const QByteArray &newValue) {
+    const qzsettingscache::snapshot &settings = qzsettingscache::get();
+    QString heartRateBeltName = settings.heart_rate_belt_name;
+    bool disable_hr_frommachinery = settings.heart_ignore_builtin;
     bool heart = false;
 
-    qDebug() << characteristic.uuid() << QStringLiteral(" << ") << newValue.toHex(' ');
+    qDebug() << uuid << QStringLiteral(" << ") << newValue.toHex(' ');
 
     lastPacket = newValue;
 
-    if (characteristic.uuid() == QBluetoothUuid((quint16)0x2AD2)) {
+    if (uuid == QBluetoothUuid((quint16)0x2AD2)) {
 
         union flags {
             struct {
@@ -233,7 +223,7 @@ void ftmsbike::characteristicChanged(const QLowEnergyCharacteristic &characteris
         index += 2;
 
         if (!Flags.moreData) {
-            if (!settings.value(QZSettings::speed_power_based, QZSettings::default_speed_power_based).toBool()) {
+            if (!settings.speed_power_based) {
                 Speed = ((double)(((uint16_t)((uint8_t)newValue.at(index + 1)) << 8) |
                                   (uint16_t)((uint8_t)newValue.at(index)))) /
                         100.0;
@@ -256,9 +246,7 @@ void ftmsbike::characteristicChanged(const QLowEnergyCharacteristic &characteris
         }
 
         if (Flags.instantCadence) {
-            if (settings.value(QZSettings::cadence_sensor_name, QZSettings::default_cadence_sensor_name)
-                    .toString()
-                    .startsWith(QStringLiteral("Disabled"))) {
+            if (settings.cadence_sensor_disabled) {
                 Cadence = ((double)(((uint16_t)((uint8_t)newValue.at(index + 1)) << 8) |
                                     (uint16_t)((uint8_t)newValue.at(index)))) /
                           2.0;
@@ -316,8 +304,8 @@ void ftmsbike::characteristicChanged(const QLowEnergyCharacteristic &characteris
                                                       (ac * pow(Cadence.value(), 2.0) + bc * Cadence.value() + cc)))) -
                        br) /
                       (2.0 * ar)) *
-                     settings.value(QZSettings::peloton_gain, QZSettings::default_peloton_gain).toDouble()) +
-                    settings.value(QZSettings::peloton_offset, QZSettings::default_peloton_offset).toDouble();
+                     settings.peloton_gain) +
+                    settings.peloton_offset;
                 if (!resistance_received) {
                     Resistance = m_pelotonResistance;
                     emit resistanceRead(Resistance.value());
@@ -327,9 +315,7 @@ void ftmsbike::characteristicChanged(const QLowEnergyCharacteristic &characteris
    
 
         if (Flags.instantPower) {
-            if (settings.value(QZSettings::power_sensor_name, QZSettings::default_power_sensor_name)
-                    .toString()
-                    .startsWith(QStringLiteral("Disabled")))
+            if (settings.power_sensor_disabled)
                 m_watt = ((double)(((uint16_t)((uint8_t)newValue.at(index + 1)) << 8) |
                                    (uint16_t)((uint8_t)newValue.at(index))));
             index += 2;
@@ -357,7 +343,7 @@ void ftmsbike::characteristicChanged(const QLowEnergyCharacteristic &characteris
         } else {
             if (watts())
                 KCal += ((((0.048 * ((double)watts()) + 1.19) *
-                           settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
+                           settings.weight * 3.5) /
                           200.0) /
                          (60000.0 /
                           ((double)lastRefreshCharacteristicChanged.msecsTo(
@@ -368,7 +354,7 @@ void ftmsbike::characteristicChanged(const QLowEnergyCharacteristic &characteris
         emit debug(QStringLiteral("Current KCal: ") + QString::number(KCal.value()));
 
 #ifdef Q_OS_ANDROID
-        if (settings.value(QZSettings::ant_heart, QZSettings::default_ant_heart).toBool())
+        if (settings.ant_heart)
             Heart = (uint8_t)KeepAwakeHelper::heart();
         else
 #endif
@@ -394,7 +380,7 @@ void ftmsbike::characteristicChanged(const QLowEnergyCharacteristic &characteris
         if (Flags.remainingTime) {
             // todo
         }
-    } else if (characteristic.uuid() == QBluetoothUuid((quint16)0x2ACE)) {
+    } else if (uuid == QBluetoothUuid((quint16)0x2ACE)) {
         union flags {
             struct {
                 uint32_t moreData : 1;
@@ -425,7 +411,7 @@ void ftmsbike::characteristicChanged(const QLowEnergyCharacteristic &characteris
         index += 3;
 
         if (!Flags.moreData) {
-            if (!settings.value(QZSettings::speed_power_based, QZSettings::default_speed_power_based).toBool()) {
+            if (!settings.speed_power_based) {
                 Speed = ((double)(((uint16_t)((uint8_t)newValue.at(index + 1)) << 8) |
                                   (uint16_t)((uint8_t)newValue.at(index)))) /
                         100.0;
@@ -461,9 +447,7 @@ void ftmsbike::characteristicChanged(const QLowEnergyCharacteristic &characteris
         emit debug(QStringLiteral("Current Distance: ") + QString::number(Distance.value()));
 
         if (Flags.stepCount) {
-            if (settings.value(QZSettings::cadence_sensor_name, QZSettings::default_cadence_sensor_name)
-                    .toString()
-                    .startsWith(QStringLiteral("Disabled"))) {
+            if (settings.cadence_sensor_disabled) {
                 Cadence = ((double)(((uint16_t)((uint8_t)newValue.at(index + 1)) << 8) |
                                     (uint16_t)((uint8_t)newValue.at(index))));
             }
@@ -509,17 +493,15 @@ void ftmsbike::characteristicChanged(const QLowEnergyCharacteristic &characteris
                                                       (ac * pow(Cadence.value(), 2.0) + bc * Cadence.value() + cc)))) -
                        br) /
                       (2.0 * ar)) *
-                     settings.value(QZSettings::peloton_gain, QZSettings::default_peloton_gain).toDouble()) +
-                    settings.value(QZSettings::peloton_offset, QZSettings::default_peloton_offset).toDouble();
+                     settings.peloton_gain) +
+                    settings.peloton_offset;
                 Resistance = m_pelotonResistance;
                 emit resistanceRead(Resistance.value());
             }
         }
 
         if (Flags.instantPower) {
-            if (settings.value(QZSettings::power_sensor_name, QZSettings::default_power_sensor_name)
-                    .toString()
-                    .startsWith(QStringLiteral("Disabled")))
+            if (settings.power_sensor_disabled)
                 m_watt = ((double)(((uint16_t)((uint8_t)newValue.at(index + 1)) << 8) |
                                    (uint16_t)((uint8_t)newValue.at(index))));
             emit debug(QStringLiteral("Current Watt: ") + QString::number(m_watt.value()));
@@ -547,7 +529,7 @@ void ftmsbike::characteristicChanged(const QLowEnergyCharacteristic &characteris
         } else {
             if (watts())
                 KCal += ((((0.048 * ((double)watts()) + 1.19) *
-                           settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
+                           settings.weight * 3.5) /
                           200.0) /
                          (60000.0 /
                           ((double)lastRefreshCharacteristicChanged.msecsTo(
@@ -558,7 +540,7 @@ void ftmsbike::characteristicChanged(const QLowEnergyCharacteristic &characteris
         emit debug(QStringLiteral("Current KCal: ") + QString::number(KCal.value()));
 
 #ifdef Q_OS_ANDROID
-        if (settings.value(QZSettings::ant_heart, QZSettings::default_ant_heart).toBool())
+        if (settings.ant_heart)
             Heart = (uint8_t)KeepAwakeHelper::heart();
         else
 #endif
@@ -615,7 +597,7 @@ void ftmsbike::characteristicChanged(const QLowEnergyCharacteristic &characteris
     emit debug(QStringLiteral("Current CrankRevs: ") + QString::number(CrankRevs));
     emit debug(QStringLiteral("Last CrankEventTime: ") + QString::number(LastCrankEventTime));
 
-    if (m_control->error() != QLowEnergyController::NoError) {
+    if (m_control && m_control->error() != QLowEnergyController::NoError) {
         qDebug() << QStringLiteral("QLowEnergyController ERROR!!") << m_control->errorString();
     }
 }
@@ -782,12 +764,7 @@ void ftmsbike::ftmsCharacteristicChanged(const QLowEnergyCharacteristic &charact
             }
         }
 
-        if (writeBuffer) {
-            delete writeBuffer;
-        }
-        writeBuffer = new QByteArray(b);
-
-        gattFTMSService->writeCharacteristic(gattWriteCharControlPointId, *writeBuffer);
+        writeCharacteristic((uint8_t *)b.data(), b.length(), QStringLiteral("routed from virtualbike"));
     }
 }
 
@@ -72,8 +72,10 @@ class ftmsbike : public bike {
     bool connected() override;
     resistance_t pelotonToBikeResistance(int pelotonResistance) override;
     resistance_t maxResistance() override { return max_resistance; }
+    bool replayNotification(const QBluetoothUuid &uuid, const QByteArray &value) override;
 
   private:
+    void parseNotification(const QBluetoothUuid &uuid, const QByteArray &newValue);
     void writeCharacteristic(uint8_t *data, uint8_t data_len, const QString &info, bool disable_log = false,
                              bool wait_for_response = false);
     void startDiscover();
@@ -0,0 +1,81 @@
+#ifndef GATTLAYOUT_H
+#define GATTLAYOUT_H
+
+#include <QByteArray>
+
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @brief The gattuint24 struct names the 24 bit fields of a layout, like the FTMS total distance. Its value is
+ * passed as an uint32_t and the high byte is dropped.
+ */
+struct gattuint24 {};
+
+namespace gattdetail {
+
+template <typename T> struct field {
+    typedef T value_type;
+    typedef typename std::make_unsigned<T>::type bits;
+    static const int size = sizeof(T);
+};
+
+template <> struct field<gattuint24> {
+    typedef uint32_t value_type;
+    typedef uint32_t bits;
+    static const int size = 3;
+};
+
+template <typename... Fields> struct writer;
+
+template <> struct writer<> {
+    static const int size = 0;
+    static void write(char *) {}
+};
+
+template <typename F, typename... Rest> struct writer<F, Rest...> {
+    static const int size = field<F>::size + writer<Rest...>::size;
+
+    static void write(char *out, typename field<F>::value_type value,
+                      typename field<Rest>::value_type... rest) {
+        typename field<F>::bits bits = static_cast<typename field<F>::bits>(value);
+        for (int i = 0; i < field<F>::size; i++)
+            out[i] = (char)((bits >> (8 * i)) & 0xFF);
+        writer<Rest...>::write(out + field<F>::size, rest...);
+    }
+};
+
+} // namespace gattdetail
+
+/**
+ * @brief The gattlayout class describes a GATT characteristic value (FTMS, CPS, CSC, HRM...) at compile time: the
+ * template arguments are its fields in order, uint8_t, int8_t, uint16_t, int16_t, uint32_t or gattuint24, all
+ * little endian as the Bluetooth specs want them. The size of the value is known at compile time, so write() fills
+ * a stack buffer in one pass and append() adds it to a QByteArray with a single copy, instead of growing the array
+ * byte by byte.
+ * For instance the heart rate measurement with an 8 bit value:
+ *     typedef gattlayout<uint8_t, uint8_t> heartRateMeasurement;
+ *     heartRateMeasurement::append(value, 0x00, bpm);
+ */
+template <typename... Fields> class gattlayout {
+  public:
+    static const int size = gattdetail::writer<Fields...>::size;
+
+    /**
+     * @brief write Writes the fields in out, which has room for size bytes.
+     */
+    static void write(char *out, typename gattdetail::field<Fields>::value_type... values) {
+        gattdetail::writer<Fields...>::write(out, values...);
+    }
+
+    /**
+     * @brief append Appends the fields to out, reallocating it at most once.
+     */
+    static void append(QByteArray &out, typename gattdetail::field<Fields>::value_type... values) {
+        char buffer[size];
+        write(buffer, values...);
+        out.append(buffer, size);
+    }
+};
+
+#endif // GATTLAYOUT_H
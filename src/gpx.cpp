@@ -1,56 +1,230 @@
 #include "gpx.h"
 #include "math.h"
 #include "qdebugfixup.h"
-#include <QDomDocument>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
 #include <QSettings>
+#include <QStandardPaths>
+#include <QXmlStreamReader>
 #include <QXmlStreamWriter>
+#include <cstring>
+#include <limits>
 
 gpx::gpx(QObject *parent) : QObject(parent) {}
 
+const qint64 gpx_point::invalidTime = std::numeric_limits<qint64>::min();
+
+qint64 gpx_point::secsTo(const gpx_point &other) const {
+    if (time == invalidTime || other.time == invalidTime)
+        return 0;
+    return (other.time - time) / 1000;
+}
+
+// the layout of the processed route files: the header, the video url and the points
+static const char cacheMagic[4] = {'Q', 'Z', 'R', 'T'};
+static const quint32 cacheVersion = 2;
+
+struct cacheheader {
+    char magic[4];
+    quint32 version;
+    quint32 pointSize;
+    quint32 count;
+    quint32 videoUrlSize;
+    quint32 reserved;
+};
+
+// a point is stored field by field, in the byte order of the device, so the padding of the class isn't written
+static const int cachePointSize = sizeof(uint64_t) + 3 * sizeof(float) + 4 * sizeof(double);
+
+template <typename T> static void putField(char *&out, const T &value) {
+    memcpy(out, &value, sizeof(value));
+    out += sizeof(value);
+}
+
+template <typename T> static void getField(const uchar *&in, T &value) {
+    memcpy(&value, in, sizeof(value));
+    in += sizeof(value);
+}
+
+const int gpx::maxCachedRoutes;
+
 QList<gpx_altitude_point_for_treadmill> gpx::open(const QString &gpx) {
     QSettings settings;
-    const double meter_limit_for_auto_loop = 300;
     bool treadmill_force_speed =
         settings.value(QZSettings::treadmill_force_speed, QZSettings::default_treadmill_force_speed).toBool();
     bool gpx_loop = settings.value(QZSettings::gpx_loop, QZSettings::default_gpx_loop).toBool();
+
+    QList<gpx_altitude_point_for_treadmill> inclinationList;
+    QString cache = cacheFileName(gpx, gpx_loop, treadmill_force_speed);
+    if (!cache.isEmpty() && loadCache(cache, inclinationList)) {
+        qDebug() << "gpx::open" << gpx << "from the cache" << cache << inclinationList.count() << "points";
+        return inclinationList;
+    }
+
+    inclinationList = parse(gpx, gpx_loop, treadmill_force_speed);
+    if (!cache.isEmpty() && !inclinationList.isEmpty())
+        saveCache(cache, inclinationList);
+    return inclinationList;
+}
+
+QString gpx::cacheFileName(const QString &gpx, bool gpx_loop, bool treadmill_force_speed) {
+    QFile input(gpx);
+    if (!input.open(QIODevice::ReadOnly))
+        return QString();
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    if (!hash.addData(&input))
+        return QString();
+    hash.addData(QByteArray::number(cacheVersion));
+    hash.addData(gpx_loop ? "L" : "l");
+    hash.addData(treadmill_force_speed ? "T" : "t");
+
+    QString dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if (dir.isEmpty() || !QDir().mkpath(dir + QStringLiteral("/gpx")))
+        return QString();
+    return dir + QStringLiteral("/gpx/") + QString::fromLatin1(hash.result().toHex()) + QStringLiteral(".route");
+}
+
+bool gpx::loadCache(const QString &fileName, QList<gpx_altitude_point_for_treadmill> &inclinationList) {
+    QFile cache(fileName);
+    if (!cache.open(QIODevice::ReadOnly) || cache.size() < (qint64)sizeof(cacheheader))
+        return false;
+
+    const uchar *data = cache.map(0, cache.size());
+    if (!data)
+        return false;
+
+    cacheheader header;
+    memcpy(&header, data, sizeof(header));
+    qint64 offset = sizeof(header) + (qint64)header.videoUrlSize;
+    bool valid = !memcmp(header.magic, cacheMagic, sizeof(cacheMagic)) && header.version == cacheVersion &&
+                 header.pointSize == cachePointSize && header.count > 0 &&
+                 offset + (qint64)header.count * header.pointSize == cache.size();
+    if (valid) {
+        videoUrl = QString::fromUtf8((const char *)data + sizeof(header), header.videoUrlSize);
+        const uchar *in = data + offset;
+        inclinationList.reserve(header.count);
+        for (quint32 i = 0; i < header.count; i++) {
+            gpx_altitude_point_for_treadmill p;
+            getField(in, p.seconds);
+            getField(in, p.inclination);
+            getField(in, p.elevation);
+            getField(in, p.speed);
+            getField(in, p.distance);
+            getField(in, p.latitude);
+            getField(in, p.longitude);
+            getField(in, p.azimuth);
+            inclinationList.append(p);
+        }
+    }
+    cache.unmap((uchar *)data);
+    return valid;
+}
+
+void gpx::saveCache(const QString &fileName, const QList<gpx_altitude_point_for_treadmill> &inclinationList) const {
+    QByteArray url = videoUrl.toUtf8();
+    cacheheader header;
+    memcpy(header.magic, cacheMagic, sizeof(cacheMagic));
+    header.version = cacheVersion;
+    header.pointSize = cachePointSize;
+    header.count = inclinationList.count();
+    header.videoUrlSize = url.size();
+    header.reserved = 0;
+
+    QSaveFile cache(fileName);
+    if (!cache.open(QIODevice::WriteOnly))
+        return;
+    QByteArray points(inclinationList.count() * cachePointSize, Qt::Uninitialized);
+    char *out = points.data();
+    for (const gpx_altitude_point_for_treadmill &p : inclinationList) {
+        putField(out, p.seconds);
+        putField(out, p.inclination);
+        putField(out, p.elevation);
+        putField(out, p.speed);
+        putField(out, p.distance);
+        putField(out, p.latitude);
+        putField(out, p.longitude);
+        putField(out, p.azimuth);
+    }
+    cache.write((const char *)&header, sizeof(header));
+    cache.write(url);
+    cache.write(points);
+    if (!cache.commit()) {
+        qDebug() << "gpx::saveCache" << fileName << cache.errorString();
+        return;
+    }
+    pruneCache(fileName);
+}
+
+void gpx::pruneCache(const QString &kept) {
+    // the newest routes are kept, the one just written whatever the resolution of the modification times
+    QFileInfo keptInfo(kept);
+    const QFileInfoList routes =
+        keptInfo.dir().entryInfoList(QStringList() << QStringLiteral("*.route"), QDir::Files, QDir::Time);
+    int count = 1;
+    for (const QFileInfo &route : routes) {
+        if (route.fileName() == keptInfo.fileName())
+            continue;
+        if (++count > maxCachedRoutes && !QFile::remove(route.filePath()))
+            qDebug() << "gpx::pruneCache can't remove" << route.filePath();
+    }
+}
+
+QList<gpx_altitude_point_for_treadmill> gpx::parse(const QString &gpx, bool gpx_loop, bool treadmill_force_speed) {
+    const double meter_limit_for_auto_loop = 300;
     QFile input(gpx);
     input.open(QIODevice::ReadOnly);
-    QDomDocument doc;
-    doc.setContent(&input);
-    QDomNodeList metadata = doc.elementsByTagName(QStringLiteral("metadata"));
-    if (metadata.size()) {
-        QDomNodeList list = metadata.at(0).childNodes();
-        for (int i = 0; i < list.count(); i++) {
-            if (list.at(i).nodeName().toLower() == "video") {
-                QString video = list.at(i).toElement().firstChild().nodeValue();
-                if (!video.isEmpty()) {
-                    videoUrl = video;
-                    qDebug() << "gpx::videoUrl " << videoUrl;
-                    break;
+
+    // the file is read as a stream, so only the points are kept in memory and not the whole document
+    QXmlStreamReader stream(&input);
+    bool metadataRead = false;
+    while (!stream.atEnd()) {
+        if (stream.readNext() != QXmlStreamReader::StartElement)
+            continue;
+
+        if (!metadataRead && stream.qualifiedName() == QLatin1String("metadata")) {
+            metadataRead = true;
+            while (stream.readNextStartElement()) {
+                if (videoUrl.isEmpty() && stream.qualifiedName().toString().toLower() == QLatin1String("video")) {
+                    videoUrl = stream.readElementText(QXmlStreamReader::IncludeChildElements);
+                    if (!videoUrl.isEmpty())
+                        qDebug() << "gpx::videoUrl " << videoUrl;
+                } else {
+                    stream.skipCurrentElement();
+                }
+            }
+        } else if (stream.qualifiedName() == QLatin1String("trkpt")) {
+            gpx_point g;
+            g.latitude = stream.attributes().value(QStringLiteral("lat")).toDouble();
+            g.longitude = stream.attributes().value(QStringLiteral("lon")).toDouble();
+            bool eleRead = false;
+            bool timeRead = false;
+            while (stream.readNextStartElement()) {
+                if (!eleRead && stream.qualifiedName() == QLatin1String("ele")) {
+                    eleRead = true;
+                    g.altitude = stream.readElementText(QXmlStreamReader::IncludeChildElements).toDouble();
+                } else if (!timeRead && stream.qualifiedName() == QLatin1String("time")) {
+                    timeRead = true;
+                    // 2020-10-10T10:54:45
+                    QDateTime time = QDateTime::fromString(
+                        stream.readElementText(QXmlStreamReader::IncludeChildElements), Qt::ISODate);
+                    if (time.isValid())
+                        g.time = time.toMSecsSinceEpoch();
+                } else {
+                    stream.skipCurrentElement();
                 }
             }
+            this->points.append(g);
         }
     }
-
-    QDomNodeList points = doc.elementsByTagName(QStringLiteral("trkpt"));
-    for (int i = 0; i < points.size(); i++) {
-        QDomNode point = points.item(i);
-        QDomNamedNodeMap att = point.attributes();
-        QString lat = att.namedItem(QStringLiteral("lat")).nodeValue();
-        QString lon = att.namedItem(QStringLiteral("lon")).nodeValue();
-        QDomElement ele = point.firstChildElement(QStringLiteral("ele"));
-        QDomElement time = point.firstChildElement(QStringLiteral("time"));
-        gpx_point g;
-        // 2020-10-10T10:54:45
-        g.time = QDateTime::fromString(time.text(), Qt::ISODate);
-        g.p.setAltitude(ele.text().toDouble());
-        g.p.setLatitude(lat.toDouble());
-        g.p.setLongitude(lon.toDouble());
-        this->points.append(g);
-    }
+    if (stream.hasError())
+        qDebug() << "gpx::open" << gpx << stream.errorString() << "at line" << stream.lineNumber();
 
     if (gpx_loop && this->points.size() > 2 &&
-        this->points.first().p.distanceTo(this->points.last().p) >= meter_limit_for_auto_loop) {
+        this->points.first().coordinate().distanceTo(this->points.last().coordinate()) >= meter_limit_for_auto_loop) {
+        this->points.reserve(this->points.size() * 2 - 1);
         for (int i =
                  this->points.size() - 2 /* -2 because otherwise the first point will be the same as the last point */;
              i >= 0; i--) {
@@ -64,7 +238,9 @@ QList<gpx_altitude_point_for_treadmill> gpx::open(const QString &gpx) {
         return inclinationList;
     }
 
+    inclinationList.reserve(this->points.size() + 1);
     gpx_point pP = this->points.constFirst();
+    QGeoCoordinate previous = pP.coordinate();
 
     if (treadmill_force_speed) {
 
@@ -72,42 +248,47 @@ QList<gpx_altitude_point_for_treadmill> gpx::open(const QString &gpx) {
         gpx_altitude_point_for_treadmill g;
         g.distance = 0;
         g.inclination = 0;
-        g.elevation = pP.p.altitude();
-        g.latitude = pP.p.latitude();
-        g.longitude = pP.p.longitude();
+        g.elevation = pP.altitude;
+        g.latitude = pP.latitude;
+        g.longitude = pP.longitude;
         g.seconds = 0;
         inclinationList.append(g);
 
         for (int32_t i = 1; i < this->points.count(); i++) {
-            qint64 dT = qAbs(pP.time.secsTo(this->points.at(i).time));
+            const gpx_point &point = this->points.at(i);
+            qint64 dT = qAbs(pP.secsTo(point));
 
-            double distance = this->points.at(i).p.distanceTo(pP.p);
-            double elevation = this->points.at(i).p.altitude() - pP.p.altitude();
+            QGeoCoordinate current = point.coordinate();
+            double distance = current.distanceTo(previous);
+            double elevation = point.altitude - pP.altitude;
 
             if (distance == 0 || dT == 0) {
                 continue;
             }
 
-            pP = this->points[i];
-
             gpx_altitude_point_for_treadmill g;
-            g.seconds = this->points.constFirst().time.secsTo(pP.time);
+            g.azimuth = previous.azimuthTo(current);
+            pP = point;
+            previous = current;
+
+            g.seconds = this->points.constFirst().secsTo(pP);
             g.distance = distance / 1000.0;
             g.speed = (distance / 1000.0) * (3600 / dT);
             g.inclination = (elevation / distance) * 100;
-            g.elevation = this->points.at(i).p.altitude();
-            g.latitude = pP.p.latitude();
-            g.longitude = pP.p.longitude();
+            g.elevation = point.altitude;
+            g.latitude = pP.latitude;
+            g.longitude = pP.longitude;
             inclinationList.append(g);
         }
     }
     if (inclinationList.empty()) {
         gpx_point pP = this->points.constFirst();
+        QGeoCoordinate previous = pP.coordinate();
         double totDistance = 0;
-        if (!isnan(this->points.constFirst().p.latitude()) && !isnan(this->points.constFirst().p.longitude()) &&
-            QGeoCoordinate(this->points.first().p.latitude(), this->points.first().p.longitude())
-                    .distanceTo(QGeoCoordinate(this->points.constLast().p.latitude(),
-                                               this->points.constLast().p.longitude())) < meter_limit_for_auto_loop) {
+        if (!isnan(this->points.constFirst().latitude) && !isnan(this->points.constFirst().longitude) &&
+            QGeoCoordinate(this->points.first().latitude, this->points.first().longitude)
+                    .distanceTo(QGeoCoordinate(this->points.constLast().latitude,
+                                               this->points.constLast().longitude)) < meter_limit_for_auto_loop) {
             // to create the circuit
             this->points.append(this->points.constFirst());
             this->points.last().time = this->points.at(this->points.count() - 2).time;
@@ -117,32 +298,36 @@ QList<gpx_altitude_point_for_treadmill> gpx::open(const QString &gpx) {
         gpx_altitude_point_for_treadmill g;
         g.distance = 0;
         g.inclination = 0;
-        g.elevation = pP.p.altitude();
-        g.latitude = pP.p.latitude();
-        g.longitude = pP.p.longitude();
+        g.elevation = pP.altitude;
+        g.latitude = pP.latitude;
+        g.longitude = pP.longitude;
         g.seconds = 0;
         /*qDebug() << qSetRealNumberPrecision(10) << i << g.distance << g.inclination << g.elevation << g.latitude
              << g.longitude << totDistance << pP.time;*/
         inclinationList.append(g);
 
         for (int32_t i = 1; i < this->points.count(); i++) {
-            double distance = this->points.at(i).p.distanceTo(pP.p);
-            double elevation = this->points.at(i).p.altitude() - pP.p.altitude();
+            const gpx_point &point = this->points.at(i);
+            QGeoCoordinate current = point.coordinate();
+            double distance = current.distanceTo(previous);
+            double elevation = point.altitude - pP.altitude;
 
             if (distance == 0) {
                 continue;
             }
 
-            pP = this->points[i];
-
             gpx_altitude_point_for_treadmill g;
+            g.azimuth = previous.azimuthTo(current);
+            pP = point;
+            previous = current;
+
             g.distance = distance / 1000.0;
             totDistance += g.distance;
             g.inclination = (elevation / distance) * 100;
-            g.elevation = this->points.at(i).p.altitude();
-            g.latitude = pP.p.latitude();
-            g.longitude = pP.p.longitude();
-            g.seconds = this->points.constFirst().time.secsTo(pP.time);
+            g.elevation = point.altitude;
+            g.latitude = pP.latitude;
+            g.longitude = pP.longitude;
+            g.seconds = this->points.constFirst().secsTo(pP);
             /*qDebug() << qSetRealNumberPrecision(10) << i << g.distance << g.inclination << g.elevation << g.latitude
              << g.longitude << totDistance << pP.time;*/
             inclinationList.append(g);
@@ -152,7 +337,7 @@ QList<gpx_altitude_point_for_treadmill> gpx::open(const QString &gpx) {
     return inclinationList;
 }
 
-void gpx::save(const QString &filename, QList<SessionLine> session, bluetoothdevice::BLUETOOTH_TYPE type) {
+void gpx::save(const QString &filename, const sessionstore &session, bluetoothdevice::BLUETOOTH_TYPE type) {
     if (session.isEmpty()) {
         return;
     }
@@ -201,8 +386,9 @@ void gpx::save(const QString &filename, QList<SessionLine> session, bluetoothdev
     }
 
     stream.writeStartElement(QStringLiteral("trkseg"));
-    for (const SessionLine &s : qAsConst(session)) {
-        if (s.speed > 0) {
+    for (int i = 0; i < session.count(); i++) {
+        if (session.speed().at(i) > 0) {
+            const SessionLine s = session.at(i);
             stream.writeStartElement(QStringLiteral("trkpt"));
             stream.writeAttribute(QStringLiteral("lat"), QStringLiteral("0"));
             stream.writeAttribute(QStringLiteral("lon"), QStringLiteral("0"));
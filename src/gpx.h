@@ -3,10 +3,12 @@
 
 #include "bluetoothdevice.h"
 #include "sessionline.h"
+#include "sessionstore.h"
 #include <QFile>
 #include <QGeoCoordinate>
 #include <QObject>
 #include <QTime>
+#include <QVector>
 
 class gpx_altitude_point_for_treadmill {
   public:
@@ -17,26 +19,69 @@ class gpx_altitude_point_for_treadmill {
     double distance = 0;
     double latitude = 0;
     double longitude = 0;
+
+    /**
+     * @brief azimuth The direction from the previous point, NAN for the first one. Unit: degrees
+     */
+    double azimuth = NAN;
 };
 
+/**
+ * @brief The gpx_point class A track point as read from the file. It's kept as plain values, rather than a QDateTime
+ * and a QGeoCoordinate, so that a route doesn't cost an allocation per point.
+ */
 class gpx_point {
   public:
-    QDateTime time;
-    QGeoCoordinate p;
+    /**
+     * @brief time Milliseconds since epoch, invalidTime if the point has no time.
+     */
+    qint64 time = invalidTime;
+    double latitude = 0;
+    double longitude = 0;
+    double altitude = 0;
+
+    static const qint64 invalidTime;
+
+    QGeoCoordinate coordinate() const { return QGeoCoordinate(latitude, longitude, altitude); }
+
+    /**
+     * @brief secsTo The seconds from this point to the other, 0 if either has no time (as QDateTime::secsTo).
+     */
+    qint64 secsTo(const gpx_point &other) const;
 };
 
 class gpx : public QObject {
     Q_OBJECT
   public:
     explicit gpx(QObject *parent = nullptr);
+    /**
+     * @brief open Reads the route of a GPX file. The processed route is kept in a cache, keyed by the content of the
+     * file and by the settings that change the processing, so opening the same route again skips the parsing.
+     */
     QList<gpx_altitude_point_for_treadmill> open(const QString &gpx);
-    static void save(const QString &filename, QList<SessionLine> session, bluetoothdevice::BLUETOOTH_TYPE type);
+
+    /**
+     * @brief maxCachedRoutes The processed routes kept in the cache, the least recently written are removed.
+     */
+    static const int maxCachedRoutes = 20;
+    static void save(const QString &filename, const sessionstore &session, bluetoothdevice::BLUETOOTH_TYPE type);
     QString getVideoURL() {return videoUrl;}
 
   private:
-    QList<gpx_point> points;
+    QVector<gpx_point> points;
     QString videoUrl = "";
 
+    QList<gpx_altitude_point_for_treadmill> parse(const QString &gpx, bool gpx_loop, bool treadmill_force_speed);
+
+    /**
+     * @brief cacheFileName The processed route cache of the file with the given settings.
+     * @return An empty string if the file can't be read or there's no cache directory.
+     */
+    static QString cacheFileName(const QString &gpx, bool gpx_loop, bool treadmill_force_speed);
+    bool loadCache(const QString &fileName, QList<gpx_altitude_point_for_treadmill> &inclinationList);
+    void saveCache(const QString &fileName, const QList<gpx_altitude_point_for_treadmill> &inclinationList) const;
+    static void pruneCache(const QString &kept);
+
   signals:
 };
 
@@ -8,6 +8,7 @@
 #endif
 #include "material.h"
 #include "qfit.h"
+#include "qzsettingscache.h"
 #include "simplecrypt.h"
 #include "templateinfosenderbuilder.h"
 #include "zwiftworkout.h"
@@ -36,6 +37,7 @@
 #include <QStandardPaths>
 #include <QTime>
 #include <QUrlQuery>
+#include <QXYSeries>
 #include <chrono>
 
 homeform *homeform::m_singleton = 0;
@@ -85,34 +87,84 @@ DataObject::DataObject(const QString &name, const QString &icon, const QString &
 }
 
 void DataObject::setName(const QString &v) {
+    if (m_name == v)
+        return;
     m_name = v;
     emit nameChanged(m_name);
 }
 void DataObject::setValue(const QString &v) {
+    // a text set directly invalidates the number setValue(double, int) compares with
+    m_decimals = -1;
+    if (m_value == v)
+        return;
     m_value = v;
+    if (!m_shown) {
+        m_stale = true;
+        return;
+    }
     emit valueChanged(m_value);
 }
+void DataObject::setValue(double value, int decimals) {
+    if (m_decimals == decimals && m_number == value)
+        return;
+    if (!m_shown) {
+        // formatted by setShown if the tile ever makes it to the grid
+        m_number = value;
+        m_decimals = decimals;
+        m_stale = true;
+        return;
+    }
+    setValue(QString::number(value, 'f', decimals));
+    m_number = value;
+    m_decimals = decimals;
+}
 void DataObject::setSecondLine(const QString &value) {
+    if (m_secondLine == value)
+        return;
     m_secondLine = value;
+    if (!m_shown) {
+        m_stale = true;
+        return;
+    }
+    emit secondLineChanged(m_secondLine);
+}
+void DataObject::setShown(bool shown) {
+    m_shown = shown;
+    if (!m_shown || !m_stale)
+        return;
+    m_stale = false;
+    if (m_decimals >= 0)
+        m_value = QString::number(m_number, 'f', m_decimals);
+    emit valueChanged(m_value);
     emit secondLineChanged(m_secondLine);
 }
 void DataObject::setValueFontSize(int value) {
+    if (m_valueFontSize == value)
+        return;
     m_valueFontSize = value;
     emit valueFontSizeChanged(m_valueFontSize);
 }
 void DataObject::setValueFontColor(const QString &value) {
+    if (m_valueFontColor == value)
+        return;
     m_valueFontColor = value;
     emit valueFontColorChanged(m_valueFontColor);
 }
 void DataObject::setLabelFontSize(int value) {
+    if (m_labelFontSize == value)
+        return;
     m_labelFontSize = value;
     emit labelFontSizeChanged(m_labelFontSize);
 }
 void DataObject::setGridId(int id) {
+    if (m_gridId == id)
+        return;
     m_gridId = id;
     emit gridIdChanged(m_gridId);
 }
 void DataObject::setVisible(bool visible) {
+    if (m_visible == visible)
+        return;
     m_visible = visible;
     emit visibleChanged(m_visible);
 }
@@ -456,13 +508,26 @@ homeform::homeform(QQmlApplicationEngine *engine, bluetooth *bl) {
     connect(this->innerTemplateManager, &TemplateInfoSenderBuilder::activityDescriptionChanged, this,
             &homeform::setActivityDescription);
     engine->rootContext()->setContextProperty(QStringLiteral("rootItem"), (QObject *)this);
+    engine->rootContext()->setContextProperty(QStringLiteral("settingsCache"), qzsettingscache::instance());
 
     this->trainProgram = new trainprogram(QList<trainrow>(), bl);
 
+    // the workout is sampled on this tick: a precise timer is rescheduled from its previous deadline, so the session
+    // keeps exactly one line per second instead of drifting with the event loop load
     timer = new QTimer(this);
+    timer->setTimerType(Qt::PreciseTimer);
     connect(timer, &QTimer::timeout, this, &homeform::update);
     timer->start(1s);
 
+    // the fast changing tiles have their own, faster, refresh so they don't lag the device by up to a second
+    int tilesRefreshRate =
+        settings.value(QZSettings::tiles_refresh_rate, QZSettings::default_tiles_refresh_rate).toInt();
+    if (tilesRefreshRate > 1) {
+        tilesTimer = new QTimer(this);
+        connect(tilesTimer, &QTimer::timeout, this, &homeform::updateLiveTiles);
+        tilesTimer->start(1000 / qMin(tilesRefreshRate, 20));
+    }
+
     backupTimer = new QTimer(this);
     connect(backupTimer, &QTimer::timeout, this, &homeform::backup);
     backupTimer->start(1min);
@@ -860,11 +925,15 @@ void homeform::backup() {
     bluetoothdevice *dev = bluetoothManager->device();
     if (dev) {
 
-        QString filename = path + QString::number(index) + backupFitFileName;
-        QFile::remove(filename);
-        qfit::save(filename, Session, dev->deviceType(),
-                   qobject_cast<m3ibike *>(dev) ? QFIT_PROCESS_DISTANCENOISE : QFIT_PROCESS_NONE,
-                   stravaPelotonWorkoutType, dev->bluetoothDevice.name());
+        // the two backup files are appended alternately, so a crash while writing one leaves the other intact
+        QScopedPointer<qfitstream> &stream = backupStream[index];
+        if (stream.isNull() || stream->type() != dev->deviceType() ||
+            stream->overrideSport() != stravaPelotonWorkoutType) {
+            QString filename = path + QString::number(index) + backupFitFileName;
+            stream.reset(new qfitstream(filename, dev->deviceType(), stravaPelotonWorkoutType,
+                                        dev->bluetoothDevice.name()));
+        }
+        stream->append(Session);
 
         index++;
         if (index > 1) {
@@ -1087,6 +1156,8 @@ void homeform::sortTiles() {
     if (!bluetoothManager || !bluetoothManager->device())
         return;
 
+    for (QObject *d : qAsConst(dataList))
+        static_cast<DataObject *>(d)->setShown(false);
     dataList.clear();
 
     if (bluetoothManager->device()->deviceType() == bluetoothdevice::TREADMILL) {
@@ -2304,6 +2375,9 @@ void homeform::sortTiles() {
         }
     }
 
+    for (QObject *d : qAsConst(dataList))
+        static_cast<DataObject *>(d)->setShown(true);
+
     engine->rootContext()->setContextProperty(QStringLiteral("appModel"), QVariant::fromValue(dataList));
 }
 
@@ -3198,6 +3272,16 @@ void homeform::Start_inner(bool send_event_to_device) {
                 bluetoothManager->device()->clearStats();
             }
             Session.clear();
+            for (QScopedPointer<qfitstream> &stream : backupStream) {
+                if (!stream.isNull())
+                    stream->reset();
+            }
+            sessionPowerCurve.clear();
+            chartWatt.clear();
+            chartHeart.clear();
+            chartCadence.clear();
+            chartResistance.clear();
+            chartPelotonResistance.clear();
             chartImagesFilenames.clear();
 
 #ifdef Q_OS_IOS
@@ -3402,9 +3486,110 @@ QString homeform::signal() {
     return QStringLiteral("icons/icons/signal-1.png");
 }
 
+void homeform::updateLiveTiles() {
+    bluetoothdevice *device = bluetoothManager->device();
+    if (!device)
+        return;
+
+    // the same values update() shows, the colors and the second lines are still refreshed once per second
+    const qzsettingscache::snapshot &settings = qzsettingscache::get();
+    speed->setValue(device->currentSpeed().value() * (settings.miles_unit ? 0.621371 : 1.0), 1);
+    heart->setValue(device->currentHeart().value(), 0);
+    watt->setValue(settings.power_avg_5s ? device->wattsMetric().average5s() : device->wattsMetric().value(), 0);
+    cadence->setValue((uint8_t)device->currentCadence().value(), 0);
+}
+
+void homeform::updateNextRowsTile(double ftpSetting) {
+    trainrow next = trainProgram->getRowFromCurrent(1);
+    trainrow next_1 = trainProgram->getRowFromCurrent(2);
+    if (next.duration.second() != 0 || next.duration.minute() != 0 || next.duration.hour() != 0) {
+        if (next.requested_peloton_resistance != -1)
+            nextRows->setValue(QStringLiteral("PR") + QString::number(next.requested_peloton_resistance) +
+                               QStringLiteral(" ") + next.duration.toString(QStringLiteral("mm:ss")));
+        else if (next.resistance != -1)
+            nextRows->setValue(QStringLiteral("R") + QString::number(next.resistance) + QStringLiteral(" ") +
+                               next.duration.toString(QStringLiteral("mm:ss")));
+        else if (next.zoneHR != -1)
+            nextRows->setValue(QStringLiteral("HR") + QString::number(next.zoneHR) + QStringLiteral(" ") +
+                               next.duration.toString(QStringLiteral("mm:ss")));
+        else if (next.HRmin != -1 && next.HRmax != -1)
+            nextRows->setValue(QStringLiteral("HR") + QString::number(next.HRmin) + QStringLiteral("-") +
+                               QString::number(next.HRmax) + QStringLiteral(" ") +
+                               next.duration.toString(QStringLiteral("mm:ss")));
+        else if (next.speed != -1 && next.inclination != -1)
+            nextRows->setValue(QStringLiteral("S") + QString::number(next.speed) + QStringLiteral("I") +
+                               QString::number(next.inclination) + QStringLiteral(" ") +
+                               next.duration.toString(QStringLiteral("mm:ss")));
+        else if (next.speed != -1)
+            nextRows->setValue(QStringLiteral("S") + QString::number(next.speed) + QStringLiteral(" ") +
+                               next.duration.toString(QStringLiteral("mm:ss")));
+        else if (next.inclination != -200)
+            nextRows->setValue(QStringLiteral("I") + QString::number(next.inclination) + QStringLiteral(" ") +
+                               next.duration.toString(QStringLiteral("mm:ss")));
+        else if (next.power != -1) {
+            double ftpPerc = (next.power / ftpSetting) * 100.0;
+            uint8_t ftpZone = 1;
+            if (ftpPerc < 56) {
+                ftpZone = 1;
+            } else if (ftpPerc < 76) {
+                ftpZone = 2;
+            } else if (ftpPerc < 91) {
+                ftpZone = 3;
+            } else if (ftpPerc < 106) {
+                ftpZone = 4;
+            } else if (ftpPerc < 121) {
+                ftpZone = 5;
+            } else if (ftpPerc < 151) {
+                ftpZone = 6;
+            } else {
+                ftpZone = 7;
+            }
+            nextRows->setValue(QStringLiteral("Z") + QString::number(ftpZone) + QStringLiteral(" ") +
+                               next.duration.toString(QStringLiteral("mm:ss")));
+            if (next_1.duration.second() != 0 || next_1.duration.minute() != 0 || next_1.duration.hour() != 0) {
+                if (next_1.requested_peloton_resistance != -1)
+                    nextRows->setSecondLine(
+                        QStringLiteral("PR") + QString::number(next_1.requested_peloton_resistance) +
+                        QStringLiteral(" ") + next_1.duration.toString(QStringLiteral("mm:ss")));
+                else if (next_1.resistance != -1)
+                    nextRows->setSecondLine(QStringLiteral("R") + QString::number(next_1.resistance) +
+                                            QStringLiteral(" ") +
+                                            next_1.duration.toString(QStringLiteral("mm:ss")));
+                else if (next_1.power != -1) {
+                    double ftpPerc = (next_1.power / ftpSetting) * 100.0;
+                    uint8_t ftpZone = 1;
+                    if (ftpPerc < 56) {
+                        ftpZone = 1;
+                    } else if (ftpPerc < 76) {
+                        ftpZone = 2;
+                    } else if (ftpPerc < 91) {
+                        ftpZone = 3;
+                    } else if (ftpPerc < 106) {
+                        ftpZone = 4;
+                    } else if (ftpPerc < 121) {
+                        ftpZone = 5;
+                    } else if (ftpPerc < 151) {
+                        ftpZone = 6;
+                    } else {
+                        ftpZone = 7;
+                    }
+                    nextRows->setSecondLine(QStringLiteral("Z") + QString::number(ftpZone) +
+                                            QStringLiteral(" ") +
+                                            next_1.duration.toString(QStringLiteral("mm:ss")));
+                }
+            } else {
+                nextRows->setSecondLine(QStringLiteral("N/A"));
+            }
+        }
+    } else {
+        nextRows->setValue(QStringLiteral("N/A"));
+    }
+}
+
 void homeform::update() {
 
     QSettings settings;
+    const qzsettingscache::snapshot &cachedSettings = qzsettingscache::get();
     double currentHRZone = 1;
     double ftpZone = 1;
 
@@ -3413,7 +3598,7 @@ void homeform::update() {
     }
 
     if ((paused || stopped) &&
-        settings.value(QZSettings::top_bar_enabled, QZSettings::default_top_bar_enabled).toBool()) {
+        cachedSettings.top_bar_enabled) {
 
         emit stopIconChanged(stopIcon());
         emit stopTextChanged(stopText());
@@ -3439,12 +3624,12 @@ void homeform::update() {
         double groundContact = 0;
         double verticalOscillation = 0;
 
-        bool miles = settings.value(QZSettings::miles_unit, QZSettings::default_miles_unit).toBool();
-        double ftpSetting = settings.value(QZSettings::ftp, QZSettings::default_ftp).toDouble();
+        bool miles = cachedSettings.miles_unit;
+        double ftpSetting = cachedSettings.ftp;
         double unit_conversion = 1.0;
         double meter_feet_conversion = 1.0;
         double cm_inches_conversion = 1.0;
-        bool power5s = settings.value(QZSettings::power_avg_5s, QZSettings::default_power_avg_5s).toBool();
+        bool power5s = cachedSettings.power_avg_5s;
         uint8_t treadmill_pid_heart_zone =
             settings.value(QZSettings::treadmill_pid_heart_zone, QZSettings::default_treadmill_pid_heart_zone)
                 .toString()
@@ -3465,22 +3650,22 @@ void homeform::update() {
 
         emit signalChanged(signal());
         emit currentSpeedChanged(bluetoothManager->device()->currentSpeed().value());
-        speed->setValue(QString::number(bluetoothManager->device()->currentSpeed().value() * unit_conversion, 'f', 1));
+        speed->setValue(bluetoothManager->device()->currentSpeed().value() * unit_conversion, 1);
         speed->setSecondLine(
             QStringLiteral("AVG: ") +
             QString::number((bluetoothManager->device())->currentSpeed().average() * unit_conversion, 'f', 1) +
             QStringLiteral(" MAX: ") +
             QString::number((bluetoothManager->device())->currentSpeed().max() * unit_conversion, 'f', 1));
-        heart->setValue(QString::number(bluetoothManager->device()->currentHeart().value(), 'f', 0));
+        heart->setValue(bluetoothManager->device()->currentHeart().value(), 0);
 
-        calories->setValue(QString::number(bluetoothManager->device()->calories().value(), 'f', 0));
+        calories->setValue(bluetoothManager->device()->calories().value(), 0);
         calories->setSecondLine(QString::number(bluetoothManager->device()->calories().rate1s() * 60.0, 'f', 1) +
                                 " /min");
         if (!settings.value(QZSettings::fitmetria_fanfit_enable, QZSettings::default_fitmetria_fanfit_enable).toBool())
             fan->setValue(QString::number(bluetoothManager->device()->fanSpeed()));
         else
             fan->setValue(QString::number(qRound(((double)bluetoothManager->device()->fanSpeed()) / 10.0) * 10.0));
-        jouls->setValue(QString::number(bluetoothManager->device()->jouls().value() / 1000.0, 'f', 1));
+        jouls->setValue(bluetoothManager->device()->jouls().value() / 1000.0, 1);
         jouls->setSecondLine(QString::number(bluetoothManager->device()->jouls().rate1s() / 1000.0 * 60.0, 'f', 1) +
                              " /min");
         elapsed->setValue(bluetoothManager->device()->elapsedTime().toString(QStringLiteral("h:mm:ss")));
@@ -3510,130 +3695,49 @@ void homeform::update() {
                 trainProgram->currentRowRemainingTime().toString(QStringLiteral("h:mm:ss")));
             remaningTimeTrainingProgramCurrentRow->setSecondLine(
                 trainProgram->currentRowElapsedTime().toString(QStringLiteral("h:mm:ss")));
-            targetMets->setValue(QString::number(trainProgram->currentTargetMets(), 'f', 1));
-            trainrow next = trainProgram->getRowFromCurrent(1);
-            trainrow next_1 = trainProgram->getRowFromCurrent(2);
-            if (next.duration.second() != 0 || next.duration.minute() != 0 || next.duration.hour() != 0) {
-                if (next.requested_peloton_resistance != -1)
-                    nextRows->setValue(QStringLiteral("PR") + QString::number(next.requested_peloton_resistance) +
-                                       QStringLiteral(" ") + next.duration.toString(QStringLiteral("mm:ss")));
-                else if (next.resistance != -1)
-                    nextRows->setValue(QStringLiteral("R") + QString::number(next.resistance) + QStringLiteral(" ") +
-                                       next.duration.toString(QStringLiteral("mm:ss")));
-                else if (next.zoneHR != -1)
-                    nextRows->setValue(QStringLiteral("HR") + QString::number(next.zoneHR) + QStringLiteral(" ") +
-                                       next.duration.toString(QStringLiteral("mm:ss")));
-                else if (next.HRmin != -1 && next.HRmax != -1)
-                    nextRows->setValue(QStringLiteral("HR") + QString::number(next.HRmin) + QStringLiteral("-") +
-                                       QString::number(next.HRmax) + QStringLiteral(" ") +
-                                       next.duration.toString(QStringLiteral("mm:ss")));
-                else if (next.speed != -1 && next.inclination != -1)
-                    nextRows->setValue(QStringLiteral("S") + QString::number(next.speed) + QStringLiteral("I") +
-                                       QString::number(next.inclination) + QStringLiteral(" ") +
-                                       next.duration.toString(QStringLiteral("mm:ss")));
-                else if (next.speed != -1)
-                    nextRows->setValue(QStringLiteral("S") + QString::number(next.speed) + QStringLiteral(" ") +
-                                       next.duration.toString(QStringLiteral("mm:ss")));
-                else if (next.inclination != -200)
-                    nextRows->setValue(QStringLiteral("I") + QString::number(next.inclination) + QStringLiteral(" ") +
-                                       next.duration.toString(QStringLiteral("mm:ss")));
-                else if (next.power != -1) {
-                    double ftpPerc = (next.power / ftpSetting) * 100.0;
-                    uint8_t ftpZone = 1;
-                    if (ftpPerc < 56) {
-                        ftpZone = 1;
-                    } else if (ftpPerc < 76) {
-                        ftpZone = 2;
-                    } else if (ftpPerc < 91) {
-                        ftpZone = 3;
-                    } else if (ftpPerc < 106) {
-                        ftpZone = 4;
-                    } else if (ftpPerc < 121) {
-                        ftpZone = 5;
-                    } else if (ftpPerc < 151) {
-                        ftpZone = 6;
-                    } else {
-                        ftpZone = 7;
-                    }
-                    nextRows->setValue(QStringLiteral("Z") + QString::number(ftpZone) + QStringLiteral(" ") +
-                                       next.duration.toString(QStringLiteral("mm:ss")));
-                    if (next_1.duration.second() != 0 || next_1.duration.minute() != 0 || next_1.duration.hour() != 0) {
-                        if (next_1.requested_peloton_resistance != -1)
-                            nextRows->setSecondLine(
-                                QStringLiteral("PR") + QString::number(next_1.requested_peloton_resistance) +
-                                QStringLiteral(" ") + next_1.duration.toString(QStringLiteral("mm:ss")));
-                        else if (next_1.resistance != -1)
-                            nextRows->setSecondLine(QStringLiteral("R") + QString::number(next_1.resistance) +
-                                                    QStringLiteral(" ") +
-                                                    next_1.duration.toString(QStringLiteral("mm:ss")));
-                        else if (next_1.power != -1) {
-                            double ftpPerc = (next_1.power / ftpSetting) * 100.0;
-                            uint8_t ftpZone = 1;
-                            if (ftpPerc < 56) {
-                                ftpZone = 1;
-                            } else if (ftpPerc < 76) {
-                                ftpZone = 2;
-                            } else if (ftpPerc < 91) {
-                                ftpZone = 3;
-                            } else if (ftpPerc < 106) {
-                                ftpZone = 4;
-                            } else if (ftpPerc < 121) {
-                                ftpZone = 5;
-                            } else if (ftpPerc < 151) {
-                                ftpZone = 6;
-                            } else {
-                                ftpZone = 7;
-                            }
-                            nextRows->setSecondLine(QStringLiteral("Z") + QString::number(ftpZone) +
-                                                    QStringLiteral(" ") +
-                                                    next_1.duration.toString(QStringLiteral("mm:ss")));
-                        }
-                    } else {
-                        nextRows->setSecondLine(QStringLiteral("N/A"));
-                    }
-                }
-            } else {
-                nextRows->setValue(QStringLiteral("N/A"));
-            }
+            targetMets->setValue(trainProgram->currentTargetMets(), 1);
+            if (nextRows->shown())
+                updateNextRowsTile(ftpSetting);
         }
-        mets->setValue(QString::number(bluetoothManager->device()->currentMETS().value(), 'f', 1));
+        mets->setValue(bluetoothManager->device()->currentMETS().value(), 1);
         mets->setSecondLine(
             QStringLiteral("AVG: ") + QString::number(bluetoothManager->device()->currentMETS().average(), 'f', 1) +
             QStringLiteral("MAX: ") + QString::number(bluetoothManager->device()->currentMETS().max(), 'f', 1));
         lapElapsed->setValue(bluetoothManager->device()->lapElapsedTime().toString(QStringLiteral("h:mm:ss")));
-        avgWatt->setValue(QString::number(bluetoothManager->device()->wattsMetric().average(), 'f', 0));
-        avgWattLap->setValue(QString::number(bluetoothManager->device()->wattsMetric().lapAverage(), 'f', 0));
-        wattKg->setValue(QString::number(bluetoothManager->device()->wattKg().value(), 'f', 1));
+        avgWatt->setValue(bluetoothManager->device()->wattsMetric().average(), 0);
+        avgWattLap->setValue(bluetoothManager->device()->wattsMetric().lapAverage(), 0);
+        wattKg->setValue(bluetoothManager->device()->wattKg().value(), 1);
         wattKg->setSecondLine(
             QStringLiteral("AVG: ") + QString::number(bluetoothManager->device()->wattKg().average(), 'f', 1) +
             QStringLiteral("MAX: ") + QString::number(bluetoothManager->device()->wattKg().max(), 'f', 1));
-        QLocale locale = QLocale::system();
-
-        // Format the time based on the locale
-        QString timeFormat = locale.timeFormat(QLocale::ShortFormat);
-        bool usesAMPMFormat = timeFormat.toUpper().contains("A");
-        QDateTime currentTime = QDateTime::currentDateTime();
-
-        QString formattedTime;
-        if (usesAMPMFormat) {
-            // The locale uses 12-hour format with AM/PM
-            formattedTime = currentTime.toString("h:mm:ss AP");
-        } else {
-            // The locale uses 24-hour format
-            formattedTime = currentTime.toString("H:mm:ss");
+        if (datetime->shown()) {
+            QLocale locale = QLocale::system();
+
+            // Format the time based on the locale
+            QString timeFormat = locale.timeFormat(QLocale::ShortFormat);
+            bool usesAMPMFormat = timeFormat.toUpper().contains("A");
+            QDateTime currentTime = QDateTime::currentDateTime();
+
+            QString formattedTime;
+            if (usesAMPMFormat) {
+                // The locale uses 12-hour format with AM/PM
+                formattedTime = currentTime.toString("h:mm:ss AP");
+            } else {
+                // The locale uses 24-hour format
+                formattedTime = currentTime.toString("H:mm:ss");
+            }
+            datetime->setValue(formattedTime);
         }
-        datetime->setValue(formattedTime);
         if (power5s)
             watts = bluetoothManager->device()->wattsMetric().average5s();
         else
             watts = bluetoothManager->device()->wattsMetric().value();
-        watt->setValue(QString::number(watts, 'f', 0));
-        weightLoss->setValue(QString::number(miles ? bluetoothManager->device()->weightLoss() * 35.274
-                                                   : bluetoothManager->device()->weightLoss(),
-                                             'f', 2));
+        watt->setValue(watts, 0);
+        weightLoss->setValue(
+            miles ? bluetoothManager->device()->weightLoss() * 35.274 : bluetoothManager->device()->weightLoss(), 2);
 
         cadence = bluetoothManager->device()->currentCadence().value();
-        this->cadence->setValue(QString::number(cadence));
+        this->cadence->setValue(cadence, 0);
         this->cadence->setSecondLine(
             QStringLiteral("AVG: ") +
             QString::number(((bike *)bluetoothManager->device())->currentCadence().average(), 'f', 0) +
@@ -3665,7 +3769,7 @@ void homeform::update() {
 
         if (bluetoothManager->device()->deviceType() == bluetoothdevice::TREADMILL) {
 
-            odometer->setValue(QString::number(bluetoothManager->device()->odometer() * unit_conversion, 'f', 2));
+            odometer->setValue(bluetoothManager->device()->odometer() * unit_conversion, 2);
             if (bluetoothManager->device()->currentSpeed().value()) {
                 pace = 10000 / (((treadmill *)bluetoothManager->device())->currentPace().second() +
                                 (((treadmill *)bluetoothManager->device())->currentPace().minute() * 60));
@@ -3691,35 +3795,35 @@ void homeform::update() {
                 ((treadmill *)bluetoothManager->device())->averagePace().toString(QStringLiteral("m:ss")) +
                 QStringLiteral(" MAX: ") +
                 ((treadmill *)bluetoothManager->device())->maxPace().toString(QStringLiteral("m:ss")));
-            this->inclination->setValue(QString::number(inclination, 'f', 1));
+            this->inclination->setValue(inclination, 1);
             this->inclination->setSecondLine(
                 QStringLiteral("AVG: ") +
                 QString::number(((treadmill *)bluetoothManager->device())->currentInclination().average(), 'f', 1) +
                 QStringLiteral(" MAX: ") +
                 QString::number(((treadmill *)bluetoothManager->device())->currentInclination().max(), 'f', 1));
-            elevation->setValue(QString::number(((treadmill *)bluetoothManager->device())->elevationGain().value() *
-                                                    meter_feet_conversion,
-                                                'f', (miles ? 0 : 1)));
+            elevation->setValue(
+                ((treadmill *)bluetoothManager->device())->elevationGain().value() * meter_feet_conversion,
+                (miles ? 0 : 1));
             elevation->setSecondLine(
                 QString::number(((treadmill *)bluetoothManager->device())->elevationGain().rate1s() * 60.0 *
                                     meter_feet_conversion,
                                 'f', (miles ? 0 : 1)) +
                 " /min");
-            this->instantaneousStrideLengthCM->setValue(QString::number(strideLength, 'f', 0));
+            this->instantaneousStrideLengthCM->setValue(strideLength, 0);
             this->instantaneousStrideLengthCM->setSecondLine(
                 QStringLiteral("AVG: ") +
                 QString::number(((treadmill *)bluetoothManager->device())->currentStrideLength().average(), 'f', 0) +
                 QStringLiteral(" MAX: ") +
                 QString::number(((treadmill *)bluetoothManager->device())->currentStrideLength().max(), 'f', 0));
 
-            this->groundContactMS->setValue(QString::number(groundContact, 'f', 0));
+            this->groundContactMS->setValue(groundContact, 0);
             this->groundContactMS->setSecondLine(
                 QStringLiteral("AVG: ") +
                 QString::number(((treadmill *)bluetoothManager->device())->currentGroundContact().average(), 'f', 0) +
                 QStringLiteral(" MAX: ") +
                 QString::number(((treadmill *)bluetoothManager->device())->currentGroundContact().max(), 'f', 0));
 
-            this->verticalOscillationMM->setValue(QString::number(verticalOscillation, 'f', 0));
+            this->verticalOscillationMM->setValue(verticalOscillation, 0);
             this->verticalOscillationMM->setSecondLine(
                 QStringLiteral("AVG: ") +
                 QString::number(((treadmill *)bluetoothManager->device())->currentVerticalOscillation().average(), 'f',
@@ -3751,7 +3855,7 @@ void homeform::update() {
                     speed->setValueFontColor(QStringLiteral("red"));
                     this->pace->setValueFontColor(QStringLiteral("red"));
                 }
-                bluetoothManager->device()->currentSpeed().setColor(speed->valueFontColor());
+                bluetoothManager->device()->setMetricColor(bluetoothdevice::SPEED_COLOR, speed->valueFontColor());
             } else {
                 if (bluetoothManager->device()->currentSpeed().value() <= trainProgram->currentRow().upper_speed &&
                     bluetoothManager->device()->currentSpeed().value() >= trainProgram->currentRow().lower_speed) {
@@ -3767,13 +3871,13 @@ void homeform::update() {
                     this->target_zone->setValueFontColor(QStringLiteral("red"));
                     this->pace->setValueFontColor(QStringLiteral("red"));
                 }
-                bluetoothManager->device()->currentSpeed().setColor(speed->valueFontColor());
+                bluetoothManager->device()->setMetricColor(bluetoothdevice::SPEED_COLOR, speed->valueFontColor());
             }
 
             this->target_pace->setValue(
                 ((treadmill *)bluetoothManager->device())->lastRequestedPace().toString(QStringLiteral("m:ss")));
-            this->target_speed->setValue(QString::number(
-                ((treadmill *)bluetoothManager->device())->lastRequestedSpeed().value() * unit_conversion, 'f', 1));
+            this->target_speed->setValue(
+                ((treadmill *)bluetoothManager->device())->lastRequestedSpeed().value() * unit_conversion, 1);
             this->target_speed->setSecondLine(QString::number(bluetoothManager->device()->difficult() * 100.0, 'f', 0) +
                                               QStringLiteral("% @0%=") +
                                               QString::number(bluetoothManager->device()->difficult(), 'f', 0));
@@ -3802,7 +3906,7 @@ void homeform::update() {
 
             if (!pelotoncadence) {
                 inclination = ((bike *)bluetoothManager->device())->currentInclination().value();
-                this->inclination->setValue(QString::number(inclination, 'f', 1));
+                this->inclination->setValue(inclination, 1);
                 this->inclination->setSecondLine(
                     QStringLiteral("AVG: ") +
                     QString::number(((bike *)bluetoothManager->device())->currentInclination().average(), 'f', 1) +
@@ -3815,23 +3919,23 @@ void homeform::update() {
             double elite_rizer_gain =
                 settings.value(QZSettings::elite_rizer_gain, QZSettings::default_elite_rizer_gain).toDouble();
             extIncline->setSecondLine(QStringLiteral("Gain: ") + QString::number(elite_rizer_gain, 'f', 1));
-            odometer->setValue(QString::number(bluetoothManager->device()->odometer() * unit_conversion, 'f', 2));
+            odometer->setValue(bluetoothManager->device()->odometer() * unit_conversion, 2);
             resistance = ((bike *)bluetoothManager->device())->currentResistance().value();
             peloton_resistance = ((bike *)bluetoothManager->device())->pelotonResistance().value();
-            this->peloton_resistance->setValue(QString::number(peloton_resistance, 'f', 0));
+            this->peloton_resistance->setValue(peloton_resistance, 0);
             this->target_resistance->setValue(
                 QString::number(((bike *)bluetoothManager->device())->lastRequestedResistance().value(), 'f', 0));
-            this->target_peloton_resistance->setValue(QString::number(
-                ((bike *)bluetoothManager->device())->lastRequestedPelotonResistance().value(), 'f', 0));
+            this->target_peloton_resistance->setValue(
+                ((bike *)bluetoothManager->device())->lastRequestedPelotonResistance().value(), 0);
             this->target_cadence->setValue(
                 QString::number(((bike *)bluetoothManager->device())->lastRequestedCadence().value(), 'f', 0));
             this->target_power->setValue(
                 QString::number(((bike *)bluetoothManager->device())->lastRequestedPower().value(), 'f', 0));
-            this->resistance->setValue(QString::number(resistance, 'f', 0));
+            this->resistance->setValue(resistance, 0);
             if (settings.value(QZSettings::gears_gain, QZSettings::default_gears_gain).toDouble() == 1.0)
                 this->gears->setValue(QString::number(((bike *)bluetoothManager->device())->gears()));
             else
-                this->gears->setValue(QString::number(((bike *)bluetoothManager->device())->gears(), 'f', 1));
+                this->gears->setValue(((bike *)bluetoothManager->device())->gears(), 1);
 
             this->resistance->setSecondLine(
                 QStringLiteral("AVG: ") +
@@ -3944,7 +4048,7 @@ void homeform::update() {
                     break;
                 }
             }
-            odometer->setValue(QString::number(bluetoothManager->device()->odometer() * 1000.0, 'f', 0));
+            odometer->setValue(bluetoothManager->device()->odometer() * 1000.0, 0);
             resistance = ((rower *)bluetoothManager->device())->currentResistance().value();
             peloton_resistance = ((rower *)bluetoothManager->device())->pelotonResistance().value();
             totalStrokes = ((rower *)bluetoothManager->device())->currentStrokesCount().value();
@@ -3956,19 +4060,19 @@ void homeform::update() {
             this->strokesLength->setValue(
                 QString::number(((rower *)bluetoothManager->device())->currentStrokesLength().value(), 'f', 1));
 
-            this->target_speed->setValue(QString::number(
-                ((rower *)bluetoothManager->device())->lastRequestedSpeed().value() * unit_conversion, 'f', 1));
+            this->target_speed->setValue(
+                ((rower *)bluetoothManager->device())->lastRequestedSpeed().value() * unit_conversion, 1);
 
-            this->peloton_resistance->setValue(QString::number(peloton_resistance, 'f', 0));
+            this->peloton_resistance->setValue(peloton_resistance, 0);
             this->target_resistance->setValue(
                 QString::number(((rower *)bluetoothManager->device())->lastRequestedResistance().value(), 'f', 0));
-            this->target_peloton_resistance->setValue(QString::number(
-                ((rower *)bluetoothManager->device())->lastRequestedPelotonResistance().value(), 'f', 0));
+            this->target_peloton_resistance->setValue(
+                ((rower *)bluetoothManager->device())->lastRequestedPelotonResistance().value(), 0);
             this->target_cadence->setValue(
                 QString::number(((rower *)bluetoothManager->device())->lastRequestedCadence().value(), 'f', 0));
             this->target_power->setValue(
                 QString::number(((rower *)bluetoothManager->device())->lastRequestedPower().value(), 'f', 0));
-            this->resistance->setValue(QString::number(resistance, 'f', 0));
+            this->resistance->setValue(resistance, 0);
 
             this->resistance->setSecondLine(
                 QStringLiteral("AVG: ") +
@@ -4019,7 +4123,7 @@ void homeform::update() {
                     speed->setValueFontColor(QStringLiteral("red"));
                     this->pace->setValueFontColor(QStringLiteral("red"));
                 }
-                bluetoothManager->device()->currentSpeed().setColor(speed->valueFontColor());
+                bluetoothManager->device()->setMetricColor(bluetoothdevice::SPEED_COLOR, speed->valueFontColor());
             }
         } else if (bluetoothManager->device()->deviceType() == bluetoothdevice::ELLIPTICAL) {
 
@@ -4033,14 +4137,14 @@ void homeform::update() {
                 ((elliptical *)bluetoothManager->device())->averagePace().toString(QStringLiteral("m:ss")) +
                 QStringLiteral(" MAX: ") +
                 ((elliptical *)bluetoothManager->device())->maxPace().toString(QStringLiteral("m:ss")));
-            odometer->setValue(QString::number(bluetoothManager->device()->odometer() * unit_conversion, 'f', 2));
+            odometer->setValue(bluetoothManager->device()->odometer() * unit_conversion, 2);
             resistance = ((elliptical *)bluetoothManager->device())->currentResistance().value();
             peloton_resistance = ((elliptical *)bluetoothManager->device())->pelotonResistance().value();
-            this->peloton_resistance->setValue(QString::number(peloton_resistance, 'f', 0));
+            this->peloton_resistance->setValue(peloton_resistance, 0);
             this->target_resistance->setValue(
                 QString::number(((elliptical *)bluetoothManager->device())->lastRequestedResistance().value(), 'f', 0));
-            this->target_peloton_resistance->setValue(QString::number(
-                ((elliptical *)bluetoothManager->device())->lastRequestedPelotonResistance().value(), 'f', 0));
+            this->target_peloton_resistance->setValue(
+                ((elliptical *)bluetoothManager->device())->lastRequestedPelotonResistance().value(), 0);
             this->resistance->setValue(QString::number(resistance));
             this->peloton_resistance->setSecondLine(
                 QStringLiteral("AVG: ") +
@@ -4057,23 +4161,23 @@ void homeform::update() {
                             .toDouble(),
                     'f', 0));
             inclination = ((elliptical *)bluetoothManager->device())->currentInclination().value();
-            this->inclination->setValue(QString::number(inclination, 'f', 1));
+            this->inclination->setValue(inclination, 1);
             this->inclination->setSecondLine(
                 QStringLiteral("AVG: ") +
                 QString::number(((elliptical *)bluetoothManager->device())->currentInclination().average(), 'f', 1) +
                 QStringLiteral(" MAX: ") +
                 QString::number(((elliptical *)bluetoothManager->device())->currentInclination().max(), 'f', 1));
-            elevation->setValue(QString::number(((elliptical *)bluetoothManager->device())->elevationGain().value() *
-                                                    meter_feet_conversion,
-                                                'f', (miles ? 0 : 1)));
+            elevation->setValue(
+                ((elliptical *)bluetoothManager->device())->elevationGain().value() * meter_feet_conversion,
+                (miles ? 0 : 1));
             elevation->setSecondLine(
                 QString::number(((elliptical *)bluetoothManager->device())->elevationGain().rate1s() * 60.0 *
                                     meter_feet_conversion,
                                 'f', (miles ? 0 : 1)) +
                 " /min");
             this->gears->setValue(QString::number(((elliptical *)bluetoothManager->device())->gears()));
-            this->target_speed->setValue(QString::number(
-                ((elliptical *)bluetoothManager->device())->lastRequestedSpeed().value() * unit_conversion, 'f', 1));
+            this->target_speed->setValue(
+                ((elliptical *)bluetoothManager->device())->lastRequestedSpeed().value() * unit_conversion, 1);
 
             this->target_cadence->setValue(
                 QString::number(((elliptical *)bluetoothManager->device())->lastRequestedCadence().value(), 'f', 0));
@@ -4121,10 +4225,8 @@ void homeform::update() {
                 } else {
                     this->peloton_resistance->setValueFontColor(QStringLiteral("orange"));
                 }
-                if (bluetoothManager->device()->deviceType() == bluetoothdevice::BIKE)
-                    ((bike *)bluetoothManager->device())
-                        ->pelotonResistance()
-                        .setColor(this->peloton_resistance->valueFontColor());
+                bluetoothManager->device()->setMetricColor(bluetoothdevice::PELOTON_RESISTANCE_COLOR,
+                                                           this->peloton_resistance->valueFontColor());
             }
 
             int16_t lower_cadence = trainProgram->currentRow().lower_cadence;
@@ -4147,7 +4249,8 @@ void homeform::update() {
                 } else {
                     this->cadence->setValueFontColor(QStringLiteral("orange"));
                 }
-                bluetoothManager->device()->currentCadence().setColor(this->cadence->valueFontColor());
+                bluetoothManager->device()->setMetricColor(bluetoothdevice::CADENCE_COLOR,
+                                                           this->cadence->valueFontColor());
             }
         }
 
@@ -4243,7 +4346,7 @@ void homeform::update() {
             ftp->setValueFontColor(QStringLiteral("red"));
             watt->setValueFontColor(QStringLiteral("red"));
         }
-        bluetoothManager->device()->wattsMetric().setColor(watt->valueFontColor());
+        bluetoothManager->device()->setMetricColor(bluetoothdevice::WATT_COLOR, watt->valueFontColor());
         bluetoothManager->device()->setPowerZone(ftpZone);
         ftp->setValue(QStringLiteral("Z") + QString::number(ftpZone, 'f', 1));
         ftp->setSecondLine(ftpMinW + QStringLiteral("-") + ftpMaxW + QStringLiteral("W ") +
@@ -4333,79 +4436,79 @@ void homeform::update() {
         double hrCurrentZoneRangeMax = maxHeartRate;
 
         if (percHeartRate <
-            settings.value(QZSettings::heart_rate_zone1, QZSettings::default_heart_rate_zone1).toDouble()) {
+            cachedSettings.heart_rate_zone1) {
             currentHRZone = 1;
             currentHRZone +=
                 (percHeartRate /
-                 settings.value(QZSettings::heart_rate_zone1, QZSettings::default_heart_rate_zone1).toDouble());
+                 cachedSettings.heart_rate_zone1);
             if (currentHRZone >= 2) { // double precision could cause unwanted approximation
                 currentHRZone = 1.9999;
             }
             hrCurrentZoneRangeMax =
-                ((settings.value(QZSettings::heart_rate_zone1, QZSettings::default_heart_rate_zone1).toDouble() *
+                ((cachedSettings.heart_rate_zone1 *
                   maxHeartRate) /
                  100) -
                 1;
             heart->setValueFontColor(QStringLiteral("lightsteelblue"));
         } else if (percHeartRate <
-                   settings.value(QZSettings::heart_rate_zone2, QZSettings::default_heart_rate_zone2).toDouble()) {
+                   cachedSettings.heart_rate_zone2) {
             currentHRZone = 2;
             currentHRZone +=
                 ((percHeartRate -
-                  settings.value(QZSettings::heart_rate_zone1, QZSettings::default_heart_rate_zone1).toDouble()) /
-                 (settings.value(QZSettings::heart_rate_zone2, QZSettings::default_heart_rate_zone2).toDouble() -
-                  settings.value(QZSettings::heart_rate_zone1, QZSettings::default_heart_rate_zone1).toDouble()));
+                  cachedSettings.heart_rate_zone1) /
+                 (cachedSettings.heart_rate_zone2 -
+                  cachedSettings.heart_rate_zone1));
             if (currentHRZone >= 3) { // double precision could cause unwanted approximation
                 currentHRZone = 2.9999;
             }
             hrCurrentZoneRangeMin =
-                (settings.value(QZSettings::heart_rate_zone1, QZSettings::default_heart_rate_zone1).toDouble() *
+                (cachedSettings.heart_rate_zone1 *
                  maxHeartRate) /
                 100;
             hrCurrentZoneRangeMax =
-                ((settings.value(QZSettings::heart_rate_zone2, QZSettings::default_heart_rate_zone2).toDouble() *
+                ((cachedSettings.heart_rate_zone2 *
                   maxHeartRate) /
                  100) -
                 1;
             heart->setValueFontColor(QStringLiteral("green"));
         } else if (percHeartRate <
-                   settings.value(QZSettings::heart_rate_zone3, QZSettings::default_heart_rate_zone3).toDouble()) {
+                   cachedSettings.heart_rate_zone3) {
             currentHRZone = 3;
             currentHRZone +=
                 ((percHeartRate -
-                  settings.value(QZSettings::heart_rate_zone2, QZSettings::default_heart_rate_zone2).toDouble()) /
-                 (settings.value(QZSettings::heart_rate_zone3, QZSettings::default_heart_rate_zone3).toDouble() -
-                  settings.value(QZSettings::heart_rate_zone2, QZSettings::default_heart_rate_zone2).toDouble()));
+                  cachedSettings.heart_rate_zone2) /
+                 (cachedSettings.heart_rate_zone3 -
+                  cachedSettings.heart_rate_zone2));
             if (currentHRZone >= 4) { // double precision could cause unwanted approximation
                 currentHRZone = 3.9999;
             }
             hrCurrentZoneRangeMin =
-                (settings.value(QZSettings::heart_rate_zone2, QZSettings::default_heart_rate_zone2).toDouble() *
+                (cachedSettings.heart_rate_zone2 *
                  maxHeartRate) /
                 100;
             hrCurrentZoneRangeMax =
-                ((settings.value(QZSettings::heart_rate_zone3, QZSettings::default_heart_rate_zone3).toDouble() *
+                ((cachedSettings.heart_rate_zone3 *
                   maxHeartRate) /
                  100) -
                 1;
             heart->setValueFontColor(QStringLiteral("yellow"));
         } else if (percHeartRate <
-                   settings.value(QZSettings::heart_rate_zone4, QZSettings::default_heart_rate_zone4).toDouble()) {
+                   cachedSettings.heart_rate_zone4) {
             currentHRZone = 4;
             currentHRZone +=
                 ((percHeartRate -
-                  settings.value(QZSettings::heart_rate_zone3, QZSettings::default_heart_rate_zone3).toDouble()) /
-                 (settings.value(QZSettings::heart_rate_zone4, QZSettings::default_heart_rate_zone4).toDouble() -
-                  settings.value(QZSettings::heart_rate_zone3, QZSettings::default_heart_rate_zone3).toDouble()));
+                  cachedSettings.heart_rate_zone3) /
+                 (cachedSettings.heart_rate_zone4 -
+                  cachedSettings.heart_rate_zone3));
             if (currentHRZone >= 5) { // double precision could cause unwanted approximation
                 currentHRZone = 4.9999;
             }
             hrCurrentZoneRangeMin =
-                (settings.value(QZSettings::heart_rate_zone3, QZSettings::default_heart_rate_zone3).toDouble() *
+                (cachedSettings.heart_rate_zone3 *
                  maxHeartRate) /
                 100;
             hrCurrentZoneRangeMax =
-                ((settings.value(QZSettings::heart_rate_zone4, QZSettings::default_heart_rate_zone4).toDouble() *
+                ((cachedSettings.heart_rate_zone4 *
                   maxHeartRate) /
                  100) -
                 1;
@@ -4414,7 +4517,7 @@ void homeform::update() {
             currentHRZone = 5;
             heart->setValueFontColor(QStringLiteral("red"));
             hrCurrentZoneRangeMin =
-                (settings.value(QZSettings::heart_rate_zone4, QZSettings::default_heart_rate_zone4).toDouble() *
+                (cachedSettings.heart_rate_zone4 *
                  maxHeartRate) /
                 100;
         }
@@ -4441,7 +4544,7 @@ void homeform::update() {
             pidHR->setValueFontColor(QStringLiteral("white"));
             break;
         }
-        bluetoothManager->device()->currentHeart().setColor(heart->valueFontColor());
+        bluetoothManager->device()->setMetricColor(bluetoothdevice::HEART_COLOR, heart->valueFontColor());
         bluetoothManager->device()->setHeartZone(currentHRZone);
         Z = QStringLiteral("Z") + QString::number(currentHRZone, 'f', 1);
         heart->setSecondLine(Z + QStringLiteral(" AVG: ") +
@@ -5142,6 +5245,12 @@ void homeform::update() {
                 bluetoothManager->device()->currentCordinate(), strideLength, groundContact, verticalOscillation);
 
             Session.append(s);
+            sessionPowerCurve.append(s.elapsedTime, s.watt);
+            chartWatt.append(s.watt);
+            chartHeart.append(s.heart);
+            chartCadence.append(s.cadence);
+            chartResistance.append(s.resistance);
+            chartPelotonResistance.append(s.peloton_resistance);
 
             if (lapTrigger) {
                 lapTrigger = false;
@@ -5305,7 +5414,7 @@ void homeform::fit_save_clicked() {
         if (!stravaPelotonActivityName.isEmpty() && !stravaPelotonInstructorName.isEmpty())
             workoutName = stravaPelotonActivityName + " - " + stravaPelotonInstructorName;
 
-        qfit::save(filename, Session, dev->deviceType(),
+        qfit::save(filename, Session.toList(), dev->deviceType(),
                    qobject_cast<m3ibike *>(dev) ? QFIT_PROCESS_DISTANCENOISE : QFIT_PROCESS_NONE,
                    stravaPelotonWorkoutType, workoutName, dev->bluetoothDevice.name());
         lastFitFileSaved = filename;
@@ -5349,9 +5458,7 @@ void homeform::gpx_open_clicked(const QUrl &fileName) {
             for (const auto &p : g_list) {
                 trainrow r;
                 if (p.speed > 0 && i > 0) {
-                    QGeoCoordinate p1(last.latitude, last.longitude);
-                    QGeoCoordinate p2(p.latitude, p.longitude, p.elevation);
-                    r.azimuth = p1.azimuthTo(p2);
+                    r.azimuth = p.azimuth;
                     r.speed = p.speed;
                     r.distance = p.distance;
                     r.duration = QTime(0, 0, 0, 0);
@@ -5368,9 +5475,7 @@ void homeform::gpx_open_clicked(const QUrl &fileName) {
 
                 } else {
                     if (i > 0) {
-                        QGeoCoordinate p1(last.latitude, last.longitude);
-                        QGeoCoordinate p2(p.latitude, p.longitude, p.elevation);
-                        r.azimuth = p1.azimuthTo(p2);
+                        r.azimuth = p.azimuth;
                         r.distance = p.distance;
                         r.altitude = last.elevation;
                         r.inclination = p.inclination;
@@ -5925,6 +6030,36 @@ QByteArray homeform::currentPelotonImage() {
     return QByteArray();
 }
 
+void homeform::update_chart_series(QObject *series, const QString &name, int maxPoints) {
+    QtCharts::QXYSeries *xySeries = qobject_cast<QtCharts::QXYSeries *>(series);
+    if (!xySeries) {
+        qDebug() << QStringLiteral("update_chart_series: not a XY series") << name;
+        return;
+    }
+
+    const chartseries *source = nullptr;
+    if (name == QStringLiteral("watt"))
+        source = &chartWatt;
+    else if (name == QStringLiteral("heart"))
+        source = &chartHeart;
+    else if (name == QStringLiteral("cadence"))
+        source = &chartCadence;
+    else if (name == QStringLiteral("resistance"))
+        source = &chartResistance;
+    else if (name == QStringLiteral("peloton_resistance"))
+        source = &chartPelotonResistance;
+    if (!source) {
+        qDebug() << QStringLiteral("update_chart_series: unknown series") << name;
+        return;
+    }
+
+    // a sample per second, the time axis is in ms
+    QVector<QPointF> points = source->points(maxPoints, 1000.0);
+    qDebug() << QStringLiteral("update_chart_series") << name << source->size() << points.size();
+    // replace() redraws the series once, append() redraws it for every point
+    xySeries->replace(points);
+}
+
 void homeform::sendMail() {
 
     QSettings settings;
@@ -6050,22 +6185,23 @@ void homeform::sendMail() {
         QStringLiteral("Moving Time: ") + bluetoothManager->device()->movingTime().toString() + QStringLiteral("\n");
     textMessage += QStringLiteral("Weight Loss (") + weightLossUnit + "): " + QString::number(WeightLoss, 'f', 2) +
                    QStringLiteral("\n");
-    textMessage += QStringLiteral("Estimated VO2Max: ") + QString::number(metric::calculateVO2Max(&Session), 'f', 0) +
+    textMessage += QStringLiteral("Estimated VO2Max: ") +
+                   QString::number(metric::calculateVO2Max(sessionPowerCurve), 'f', 0) +
                    QStringLiteral("\n");
-    double peak = metric::powerPeak(&Session, 5);
+    double peak = sessionPowerCurve.best(5);
     double weightKg = settings.value(QZSettings::weight, QZSettings::default_weight).toFloat();
     textMessage += QStringLiteral("5 Seconds Power: ") + QString::number(peak, 'f', 0) +
                    QStringLiteral("W ") + QString::number(peak/weightKg, 'f', 1) + QStringLiteral("W/Kg\n");
-    peak = metric::powerPeak(&Session, 60);
+    peak = sessionPowerCurve.best(60);
     textMessage += QStringLiteral("1 Minute Power: ") + QString::number(peak, 'f', 0) +
                    QStringLiteral("W ") + QString::number(peak/weightKg, 'f', 1) + QStringLiteral("W/Kg\n");
-    peak = metric::powerPeak(&Session, 5 * 60);
+    peak = sessionPowerCurve.best(5 * 60);
     textMessage += QStringLiteral("5 Minutes Power: ") + QString::number(peak, 'f', 0) +
                    QStringLiteral("W ") + QString::number(peak/weightKg, 'f', 1) + QStringLiteral("W/Kg\n");    
 
     // FTP
     double ftpSetting = settings.value(QZSettings::ftp, QZSettings::default_ftp).toDouble();
-    peak = (metric::powerPeak(&Session, 20 * 60) * 0.95) * 0.95;
+    peak = (sessionPowerCurve.best(20 * 60) * 0.95) * 0.95;
     textMessage += QStringLiteral("Estimated FTP: ") + QString::number(peak, 'f', 0) +
                    QStringLiteral("W ");
     if(peak > ftpSetting) {
@@ -6342,6 +6478,7 @@ void homeform::loadSettings(const QUrl &filename) {
             }
         }
     }
+    qzsettingscache::instance()->invalidate();
 }
 
 void homeform::deleteSettings(const QUrl &filename) { QFile(filename.toLocalFile()).remove(); }
@@ -6400,7 +6537,8 @@ void homeform::clearFiles() {
     QFileInfoList list = dir.entryInfoList(QDir::Files);
     foreach (QFileInfo f, list) {
         if (!f.suffix().toLower().compare("log") || !f.suffix().toLower().compare("jpg") ||
-            !f.suffix().toLower().compare("fit") || !f.suffix().toLower().compare("png")) {
+            !f.suffix().toLower().compare("fit") || !f.suffix().toLower().compare("png") ||
+            f.fileName().toLower().endsWith(QStringLiteral(".log.gz"))) {
             QFile::remove(f.filePath());
         }
     }
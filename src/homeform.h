@@ -3,9 +3,13 @@
 
 #include "PathController.h"
 #include "bluetooth.h"
+#include "chartseries.h"
 #include "fit_profile.hpp"
 #include "gpx.h"
 #include "peloton.h"
+#include "powercurve.h"
+#include "qfitstream.h"
+#include "sessionstore.h"
 #include "qmdnsengine/browser.h"
 #include "qmdnsengine/cache.h"
 #include "qmdnsengine/resolver.h"
@@ -64,12 +68,25 @@ class DataObject : public QObject {
                const QString largeButtonColor = QZSettings::default_tile_preset_resistance_1_color);
     void setName(const QString &value);
     void setValue(const QString &value);
+
+    /**
+     * @brief setValue Shows the number with the given decimals. The text is formatted only when the number or the
+     * decimals change, so the tiles can be refreshed every second without allocating a new string each time.
+     */
+    void setValue(double value, int decimals);
     void setSecondLine(const QString &value);
     void setValueFontSize(int value);
     void setValueFontColor(const QString &value);
     void setLabelFontSize(int value);
     void setVisible(bool visible);
     void setGridId(int id);
+
+    /**
+     * @brief setShown Marks the tile as part of the grid. The value and the second line of a tile that isn't are
+     * stored without being formatted or notified, and are flushed to QML when the tile is shown again.
+     */
+    void setShown(bool shown);
+    bool shown() const { return m_shown; }
     QString name() { return m_name; }
     QString icon() { return m_icon; }
     QString value() { return m_value; }
@@ -98,6 +115,10 @@ class DataObject : public QObject {
     int m_labelFontSize;
     bool m_writable;
     bool m_visible = true;
+    bool m_shown = false;
+    bool m_stale = false;
+    double m_number = qQNaN();
+    int m_decimals = -1;
     bool m_largeButton = false;
     QString m_largeButtonLabel = QLatin1String("");
     QString m_largeButtonColor = QZSettings::default_tile_preset_resistance_1_color;
@@ -162,6 +183,8 @@ class homeform : public QObject {
     Q_PROPERTY(QString instructorName READ instructorName)
     Q_PROPERTY(int workout_sample_points READ workout_sample_points)
     Q_PROPERTY(QList<double> workout_watt_points READ workout_watt_points)
+    Q_PROPERTY(QList<double> workout_power_curve_seconds READ workout_power_curve_seconds)
+    Q_PROPERTY(QList<double> workout_power_curve_watts READ workout_power_curve_watts)
     Q_PROPERTY(QList<double> workout_heart_points READ workout_heart_points)
     Q_PROPERTY(QList<double> workout_cadence_points READ workout_cadence_points)
     Q_PROPERTY(QList<double> workout_peloton_resistance_points READ workout_peloton_resistance_points)
@@ -220,6 +243,13 @@ class homeform : public QObject {
         });
     }
 
+    /**
+     * @brief update_chart_series Fills a LineSeries of the charts with a series of the session in one go, downsampled
+     * to maxPoints keeping the peaks.
+     * @param name watt, heart, cadence, resistance or peloton_resistance
+     */
+    Q_INVOKABLE void update_chart_series(QObject *series, const QString &name, int maxPoints);
+
     Q_INVOKABLE void update_chart_power(QQuickItem *item) {
         if (QGraphicsScene *scene = item->findChild<QGraphicsScene *>()) {
             auto items_list = scene->items();
@@ -473,46 +503,25 @@ class homeform : public QObject {
     Q_INVOKABLE void moveTile(QString name, int newIndex, int oldIndex);
     DataObject *tileFromName(QString name);
 
-    QList<double> workout_watt_points() {
-        QList<double> l;
-        l.reserve(Session.size() + 1);
-        for (const SessionLine &s : qAsConst(Session)) {
-            l.append(s.watt);
-        }
-        return l;
-    }
-    QList<double> workout_heart_points() {
-        QList<double> l;
-        l.reserve(Session.size() + 1);
-        for (const SessionLine &s : qAsConst(Session)) {
-            l.append(s.heart);
-        }
-        return l;
-    }
-    QList<double> workout_cadence_points() {
-        QList<double> l;
-        l.reserve(Session.size() + 1);
-        for (const SessionLine &s : qAsConst(Session)) {
-            l.append(s.cadence);
-        }
-        return l;
-    }
-    QList<double> workout_resistance_points() {
+    QList<double> workout_watt_points() { return Session.watt().toList(); }
+    QList<double> workout_power_curve_seconds() {
         QList<double> l;
-        l.reserve(Session.size() + 1);
-        for (const SessionLine &s : qAsConst(Session)) {
-            l.append(s.resistance);
+        for (const QPointF &p : sessionPowerCurve.curve()) {
+            l.append(p.x());
         }
         return l;
     }
-    QList<double> workout_peloton_resistance_points() {
+    QList<double> workout_power_curve_watts() {
         QList<double> l;
-        l.reserve(Session.size() + 1);
-        for (const SessionLine &s : qAsConst(Session)) {
-            l.append(s.peloton_resistance);
+        for (const QPointF &p : sessionPowerCurve.curve()) {
+            l.append(p.y());
         }
         return l;
     }
+    QList<double> workout_heart_points() { return Session.heart().toList(); }
+    QList<double> workout_cadence_points() { return Session.cadence().toList(); }
+    QList<double> workout_resistance_points() { return Session.resistance().toList(); }
+    QList<double> workout_peloton_resistance_points() { return Session.pelotonResistance().toList(); }
 
     QList<double> preview_workout_watt() {
         QList<double> l;
@@ -560,7 +569,14 @@ class homeform : public QObject {
     TemplateInfoSenderBuilder *userTemplateManager = nullptr;
     TemplateInfoSenderBuilder *innerTemplateManager = nullptr;
     QList<QObject *> dataList;
-    QList<SessionLine> Session;
+    sessionstore Session;
+    powercurve sessionPowerCurve;
+    // the chart series of the session, kept downsampled while it's recorded
+    chartseries chartWatt;
+    chartseries chartHeart;
+    chartseries chartCadence;
+    chartseries chartResistance;
+    chartseries chartPelotonResistance;
     bluetooth *bluetoothManager;
     QQmlApplicationEngine *engine;
     trainprogram *trainProgram = nullptr;
@@ -569,6 +585,7 @@ class homeform : public QObject {
         QStringLiteral("QZ-backup-") +
         QDateTime::currentDateTime().toString().replace(QStringLiteral(":"), QStringLiteral("_")) +
         QStringLiteral(".fit");
+    QScopedPointer<qfitstream> backupStream[2];
 
     int m_topBarHeight = 120;
     QString m_info = QStringLiteral("Connecting...");
@@ -680,6 +697,7 @@ class homeform : public QObject {
     DataObject *pace_last500m;
 
     QTimer *timer;
+    QTimer *tilesTimer = nullptr;
     QTimer *backupTimer;
 
     QString strava_code;
@@ -697,6 +715,8 @@ class homeform : public QObject {
     int16_t fanOverride = 0;
 
     void update();
+    void updateLiveTiles();
+    void updateNextRowsTile(double ftpSetting);
     double heartRateMax();
     void backup();
     bool getDevice();
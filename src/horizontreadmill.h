@@ -46,8 +46,10 @@ class horizontreadmill : public treadmill {
 
     bool autoPauseWhenSpeedIsZero() override;
     bool autoStartWhenSpeedIsGreaterThenZero() override;
+    bool replayNotification(const QBluetoothUuid &uuid, const QByteArray &value) override;
 
   private:
+    void parseNotification(const QBluetoothUuid &uuid, const QByteArray &newValue);
     void writeCharacteristic(QLowEnergyService *service, QLowEnergyCharacteristic characteristic, uint8_t *data,
                              uint8_t data_len, QString info, bool disable_log = false, bool wait_for_response = false);
     void waitForAPacket();
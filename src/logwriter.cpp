@@ -0,0 +1,324 @@
+#include "logwriter.h"
+
+#include <QDateTime>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <stdio.h>
+#include <string.h>
+
+// set while a thread writes the queue to the file: a message it logs meanwhile (e.g. a warning of QFile) is only
+// queued, the drain in progress writes it. Waiting on the high water mark or taking the mutex there would block the
+// writer on itself
+static thread_local bool writing = false;
+
+logwriter::logwriter(const QString &fileName, qint64 maxSize, qint64 maxAge, bool compress, QObject *parent)
+    : QThread(parent), fileName(fileName), maxSize(maxSize), maxAge(maxAge), compress(compress) {
+    // the queue always holds a node, the one the writer consumed last
+    tail = new entry;
+    head.store(tail);
+    current = fileName;
+}
+
+logwriter::~logwriter() {
+    stop();
+    // a producer that checked synchronous before stop() may have pushed after its drain
+    QMutexLocker locker(&mutex);
+    drain();
+    if (file.isOpen())
+        file.flush();
+    delete tail;
+}
+
+void logwriter::append(QtMsgType type, const QMessageLogContext &context, const QString &msg) {
+    entry *e = new entry;
+    e->type = type;
+    e->time = QDateTime::currentMSecsSinceEpoch();
+    e->msg = msg;
+    // the context strings aren't always static (e.g. the QML ones), and they are null in the release builds
+    if (context.file)
+        e->file = QByteArray(context.file);
+    if (context.function)
+        e->function = QByteArray(context.function);
+    if (context.category && strcmp(context.category, "default"))
+        e->category = QByteArray(context.category);
+
+    if (writing) {
+        push(e);
+        return;
+    }
+
+    if (synchronous.load()) {
+        // the writer is gone, whoever logs writes the line
+        QMutexLocker locker(&mutex);
+        push(e);
+        drain();
+        if (file.isOpen())
+            file.flush();
+        return;
+    }
+
+    if (pending.load(std::memory_order_relaxed) >= highWaterMark) {
+        // lossless: rather than dropping the message, wait for the writer to catch up
+        waiting++;
+        QMutexLocker locker(&mutex);
+        while (pending.load() >= highWaterMark && !synchronous.load()) {
+            queued.wakeOne();
+            drained.wait(&mutex, 10);
+        }
+        waiting--;
+    }
+
+    push(e);
+
+    // stop() may have drained the queue for the last time between the check above and the push: then the line is
+    // written here, as in the synchronous mode
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (synchronous.load()) {
+        QMutexLocker locker(&mutex);
+        drain();
+        if (file.isOpen())
+            file.flush();
+    }
+}
+
+void logwriter::push(entry *e) {
+    if (pending.fetch_add(1) == 0)
+        queued.wakeOne();
+    entry *prev = head.exchange(e, std::memory_order_acq_rel);
+    prev->next.store(e, std::memory_order_release);
+}
+
+bool logwriter::pop(entry &out) {
+    entry *t = tail;
+    entry *next = t->next.load(std::memory_order_acquire);
+    if (!next)
+        return false;
+    out.type = next->type;
+    out.time = next->time;
+    out.msg.swap(next->msg);
+    out.file.swap(next->file);
+    out.function.swap(next->function);
+    out.category.swap(next->category);
+    tail = next;
+    delete t;
+    return true;
+}
+
+int logwriter::drain() {
+    const bool reentered = writing;
+    writing = true;
+    entry e;
+    int n = 0, total = 0;
+    while (pop(e)) {
+        write(e);
+        // the producers waiting on the high water mark don't have to wait for the whole batch
+        if (++n == 256) {
+            pending.fetch_sub(n);
+            total += n;
+            n = 0;
+            if (waiting.load())
+                drained.wakeAll();
+        }
+    }
+    if (n) {
+        pending.fetch_sub(n);
+        total += n;
+        if (waiting.load())
+            drained.wakeAll();
+    }
+    writing = reentered;
+    return total;
+}
+
+void logwriter::run() {
+    while (true) {
+        drain();
+        if (file.isOpen())
+            file.flush();
+        if (stopping.load() && pending.load() <= 0)
+            break;
+        QMutexLocker locker(&mutex);
+        if (pending.load() <= 0 && !stopping.load())
+            queued.wait(&mutex, 100);
+    }
+}
+
+void logwriter::stop() {
+    if (synchronous.load())
+        return;
+    stopping.store(true);
+    queued.wakeOne();
+    wait();
+    QMutexLocker locker(&mutex);
+    synchronous.store(true);
+    // pairs with the fence of append(): a push this drain doesn't see finds synchronous set
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    // what was queued while the writer was ending
+    drain();
+    if (file.isOpen())
+        file.flush();
+    drained.wakeAll();
+}
+
+QString logwriter::currentFileName() const {
+    QMutexLocker locker(&nameMutex);
+    return current;
+}
+
+void logwriter::write(const entry &e) {
+    if (limited(e))
+        return;
+
+    QString txt = QDateTime::fromMSecsSinceEpoch(e.time).toString() + QStringLiteral(" ") + QString::number(e.time) +
+                  QStringLiteral(" ");
+    QString file = QString::fromUtf8(e.file);
+    QString function = QString::fromUtf8(e.function);
+    switch (e.type) {
+    case QtInfoMsg:
+        txt += QStringLiteral("Info: %1 %2 %3\n").arg(file, function, e.msg);
+        break;
+    case QtDebugMsg:
+        txt += QStringLiteral("Debug: %1 %2 %3\n").arg(file, function, e.msg);
+        break;
+    case QtWarningMsg:
+        txt += QStringLiteral("Warning: %1 %2 %3\n").arg(file, function, e.msg);
+        break;
+    case QtCriticalMsg:
+        txt += QStringLiteral("Critical: %1 %2 %3\n").arg(file, function, e.msg);
+        break;
+    case QtFatalMsg:
+        txt += QStringLiteral("Fatal: %1 %2 %3\n").arg(file, function, e.msg);
+        break;
+    }
+    writeLine(txt, e.time);
+}
+
+void logwriter::writeLine(const QString &txt, qint64 time) {
+    QByteArray line = txt.toUtf8();
+
+    if (file.isOpen() && ((maxSize > 0 && written > 0 && written + line.size() > maxSize) ||
+                          (maxAge > 0 && time - opened > maxAge * 1000))) {
+        closePart();
+        part++;
+    }
+    if (!file.isOpen())
+        openPart(time);
+    if (file.isOpen()) {
+        file.write(line);
+        written += line.size();
+    }
+
+    if (echo)
+        fprintf(stderr, "%s", txt.toLocal8Bit().constData());
+}
+
+bool logwriter::limited(const entry &e) {
+    if (rateLimit <= 0 || e.category.isEmpty())
+        return false;
+
+    bucket &b = buckets[e.category];
+    qint64 second = e.time / 1000;
+    if (second != b.second) {
+        if (b.suppressed)
+            writeLine(QDateTime::fromMSecsSinceEpoch(e.time).toString() + QStringLiteral(" ") +
+                          QString::number(e.time) +
+                          QStringLiteral(" Warning: %1 lines of %2 suppressed\n")
+                              .arg(b.suppressed)
+                              .arg(QString::fromUtf8(e.category)),
+                      e.time);
+        b.second = second;
+        b.lines = 0;
+        b.suppressed = 0;
+    }
+    if (b.lines >= rateLimit) {
+        b.suppressed++;
+        return true;
+    }
+    b.lines++;
+    return false;
+}
+
+QString logwriter::partName(int part) const {
+    if (part <= 1)
+        return fileName;
+    QFileInfo info(fileName);
+    QString name = info.path() + QStringLiteral("/") + info.completeBaseName() + QStringLiteral("-") +
+                   QString::number(part);
+    if (!info.suffix().isEmpty())
+        name += QStringLiteral(".") + info.suffix();
+    return name;
+}
+
+bool logwriter::openPart(qint64 time) {
+    QString name = partName(part);
+    file.setFileName(name);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        fprintf(stderr, "Cannot open the log file %s\n", name.toLocal8Bit().constData());
+        return false;
+    }
+    written = file.size();
+    opened = time;
+    QMutexLocker locker(&nameMutex);
+    current = name;
+    return true;
+}
+
+void logwriter::closePart() {
+    file.close();
+    if (!compress)
+        return;
+
+    QFile log(file.fileName());
+    if (!log.open(QIODevice::ReadOnly))
+        return;
+    QByteArray data = log.readAll();
+    log.close();
+    QFile gz(file.fileName() + QStringLiteral(".gz"));
+    if (gz.open(QIODevice::WriteOnly | QIODevice::Truncate) && gz.write(gzip(data)) > 0 && gz.flush()) {
+        gz.close();
+        log.remove();
+    }
+}
+
+namespace {
+struct crcTable {
+    quint32 values[256];
+    crcTable() {
+        for (quint32 i = 0; i < 256; i++) {
+            quint32 c = i;
+            for (int k = 0; k < 8; k++)
+                c = (c & 1) ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+            values[i] = c;
+        }
+    }
+};
+} // namespace
+
+quint32 logwriter::crc32(const QByteArray &data) {
+    static const crcTable table;
+    quint32 crc = 0xFFFFFFFF;
+    const uchar *p = (const uchar *)data.constData();
+    for (int i = 0; i < data.size(); i++)
+        crc = table.values[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+    return crc ^ 0xFFFFFFFF;
+}
+
+QByteArray logwriter::gzip(const QByteArray &data) {
+    // qCompress gives the size (4 bytes), then a zlib stream: a 2 bytes header, the deflate data and the adler32
+    QByteArray z = qCompress(data, 9);
+    static const char header[10] = {0x1f, (char)0x8b, 0x08, 0, 0, 0, 0, 0, 0x02, (char)0xff};
+    QByteArray out;
+    out.reserve(z.size() + 12);
+    out.append(header, sizeof(header));
+    if (z.size() > 10)
+        out.append(z.constData() + 6, z.size() - 10);
+    else
+        out.append("\x03\x00", 2); // an empty final block
+    quint32 crc = crc32(data);
+    quint32 size = (quint32)data.size();
+    for (int i = 0; i < 4; i++)
+        out.append((char)((crc >> (8 * i)) & 0xFF));
+    for (int i = 0; i < 4; i++)
+        out.append((char)((size >> (8 * i)) & 0xFF));
+    return out;
+}
@@ -0,0 +1,140 @@
+#ifndef LOGWRITER_H
+#define LOGWRITER_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QThread>
+#include <QWaitCondition>
+#include <atomic>
+
+/**
+ * @brief The logwriter class writes the debug log from its own thread, so the threads that log only queue the message.
+ *
+ * The messages go through a lock-free multiple producer, single consumer queue: append() never takes a lock unless
+ * the queue is above its high water mark, in which case the caller waits for the writer to catch up. No message is
+ * ever dropped because the writer is behind, nor because it was logged while the writer was stopping: once stop()
+ * has drained the queue, the producer that pushed after it writes its line. A message logged by the writer itself,
+ * while it writes, is only queued.
+ * The writer keeps the file open, formats the lines as the message handler used to, also writes them to stderr and
+ * flushes every time the queue is empty. The file is rotated when it exceeds a size or an age: the next parts get a
+ * "-2", "-3"... suffix and the closed ones can be gzipped.
+ * The messages of the Qt categories (e.g. qt.bluetooth) can be limited to a number of lines per second, the lines
+ * suppressed are counted in the log. The application category ("default") is never limited.
+ */
+class logwriter : public QThread {
+    Q_OBJECT
+
+  public:
+    /**
+     * @param fileName The first part of the log. It's created with the first message.
+     * @param maxSize The size that starts a new part, 0 to never rotate by size. Unit: bytes
+     * @param maxAge The age that starts a new part, 0 to never rotate by age. Unit: seconds
+     * @param compress Gzip the parts once they are closed.
+     */
+    logwriter(const QString &fileName, qint64 maxSize = 0, qint64 maxAge = 0, bool compress = false,
+              QObject *parent = nullptr);
+    ~logwriter();
+
+    /**
+     * @brief append Queues a message, from any thread.
+     */
+    void append(QtMsgType type, const QMessageLogContext &context, const QString &msg);
+
+    /**
+     * @brief stop Writes what is still queued and ends the thread. The file stays open: from then on append() writes
+     * and flushes the line itself, so the messages logged while the application quits aren't lost.
+     */
+    void stop();
+
+    /**
+     * @brief setHighWaterMark The number of queued messages above which append() waits.
+     */
+    void setHighWaterMark(int messages) { highWaterMark = messages; }
+
+    /**
+     * @brief setRateLimit The lines per second each Qt category can write, 0 for no limit.
+     */
+    void setRateLimit(int linesPerSecond) { rateLimit = linesPerSecond; }
+
+    /**
+     * @brief setEcho Also write the lines to stderr.
+     */
+    void setEcho(bool echo) { this->echo = echo; }
+
+    /**
+     * @brief currentFileName The part being written.
+     */
+    QString currentFileName() const;
+
+    /**
+     * @brief gzip Packs the data in a gzip member (RFC 1952).
+     */
+    static QByteArray gzip(const QByteArray &data);
+
+    static quint32 crc32(const QByteArray &data);
+
+  protected:
+    void run() override;
+
+  private:
+    struct entry {
+        std::atomic<entry *> next{nullptr};
+        QtMsgType type = QtDebugMsg;
+        qint64 time = 0;
+        QString msg;
+        QByteArray file;
+        QByteArray function;
+        // empty for the "default" category
+        QByteArray category;
+    };
+
+    struct bucket {
+        qint64 second = 0;
+        int lines = 0;
+        int suppressed = 0;
+    };
+
+    void push(entry *e);
+    bool pop(entry &out);
+    int drain();
+    void write(const entry &e);
+    void writeLine(const QString &txt, qint64 time);
+    bool openPart(qint64 time);
+    void closePart();
+    bool limited(const entry &e);
+    QString partName(int part) const;
+
+    QString fileName;
+    qint64 maxSize;
+    qint64 maxAge;
+    bool compress;
+    bool echo = true;
+    int highWaterMark = 100000;
+    int rateLimit = 0;
+
+    // the producers swap themselves in at head, the writer consumes from tail
+    std::atomic<entry *> head;
+    entry *tail;
+    std::atomic<int> pending{0};
+    std::atomic<int> waiting{0};
+    std::atomic<bool> stopping{false};
+    // set once the thread has ended: from then on append() writes the line itself
+    std::atomic<bool> synchronous{false};
+    QMutex mutex;
+    QWaitCondition queued;
+    QWaitCondition drained;
+
+    // owned by the writer thread
+    QFile file;
+    int part = 1;
+    qint64 opened = 0;
+    qint64 written = 0;
+    QHash<QByteArray, bucket> buckets;
+    mutable QMutex nameMutex;
+    QString current;
+};
+
+#endif // LOGWRITER_H
@@ -12,8 +12,10 @@
 #include "bluetooth.h"
 #include "domyostreadmill.h"
 #include "homeform.h"
+#include "logwriter.h"
 #include "mainwindow.h"
 #include "qfit.h"
+#include "qzsettingscache.h"
 #include "virtualtreadmill.h"
 #include <QDir>
 #include <QGuiApplication>
@@ -81,6 +83,7 @@ QString logfilename = QStringLiteral("debug-") +
                       QStringLiteral(".log");
 QUrl profileToLoad;
 static const QtMessageHandler QT_DEFAULT_MESSAGE_HANDLER = qInstallMessageHandler(0);
+static logwriter *logWriter = nullptr;
 
 QCoreApplication *createApplication(int &argc, char *argv[]) {
 
@@ -234,8 +237,7 @@ QCoreApplication *createApplication(int &argc, char *argv[]) {
 
 void myMessageOutput(QtMsgType type, const QMessageLogContext &context, const QString &msg) {
 
-    QSettings settings;
-    static bool logdebug = settings.value(QZSettings::log_debug, QZSettings::default_log_debug).toBool();
+    static bool logdebug = QSettings().value(QZSettings::log_debug, QZSettings::default_log_debug).toBool();
 #if defined(Q_OS_LINUX) // Linux OS does not read settings file for now
     if ((logs == false && !forceQml) || (logdebug == false && forceQml))
 #else
@@ -243,40 +245,14 @@ void myMessageOutput(QtMsgType type, const QMessageLogContext &context, const QS
 #endif
         return;
 
-    // QByteArray localMsg = msg.toLocal8Bit(); // NOTE: clazy-unused-non-trivial-variable
-    const char *file = context.file ? context.file : "";
-    const char *function = context.function ? context.function : "";
-    QString txt = QDateTime::currentDateTime().toString() + QStringLiteral(" ") +
-                  QString::number(QDateTime::currentMSecsSinceEpoch()) + QStringLiteral(" ");
-    switch (type) {
-    case QtInfoMsg:
-        txt += QStringLiteral("Info: %1 %2 %3\n").arg(file, function, msg); // NOTE: clazy-qstring-arg
-        break;
-    case QtDebugMsg:
-        txt += QStringLiteral("Debug: %1 %2 %3\n").arg(file, function, msg); // NOTE: clazy-qstring-arg
-        break;
-    case QtWarningMsg:
-        txt += QStringLiteral("Warning: %1 %2 %3\n").arg(file, function, msg); // NOTE: clazy-qstring-arg
-        break;
-    case QtCriticalMsg:
-        txt += QStringLiteral("Critical: %1 %2 %3\n").arg(file, function, msg); // NOTE: clazy-qstring-arg
-        break;
-    case QtFatalMsg:
-        txt += QStringLiteral("Fatal: %1 %2 %3\n").arg(file, function, msg); // NOTE: clazy-qstring-arg
-        abort();
-    }
-
-    if (logs == true || logdebug == true) {
+    // the line is formatted and written (to the file and to stderr) by the log writer thread
+    if ((logs == true || logdebug == true) && logWriter)
+        logWriter->append(type, context, msg);
 
-        QString path = homeform::getWritableAppDir();
-
-        // Linux log files are generated on binary location
-
-        QFile outFile(path + logfilename);
-        outFile.open(QIODevice::WriteOnly | QIODevice::Append);
-        QTextStream ts(&outFile);
-        ts << txt;
-        fprintf(stderr, "%s", txt.toLocal8Bit().constData());
+    if (type == QtFatalMsg) {
+        if (logWriter)
+            logWriter->stop();
+        abort();
     }
     (*QT_DEFAULT_MESSAGE_HANDLER)(type, context, msg);
 }
@@ -364,6 +340,7 @@ int main(int argc, char *argv[]) {
         settings.setValue(QZSettings::run_cadence_sensor, run_cadence_sensor);
         settings.setValue(QZSettings::nordictrack_10_treadmill, nordictrack_10_treadmill);
         settings.setValue(QZSettings::reebok_fr30_treadmill, reebok_fr30_treadmill);
+        qzsettingscache::instance()->invalidate();
     }
 #endif
 
@@ -374,6 +351,17 @@ int main(int argc, char *argv[]) {
     }
 #endif
 
+    // Linux log files are generated on binary location
+    logWriter = new logwriter(
+        homeform::getWritableAppDir() + logfilename,
+        settings.value(QZSettings::log_debug_max_size, QZSettings::default_log_debug_max_size).toLongLong() * 1024 *
+            1024,
+        settings.value(QZSettings::log_debug_max_age, QZSettings::default_log_debug_max_age).toLongLong() * 60,
+        settings.value(QZSettings::log_debug_compress, QZSettings::default_log_debug_compress).toBool());
+    // the Qt categories (e.g. qt.bluetooth) can flood the log with the same warning
+    logWriter->setRateLimit(100);
+    logWriter->start();
+    QObject::connect(app.data(), &QCoreApplication::aboutToQuit, []() { logWriter->stop(); });
     qInstallMessageHandler(myMessageOutput);
     qDebug() << QStringLiteral("version ") << app->applicationVersion();
     foreach (QString s, settings.allKeys()) {
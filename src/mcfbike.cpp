@@ -28,6 +28,7 @@ mcfbike::mcfbike(bool noWriteResistance, bool noHeartService, uint8_t bikeResist
     this->noHeartService = noHeartService;
     this->bikeResistanceGain = bikeResistanceGain;
     this->bikeResistanceOffset = bikeResistanceOffset;
+    setPowerCurve([this](double resistance, double cadence) { return wattsFromResistance(resistance, cadence); });
     initDone = false;
     connect(refresh, &QTimer::timeout, this, &mcfbike::update);
     refresh->start(300ms);
@@ -150,22 +151,16 @@ resistance_t mcfbike::pelotonToBikeResistance(int pelotonResistance) {
 resistance_t mcfbike::resistanceFromPowerRequest(uint16_t power) {
     qDebug() << QStringLiteral("resistanceFromPowerRequest") << Cadence.value();
 
-    for (resistance_t i = 1; i < max_resistance; i++) {
-        if (wattsFromResistance(i) <= power && wattsFromResistance(i + 1) >= power) {
-            qDebug() << QStringLiteral("resistanceFromPowerRequest") << wattsFromResistance(i)
-                     << wattsFromResistance(i + 1) << power;
-            return i;
-        }
-    }
-    if (power < wattsFromResistance(1))
-        return 1;
-    else
-        return max_resistance;
+    return resistanceFromPowerCurve(power);
 }
 
 // TO CHANGE
+double mcfbike::wattsFromResistance(double resistance, double cadence) {
+    return ((10.39 + 1.45 * (resistance - 1.0)) * (exp(0.028 * cadence)));
+}
+
 uint16_t mcfbike::wattsFromResistance(double resistance) {
-    return ((10.39 + 1.45 * (resistance - 1.0)) * (exp(0.028 * (currentCadence().value()))));
+    return wattsFromResistance(resistance, currentCadence().value());
 }
 
 double mcfbike::bikeResistanceToPeloton(double resistance) {
@@ -1,51 +1,56 @@
 #include "metric.h"
+#include "powercurve.h"
 #include "qdebugfixup.h"
 #include "qzsettings.h"
+#include "qzsettingscache.h"
+#include <QElapsedTimer>
 #include <QSettings>
+#include <type_traits>
 
 #ifdef TEST
 static uint32_t random_value_uint32 = 0;
 static uint8_t random_value_uint8 = 0;
 #endif
 
+static_assert(std::is_trivially_copyable<metric::snapshot>::value, "metric::snapshot is copied around freely");
+
 metric::metric() {}
 
 void metric::setType(_metric_type t) { m_type = t; }
 
 void metric::setValue(double v, bool applyGainAndOffset) {
-    QSettings settings;
     if (applyGainAndOffset) {
         if (m_type == METRIC_WATT) {
             if (v > 0) {
-                if (settings.value(QZSettings::watt_gain, QZSettings::default_watt_gain).toDouble() <= 2.00) {
-                    if (settings.value(QZSettings::watt_gain, QZSettings::default_watt_gain).toDouble() != 1.0) {
+                const qzsettingscache::snapshot &settings = qzsettingscache::get();
+                if (settings.watt_gain <= 2.00) {
+                    if (settings.watt_gain != 1.0) {
                         qDebug() << QStringLiteral("watt value was ") << v
-                                 << QStringLiteral("but it will be transformed to")
-                                 << v * settings.value(QZSettings::watt_gain, QZSettings::default_watt_gain).toDouble();
+                                 << QStringLiteral("but it will be transformed to") << v * settings.watt_gain;
                     }
-                    v *= settings.value(QZSettings::watt_gain, QZSettings::default_watt_gain).toDouble();
+                    v *= settings.watt_gain;
                 }
-                if (settings.value(QZSettings::watt_offset, QZSettings::default_watt_offset).toDouble() != 0.0) {
-                    qDebug()
-                        << QStringLiteral("watt value was ") << v << QStringLiteral("but it will be transformed to")
-                        << v + settings.value(QZSettings::watt_offset, QZSettings::default_watt_offset).toDouble();
-                    v += settings.value(QZSettings::watt_offset, QZSettings::default_watt_offset).toDouble();
+                if (settings.watt_offset != 0.0) {
+                    qDebug() << QStringLiteral("watt value was ") << v
+                             << QStringLiteral("but it will be transformed to") << v + settings.watt_offset;
+                    v += settings.watt_offset;
                 }
             }
         } else if (m_type == METRIC_SPEED) {
             if (v > 0) {
-                v *= settings.value(QZSettings::speed_gain, QZSettings::default_speed_gain).toDouble();
-                v += settings.value(QZSettings::speed_offset, QZSettings::default_speed_offset).toDouble();
+                const qzsettingscache::snapshot &settings = qzsettingscache::get();
+                v *= settings.speed_gain;
+                v += settings.speed_offset;
             }
         }
     }
 
-    QDateTime now = QDateTime::currentDateTime();
+    qint64 now = monotonicMs();
     if (v != m_value && v != INFINITY) {
         m_valueChanged = now;
-        if (m_last5.count() > 1) {
+        if (m_last5.count(now) > 1) {
             double diff = v - m_value;
-            double diffFromLastValue = qAbs(now.msecsTo(m_lastChanged));
+            double diffFromLastValue = qAbs(now - m_lastChanged);
             if (diffFromLastValue > 0)
                 m_rateAtSec = diff * (1000.0 / diffFromLastValue);
             else
@@ -62,15 +67,17 @@ void metric::setValue(double v, bool applyGainAndOffset) {
         return;
     }
 
+    if (value() != INFINITY) {
+        for (rollingwindow &w : m_windows)
+            w.append(now, value());
+    }
+
     if (value() != 0 && value() != INFINITY) {
         m_countValue++;
         m_lapCountValue++;
         m_totValue += value();
         m_lapTotValue += value();
-        m_last5.append(value());
-
-        if (m_last5.count() > 5)
-            m_last5.removeAt(0);
+        m_last5.append(now, value());
 
         if (value() < m_min) {
             m_min = value();
@@ -99,6 +106,8 @@ void metric::clear(bool accumulator) {
     m_countValue = 0;
     m_min = 999999999;
     m_last5.clear();
+    for (rollingwindow &w : m_windows)
+        w.clear();
     clearLap(accumulator);
 #ifdef TEST
     random_value_uint8 = 0;
@@ -106,7 +115,7 @@ void metric::clear(bool accumulator) {
 #endif
 }
 
-double metric::value() {
+double metric::value() const {
 #ifdef TEST
     if (m_type != METRIC_ELAPSED) {
         return (double)(rand() % 256);
@@ -118,9 +127,9 @@ double metric::value() {
     return m_value - m_offset;
 }
 
-double metric::lapValue() { return m_value - m_lapOffset; }
+double metric::lapValue() const { return m_value - m_lapOffset; }
 
-double metric::average() {
+double metric::average() const {
     if (m_countValue == 0) {
         return 0;
     } else {
@@ -128,7 +137,7 @@ double metric::average() {
     }
 }
 
-double metric::lapAverage() {
+double metric::lapAverage() const {
     if (m_lapCountValue == 0) {
         return 0;
     } else {
@@ -136,37 +145,72 @@ double metric::lapAverage() {
     }
 }
 
-double metric::average5s() {
-    if (m_last5.count() == 0)
-        return 0;
-    else {
-        double sum = 0;
-        uint8_t c = 0;
-        QMutableListIterator<double> i(m_last5);
-        while (i.hasNext()) {
-            double b = i.next();
-            sum += b;
-            c++;
-        }
+double metric::average5s() const { return m_last5.average(m_lastChanged); }
 
-        if (c > 0)
-            return (sum / c);
-        else
-            return 0;
+void metric::addWindow(qint64 spanMs) {
+    if (!window(spanMs))
+        m_windows.append(rollingwindow(spanMs));
+}
+
+const rollingwindow *metric::window(qint64 spanMs) const {
+    for (const rollingwindow &w : m_windows) {
+        if (w.span() == spanMs)
+            return &w;
     }
+    return nullptr;
+}
+
+double metric::averageOver(qint64 spanMs) const {
+    const rollingwindow *w = window(spanMs);
+    return w ? w->average(monotonicMs()) : 0;
+}
+
+double metric::minOver(qint64 spanMs) const {
+    const rollingwindow *w = window(spanMs);
+    return w ? w->min(monotonicMs()) : 0;
+}
+
+double metric::maxOver(qint64 spanMs) const {
+    const rollingwindow *w = window(spanMs);
+    return w ? w->max(monotonicMs()) : 0;
+}
+
+qint64 metric::monotonicMs() {
+    static QElapsedTimer timer;
+    if (!timer.isValid())
+        timer.start();
+    return timer.elapsed();
+}
+
+QDateTime metric::toDateTime(qint64 monotonic) {
+    return QDateTime::currentDateTime().addMSecs(monotonic - monotonicMs());
+}
+
+metric::snapshot metric::toSnapshot() const {
+    snapshot s;
+    s.value = value();
+    s.average = average();
+    s.min = min();
+    s.max = max();
+    s.lapValue = lapValue();
+    s.lapAverage = lapAverage();
+    s.lapMin = lapMin();
+    s.lapMax = lapMax();
+    s.rate1s = rate1s();
+    return s;
 }
 
 void metric::operator=(double v) { setValue(v); }
 
 void metric::operator+=(double v) { setValue(m_value + v); }
 
-double metric::min() { return m_min; }
+double metric::min() const { return m_min; }
 
-double metric::max() { return m_max; }
+double metric::max() const { return m_max; }
 
-double metric::lapMin() { return m_lapMin; }
+double metric::lapMin() const { return m_lapMin; }
 
-double metric::lapMax() { return m_lapMax; }
+double metric::lapMax() const { return m_lapMax; }
 
 void metric::setPaused(bool p) { paused = p; }
 
@@ -265,75 +309,22 @@ double metric::calculateWeightLoss(double kcal) {
     return kcal / 7716.1854; // comes from 1 lbs = 3500 kcal. Converted to kg
 }
 
-struct IntervalBest {
-    double avg = 0;
-    int64_t start = 0;
-    int64_t stop = 0;
-};
-
-struct CompareBests {
-    // Sort by decreasing power and increasing start time.
-    bool operator()(const IntervalBest &a, const IntervalBest &b) const {
-        if (a.avg > b.avg)
-            return true;
-        if (b.avg > a.avg)
-            return false;
-        return a.start < b.start;
-    }
-};
-
 double metric::powerPeak(QList<SessionLine> *session, int seconds) {
-    QList<IntervalBest> bests;
-    QList<IntervalBest> _results;
-
-    uint windowSize = seconds;
-    double total = 0.0;
-    QList<const SessionLine *> window;
-
-    if (session->count() == 0)
-        return -1;
-
-           // ride is shorter than the window size!
-    if (windowSize > session->last().elapsedTime)
-        return -1;
-
-    int i = 0;
-    // We're looking for intervals with durations in [windowSizeSecs, windowSizeSecs + secsDelta).
-    foreach (SessionLine point, *session) {
-
-        total += point.watt;
-        window.append(&session->at(i));
-        double duration = window.last()->elapsedTime - window.first()->elapsedTime;
-
-        if (duration >= windowSize) {
-            double start = window.first()->elapsedTime;
-            double stop = window.last()->elapsedTime;
-            double avg = total / duration;
-            IntervalBest b;
-            b.start = start;
-            b.stop = stop;
-            b.avg = avg;
-            bests.append(b);
-
-            total -= window.first()->watt;
-            window.removeFirst();
-        }
-        i++;
-    }
-
-    std::sort(bests.begin(), bests.end(), CompareBests());
-
-    return bests.first().avg;
+    powercurve curve(QList<int>() << seconds);
+    for (const SessionLine &s : qAsConst(*session))
+        curve.append(s.elapsedTime, s.watt);
+    return curve.best(seconds);
 }
 
 // VO2 (L/min) = 0.0108 x power (W) + 0.007 x body mass (kg)
 // power = 5 min peak power for a specific ride
-double metric::calculateVO2Max(QList<SessionLine> *session) {       
-    double peak = powerPeak(session, 5*60);
-    QSettings settings;
-    return ((0.0108 * peak + 0.007 * settings.value(QZSettings::weight, QZSettings::default_weight).toFloat()) /
-            settings.value(QZSettings::weight, QZSettings::default_weight).toFloat()) *
-           1000.0;
+double metric::calculateVO2Max(QList<SessionLine> *session) { return calculateVO2Max(powerPeak(session, 5 * 60)); }
+
+double metric::calculateVO2Max(const powercurve &curve) { return calculateVO2Max(curve.best(5 * 60)); }
+
+double metric::calculateVO2Max(double peak5min) {
+    double weight = qzsettingscache::get().weight;
+    return ((0.0108 * peak5min + 0.007 * weight) / weight) * 1000.0;
 }
 
 double metric::calculateKCalfromHR(double HR_AVG, double elapsed) {
@@ -2,10 +2,13 @@
 #define METRIC_H
 
 #include "qdebugfixup.h"
+#include "rollingwindow.h"
 #include "sessionline.h"
 #include <QDateTime>
 #include <math.h>
 
+class powercurve;
+
 class metric {
 
   public:
@@ -17,33 +20,79 @@ class metric {
         METRIC_ELAPSED = 3,
     } _metric_type;
 
+    /**
+     * @brief The snapshot struct is a plain copy of the statistics of a metric, for the code that keeps them or hands
+     * them to another thread. A copy of the metric shares its windows and color, and the next setValue() has to
+     * detach them while that copy is alive; a snapshot is only a few doubles. The devices hand out their metrics by
+     * const reference, so they are read in place when no copy is needed.
+     */
+    struct snapshot {
+        double value = 0;
+        double average = 0;
+        double min = 0;
+        double max = 0;
+        double lapValue = 0;
+        double lapAverage = 0;
+        double lapMin = 0;
+        double lapMax = 0;
+        double rate1s = 0;
+    };
+
     metric();
     void setType(_metric_type t);
     void setValue(double value, bool applyGainAndOffset = true);
-    double value();
-    QDateTime lastChanged() { return m_lastChanged; }
-    QDateTime valueChanged() { return m_valueChanged; }
-    double average();
-    double average5s();
+    double value() const;
+    QDateTime lastChanged() const { return toDateTime(m_lastChanged); }
+    QDateTime valueChanged() const { return toDateTime(m_valueChanged); }
+    double average() const;
+    double average5s() const;
+
+    /**
+     * @brief addWindow Keeps a rolling window of the last spanMs milliseconds of samples, read with averageOver(),
+     * minOver() and maxOver(). Unlike average5s(), the time windows include the zero samples.
+     */
+    void addWindow(qint64 spanMs);
+
+    /**
+     * @brief averageOver Average of the window added with the same span, 0 if there is no such window.
+     */
+    double averageOver(qint64 spanMs) const;
+    double minOver(qint64 spanMs) const;
+    double maxOver(qint64 spanMs) const;
+
+    /**
+     * @brief monotonicMs Milliseconds from a monotonic clock, the time base of the metric windows.
+     */
+    static qint64 monotonicMs();
 
     // rate of the current metric in a second, useful to know how many Kcal i will burn in a
     // minute if i keep the current pace
-    double rate1s() { return m_rateAtSec; }
-
-    double min();
-    double max();
-    double lapValue();
-    double lapAverage();
-    double lapMin();
-    double lapMax();
+    double rate1s() const { return m_rateAtSec; }
+
+    double min() const;
+    double max() const;
+    double lapValue() const;
+    double lapAverage() const;
+    double lapMin() const;
+    double lapMax() const;
+
+    /**
+     * @brief toSnapshot The current value and statistics.
+     */
+    snapshot toSnapshot() const;
+
     void clearLap(bool accumulator);
     void clear(bool accumulator);
     void operator=(double);
     void operator+=(double);
     void setPaused(bool p);
     void setLap(bool accumulator);
-    void setColor(QString color) { m_color = color; }
-    QString color() { return m_color; }
+
+    /**
+     * @brief setColor The color the UI shows the value with, for the web templates.
+     */
+    void setColor(const QString &color) { m_color = color; }
+    QString color() const { return m_color; }
 
     static double calculateMaxSpeedFromPower(double power, double inclination);
     static double calculatePowerFromSpeed(double speed, double inclination);
@@ -51,18 +100,24 @@ class metric {
                                           double speedLimit);
     static double calculateWeightLoss(double kcal);
     static double calculateVO2Max(QList<SessionLine> *session);
+    static double calculateVO2Max(const powercurve &curve);
+    static double calculateVO2Max(double peak5min);
     static double calculateKCalfromHR(double HR_AVG, double elapsed);
 
     static double powerPeak(QList<SessionLine> *session, int seconds);
 
   private:
+    static QDateTime toDateTime(qint64 monotonic);
+    const rollingwindow *window(qint64 spanMs) const;
+
     double m_value = 0;
     double m_totValue = 0;
     double m_countValue = 0;
     double m_min = 999999999;
     double m_max = 0;
     double m_offset = 0;
-    QList<double> m_last5;
+    rollingwindow m_last5 = rollingwindow(0, 5);
+    QVector<rollingwindow> m_windows;
 
     double m_lapOffset = 0;
     double m_lapTotValue = 0;
@@ -70,8 +125,8 @@ class metric {
     double m_lapMin = 999999999;
     double m_lapMax = 0;
 
-    QDateTime m_lastChanged = QDateTime::currentDateTime();
-    QDateTime m_valueChanged = QDateTime::currentDateTime();
+    qint64 m_lastChanged = monotonicMs();
+    qint64 m_valueChanged = monotonicMs();
     double m_rateAtSec = 0;
 
     _metric_type m_type = METRIC_OTHER;
@@ -0,0 +1,122 @@
+#include "ocrworker.h"
+#include <QDebug>
+
+ocrworker::ocrworker(const QString &program, const QStringList &arguments, int startTimeout)
+    : program(program), arguments(arguments), startTimeout(startTimeout) {
+    // the worker logs are read with the answers, a full stderr pipe would block it
+    process.setProcessChannelMode(QProcess::MergedChannels);
+}
+
+ocrworker::~ocrworker() {
+    if (process.state() == QProcess::NotRunning)
+        return;
+
+    // the worker exits when its input is closed
+    process.closeWriteChannel();
+    if (!process.waitForFinished(1000))
+        stop();
+}
+
+bool ocrworker::start() {
+    if (isRunning())
+        return true;
+
+    m_stats.starts++;
+    process.start(program, arguments);
+    if (!process.waitForStarted(startTimeout)) {
+        qDebug() << "ocrworker" << program << arguments << "failed to start" << process.errorString();
+        return false;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    QByteArray line;
+    while (readLine(line, timer, startTimeout)) {
+        if (line == "ready") {
+            qDebug() << "ocrworker" << program << arguments << "ready in" << timer.elapsed() << "ms";
+            return true;
+        }
+        qDebug() << "ocrworker <<" << line;
+    }
+
+    qDebug() << "ocrworker" << program << arguments << "not ready" << process.errorString();
+    stop();
+    return false;
+}
+
+bool ocrworker::request(const QString &command, QString &result, int timeout) {
+    if (!start())
+        return false;
+
+    m_stats.requests++;
+    QByteArray id = QByteArray::number(nextId++);
+    QElapsedTimer timer;
+    timer.start();
+
+    process.write(id + ' ' + command.toUtf8() + '\n');
+    process.waitForBytesWritten(timeout);
+
+    QByteArray line;
+    while (readLine(line, timer, timeout)) {
+        if (line == id || line.startsWith(id + ' ')) {
+            qint64 latency = timer.elapsed();
+            m_stats.responses++;
+            m_stats.lastLatency = latency;
+            m_stats.totalLatency += latency;
+            if (latency > m_stats.maxLatency)
+                m_stats.maxLatency = latency;
+
+            result = QString::fromUtf8(line.mid(id.length() + 1));
+            return true;
+        }
+        qDebug() << "ocrworker <<" << line;
+    }
+
+    if (isRunning()) {
+        m_stats.timeouts++;
+        qDebug() << "ocrworker request" << id << command << "timed out after" << timeout << "ms";
+    } else {
+        qDebug() << "ocrworker" << program << arguments << "exited" << process.exitCode();
+    }
+
+    // a stuck or dead worker is started again by the next request
+    stop();
+    return false;
+}
+
+bool ocrworker::readLine(QByteArray &line, const QElapsedTimer &timer, int timeout) {
+    while (!process.canReadLine()) {
+        qint64 left = timeout - timer.elapsed();
+        if (left <= 0 || !isRunning())
+            return false;
+        process.waitForReadyRead((int)left);
+    }
+
+    line = process.readLine().trimmed();
+    return true;
+}
+
+void ocrworker::stop() {
+    if (process.state() == QProcess::NotRunning)
+        return;
+
+    process.kill();
+    process.waitForFinished(1000);
+}
+
+double ocrworker::statistics::meanLatency() const {
+    if (responses == 0)
+        return 0;
+    return (double)totalLatency / responses;
+}
+
+QString ocrworker::statistics::toString() const {
+    return QStringLiteral("requests %1 responses %2 timeouts %3 starts %4 latency ms last %5 mean %6 max %7")
+        .arg(requests)
+        .arg(responses)
+        .arg(timeouts)
+        .arg(starts)
+        .arg(lastLatency)
+        .arg(meanLatency(), 0, 'f', 1)
+        .arg(maxLatency);
+}
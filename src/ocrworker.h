@@ -0,0 +1,74 @@
+#ifndef OCRWORKER_H
+#define OCRWORKER_H
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QProcess>
+#include <QString>
+#include <QStringList>
+
+/**
+ * @brief The ocrworker class sends the OCR requests to a long-lived worker process, so the interpreter and the OCR
+ * models are loaded once instead of for every frame.
+ *
+ * The protocol is line based, over the standard input and output of the worker:
+ * - the worker writes "ready" once it accepts requests;
+ * - a request is "<id> <command>" and the worker answers "<id> <result>" on a single line.
+ *
+ * Any other line (a late answer to a request that timed out, a log line) is skipped. A request that doesn't get its
+ * answer in time kills the worker, and the next request starts a new one.
+ * The requests are synchronous, so an ocrworker has to be used by the thread that created it.
+ */
+class ocrworker {
+  public:
+    /**
+     * @brief The statistics struct The counters of the worker. Unit of the latencies: milliseconds
+     */
+    struct statistics {
+        int requests = 0;
+        int responses = 0;
+        int timeouts = 0;
+        int starts = 0;
+        qint64 lastLatency = 0;
+        qint64 maxLatency = 0;
+        qint64 totalLatency = 0;
+
+        double meanLatency() const;
+        QString toString() const;
+    };
+
+    /**
+     * @param startTimeout How long the worker can take to become ready. Unit: milliseconds
+     */
+    ocrworker(const QString &program, const QStringList &arguments, int startTimeout = 120000);
+    ~ocrworker();
+
+    /**
+     * @brief start Starts the worker, if it isn't running, and waits for it to be ready.
+     */
+    bool start();
+
+    bool isRunning() const { return process.state() == QProcess::Running; }
+
+    /**
+     * @brief request Sends a command to the worker, starting it if needed, and waits for the answer.
+     * @param timeout Unit: milliseconds
+     * @return false if the worker couldn't be started, died or didn't answer in time.
+     */
+    bool request(const QString &command, QString &result, int timeout);
+
+    const statistics &stats() const { return m_stats; }
+
+  private:
+    bool readLine(QByteArray &line, const QElapsedTimer &timer, int timeout);
+    void stop();
+
+    QString program;
+    QStringList arguments;
+    int startTimeout;
+    QProcess process;
+    quint32 nextId = 1;
+    statistics m_stats;
+};
+
+#endif // OCRWORKER_H
@@ -30,6 +30,7 @@ pafersbike::pafersbike(bool noWriteResistance, bool noHeartService, uint8_t bike
     this->noHeartService = noHeartService;
     this->bikeResistanceGain = bikeResistanceGain;
     this->bikeResistanceOffset = bikeResistanceOffset;
+    setPowerCurve([this](double resistance, double cadence) { return wattsFromResistance(resistance, cadence); });
     initDone = false;
     connect(refresh, &QTimer::timeout, this, &pafersbike::update);
     refresh->start(400ms);
@@ -158,22 +159,16 @@ resistance_t pafersbike::pelotonToBikeResistance(int pelotonResistance) {
 resistance_t pafersbike::resistanceFromPowerRequest(uint16_t power) {
     qDebug() << QStringLiteral("resistanceFromPowerRequest") << Cadence.value();
 
-    for (resistance_t i = 1; i < max_resistance; i++) {
-        if (wattsFromResistance(i) <= power && wattsFromResistance(i + 1) >= power) {
-            qDebug() << QStringLiteral("resistanceFromPowerRequest") << wattsFromResistance(i)
-                     << wattsFromResistance(i + 1) << power;
-            return i;
-        }
-    }
-    if (power < wattsFromResistance(1))
-        return 1;
-    else
-        return max_resistance;
+    return resistanceFromPowerCurve(power);
 }
 
-uint16_t pafersbike::wattsFromResistance(double resistance) {
+double pafersbike::wattsFromResistance(double resistance, double cadence) {
     // to be changed
-    return ((10.39 + 1.45 * (resistance - 1.0)) * (exp(0.028 * (currentCadence().value()))));
+    return ((10.39 + 1.45 * (resistance - 1.0)) * (exp(0.028 * cadence)));
+}
+
+uint16_t pafersbike::wattsFromResistance(double resistance) {
+    return wattsFromResistance(resistance, currentCadence().value());
 }
 
 double pafersbike::bikeResistanceToPeloton(double resistance) {
@@ -0,0 +1,73 @@
+#include "powercurve.h"
+
+const QList<int> &powercurve::ladder() {
+    static const QList<int> durations = {1,   2,   3,   5,   10,  15,   20,   30,   45,   60,   90,
+                                         120, 180, 300, 420, 600, 900, 1200, 1800, 2400, 3600};
+    return durations;
+}
+
+powercurve::powercurve(const QList<int> &durations) {
+    m_windows.reserve(durations.size());
+    for (int seconds : durations) {
+        window w;
+        w.seconds = seconds;
+        m_windows.append(w);
+    }
+}
+
+void powercurve::slide(window &w, int last) const {
+    // the window grows by one sample and, once it covers the duration, the average is a candidate and the first
+    // sample leaves it
+    w.total += m_watts.at(last);
+    double duration = m_elapsed.at(last) - m_elapsed.at(w.first);
+    if (duration >= w.seconds && duration > 0) {
+        double avg = w.total / duration;
+        if (avg > w.best)
+            w.best = avg;
+        w.total -= m_watts.at(w.first);
+        w.first++;
+    }
+}
+
+void powercurve::append(double elapsedSeconds, double watt) {
+    m_elapsed.append(elapsedSeconds);
+    m_watts.append(watt);
+    int last = m_watts.size() - 1;
+    for (window &w : m_windows)
+        slide(w, last);
+}
+
+void powercurve::clear() {
+    m_elapsed.clear();
+    m_watts.clear();
+    for (window &w : m_windows) {
+        w.first = 0;
+        w.total = 0;
+        w.best = -1;
+    }
+}
+
+double powercurve::best(int seconds) const {
+    if (m_watts.isEmpty() || seconds > m_elapsed.last())
+        return -1;
+
+    for (const window &w : m_windows) {
+        if (w.seconds == seconds)
+            return w.best;
+    }
+
+    window w;
+    w.seconds = seconds;
+    for (int i = 0; i < m_watts.size(); i++)
+        slide(w, i);
+    return w.best;
+}
+
+QList<QPointF> powercurve::curve() const {
+    QList<QPointF> points;
+    for (const window &w : m_windows) {
+        if (w.best >= 0)
+            points.append(QPointF(w.seconds, w.best));
+    }
+    return points;
+}
@@ -0,0 +1,57 @@
+#ifndef POWERCURVE_H
+#define POWERCURVE_H
+
+#include <QList>
+#include <QPointF>
+#include <QVector>
+
+/**
+ * @brief The powercurve class computes the mean maximal power curve of a workout while it is recorded.
+ * Each duration of the ladder keeps its own sliding window over the samples (the same window metric::powerPeak
+ * used), so append() costs O(1) per duration and the best efforts are available at any time without walking the
+ * session again. Durations outside of the ladder are computed on demand over the recorded samples.
+ */
+class powercurve {
+  public:
+    /**
+     * @brief ladder The standard durations, in seconds, from 1 s to 60 min.
+     */
+    static const QList<int> &ladder();
+
+    explicit powercurve(const QList<int> &durations = ladder());
+
+    /**
+     * @brief append Adds a power sample. elapsedSeconds must not decrease.
+     */
+    void append(double elapsedSeconds, double watt);
+    void clear();
+
+    int samples() const { return m_watts.size(); }
+
+    /**
+     * @brief best Best average power over the given duration, -1 if the workout is shorter than it.
+     */
+    double best(int seconds) const;
+
+    /**
+     * @brief curve The whole curve, x = duration in seconds, y = best average power. Durations not reached yet are
+     * left out.
+     */
+    QList<QPointF> curve() const;
+
+  private:
+    struct window {
+        int seconds;
+        int first = 0;
+        double total = 0;
+        double best = -1;
+    };
+
+    void slide(window &w, int last) const;
+
+    QVector<double> m_elapsed;
+    QVector<double> m_watts;
+    QVector<window> m_windows;
+};
+
+#endif // POWERCURVE_H
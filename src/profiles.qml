@@ -13,6 +13,8 @@ ColumnLayout {
         property string profile_name: "default"
     }
 
+    Component.onDestruction: settingsCache.invalidateLater();
+
     MessageDialog {
         id: quitDialog
         title: "Profile loaded"
@@ -41,10 +41,12 @@ class proformbike : public bike {
     resistance_t maxResistance() override { return max_resistance; }
     bool inclinationAvailableByHardware() override;
     bool connected() override;
+    bool replayNotification(const QBluetoothUuid &uuid, const QByteArray &value) override;
 
   private:
     resistance_t max_resistance = 16;
     uint16_t wattsFromResistance(resistance_t resistance);
+    double wattsFromResistance(resistance_t resistance, double cadence);
     double GetDistanceFromPacket(QByteArray packet);
     QTime GetElapsedFromPacket(QByteArray packet);
     void btinit();
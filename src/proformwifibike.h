@@ -57,6 +57,7 @@ class proformwifibike : public bike {
     double max_incline_supported = 20;
     void connectToDevice();
     uint16_t wattsFromResistance(resistance_t resistance);
+    double wattsFromResistance(resistance_t resistance, double cadence);
     double GetDistanceFromPacket(QByteArray packet);
     QTime GetElapsedFromPacket(QByteArray packet);
     void btinit();
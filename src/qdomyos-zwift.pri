@@ -73,8 +73,17 @@ DEFINES += QT_DEPRECATED_WARNINGS IO_UNDER_QT SMTP_BUILD NOMINMAX
 
 SOURCES += \
    $$PWD/bkoolbike.cpp \
+   $$PWD/blewritequeue.cpp \
    $$PWD/csafe.cpp \
    $$PWD/csaferower.cpp \
+   $$PWD/devicenamematcher.cpp \
+   $$PWD/chartseries.cpp \
+   $$PWD/ergtable.cpp \
+   $$PWD/logwriter.cpp \
+   $$PWD/powercurve.cpp \
+   $$PWD/ocrworker.cpp \
+   $$PWD/rollingwindow.cpp \
+   $$PWD/sessionstore.cpp \
    $$PWD/fakerower.cpp \
     $$PWD/virtualdevice.cpp \
     $$PWD/androidactivityresultreceiver.cpp \
@@ -213,7 +222,9 @@ SOURCES += \
    proformelliptical.cpp \
 	proformtreadmill.cpp \
 	qfit.cpp \
+	qfitstream.cpp \
     qzsettings.cpp \
+    qzsettingscache.cpp \
    renphobike.cpp \
    rower.cpp \
 	schwinnic4bike.cpp \
@@ -281,8 +292,18 @@ INCLUDEPATH += fit-sdk/
 
 HEADERS += \
    $$PWD/bkoolbike.h \
+   $$PWD/blewritequeue.h \
    $$PWD/csafe.h \
    $$PWD/csaferower.h \
+   $$PWD/devicenamematcher.h \
+   $$PWD/chartseries.h \
+   $$PWD/ergtable.h \
+   $$PWD/gattlayout.h \
+   $$PWD/logwriter.h \
+   $$PWD/powercurve.h \
+   $$PWD/ocrworker.h \
+   $$PWD/rollingwindow.h \
+   $$PWD/sessionstore.h \
    $$PWD/windows_zwift_workout_paddleocr_thread.h \
    $$PWD/fakerower.h \
     virtualdevice.h \
@@ -633,8 +654,10 @@ HEADERS += \
 	proformtreadmill.h \
     qdebugfixup.h \
 	qfit.h \
+	qfitstream.h \
     qmdnsengine_export.h \
     qzsettings.h \
+    qzsettingscache.h \
    renphobike.h \
    rower.h \
 	schwinnic4bike.h \
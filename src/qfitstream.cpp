@@ -0,0 +1,290 @@
+#include "qfitstream.h"
+
+#include <QDebug>
+#include <QSettings>
+
+#include "fit_crc.hpp"
+#include "fit_date_time.hpp"
+
+#include <cstring>
+#include <math.h>
+
+qfitstream::qfitstream(const QString &filename, bluetoothdevice::BLUETOOTH_TYPE type, FIT_SPORT overrideSport,
+                       const QString &bluetooth_device_name)
+    : m_file(filename), m_type(type), m_overrideSport(overrideSport),
+      m_bluetoothDeviceName(bluetooth_device_name) {
+    QSettings settings;
+    m_cadenceHalf = settings
+                        .value(QZSettings::powr_sensor_running_cadence_half_on_strava,
+                               QZSettings::default_powr_sensor_running_cadence_half_on_strava)
+                        .toBool();
+}
+
+qfitstream::~qfitstream() { close(); }
+
+FIT_UINT16 qfitstream::crcAppend(FIT_UINT16 crc, const std::string &bytes) {
+    for (size_t i = 0; i < bytes.size(); i++) {
+        crc = fit::CRC::Get16(crc, (FIT_UINT8)bytes[i]);
+    }
+    return crc;
+}
+
+// the FIT CRC is linear over GF(2): feeding n zero bytes is a 16x16 bit matrix, raised to the n-th power by
+// repeated squaring like zlib's crc32_combine
+static FIT_UINT16 crcMatrixTimes(const FIT_UINT16 *mat, FIT_UINT16 vec) {
+    FIT_UINT16 sum = 0;
+    for (int i = 0; vec; i++, vec >>= 1) {
+        if (vec & 1)
+            sum ^= mat[i];
+    }
+    return sum;
+}
+
+static void crcMatrixSquare(FIT_UINT16 *square, const FIT_UINT16 *mat) {
+    for (int i = 0; i < 16; i++) {
+        square[i] = crcMatrixTimes(mat, mat[i]);
+    }
+}
+
+FIT_UINT16 qfitstream::crcShift(FIT_UINT16 crc, quint64 count) {
+    FIT_UINT16 odd[16];
+    FIT_UINT16 even[16];
+
+    // operator for one zero byte
+    for (int i = 0; i < 16; i++) {
+        odd[i] = fit::CRC::Get16((FIT_UINT16)(1 << i), 0);
+    }
+
+    while (count) {
+        if (count & 1)
+            crc = crcMatrixTimes(odd, crc);
+        count >>= 1;
+        if (!count)
+            break;
+        crcMatrixSquare(even, odd);
+        memcpy(odd, even, sizeof(odd));
+    }
+    return crc;
+}
+
+FIT_SPORT qfitstream::sport() const {
+    if (m_overrideSport != FIT_SPORT_INVALID)
+        return m_overrideSport;
+    else if (m_type == bluetoothdevice::TREADMILL || m_type == bluetoothdevice::ELLIPTICAL)
+        return FIT_SPORT_RUNNING;
+    else if (m_type == bluetoothdevice::ROWING)
+        return FIT_SPORT_ROWING;
+    return FIT_SPORT_CYCLING;
+}
+
+std::string qfitstream::takeEncoded() {
+    std::string bytes = m_buffer.str();
+    m_buffer.str(std::string());
+    m_buffer.clear();
+    return bytes;
+}
+
+bool qfitstream::open(const sessionstore &session) {
+    // same rule as qfit::save: the activity starts with the first sample where the user is moving
+    m_first = -1;
+    for (int i = 0; i < session.length(); i++) {
+        if ((session.at(i).speed > 0 &&
+             (m_type == bluetoothdevice::TREADMILL || m_type == bluetoothdevice::ELLIPTICAL)) ||
+            (session.at(i).cadence > 0 && (m_type == bluetoothdevice::BIKE || m_type == bluetoothdevice::ROWING))) {
+            m_first = i;
+            break;
+        }
+    }
+    if (m_first < 0)
+        return false;
+
+    QFile::remove(m_file.fileName());
+    if (!m_file.open(QIODevice::ReadWrite)) {
+        qDebug() << QStringLiteral("qfitstream: unable to open") << m_file.fileName();
+        return false;
+    }
+
+    m_sessionStart = session.first().time;
+    m_start = fit::DateTime((time_t)m_sessionStart.toSecsSinceEpoch()).GetTimeStamp();
+    m_written = m_first;
+    m_dataEnd = FIT_FILE_HDR_SIZE;
+    m_dataCrc = 0;
+
+    m_encode.reset(new fit::Encode(fit::ProtocolVersion::V20));
+    m_buffer.str(std::string());
+    m_buffer.clear();
+    m_encode->Open(m_buffer);
+    // the real header is written by append(), only the data bytes are kept
+    takeEncoded();
+
+    fit::FileIdMesg fileIdMesg;
+    fileIdMesg.SetType(FIT_FILE_ACTIVITY);
+    if (m_bluetoothDeviceName.toUpper().startsWith(QStringLiteral("DOMYOS")))
+        fileIdMesg.SetManufacturer(FIT_MANUFACTURER_DECATHLON);
+    else
+        fileIdMesg.SetManufacturer(FIT_MANUFACTURER_DEVELOPMENT);
+    fileIdMesg.SetProduct(1);
+    fileIdMesg.SetSerialNumber(12345);
+    fileIdMesg.SetTimeCreated(m_start + m_first);
+    m_encode->Write(fileIdMesg);
+
+    fit::DeveloperDataIdMesg devIdMesg;
+    for (FIT_UINT8 i = 0; i < 16; i++) {
+        devIdMesg.SetApplicationId(i, i);
+    }
+    devIdMesg.SetDeveloperDataIndex(0);
+    m_encode->Write(devIdMesg);
+
+    fit::EventMesg eventMesg;
+    eventMesg.SetEvent(FIT_EVENT_TIMER);
+    eventMesg.SetEventType(FIT_EVENT_TYPE_START);
+    eventMesg.SetData(0);
+    eventMesg.SetEventGroup(0);
+    eventMesg.SetTimestamp(m_start + m_first);
+    m_encode->Write(eventMesg);
+
+    return true;
+}
+
+void qfitstream::close() {
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+    m_written = 0;
+    m_first = -1;
+    m_sessionStart = QDateTime();
+}
+
+std::string qfitstream::trailer(const sessionstore &session) {
+    const SessionLine &first = session.at(m_first);
+    const SessionLine &last = session.last();
+    FIT_DATE_TIME start = m_start + m_first;
+    FIT_DATE_TIME end = m_start + session.length() - 1;
+    FIT_SPORT s = sport();
+
+    // a separate encoder, so its message definitions don't leak in the records encoder state
+    fit::Encode encode(fit::ProtocolVersion::V20);
+    std::stringstream buffer;
+    encode.Open(buffer);
+
+    fit::LapMesg lapMesg;
+    lapMesg.SetIntensity(FIT_INTENSITY_ACTIVE);
+    lapMesg.SetStartTime(start);
+    lapMesg.SetTimestamp(end);
+    lapMesg.SetEvent(FIT_EVENT_LAP);
+    lapMesg.SetEventType(FIT_EVENT_TYPE_STOP);
+    lapMesg.SetLapTrigger(FIT_LAP_TRIGGER_SESSION_END);
+    lapMesg.SetTotalElapsedTime(last.elapsedTime - first.elapsedTime);
+    lapMesg.SetTotalTimerTime(last.elapsedTime - first.elapsedTime);
+    lapMesg.SetTotalDistance((last.distance - first.distance) * 1000.0); // meters
+    lapMesg.SetSport(s);
+    encode.Write(lapMesg);
+
+    fit::SessionMesg sessionMesg;
+    sessionMesg.SetTimestamp(end);
+    sessionMesg.SetStartTime(start);
+    sessionMesg.SetTotalElapsedTime(last.elapsedTime);
+    sessionMesg.SetTotalTimerTime(last.time.toSecsSinceEpoch() - first.time.toSecsSinceEpoch());
+    sessionMesg.SetTotalDistance((last.distance - first.distance) * 1000.0); // meters
+    sessionMesg.SetTotalCalories(last.calories);
+    sessionMesg.SetTotalMovingTime(last.elapsedTime);
+    sessionMesg.SetEvent(FIT_EVENT_SESSION);
+    sessionMesg.SetEventType(FIT_EVENT_TYPE_STOP);
+    sessionMesg.SetFirstLapIndex(0);
+    sessionMesg.SetNumLaps(1);
+    sessionMesg.SetTrigger(FIT_SESSION_TRIGGER_ACTIVITY_END);
+    sessionMesg.SetMessageIndex(FIT_MESSAGE_INDEX_RESERVED);
+    sessionMesg.SetSport(s);
+    if (m_type == bluetoothdevice::ROWING) {
+        sessionMesg.SetSubSport(FIT_SUB_SPORT_INDOOR_ROWING);
+        if (last.totalStrokes)
+            sessionMesg.SetTotalStrokes(last.totalStrokes);
+    }
+    encode.Write(sessionMesg);
+
+    fit::ActivityMesg activityMesg;
+    activityMesg.SetTimestamp(end);
+    activityMesg.SetTotalTimerTime(last.elapsedTime);
+    activityMesg.SetNumSessions(1);
+    activityMesg.SetType(FIT_ACTIVITY_MANUAL);
+    activityMesg.SetLocalTimestamp(fit::DateTime((time_t)last.time.toSecsSinceEpoch()).GetTimeStamp());
+    activityMesg.SetEvent(FIT_EVENT_ACTIVITY);
+    activityMesg.SetEventType(FIT_EVENT_TYPE_STOP);
+    encode.Write(activityMesg);
+
+    return buffer.str().substr(FIT_FILE_HDR_SIZE);
+}
+
+bool qfitstream::append(const sessionstore &session) {
+    if (m_file.isOpen() &&
+        (session.length() < m_written || session.isEmpty() || session.first().time != m_sessionStart)) {
+        // the workout has been restarted
+        close();
+    }
+
+    if (!m_file.isOpen() && !open(session)) {
+        return false;
+    }
+
+    double startingDistanceOffset = session.at(m_first).distance;
+    for (int i = m_written; i < session.length(); i++) {
+        const SessionLine &sl = session.at(i);
+        fit::RecordMesg newRecord;
+        newRecord.SetHeartRate(sl.heart);
+        newRecord.SetCadence(m_cadenceHalf ? sl.cadence / 2 : sl.cadence);
+        newRecord.SetDistance((sl.distance - startingDistanceOffset) * 1000.0); // meters
+        newRecord.SetSpeed(sl.speed / 3.6);                                     // meter per second
+        newRecord.SetPower(sl.watt);
+        newRecord.SetResistance(sl.resistance);
+        newRecord.SetCalories(sl.calories);
+        if (m_type == bluetoothdevice::TREADMILL) {
+            newRecord.SetStepLength(sl.instantaneousStrideLengthCM * 10);
+            newRecord.SetVerticalOscillation(sl.verticalOscillationMM);
+            newRecord.SetStanceTime(sl.groundContactMS);
+        }
+        if (sl.coordinate.isValid()) {
+            newRecord.SetAltitude(sl.coordinate.altitude());
+            newRecord.SetPositionLat(pow(2, 31) * (sl.coordinate.latitude()) / 180.0);
+            newRecord.SetPositionLong(pow(2, 31) * (sl.coordinate.longitude()) / 180.0);
+        } else {
+            newRecord.SetAltitude(sl.elevationGain);
+        }
+        newRecord.SetTimestamp(m_start + i);
+        m_encode->Write(newRecord);
+    }
+    m_written = session.length();
+
+    // the new records overwrite the previous trailer
+    std::string records = takeEncoded();
+    std::string tail = trailer(session);
+    if (!m_file.seek(m_dataEnd) || m_file.write(records.data(), records.size()) != (qint64)records.size()) {
+        qDebug() << QStringLiteral("qfitstream: write error") << m_file.errorString();
+        return false;
+    }
+    m_dataEnd += records.size();
+    m_dataCrc = crcAppend(m_dataCrc, records);
+
+    FIT_UINT32 dataSize = (FIT_UINT32)(m_dataEnd - FIT_FILE_HDR_SIZE + tail.size());
+
+    FIT_FILE_HDR header;
+    header.header_size = FIT_FILE_HDR_SIZE;
+    header.profile_version = FIT_PROFILE_VERSION;
+    header.protocol_version = fit::versionMap.at(fit::ProtocolVersion::V20).GetVersionByte();
+    memcpy((FIT_UINT8 *)&header.data_type, ".FIT", 4);
+    header.data_size = dataSize;
+    header.crc = fit::CRC::Calc16(&header, FIT_STRUCT_OFFSET(crc, FIT_FILE_HDR));
+    std::string headerBytes((const char *)&header, FIT_FILE_HDR_SIZE);
+
+    // crc(header + data) = crc(header) shifted over the data length, xor crc(data) computed from zero
+    FIT_UINT16 crc = crcShift(crcAppend(0, headerBytes), dataSize) ^ crcAppend(m_dataCrc, tail);
+    tail.push_back((char)(crc & 0xFF));
+    tail.push_back((char)(crc >> 8));
+
+    if (m_file.write(tail.data(), tail.size()) != (qint64)tail.size() || !m_file.resize(m_file.pos()) ||
+        !m_file.seek(0) || m_file.write(headerBytes.data(), headerBytes.size()) != (qint64)headerBytes.size()) {
+        qDebug() << QStringLiteral("qfitstream: write error") << m_file.errorString();
+        return false;
+    }
+    m_file.flush();
+    return true;
+}
@@ -0,0 +1,94 @@
+#ifndef QFITSTREAM_H
+#define QFITSTREAM_H
+
+#include "bluetoothdevice.h"
+#include "fit_encode.hpp"
+#include "fit_profile.hpp"
+#include "sessionstore.h"
+#include <QDateTime>
+#include <QFile>
+#include <QList>
+#include <QScopedPointer>
+#include <sstream>
+
+/**
+ * @brief The qfitstream class writes a FIT activity file incrementally, for the crash backups taken during a
+ * workout. The file stays open; every append() writes only the SessionLine records added since the previous
+ * call, then rewrites the small lap/session/activity trailer, the file header and the file CRC. The CRC of the
+ * data already on disk is carried over, so a checkpoint costs O(new records) and the file is a complete,
+ * decodable FIT file after each one.
+ */
+class qfitstream {
+  public:
+    qfitstream(const QString &filename, bluetoothdevice::BLUETOOTH_TYPE type,
+               FIT_SPORT overrideSport = FIT_SPORT_INVALID, const QString &bluetooth_device_name = QString());
+    ~qfitstream();
+
+    /**
+     * @brief append Writes the records of the session not written yet and refreshes the trailer, header and CRC.
+     * If the session does not start with the sample the file was opened on, or is shorter than what has been
+     * written, a new workout has started and the file is rewritten.
+     * @return false if the file could not be written.
+     */
+    bool append(const sessionstore &session);
+
+    /**
+     * @brief reset Forgets the current workout, the next append() rewrites the file from the first sample.
+     */
+    void reset() { close(); }
+
+    /**
+     * @brief written Number of session lines consumed so far.
+     */
+    int written() const { return m_written; }
+
+    bluetoothdevice::BLUETOOTH_TYPE type() const { return m_type; }
+    FIT_SPORT overrideSport() const { return m_overrideSport; }
+
+    /**
+     * @brief crcAppend Continues the FIT CRC over a block of bytes.
+     */
+    static FIT_UINT16 crcAppend(FIT_UINT16 crc, const std::string &bytes);
+
+    /**
+     * @brief crcShift Advances a CRC state over count zero bytes, in O(log count).
+     */
+    static FIT_UINT16 crcShift(FIT_UINT16 crc, quint64 count);
+
+  private:
+    bool open(const sessionstore &session);
+    void close();
+    std::string takeEncoded();
+    std::string trailer(const sessionstore &session);
+    FIT_SPORT sport() const;
+
+    QFile m_file;
+    bluetoothdevice::BLUETOOTH_TYPE m_type;
+    FIT_SPORT m_overrideSport;
+    QString m_bluetoothDeviceName;
+    bool m_cadenceHalf = false;
+
+    QScopedPointer<fit::Encode> m_encode;
+    std::stringstream m_buffer;
+
+    int m_first = -1;
+    int m_written = 0;
+    FIT_DATE_TIME m_start = 0;
+
+    /**
+     * @brief m_sessionStart Time of the first sample of the session being written, identifies the workout.
+     */
+    QDateTime m_sessionStart;
+
+    /**
+     * @brief m_dataEnd File offset where the trailer starts, i.e. just after the last record.
+     */
+    qint64 m_dataEnd = FIT_FILE_HDR_SIZE;
+
+    /**
+     * @brief m_dataCrc CRC of the data bytes between the header and m_dataEnd, computed from a zero state.
+     */
+    FIT_UINT16 m_dataCrc = 0;
+};
+
+#endif // QFITSTREAM_H
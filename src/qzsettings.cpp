@@ -676,8 +676,12 @@ const QString QZSettings::ant_speed_gain = QStringLiteral("ant_speed_gain");
 const QString QZSettings::proform_rower_sport_rl = QStringLiteral("proform_rower_sport_rl");
 const QString QZSettings::strava_date_prefix = QStringLiteral("strava_date_prefix");
 const QString QZSettings::race_mode = QStringLiteral("race_mode");
+const QString QZSettings::tiles_refresh_rate = QStringLiteral("tiles_refresh_rate");
+const QString QZSettings::log_debug_max_size = QStringLiteral("log_debug_max_size");
+const QString QZSettings::log_debug_max_age = QStringLiteral("log_debug_max_age");
+const QString QZSettings::log_debug_compress = QStringLiteral("log_debug_compress");
 
-const uint32_t allSettingsCount = 566;
+const uint32_t allSettingsCount = 570;
 
 QVariant allSettings[allSettingsCount][2] = {
     {QZSettings::cryptoKeySettingsProfiles, QZSettings::default_cryptoKeySettingsProfiles},
@@ -1250,6 +1254,10 @@ QVariant allSettings[allSettingsCount][2] = {
     {QZSettings::proform_rower_sport_rl, QZSettings::default_proform_rower_sport_rl},
     {QZSettings::strava_date_prefix, QZSettings::default_strava_date_prefix},
     {QZSettings::race_mode, QZSettings::default_race_mode},
+    {QZSettings::tiles_refresh_rate, QZSettings::default_tiles_refresh_rate},
+    {QZSettings::log_debug_max_size, QZSettings::default_log_debug_max_size},
+    {QZSettings::log_debug_max_age, QZSettings::default_log_debug_max_age},
+    {QZSettings::log_debug_compress, QZSettings::default_log_debug_compress},
 };
 
 void QZSettings::qDebugAllSettings(bool showDefaults) {
@@ -930,6 +930,24 @@ class QZSettings {
      */
     static const QString log_debug;
     static constexpr bool default_log_debug = false;
+
+    /**
+     * @brief The size above which the debug log continues in a new file, 0 to keep a single file. Unit: MB
+     */
+    static const QString log_debug_max_size;
+    static constexpr int default_log_debug_max_size = 0;
+
+    /**
+     * @brief The age after which the debug log continues in a new file, 0 to keep a single file. Unit: minutes
+     */
+    static const QString log_debug_max_age;
+    static constexpr int default_log_debug_max_age = 0;
+
+    /**
+     * @brief Gzip the debug log files once they are complete.
+     */
+    static const QString log_debug_compress;
+    static constexpr bool default_log_debug_compress = false;
     /**
      *@brief Force QZ to communicate ONLY the Heart Rate metric to third-party apps.
      */
@@ -1899,6 +1917,13 @@ class QZSettings {
     static const QString race_mode;
     static constexpr bool default_race_mode = false;
 
+    /**
+     * @brief How many times per second the live tiles (speed, power, cadence, heart rate) are refreshed. The rest of
+     * the UI and the workout recording stay at 1 Hz. Unit: Hz
+     */
+    static const QString tiles_refresh_rate;
+    static constexpr int default_tiles_refresh_rate = 4;
+
     /**
      * @brief Write the QSettings values using the constants from this namespace.
      * @param showDefaults Optionally indicates if the default should be shown with the key.
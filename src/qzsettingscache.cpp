@@ -0,0 +1,78 @@
+#include "qzsettingscache.h"
+#include <QDebug>
+#include <QSettings>
+#include <QThread>
+
+qzsettingscache::qzsettingscache(QObject *parent) : QObject(parent) {}
+
+qzsettingscache *qzsettingscache::instance() {
+    static qzsettingscache *cache = new qzsettingscache();
+    return cache;
+}
+
+const qzsettingscache::snapshot &qzsettingscache::get() {
+    qzsettingscache *cache = instance();
+    Q_ASSERT(QThread::currentThread() == cache->thread());
+    if (cache->m_dirty.testAndSetOrdered(1, 0)) {
+        cache->reload();
+        emit cache->changed();
+    }
+    return cache->m_snapshot;
+}
+
+void qzsettingscache::invalidate() { m_dirty.storeRelease(1); }
+
+void qzsettingscache::invalidateLater() { QMetaObject::invokeMethod(this, "invalidate", Qt::QueuedConnection); }
+
+void qzsettingscache::reload() {
+    QSettings settings;
+    snapshot s;
+    s.watt_gain = settings.value(QZSettings::watt_gain, QZSettings::default_watt_gain).toDouble();
+    s.watt_offset = settings.value(QZSettings::watt_offset, QZSettings::default_watt_offset).toDouble();
+    s.speed_gain = settings.value(QZSettings::speed_gain, QZSettings::default_speed_gain).toDouble();
+    s.speed_offset = settings.value(QZSettings::speed_offset, QZSettings::default_speed_offset).toDouble();
+    s.weight = settings.value(QZSettings::weight, QZSettings::default_weight).toFloat();
+    s.miles_unit = settings.value(QZSettings::miles_unit, QZSettings::default_miles_unit).toBool();
+    s.heart_rate_belt_name =
+        settings.value(QZSettings::heart_rate_belt_name, QZSettings::default_heart_rate_belt_name).toString();
+    s.heart_ignore_builtin =
+        settings.value(QZSettings::heart_ignore_builtin, QZSettings::default_heart_ignore_builtin).toBool();
+    s.power_sensor_name =
+        settings.value(QZSettings::power_sensor_name, QZSettings::default_power_sensor_name).toString();
+    s.power_sensor_as_bike =
+        settings.value(QZSettings::power_sensor_as_bike, QZSettings::default_power_sensor_as_bike).toBool();
+    s.power_sensor_as_treadmill =
+        settings.value(QZSettings::power_sensor_as_treadmill, QZSettings::default_power_sensor_as_treadmill).toBool();
+    s.cadence_sensor_name =
+        settings.value(QZSettings::cadence_sensor_name, QZSettings::default_cadence_sensor_name).toString();
+    s.speed_power_based = settings.value(QZSettings::speed_power_based, QZSettings::default_speed_power_based).toBool();
+    s.peloton_gain = settings.value(QZSettings::peloton_gain, QZSettings::default_peloton_gain).toDouble();
+    s.peloton_offset = settings.value(QZSettings::peloton_offset, QZSettings::default_peloton_offset).toDouble();
+    s.ant_heart = settings.value(QZSettings::ant_heart, QZSettings::default_ant_heart).toBool();
+    s.continuous_moving =
+        settings.value(QZSettings::continuous_moving, QZSettings::default_continuous_moving).toBool();
+    s.instant_power_on_pause =
+        settings.value(QZSettings::instant_power_on_pause, QZSettings::default_instant_power_on_pause).toBool();
+    s.ftp = settings.value(QZSettings::ftp, QZSettings::default_ftp).toDouble();
+    s.power_avg_5s = settings.value(QZSettings::power_avg_5s, QZSettings::default_power_avg_5s).toBool();
+    s.top_bar_enabled = settings.value(QZSettings::top_bar_enabled, QZSettings::default_top_bar_enabled).toBool();
+    s.heart_rate_zone1 = settings.value(QZSettings::heart_rate_zone1, QZSettings::default_heart_rate_zone1).toDouble();
+    s.heart_rate_zone2 = settings.value(QZSettings::heart_rate_zone2, QZSettings::default_heart_rate_zone2).toDouble();
+    s.heart_rate_zone3 = settings.value(QZSettings::heart_rate_zone3, QZSettings::default_heart_rate_zone3).toDouble();
+    s.heart_rate_zone4 = settings.value(QZSettings::heart_rate_zone4, QZSettings::default_heart_rate_zone4).toDouble();
+    s.virtual_device_rower =
+        settings.value(QZSettings::virtual_device_rower, QZSettings::default_virtual_device_rower).toBool();
+    s.powr_sensor_running_cadence_double =
+        settings
+            .value(QZSettings::powr_sensor_running_cadence_double,
+                   QZSettings::default_powr_sensor_running_cadence_double)
+            .toBool();
+    s.peloton_heartrate_metric =
+        settings.value(QZSettings::peloton_heartrate_metric, QZSettings::default_peloton_heartrate_metric).toString();
+    s.domyos_bike_500_profile_v1 =
+        settings.value(QZSettings::domyos_bike_500_profile_v1, QZSettings::default_domyos_bike_500_profile_v1).toBool();
+    s.power_sensor_disabled = s.power_sensor_name.startsWith(QStringLiteral("Disabled"));
+    s.cadence_sensor_disabled = s.cadence_sensor_name.startsWith(QStringLiteral("Disabled"));
+    m_snapshot = s;
+    qDebug() << QStringLiteral("qzsettingscache reloaded");
+}
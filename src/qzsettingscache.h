@@ -0,0 +1,98 @@
+#ifndef QZSETTINGSCACHE_H
+#define QZSETTINGSCACHE_H
+
+#include "qzsettings.h"
+
+#include <QAtomicInt>
+#include <QObject>
+#include <QString>
+
+/**
+ * @brief The qzsettingscache class keeps an in-memory, typed copy of the settings read on the hot paths
+ * (every BLE notification, every metric sample, every UI tick), so they don't construct a QSettings and
+ * do a string-keyed lookup each time. The fields are named after the QZSettings keys they mirror and
+ * are loaded with the same QZSettings defaults.
+ * The copy is reloaded lazily after invalidate(), which is called by the C++ code that writes settings (a profile
+ * load, the web templates, the command line options), and through invalidateLater() when the user leaves the settings
+ * or the profiles page.
+ * Not thread safe: get() reloads the snapshot in place, so it must only be called from the GUI thread. That's where
+ * the devices update their metrics (metric::setValue() reads the gains from here) and send their notifications; the
+ * worker threads hand their readings over through queued signals.
+ */
+class qzsettingscache : public QObject {
+    Q_OBJECT
+
+  public:
+    struct snapshot {
+        double watt_gain = QZSettings::default_watt_gain;
+        double watt_offset = QZSettings::default_watt_offset;
+        double speed_gain = QZSettings::default_speed_gain;
+        double speed_offset = QZSettings::default_speed_offset;
+        float weight = QZSettings::default_weight;
+        bool miles_unit = QZSettings::default_miles_unit;
+        QString heart_rate_belt_name = QZSettings::default_heart_rate_belt_name;
+        bool heart_ignore_builtin = QZSettings::default_heart_ignore_builtin;
+        QString power_sensor_name = QZSettings::default_power_sensor_name;
+        bool power_sensor_as_bike = QZSettings::default_power_sensor_as_bike;
+        bool power_sensor_as_treadmill = QZSettings::default_power_sensor_as_treadmill;
+        QString cadence_sensor_name = QZSettings::default_cadence_sensor_name;
+        bool speed_power_based = QZSettings::default_speed_power_based;
+        double peloton_gain = QZSettings::default_peloton_gain;
+        double peloton_offset = QZSettings::default_peloton_offset;
+        bool ant_heart = QZSettings::default_ant_heart;
+        bool continuous_moving = QZSettings::default_continuous_moving;
+        bool instant_power_on_pause = QZSettings::default_instant_power_on_pause;
+        double ftp = QZSettings::default_ftp;
+        bool power_avg_5s = QZSettings::default_power_avg_5s;
+        bool top_bar_enabled = QZSettings::default_top_bar_enabled;
+        double heart_rate_zone1 = QZSettings::default_heart_rate_zone1;
+        double heart_rate_zone2 = QZSettings::default_heart_rate_zone2;
+        double heart_rate_zone3 = QZSettings::default_heart_rate_zone3;
+        double heart_rate_zone4 = QZSettings::default_heart_rate_zone4;
+        bool virtual_device_rower = QZSettings::default_virtual_device_rower;
+        bool powr_sensor_running_cadence_double = QZSettings::default_powr_sensor_running_cadence_double;
+        QString peloton_heartrate_metric = QZSettings::default_peloton_heartrate_metric;
+        bool domyos_bike_500_profile_v1 = QZSettings::default_domyos_bike_500_profile_v1;
+
+        /**
+         * @brief power_sensor_disabled True when power_sensor_name starts with "Disabled"
+         */
+        bool power_sensor_disabled = true;
+
+        /**
+         * @brief cadence_sensor_disabled True when cadence_sensor_name starts with "Disabled"
+         */
+        bool cadence_sensor_disabled = true;
+    };
+
+    static qzsettingscache *instance();
+
+    /**
+     * @brief get Returns the current snapshot, reloading it from QSettings only if it was invalidated.
+     */
+    static const snapshot &get();
+
+    /**
+     * @brief invalidate Marks the snapshot as stale. The next get() reloads it and emits changed().
+     */
+    Q_INVOKABLE void invalidate();
+
+    /**
+     * @brief invalidateLater Marks the snapshot as stale once the event loop runs again. The QML Settings elements
+     * only write their pending values when they are destroyed, after the Component.onDestruction handlers of their
+     * page, so the pages call this one.
+     */
+    Q_INVOKABLE void invalidateLater();
+
+  Q_SIGNALS:
+    void changed();
+
+  private:
+    explicit qzsettingscache(QObject *parent = nullptr);
+    void reload();
+
+    snapshot m_snapshot;
+    QAtomicInt m_dirty = 1;
+};
+
+#endif // QZSETTINGSCACHE_H
@@ -0,0 +1,116 @@
+#include "rollingwindow.h"
+
+void rollingwindow::ring::pushBack(const sample &s) {
+    if (m_size == m_data.size()) {
+        // full: unroll into a buffer twice as large, this only happens while the window fills up
+        QVector<sample> grown;
+        grown.reserve(qMax(8, m_data.size() * 2));
+        for (int i = 0; i < m_size; i++)
+            grown.append(at(i));
+        grown.resize(grown.capacity());
+        m_data = grown;
+        m_first = 0;
+    }
+    m_data[(m_first + m_size) % m_data.size()] = s;
+    m_size++;
+}
+
+void rollingwindow::ring::popFront() {
+    m_first = (m_first + 1) % m_data.size();
+    m_size--;
+}
+
+rollingwindow::rollingwindow(qint64 spanMs, int maxSamples) : m_spanMs(spanMs), m_maxSamples(maxSamples) {}
+
+void rollingwindow::append(qint64 timestampMs, double value) {
+    sample s = {timestampMs, value, m_seq++};
+
+    m_samples.pushBack(s);
+    m_sum += value;
+
+    while (!m_min.isEmpty() && m_min.back().value >= value)
+        m_min.popBack();
+    m_min.pushBack(s);
+    while (!m_max.isEmpty() && m_max.back().value <= value)
+        m_max.popBack();
+    m_max.pushBack(s);
+
+    while (!m_samples.isEmpty() && ((m_maxSamples > 0 && m_samples.size() > m_maxSamples) ||
+                                    (m_spanMs > 0 && timestampMs - m_samples.front().timestamp >= m_spanMs))) {
+        m_sum -= m_samples.front().value;
+        m_samples.popFront();
+    }
+
+    if (m_samples.isEmpty()) {
+        m_sum = 0;
+        m_min.clear();
+        m_max.clear();
+        return;
+    }
+
+    quint64 firstSeq = m_samples.front().seq;
+    while (!m_min.isEmpty() && m_min.front().seq < firstSeq)
+        m_min.popFront();
+    while (!m_max.isEmpty() && m_max.front().seq < firstSeq)
+        m_max.popFront();
+}
+
+void rollingwindow::clear() {
+    m_sum = 0;
+    m_samples.clear();
+    m_min.clear();
+    m_max.clear();
+}
+
+int rollingwindow::firstValid(qint64 nowMs) const {
+    int i = 0;
+    if (m_spanMs > 0) {
+        while (i < m_samples.size() && nowMs - m_samples.at(i).timestamp >= m_spanMs)
+            i++;
+    }
+    return i;
+}
+
+int rollingwindow::count(qint64 nowMs) const { return m_samples.size() - firstValid(nowMs); }
+
+double rollingwindow::sum(qint64 nowMs) const {
+    int first = firstValid(nowMs);
+    if (first == m_samples.size())
+        return 0;
+    double s = m_sum;
+    for (int i = 0; i < first; i++)
+        s -= m_samples.at(i).value;
+    return s;
+}
+
+double rollingwindow::average(qint64 nowMs) const {
+    int c = count(nowMs);
+    if (c == 0)
+        return 0;
+    return sum(nowMs) / c;
+}
+
+double rollingwindow::min(qint64 nowMs) const {
+    int first = firstValid(nowMs);
+    if (first == m_samples.size())
+        return 0;
+    // the deque is sorted by sequence number, the expired entries are at its front
+    quint64 firstSeq = m_samples.at(first).seq;
+    for (int i = 0; i < m_min.size(); i++) {
+        if (m_min.at(i).seq >= firstSeq)
+            return m_min.at(i).value;
+    }
+    return 0;
+}
+
+double rollingwindow::max(qint64 nowMs) const {
+    int first = firstValid(nowMs);
+    if (first == m_samples.size())
+        return 0;
+    quint64 firstSeq = m_samples.at(first).seq;
+    for (int i = 0; i < m_max.size(); i++) {
+        if (m_max.at(i).seq >= firstSeq)
+            return m_max.at(i).value;
+    }
+    return 0;
+}
@@ -0,0 +1,80 @@
+#ifndef ROLLINGWINDOW_H
+#define ROLLINGWINDOW_H
+
+#include <QVector>
+#include <QtGlobal>
+
+/**
+ * @brief The rollingwindow class keeps the samples of a metric that fall in a sliding window, bounded by time
+ * (spanMs), by count (maxSamples) or both.
+ * Samples live in a ring buffer that only grows while the window fills up; the running sum is updated on append and
+ * eviction, min and max come from two monotonic deques kept in rings as well. append() is amortised O(1) and evicts
+ * the expired samples from the window and from the front of the deques, so right after an append the answers are
+ * read in O(1).
+ * The storage is implicitly shared: copying a window (and so a metric) is a reference count increment, a reader
+ * holding a copy sees a consistent snapshot and the writer detaches only if that copy is still alive.
+ * The read functions take the current time and skip the samples that expired since the last append without modifying
+ * the window, so between appends they cost O(k), k being the number of those samples.
+ */
+class rollingwindow {
+  public:
+    rollingwindow(qint64 spanMs = 0, int maxSamples = 0);
+
+    /**
+     * @brief append Adds a sample and evicts the ones out of the window. Timestamps must be monotonic.
+     */
+    void append(qint64 timestampMs, double value);
+    void clear();
+
+    qint64 span() const { return m_spanMs; }
+    int maxSamples() const { return m_maxSamples; }
+
+    int count(qint64 nowMs) const;
+    double sum(qint64 nowMs) const;
+    double average(qint64 nowMs) const;
+    double min(qint64 nowMs) const;
+    double max(qint64 nowMs) const;
+
+  private:
+    struct sample {
+        qint64 timestamp;
+        double value;
+        quint64 seq;
+    };
+
+    /**
+     * @brief The ring class is a growable circular buffer of samples used both for the window and the deques.
+     */
+    class ring {
+      public:
+        int size() const { return m_size; }
+        bool isEmpty() const { return m_size == 0; }
+        const sample &at(int i) const { return m_data.at((m_first + i) % m_data.size()); }
+        const sample &front() const { return at(0); }
+        const sample &back() const { return at(m_size - 1); }
+        void pushBack(const sample &s);
+        void popFront();
+        void popBack() { m_size--; }
+        void clear() {
+            m_first = 0;
+            m_size = 0;
+        }
+
+      private:
+        QVector<sample> m_data;
+        int m_first = 0;
+        int m_size = 0;
+    };
+
+    int firstValid(qint64 nowMs) const;
+
+    qint64 m_spanMs;
+    int m_maxSamples;
+    quint64 m_seq = 0;
+    double m_sum = 0;
+    ring m_samples;
+    ring m_min;
+    ring m_max;
+};
+
+#endif // ROLLINGWINDOW_H
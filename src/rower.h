@@ -9,16 +9,16 @@ class rower : public bluetoothdevice {
 
   public:
     rower();
-    metric lastRequestedResistance();
-    metric lastRequestedPelotonResistance();
-    metric lastRequestedCadence();
-    metric lastRequestedPower();
-    metric lastRequestedSpeed() { return RequestedSpeed; }
+    const metric &lastRequestedResistance();
+    const metric &lastRequestedPelotonResistance();
+    const metric &lastRequestedCadence();
+    const metric &lastRequestedPower();
+    const metric &lastRequestedSpeed() { return RequestedSpeed; }
     QTime lastRequestedPace();
     virtual QTime lastPace500m();
-    metric currentResistance() override;
-    virtual metric currentStrokesCount();
-    virtual metric currentStrokesLength();
+    const metric &currentResistance() override;
+    virtual const metric &currentStrokesCount();
+    virtual const metric &currentStrokesLength();
     QTime currentPace() override;
     QTime averagePace() override;
     QTime maxPace() override;
@@ -31,7 +31,7 @@ class rower : public bluetoothdevice {
     virtual resistance_t pelotonToBikeResistance(int pelotonResistance);
     virtual resistance_t resistanceFromPowerRequest(uint16_t power);
     bluetoothdevice::BLUETOOTH_TYPE deviceType() override;
-    metric pelotonResistance();
+    const metric &pelotonResistance();
     void clearStats() override;
     void setLap() override;
     void setPaused(bool p) override;
@@ -0,0 +1,87 @@
+#include "sessionstore.h"
+#include <limits>
+#include <math.h>
+
+static const qint64 invalidTime = std::numeric_limits<qint64>::min();
+
+void sessionstore::append(const SessionLine &line) {
+    m_speed.append(line.speed);
+    m_inclination.append(line.inclination);
+    m_distance.append(line.distance);
+    m_watt.append(line.watt);
+    m_resistance.append(line.resistance);
+    m_pelotonResistance.append(line.peloton_resistance);
+    m_heart.append(line.heart);
+    m_pace.append(line.pace);
+    m_cadence.append(line.cadence);
+    m_time.append(line.time.isValid() ? line.time.toMSecsSinceEpoch() : invalidTime);
+    m_calories.append(line.calories);
+    m_elevationGain.append(line.elevationGain);
+    m_lapTrigger.append(line.lapTrigger);
+    m_totalStrokes.append(line.totalStrokes);
+    m_avgStrokesRate.append(line.avgStrokesRate);
+    m_maxStrokesRate.append(line.maxStrokesRate);
+    m_avgStrokesLength.append(line.avgStrokesLength);
+    // an invalid QGeoCoordinate has NaN latitude and longitude, the altitude is NaN when it's missing
+    m_latitude.append(line.coordinate.latitude());
+    m_longitude.append(line.coordinate.longitude());
+    m_altitude.append(line.coordinate.altitude());
+    m_instantaneousStrideLengthCM.append(line.instantaneousStrideLengthCM);
+    m_groundContactMS.append(line.groundContactMS);
+    m_verticalOscillationMM.append(line.verticalOscillationMM);
+    // the count is taken from this column, so it's the last one to grow
+    m_elapsedTime.append(line.elapsedTime);
+}
+
+void sessionstore::clear() {
+    m_speed.clear();
+    m_inclination.clear();
+    m_distance.clear();
+    m_watt.clear();
+    m_resistance.clear();
+    m_pelotonResistance.clear();
+    m_heart.clear();
+    m_pace.clear();
+    m_cadence.clear();
+    m_time.clear();
+    m_calories.clear();
+    m_elevationGain.clear();
+    m_elapsedTime.clear();
+    m_lapTrigger.clear();
+    m_totalStrokes.clear();
+    m_avgStrokesRate.clear();
+    m_maxStrokesRate.clear();
+    m_avgStrokesLength.clear();
+    m_latitude.clear();
+    m_longitude.clear();
+    m_altitude.clear();
+    m_instantaneousStrideLengthCM.clear();
+    m_groundContactMS.clear();
+    m_verticalOscillationMM.clear();
+}
+
+SessionLine sessionstore::at(int i) const {
+    QGeoCoordinate coordinate;
+    if (!isnan(m_latitude.at(i)) && !isnan(m_longitude.at(i))) {
+        if (isnan(m_altitude.at(i)))
+            coordinate = QGeoCoordinate(m_latitude.at(i), m_longitude.at(i));
+        else
+            coordinate = QGeoCoordinate(m_latitude.at(i), m_longitude.at(i), m_altitude.at(i));
+    }
+
+    qint64 time = m_time.at(i);
+    return SessionLine(m_speed.at(i), m_inclination.at(i), m_distance.at(i), m_watt.at(i), m_resistance.at(i),
+                       m_pelotonResistance.at(i), m_heart.at(i), m_pace.at(i), m_cadence.at(i), m_calories.at(i),
+                       m_elevationGain.at(i), m_elapsedTime.at(i), m_lapTrigger.at(i), m_totalStrokes.at(i),
+                       m_avgStrokesRate.at(i), m_maxStrokesRate.at(i), m_avgStrokesLength.at(i), coordinate,
+                       m_instantaneousStrideLengthCM.at(i), m_groundContactMS.at(i), m_verticalOscillationMM.at(i),
+                       time == invalidTime ? QDateTime() : QDateTime::fromMSecsSinceEpoch(time));
+}
+
+QList<SessionLine> sessionstore::toList() const {
+    QList<SessionLine> l;
+    l.reserve(count());
+    for (int i = 0; i < count(); i++)
+        l.append(at(i));
+    return l;
+}
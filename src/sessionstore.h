@@ -0,0 +1,136 @@
+#ifndef SESSIONSTORE_H
+#define SESSIONSTORE_H
+
+#include "sessionline.h"
+#include <QList>
+#include <QVector>
+
+/**
+ * @brief The sessioncolumn class is an append only array of one SessionLine field, stored in fixed size chunks so
+ * appending never moves the samples already recorded. The chunks are implicitly shared: a copy of the column costs a
+ * reference count per chunk and only the last chunk is detached when the owner appends to it again.
+ */
+template <typename T> class sessioncolumn {
+  public:
+    static const int chunkSize = 1024;
+
+    void append(const T &value) {
+        if (m_chunks.isEmpty() || m_chunks.last().size() == chunkSize) {
+            QVector<T> chunk;
+            chunk.reserve(chunkSize);
+            m_chunks.append(chunk);
+        }
+        m_chunks.last().append(value);
+        m_size++;
+    }
+
+    const T &at(int i) const { return m_chunks.at(i / chunkSize).at(i % chunkSize); }
+    int size() const { return m_size; }
+
+    void clear() {
+        m_chunks.clear();
+        m_size = 0;
+    }
+
+    /**
+     * @brief toList The column converted to double, as the QML charts want it.
+     */
+    QList<double> toList() const {
+        QList<double> l;
+        l.reserve(m_size + 1);
+        for (const QVector<T> &chunk : m_chunks) {
+            for (const T &v : chunk)
+                l.append(v);
+        }
+        return l;
+    }
+
+  private:
+    QVector<QVector<T>> m_chunks;
+    int m_size = 0;
+};
+
+/**
+ * @brief The sessionstore class records the SessionLine samples of a workout column by column. A multi-hour session
+ * takes a fraction of the memory of a QList<SessionLine>, which allocates every line on the heap together with its
+ * QDateTime and QGeoCoordinate; the charts read a single column without touching the others, and copying the store to
+ * hand a snapshot to an exporter doesn't copy the samples.
+ * at() rebuilds a full SessionLine, so the exporters keep iterating the session as they did with the list.
+ */
+class sessionstore {
+  public:
+    class const_iterator {
+      public:
+        const_iterator(const sessionstore *store, int i) : m_store(store), m_i(i) {}
+        SessionLine operator*() const { return m_store->at(m_i); }
+        const_iterator &operator++() {
+            m_i++;
+            return *this;
+        }
+        bool operator!=(const const_iterator &other) const { return m_i != other.m_i; }
+
+      private:
+        const sessionstore *m_store;
+        int m_i;
+    };
+
+    void append(const SessionLine &line);
+    void clear();
+
+    int count() const { return m_elapsedTime.size(); }
+    int length() const { return count(); }
+    int size() const { return count(); }
+    bool isEmpty() const { return count() == 0; }
+
+    SessionLine at(int i) const;
+    SessionLine first() const { return at(0); }
+    SessionLine constFirst() const { return at(0); }
+    SessionLine last() const { return at(count() - 1); }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, count()); }
+
+    /**
+     * @brief toList Materializes the whole session, for the code that still works on a QList<SessionLine>.
+     */
+    QList<SessionLine> toList() const;
+
+    const sessioncolumn<double> &speed() const { return m_speed; }
+    const sessioncolumn<int8_t> &inclination() const { return m_inclination; }
+    const sessioncolumn<double> &distance() const { return m_distance; }
+    const sessioncolumn<uint16_t> &watt() const { return m_watt; }
+    const sessioncolumn<resistance_t> &resistance() const { return m_resistance; }
+    const sessioncolumn<int8_t> &pelotonResistance() const { return m_pelotonResistance; }
+    const sessioncolumn<uint8_t> &heart() const { return m_heart; }
+    const sessioncolumn<uint8_t> &cadence() const { return m_cadence; }
+    const sessioncolumn<double> &calories() const { return m_calories; }
+    const sessioncolumn<uint32_t> &elapsedTime() const { return m_elapsedTime; }
+
+  private:
+    sessioncolumn<double> m_speed;
+    sessioncolumn<int8_t> m_inclination;
+    sessioncolumn<double> m_distance;
+    sessioncolumn<uint16_t> m_watt;
+    sessioncolumn<resistance_t> m_resistance;
+    sessioncolumn<int8_t> m_pelotonResistance;
+    sessioncolumn<uint8_t> m_heart;
+    sessioncolumn<double> m_pace;
+    sessioncolumn<uint8_t> m_cadence;
+    sessioncolumn<qint64> m_time;
+    sessioncolumn<double> m_calories;
+    sessioncolumn<double> m_elevationGain;
+    sessioncolumn<uint32_t> m_elapsedTime;
+    sessioncolumn<bool> m_lapTrigger;
+    sessioncolumn<uint32_t> m_totalStrokes;
+    sessioncolumn<double> m_avgStrokesRate;
+    sessioncolumn<double> m_maxStrokesRate;
+    sessioncolumn<double> m_avgStrokesLength;
+    sessioncolumn<double> m_latitude;
+    sessioncolumn<double> m_longitude;
+    sessioncolumn<double> m_altitude;
+    sessioncolumn<double> m_instantaneousStrideLengthCM;
+    sessioncolumn<double> m_groundContactMS;
+    sessioncolumn<double> m_verticalOscillationMM;
+};
+
+#endif // SESSIONSTORE_H
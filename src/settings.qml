@@ -834,6 +834,12 @@ import QtQuick.Dialogs 1.0
 
             // from version 2.16.17
             property bool race_mode: false
+
+            // from version 2.16.20
+            property int tiles_refresh_rate: 4
+            property int log_debug_max_size: 0
+            property int log_debug_max_age: 0
+            property bool log_debug_compress: false
         }
 
         function paddingZeros(text, limit) {
@@ -860,6 +866,7 @@ import QtQuick.Dialogs 1.0
         }
 
         Component.onCompleted: window.settings_restart_to_apply = false;
+        Component.onDestruction: settingsCache.invalidateLater();
 
         ColumnLayout {
             id: column1
@@ -7299,6 +7306,42 @@ import QtQuick.Dialogs 1.0
                         color: Material.color(Material.Lime)
                     }
 
+                    RowLayout {
+                        spacing: 10
+                        Label {
+                            text: qsTr("Tiles refresh rate (Hz):")
+                            Layout.fillWidth: true
+                        }
+                        TextField {
+                            id: tilesRefreshRateTextField
+                            text: settings.tiles_refresh_rate
+                            horizontalAlignment: Text.AlignRight
+                            Layout.fillHeight: false
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            inputMethodHints: Qt.ImhDigitsOnly
+                            onAccepted: settings.tiles_refresh_rate = text
+                            onActiveFocusChanged: if(this.focus) this.cursorPosition = this.text.length
+                        }
+                        Button {
+                            text: "OK"
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            onClicked: { settings.tiles_refresh_rate = tilesRefreshRateTextField.text; toast.show("Setting saved!"); window.settings_restart_to_apply = true;}
+                        }
+                    }
+
+                    Label {
+                        text: qsTr("How many times per second the speed, power, cadence and heart rate tiles are refreshed. The workout is still recorded once per second. Lower it on slow tablets. Default is 4.")
+                        font.bold: true
+                        font.italic: true
+                        font.pixelSize: 9
+                        textFormat: Text.PlainText
+                        wrapMode: Text.WordWrap
+                        verticalAlignment: Text.AlignVCenter
+                        Layout.alignment: Qt.AlignLeft | Qt.AlignTop
+                        Layout.fillWidth: true
+                        color: Material.color(Material.Lime)
+                    }
+
                     SwitchDelegate {
                         id: instantPowerOnPause
                         text: qsTr("Instant Power on Pause")
@@ -9235,6 +9278,106 @@ import QtQuick.Dialogs 1.0
                         color: Material.color(Material.Lime)
                     }
 
+                    RowLayout {
+                        spacing: 10
+                        Label {
+                            text: qsTr("Debug log max size (MB):")
+                            Layout.fillWidth: true
+                        }
+                        TextField {
+                            id: logDebugMaxSizeTextField
+                            text: settings.log_debug_max_size
+                            horizontalAlignment: Text.AlignRight
+                            Layout.fillHeight: false
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            inputMethodHints: Qt.ImhDigitsOnly
+                            onAccepted: settings.log_debug_max_size = text
+                            onActiveFocusChanged: if(this.focus) this.cursorPosition = this.text.length
+                        }
+                        Button {
+                            text: "OK"
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            onClicked: { settings.log_debug_max_size = logDebugMaxSizeTextField.text; toast.show("Setting saved!"); window.settings_restart_to_apply = true;}
+                        }
+                    }
+
+                    Label {
+                        text: qsTr("When the debug log reaches this size it continues in a new file (-2, -3...). 0 keeps a single file. Default is 0.")
+                        font.bold: true
+                        font.italic: true
+                        font.pixelSize: 9
+                        textFormat: Text.PlainText
+                        wrapMode: Text.WordWrap
+                        verticalAlignment: Text.AlignVCenter
+                        Layout.alignment: Qt.AlignLeft | Qt.AlignTop
+                        Layout.fillWidth: true
+                        color: Material.color(Material.Lime)
+                    }
+
+                    RowLayout {
+                        spacing: 10
+                        Label {
+                            text: qsTr("Debug log max age (minutes):")
+                            Layout.fillWidth: true
+                        }
+                        TextField {
+                            id: logDebugMaxAgeTextField
+                            text: settings.log_debug_max_age
+                            horizontalAlignment: Text.AlignRight
+                            Layout.fillHeight: false
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            inputMethodHints: Qt.ImhDigitsOnly
+                            onAccepted: settings.log_debug_max_age = text
+                            onActiveFocusChanged: if(this.focus) this.cursorPosition = this.text.length
+                        }
+                        Button {
+                            text: "OK"
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            onClicked: { settings.log_debug_max_age = logDebugMaxAgeTextField.text; toast.show("Setting saved!"); window.settings_restart_to_apply = true;}
+                        }
+                    }
+
+                    Label {
+                        text: qsTr("When the debug log is older than this it continues in a new file. 0 keeps a single file. Default is 0.")
+                        font.bold: true
+                        font.italic: true
+                        font.pixelSize: 9
+                        textFormat: Text.PlainText
+                        wrapMode: Text.WordWrap
+                        verticalAlignment: Text.AlignVCenter
+                        Layout.alignment: Qt.AlignLeft | Qt.AlignTop
+                        Layout.fillWidth: true
+                        color: Material.color(Material.Lime)
+                    }
+
+                    SwitchDelegate {
+                        id: logDebugCompressDelegate
+                        text: qsTr("Compress Debug Log")
+                        spacing: 0
+                        bottomPadding: 0
+                        topPadding: 0
+                        rightPadding: 0
+                        leftPadding: 0
+                        clip: false
+                        checked: settings.log_debug_compress
+                        Layout.alignment: Qt.AlignLeft | Qt.AlignTop
+                        Layout.fillWidth: true
+                        onClicked: { settings.log_debug_compress = checked; window.settings_restart_to_apply = true; }
+                    }
+
+                    Label {
+                        text: qsTr("Gzip the debug log files once they are complete (.log.gz). Default is off.")
+                        font.bold: true
+                        font.italic: true
+                        font.pixelSize: 9
+                        textFormat: Text.PlainText
+                        wrapMode: Text.WordWrap
+                        verticalAlignment: Text.AlignVCenter
+                        Layout.alignment: Qt.AlignLeft | Qt.AlignTop
+                        Layout.fillWidth: true
+                        color: Material.color(Material.Lime)
+                    }
+
                     Button {
                         id: clearLogs
                         text: "Clear History"
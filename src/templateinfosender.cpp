@@ -14,6 +14,19 @@ TemplateInfoSender::TemplateInfoSender(const QString &id, QObject *parent) : QOb
 
 TemplateInfoSender::~TemplateInfoSender() { stop(); }
 
+QJsonObject TemplateInfoSender::delta(const QJsonObject &workout, const QStringList &fields, QJsonObject &last) {
+    const QStringList keys = fields.isEmpty() ? workout.keys() : fields;
+    QJsonObject changed;
+    for (const QString &f : keys) {
+        QJsonValue v = workout.value(f);
+        if (v != last.value(f)) {
+            changed.insert(f, v);
+            last.insert(f, v);
+        }
+    }
+    return changed;
+}
+
 bool TemplateInfoSender::init(const QString &script) {
     jscript = script;
     stop();
@@ -26,7 +39,7 @@ bool TemplateInfoSender::update(QJSEngine *eng) {
         if (!jsv.isError()) {
             QString evalres = jsv.toString();
             qDebug() << QStringLiteral("eval res ") << evalres;
-            return send(evalres);
+            return sendUpdate(evalres);
         } else {
 #if (QT_VERSION < QT_VERSION_CHECK(5, 12, 0))
             int errorType = 255;
@@ -1,6 +1,7 @@
 #ifndef TEMPLATEINFOSENDER_H
 #define TEMPLATEINFOSENDER_H
 #include <QJSEngine>
+#include <QJsonObject>
 #include <QObject>
 #include <QSettings>
 #include <QTimer>
@@ -12,6 +13,39 @@ class TemplateInfoSender : public QObject {
     virtual ~TemplateInfoSender();
     virtual bool isRunning() const = 0;
     virtual bool send(const QString &data) = 0;
+
+    /**
+     * @brief reply Sends data only to the client whose message is being handled. Senders with a single peer send it
+     * as usual.
+     */
+    virtual bool reply(const QString &data) { return send(data); }
+
+    /**
+     * @brief subscribe Registers the client whose message is being handled for the per-tick deltas of the given
+     * workout fields (all of them if empty), as JSON text or CBOR binary messages. Subscribed clients stop receiving
+     * the full workout message.
+     * @return false if the sender doesn't support subscriptions.
+     */
+    virtual bool subscribe(const QStringList &fields, bool binary) {
+        Q_UNUSED(fields)
+        Q_UNUSED(binary)
+        return false;
+    }
+
+    /**
+     * @brief publish Sends to the subscribed clients the fields of workout changed since their previous delta.
+     * @param cursor The number of session rows recorded so far, for the history requests.
+     */
+    virtual void publish(const QJsonObject &workout, int cursor) {
+        Q_UNUSED(workout)
+        Q_UNUSED(cursor)
+    }
+
+    /**
+     * @brief delta The fields of workout (all of them if fields is empty) whose value differs from last, which is
+     * updated with them.
+     */
+    static QJsonObject delta(const QJsonObject &workout, const QStringList &fields, QJsonObject &last);
     bool init(const QString &script);
     void stop();
     bool update(QJSEngine *eng);
@@ -22,6 +56,11 @@ class TemplateInfoSender : public QObject {
 
   protected:
     virtual bool init() = 0;
+
+    /**
+     * @brief sendUpdate Sends the result of the template script, every tick.
+     */
+    virtual bool sendUpdate(const QString &data) { return send(data); }
     virtual void innerStop();
     QString templateId;
     QSettings settings;
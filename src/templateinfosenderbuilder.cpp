@@ -13,6 +13,7 @@
 #include "webserverinfosender.h"
 #endif
 #include "homeform.h"
+#include "qzsettingscache.h"
 #include "tcpclientinfosender.h"
 #include "trainprogram.h"
 #include <chrono>
@@ -72,6 +73,7 @@ void TemplateInfoSenderBuilder::onUpdateTimeout() {
         if (!rv) {
             qDebug() << QStringLiteral("Error updating") << it.key() << QStringLiteral("template");
         }
+        it.value()->publish(lastWorkout, sessionRows.count());
     }
 }
 
@@ -229,12 +231,7 @@ TemplateInfoSender *TemplateInfoSenderBuilder::newTemplate(const QString &id, co
 
 void TemplateInfoSenderBuilder::reinit() { load(masterId, foldersToLook); }
 
-void TemplateInfoSenderBuilder::clearSessionArray() {
-    int len = sessionArray.count();
-    for (int i = 0; i < len; i++) {
-        sessionArray.removeAt(0);
-    }
-}
+void TemplateInfoSenderBuilder::clearSessionArray() { sessionRows.clear(); }
 
 void TemplateInfoSenderBuilder::start(bluetoothdevice *dev) {
     device = nullptr;
@@ -433,6 +430,7 @@ void TemplateInfoSenderBuilder::onSetSettings(const QJsonValue &msgContent, Temp
         }
     }
     settings.sync();
+    qzsettingscache::instance()->invalidate();
     QJsonObject main;
     main[QStringLiteral("msg")] = QStringLiteral("R_setsettings");
     main[QStringLiteral("content")] = outObj;
@@ -516,12 +514,48 @@ void TemplateInfoSenderBuilder::onAppendActivityDescription(const QJsonValue &ms
     tempSender->send(out.toJson());
 }
 
-void TemplateInfoSenderBuilder::onGetSessionArray(TemplateInfoSender *tempSender) {
+QByteArray TemplateInfoSenderBuilder::sessionArray(const QList<QByteArray> &rows, const QJsonValue &range) {
+    // without content the whole session is returned, as before. {from, count} returns a range and the cursor to
+    // continue from, so a client only asks for the rows it hasn't seen yet
+    int total = rows.count();
+    int from = 0;
+    int to = total;
+    if (range.isObject()) {
+        QJsonObject r = range.toObject();
+        from = qBound(0, r[QStringLiteral("from")].toInt(0), total);
+        if (r.contains(QStringLiteral("count")))
+            to = qBound(from, from + r[QStringLiteral("count")].toInt(0), total);
+    }
+
+    QByteArray out = QByteArrayLiteral("{\"msg\":\"R_getsessionarray\",\"cursor\":") + QByteArray::number(to) +
+                     QByteArrayLiteral(",\"total\":") + QByteArray::number(total) +
+                     QByteArrayLiteral(",\"content\":[");
+    for (int i = from; i < to; i++) {
+        if (i > from)
+            out.append(',');
+        out.append(rows.at(i));
+    }
+    out.append("]}");
+    return out;
+}
+
+void TemplateInfoSenderBuilder::onGetSessionArray(const QJsonValue &msgContent, TemplateInfoSender *tempSender) {
+    tempSender->reply(QString::fromUtf8(sessionArray(sessionRows, msgContent)));
+}
+
+void TemplateInfoSenderBuilder::onSubscribe(const QJsonValue &msgContent, TemplateInfoSender *tempSender) {
+    QJsonObject content = msgContent.toObject();
+    QStringList fields;
+    const QJsonArray fieldsArray = content[QStringLiteral("fields")].toArray();
+    for (const QJsonValue &f : fieldsArray)
+        fields.append(f.toString());
+    bool binary = content[QStringLiteral("binary")].toBool(false);
     QJsonObject main;
-    main[QStringLiteral("content")] = sessionArray;
-    main[QStringLiteral("msg")] = QStringLiteral("R_getsessionarray");
+    main[QStringLiteral("content")] = tempSender->subscribe(fields, binary);
+    main[QStringLiteral("cursor")] = sessionRows.count();
+    main[QStringLiteral("msg")] = QStringLiteral("R_subscribe");
     QJsonDocument out(main);
-    tempSender->send(out.toJson());
+    tempSender->reply(out.toJson());
 }
 
 void TemplateInfoSenderBuilder::onGetGPXBase64(TemplateInfoSender *tempSender) {
@@ -877,7 +911,10 @@ void TemplateInfoSenderBuilder::onDataReceived(const QByteArray &data) {
                     onAutoresistance(jsonObject[QStringLiteral("content")], sender);
                     return;
                 } else if (msg == QStringLiteral("getsessionarray")) {
-                    onGetSessionArray(sender);
+                    onGetSessionArray(jsonObject[QStringLiteral("content")], sender);
+                    return;
+                } else if (msg == QStringLiteral("subscribe")) {
+                    onSubscribe(jsonObject[QStringLiteral("content")], sender);
                     return;
                 }
                 if (msg == QStringLiteral("start")) {
@@ -959,7 +996,7 @@ void TemplateInfoSenderBuilder::buildContext(bool forceReinit) {
         QString nickName;
         bluetoothdevice::BLUETOOTH_TYPE tp = device->deviceType();
 
-        metric dep;
+        const metric *dep;
 #ifdef Q_OS_IOS
         obj.setProperty("deviceId", device->bluetoothDevice.deviceUuid().toString());
 #else
@@ -993,31 +1030,35 @@ void TemplateInfoSenderBuilder::buildContext(bool forceReinit) {
         obj.setProperty(QStringLiteral("moving_s"), el.second());
         obj.setProperty(QStringLiteral("moving_m"), el.minute());
         obj.setProperty(QStringLiteral("moving_h"), el.hour());
-        obj.setProperty(QStringLiteral("speed"), (dep = device->currentSpeed()).value());
-        obj.setProperty(QStringLiteral("speed_avg"), dep.average());
-        obj.setProperty(QStringLiteral("speed_color"), dep.color());
-        obj.setProperty(QStringLiteral("speed_lapavg"), dep.lapAverage());
-        obj.setProperty(QStringLiteral("speed_lapmax"), dep.lapMax());
+        obj.setProperty(QStringLiteral("speed"), (dep = &device->currentSpeed())->value());
+        obj.setProperty(QStringLiteral("speed_avg"), dep->average());
+        obj.setProperty(QStringLiteral("speed_color"), dep->color());
+        obj.setProperty(QStringLiteral("speed_lapavg"), dep->lapAverage());
+        obj.setProperty(QStringLiteral("speed_lapmax"), dep->lapMax());
         obj.setProperty(QStringLiteral("calories"), device->calories().value());
         obj.setProperty(QStringLiteral("distance"), device->odometer());
-        obj.setProperty(QStringLiteral("heart"), (dep = device->currentHeart()).value());
-        obj.setProperty(QStringLiteral("heart_color"), dep.color());
-        obj.setProperty(QStringLiteral("heart_avg"), dep.average());
-        obj.setProperty(QStringLiteral("heart_lapavg"), dep.lapAverage());
-        obj.setProperty(QStringLiteral("heart_max"), dep.max());
-        obj.setProperty(QStringLiteral("heart_lapmax"), dep.lapMax());
+        obj.setProperty(QStringLiteral("heart"), (dep = &device->currentHeart())->value());
+        obj.setProperty(QStringLiteral("heart_color"), dep->color());
+        obj.setProperty(QStringLiteral("heart_avg"), dep->average());
+        obj.setProperty(QStringLiteral("heart_lapavg"), dep->lapAverage());
+        obj.setProperty(QStringLiteral("heart_max"), dep->max());
+        obj.setProperty(QStringLiteral("heart_lapmax"), dep->lapMax());
+        obj.setProperty(QStringLiteral("heart_60s"), dep->averageOver(60000));
         obj.setProperty(QStringLiteral("jouls"), device->jouls().value());
         obj.setProperty(QStringLiteral("elevation"), device->elevationGain().value());
         obj.setProperty(QStringLiteral("difficult"), device->difficult());
-        obj.setProperty(QStringLiteral("watts"), (dep = device->wattsMetric()).value());
-        obj.setProperty(QStringLiteral("watts_avg"), dep.average());
-        obj.setProperty(QStringLiteral("watts_color"), dep.color());
-        obj.setProperty(QStringLiteral("watts_lapavg"), dep.lapAverage());
-        obj.setProperty(QStringLiteral("watts_max"), dep.max());
-        obj.setProperty(QStringLiteral("watts_lapmax"), dep.lapMax());
-        obj.setProperty(QStringLiteral("kgwatts"), (dep = device->wattKg()).value());
-        obj.setProperty(QStringLiteral("kgwatts_avg"), dep.average());
-        obj.setProperty(QStringLiteral("kgwatts_max"), dep.max());
+        obj.setProperty(QStringLiteral("watts"), (dep = &device->wattsMetric())->value());
+        obj.setProperty(QStringLiteral("watts_avg"), dep->average());
+        obj.setProperty(QStringLiteral("watts_color"), dep->color());
+        obj.setProperty(QStringLiteral("watts_lapavg"), dep->lapAverage());
+        obj.setProperty(QStringLiteral("watts_max"), dep->max());
+        obj.setProperty(QStringLiteral("watts_lapmax"), dep->lapMax());
+        obj.setProperty(QStringLiteral("watts_3s"), dep->averageOver(3000));
+        obj.setProperty(QStringLiteral("watts_10s"), dep->averageOver(10000));
+        obj.setProperty(QStringLiteral("watts_30s"), dep->averageOver(30000));
+        obj.setProperty(QStringLiteral("kgwatts"), (dep = &device->wattKg())->value());
+        obj.setProperty(QStringLiteral("kgwatts_avg"), dep->average());
+        obj.setProperty(QStringLiteral("kgwatts_max"), dep->max());
         obj.setProperty(QStringLiteral("workoutName"), workoutName);
         obj.setProperty(QStringLiteral("workoutStartDate"), workoutStartDate);
         obj.setProperty(QStringLiteral("instructorName"), instructorName);
@@ -1055,44 +1096,44 @@ void TemplateInfoSenderBuilder::buildContext(bool forceReinit) {
             obj.setProperty(QStringLiteral("power_zone_lapmax"), ((bike *)device)->currentPowerZone().lapMax());
             obj.setProperty(QStringLiteral("target_power_zone"), ((bike *)device)->targetPowerZone().value());
             obj.setProperty(QStringLiteral("peloton_resistance"),
-                            (dep = ((bike *)device)->pelotonResistance()).value());
-            obj.setProperty(QStringLiteral("peloton_resistance_avg"), dep.average());
-            obj.setProperty(QStringLiteral("peloton_resistance_color"), dep.color());
-            obj.setProperty(QStringLiteral("peloton_resistance_lapavg"), dep.lapAverage());
-            obj.setProperty(QStringLiteral("peloton_resistance_lapmax"), dep.lapMax());
+                            (dep = &((bike *)device)->pelotonResistance())->value());
+            obj.setProperty(QStringLiteral("peloton_resistance_avg"), dep->average());
+            obj.setProperty(QStringLiteral("peloton_resistance_color"), dep->color());
+            obj.setProperty(QStringLiteral("peloton_resistance_lapavg"), dep->lapAverage());
+            obj.setProperty(QStringLiteral("peloton_resistance_lapmax"), dep->lapMax());
             obj.setProperty(QStringLiteral("peloton_req_resistance"),
-                            (dep = ((bike *)device)->lastRequestedPelotonResistance()).value());
-            obj.setProperty(QStringLiteral("cadence"), (dep = ((bike *)device)->currentCadence()).value());
-            obj.setProperty(QStringLiteral("cadence_color"), dep.color());
-            obj.setProperty(QStringLiteral("cadence_avg"), dep.average());
-            obj.setProperty(QStringLiteral("cadence_lapavg"), dep.lapAverage());
-            obj.setProperty(QStringLiteral("cadence_lapmax"), dep.lapMax());
-            obj.setProperty(QStringLiteral("resistance"), (dep = ((bike *)device)->currentResistance()).value());
-            obj.setProperty(QStringLiteral("resistance_avg"), dep.average());
-            obj.setProperty(QStringLiteral("resistance_lapavg"), dep.lapAverage());
-            obj.setProperty(QStringLiteral("resistance_lapmax"), dep.lapMax());
+                            (dep = &((bike *)device)->lastRequestedPelotonResistance())->value());
+            obj.setProperty(QStringLiteral("cadence"), (dep = &((bike *)device)->currentCadence())->value());
+            obj.setProperty(QStringLiteral("cadence_color"), dep->color());
+            obj.setProperty(QStringLiteral("cadence_avg"), dep->average());
+            obj.setProperty(QStringLiteral("cadence_lapavg"), dep->lapAverage());
+            obj.setProperty(QStringLiteral("cadence_lapmax"), dep->lapMax());
+            obj.setProperty(QStringLiteral("resistance"), (dep = &((bike *)device)->currentResistance())->value());
+            obj.setProperty(QStringLiteral("resistance_avg"), dep->average());
+            obj.setProperty(QStringLiteral("resistance_lapavg"), dep->lapAverage());
+            obj.setProperty(QStringLiteral("resistance_lapmax"), dep->lapMax());
             obj.setProperty(QStringLiteral("cranks"), ((bike *)device)->currentCrankRevolutions());
             obj.setProperty(QStringLiteral("cranktime"), ((bike *)device)->lastCrankEventTime());
-            obj.setProperty(QStringLiteral("req_power"), (dep = ((bike *)device)->lastRequestedPower()).value());
-            obj.setProperty(QStringLiteral("req_cadence"), (dep = ((bike *)device)->lastRequestedCadence()).value());
+            obj.setProperty(QStringLiteral("req_power"), (dep = &((bike *)device)->lastRequestedPower())->value());
+            obj.setProperty(QStringLiteral("req_cadence"), (dep = &((bike *)device)->lastRequestedCadence())->value());
             obj.setProperty(QStringLiteral("req_resistance"),
-                            (dep = ((bike *)device)->lastRequestedResistance()).value());
+                            (dep = &((bike *)device)->lastRequestedResistance())->value());
         } else if (tp == bluetoothdevice::ROWING) {
             el = ((rower *)device)->lastRequestedPace();
             obj.setProperty(QStringLiteral("target_pace_s"), el.second());
             obj.setProperty(QStringLiteral("target_pace_m"), el.minute());
             obj.setProperty(QStringLiteral("target_pace_h"), el.hour());
             obj.setProperty(QStringLiteral("peloton_resistance"),
-                            (dep = ((rower *)device)->pelotonResistance()).value());
-            obj.setProperty(QStringLiteral("peloton_resistance_avg"), dep.average());
-            obj.setProperty(QStringLiteral("cadence"), (dep = ((rower *)device)->currentCadence()).value());
-            obj.setProperty(QStringLiteral("cadence_color"), dep.color());
-            obj.setProperty(QStringLiteral("cadence_avg"), dep.average());
-            obj.setProperty(QStringLiteral("cadence_lapavg"), dep.lapAverage());
-            obj.setProperty(QStringLiteral("cadence_lapmax"), dep.lapMax());
-            obj.setProperty(QStringLiteral("req_cadence"), (dep = ((rower *)device)->lastRequestedCadence()).value());
-            obj.setProperty(QStringLiteral("resistance"), (dep = ((rower *)device)->currentResistance()).value());
-            obj.setProperty(QStringLiteral("resistance_avg"), dep.average());
+                            (dep = &((rower *)device)->pelotonResistance())->value());
+            obj.setProperty(QStringLiteral("peloton_resistance_avg"), dep->average());
+            obj.setProperty(QStringLiteral("cadence"), (dep = &((rower *)device)->currentCadence())->value());
+            obj.setProperty(QStringLiteral("cadence_color"), dep->color());
+            obj.setProperty(QStringLiteral("cadence_avg"), dep->average());
+            obj.setProperty(QStringLiteral("cadence_lapavg"), dep->lapAverage());
+            obj.setProperty(QStringLiteral("cadence_lapmax"), dep->lapMax());
+            obj.setProperty(QStringLiteral("req_cadence"), (dep = &((rower *)device)->lastRequestedCadence())->value());
+            obj.setProperty(QStringLiteral("resistance"), (dep = &((rower *)device)->currentResistance())->value());
+            obj.setProperty(QStringLiteral("resistance_avg"), dep->average());
             obj.setProperty(QStringLiteral("cranks"), ((rower *)device)->currentCrankRevolutions());
             obj.setProperty(QStringLiteral("cranktime"), ((rower *)device)->lastCrankEventTime());
             obj.setProperty(QStringLiteral("strokescount"), ((rower *)device)->currentStrokesCount().value());
@@ -1105,33 +1146,35 @@ void TemplateInfoSenderBuilder::buildContext(bool forceReinit) {
             obj.setProperty(QStringLiteral("target_pace_h"), el.hour());
             obj.setProperty(QStringLiteral("target_inclination"),
                             ((treadmill *)device)->lastRequestedInclination().value());
-            obj.setProperty(QStringLiteral("cadence"), (dep = ((treadmill *)device)->currentCadence()).value());
-            obj.setProperty(QStringLiteral("cadence_color"), dep.color());
-            obj.setProperty(QStringLiteral("cadence_avg"), dep.average());
-            obj.setProperty(QStringLiteral("cadence_lapavg"), dep.lapAverage());
-            obj.setProperty(QStringLiteral("cadence_lapmax"), dep.lapMax());
-            obj.setProperty(QStringLiteral("inclination"), (dep = ((treadmill *)device)->currentInclination()).value());
-            obj.setProperty(QStringLiteral("inclination_avg"), dep.average());
-            obj.setProperty(QStringLiteral("inclination_lapavg"), dep.lapAverage());
-            obj.setProperty(QStringLiteral("inclination_lapmax"), dep.lapMax());
+            obj.setProperty(QStringLiteral("cadence"), (dep = &((treadmill *)device)->currentCadence())->value());
+            obj.setProperty(QStringLiteral("cadence_color"), dep->color());
+            obj.setProperty(QStringLiteral("cadence_avg"), dep->average());
+            obj.setProperty(QStringLiteral("cadence_lapavg"), dep->lapAverage());
+            obj.setProperty(QStringLiteral("cadence_lapmax"), dep->lapMax());
+            obj.setProperty(QStringLiteral("inclination"),
+                            (dep = &((treadmill *)device)->currentInclination())->value());
+            obj.setProperty(QStringLiteral("inclination_avg"), dep->average());
+            obj.setProperty(QStringLiteral("inclination_lapavg"), dep->lapAverage());
+            obj.setProperty(QStringLiteral("inclination_lapmax"), dep->lapMax());
             obj.setProperty(QStringLiteral("stridelength"),
-                            (dep = ((treadmill *)device)->currentStrideLength()).value());
+                            (dep = &((treadmill *)device)->currentStrideLength())->value());
             obj.setProperty(QStringLiteral("groundcontact"),
-                            (dep = ((treadmill *)device)->currentGroundContact()).value());
+                            (dep = &((treadmill *)device)->currentGroundContact())->value());
             obj.setProperty(QStringLiteral("verticaloscillation"),
-                            (dep = ((treadmill *)device)->currentVerticalOscillation()).value());
+                            (dep = &((treadmill *)device)->currentVerticalOscillation())->value());
         } else if (tp == bluetoothdevice::ELLIPTICAL) {
-            obj.setProperty(QStringLiteral("cadence"), (dep = ((elliptical *)device)->currentCadence()).value());
-            obj.setProperty(QStringLiteral("cadence_color"), dep.color());
-            obj.setProperty(QStringLiteral("cadence_avg"), dep.average());
-            obj.setProperty(QStringLiteral("cadence_lapavg"), dep.lapAverage());
-            obj.setProperty(QStringLiteral("cadence_lapmax"), dep.lapMax());
+            obj.setProperty(QStringLiteral("cadence"), (dep = &((elliptical *)device)->currentCadence())->value());
+            obj.setProperty(QStringLiteral("cadence_color"), dep->color());
+            obj.setProperty(QStringLiteral("cadence_avg"), dep->average());
+            obj.setProperty(QStringLiteral("cadence_lapavg"), dep->lapAverage());
+            obj.setProperty(QStringLiteral("cadence_lapmax"), dep->lapMax());
             obj.setProperty(QStringLiteral("inclination"),
-                            (dep = ((elliptical *)device)->currentInclination()).value());
-            obj.setProperty(QStringLiteral("inclination_avg"), dep.average());
+                            (dep = &((elliptical *)device)->currentInclination())->value());
+            obj.setProperty(QStringLiteral("inclination_avg"), dep->average());
         }
+        lastWorkout = QJsonObject::fromVariantMap(obj.toVariant().toMap());
         if (!device->isPaused()) {
-            sessionArray.append(QJsonObject::fromVariantMap(obj.toVariant().toMap()));
+            sessionRows.append(QJsonDocument(lastWorkout).toJson(QJsonDocument::Compact));
         }
     }
 }
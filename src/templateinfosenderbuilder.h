@@ -20,6 +20,12 @@ class TemplateInfoSenderBuilder : public QObject {
     void start(bluetoothdevice *device);
     void stop();
     QStringList templateIdList() const;
+
+    /**
+     * @brief sessionArray The R_getsessionarray reply over the serialized session rows: all of them if range is not
+     * an object, otherwise {from, count}, with the cursor to continue from and the total.
+     */
+    static QByteArray sessionArray(const QList<QByteArray> &rows, const QJsonValue &range);
     ~TemplateInfoSenderBuilder();
   signals:
     void activityDescriptionChanged(QString newDescription);
@@ -49,7 +55,13 @@ class TemplateInfoSenderBuilder : public QObject {
     QTimer updateTimer;
     QString masterId;
     QStringList foldersToLook;
-    QJsonArray sessionArray;
+
+    /**
+     * @brief sessionRows The workout object of every tick not in pause, serialized once as compact JSON, so the
+     * history requests only concatenate them.
+     */
+    QList<QByteArray> sessionRows;
+    QJsonObject lastWorkout;
     QHash<QString, QVariant> context;
     QJSEngine *engine = nullptr;
     TemplateInfoSenderBuilder(QObject *parent);
@@ -81,7 +93,8 @@ class TemplateInfoSenderBuilder : public QObject {
     void onLoadTrainingPrograms(const QJsonValue &msgContent, TemplateInfoSender *tempSender);
     void onGetTrainingProgram(const QJsonValue &msgContent, TemplateInfoSender *tempSender);
     void onAppendActivityDescription(const QJsonValue &msgContent, TemplateInfoSender *tempSender);
-    void onGetSessionArray(TemplateInfoSender *tempSender);
+    void onGetSessionArray(const QJsonValue &msgContent, TemplateInfoSender *tempSender);
+    void onSubscribe(const QJsonValue &msgContent, TemplateInfoSender *tempSender);
     void onGetLatLon(TemplateInfoSender *tempSender);
     void onNextInclination300Meters(TemplateInfoSender *tempSender);
     void onGetGPXBase64(TemplateInfoSender *tempSender);
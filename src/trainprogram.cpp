@@ -54,6 +54,8 @@ trainprogram::trainprogram(const QList<trainrow> &rows, bluetooth *b, QString *d
         applySpeedFilter();
     }
 
+    buildIndex();
+
     this->videoAvailable = videoAvailable;
 
     connect(&timer, SIGNAL(timeout()), this, SLOT(scheduler()));
@@ -181,6 +183,90 @@ uint32_t trainprogram::calculateTimeForRow(int32_t row) {
         return 0;
 }
 
+void trainprogram::buildIndex() {
+    totals.resize(rows.length() + 1);
+    distanceSorted = true;
+    gpxSecondsSorted = true;
+    powerRows = false;
+
+    cumulative t;
+    for (int32_t r = 0; r < rows.length(); r++) {
+        const trainrow &row = rows.at(r);
+        t.gpxSeconds = QTime(0, 0, 0).secsTo(row.gpxElapsed);
+        if (r > 0 && t.gpxSeconds < totals.at(r - 1).gpxSeconds)
+            gpxSecondsSorted = false;
+        totals[r] = t;
+
+        t.time += calculateTimeForRow(r);
+        t.distance += row.distance;
+        if (!(row.distance >= 0))
+            distanceSorted = false;
+        t.inclination += row.inclination;
+
+        // the same count of meters avgAzimuthNext300Meters() has always summed, counted as it did on the GPX points
+        double meters = 0;
+        if (row.distance > 100)
+            meters = isinf(row.distance) ? 0 : ceil(row.distance * 1000);
+        else
+            for (double i = 0; i < row.distance; i += 0.001)
+                meters++;
+        if (meters) {
+            if (isnan(row.azimuth)) {
+                t.unknownAzimuth++;
+            } else {
+                t.azimuthSin += meters * sin(row.azimuth * (M_PI / 180));
+                t.azimuthCos += meters * cos(row.azimuth * (M_PI / 180));
+            }
+        }
+
+        if (row.power != -1)
+            powerRows = true;
+    }
+    totals[rows.length()] = t;
+}
+
+int32_t trainprogram::rowAtTime(uint32_t seconds) const {
+    if (totals.isEmpty())
+        return 0;
+
+    // the first row that ends after the given second; the rows without a duration (distance steps) end where they
+    // start, so they're skipped as the linear scan did
+    return std::upper_bound(totals.constBegin() + 1, totals.constEnd(), seconds,
+                            [](uint32_t s, const cumulative &c) { return s < c.time; }) -
+           (totals.constBegin() + 1);
+}
+
+int32_t trainprogram::rowAfterDistance(int32_t step, double km, bool fromCurrentPosition) const {
+    const int32_t n = rows.length();
+    if (step >= n || totals.length() != n + 1)
+        return step;
+
+    // the first row in [from, to] whose total is over the limit, to + 1 if none
+    auto search = [this](int32_t from, int32_t to, double limit) -> int32_t {
+        if (from > to)
+            return to + 1;
+        if (distanceSorted)
+            return std::upper_bound(totals.constBegin() + from, totals.constBegin() + to + 1, limit,
+                                    [](double l, const cumulative &c) { return l < c.distance; }) -
+                   totals.constBegin();
+        for (int32_t r = from; r <= to; r++)
+            if (totals.at(r).distance > limit)
+                return r;
+        return to + 1;
+    };
+
+    double start = totals.at(step).distance;
+    if (!fromCurrentPosition || currentStep < step)
+        return qMin(search(step + 1, n, start + km), n);
+
+    // the windows that include the current row are shorter by the distance already run on it
+    int32_t current = qMin(currentStep, n);
+    int32_t r = search(step + 1, current, start + km);
+    if (r <= current)
+        return r;
+    return qMin(search(currentStep + 1, n, start + km + currentStepDistance), n);
+}
+
 double trainprogram::calculateDistanceForRow(int32_t row) {
     if (row >= rows.length())
         return 0;
@@ -193,87 +279,63 @@ double trainprogram::calculateDistanceForRow(int32_t row) {
 
 // meters, inclination
 QList<MetersByInclination> trainprogram::inclinationNext300Meters() {
-    int c = currentStep;
-    double km = 0;
+    int32_t last = rowAfterDistance(currentStep, 0.3, true);
     QList<MetersByInclination> next300;
+    next300.reserve(last - currentStep);
 
-    while (1) {
-        if (c < rows.length()) {
-            if (km > 0.3) {
-                return next300;
-            }
-            MetersByInclination p;
-            if (c == currentStep) {
-                p.meters = (rows.at(c).distance - currentStepDistance) * 1000.0;
-                km += (rows.at(c).distance - currentStepDistance);
-            } else {
-                p.meters = (rows.at(c).distance) * 1000.0;
-                km += (rows.at(c).distance);
-            }
-            p.inclination = rows.at(c).inclination;
-            next300.append(p);
-
-        } else {
-            return next300;
-        }
-        c++;
+    for (int32_t c = currentStep; c < last; c++) {
+        MetersByInclination p;
+        if (c == currentStep)
+            p.meters = (rows.at(c).distance - currentStepDistance) * 1000.0;
+        else
+            p.meters = (rows.at(c).distance) * 1000.0;
+        p.inclination = rows.at(c).inclination;
+        next300.append(p);
     }
     return next300;
 }
 
 // meters, inclination
 QList<MetersByInclination> trainprogram::avgInclinationNext300Meters() {
-    int c = currentStep;
-    double km = 0;
+    int32_t last = rowAfterDistance(currentStep, 0.3, true);
     QList<MetersByInclination> next300;
+    next300.reserve(last - currentStep);
 
-    while (1) {
-        if (c < rows.length()) {
-            if (km > 0.3) {
-                return next300;
-            }
-            MetersByInclination p;
-            if (c == currentStep) {
-                p.meters = (rows.at(c).distance - currentStepDistance) * 1000.0;
-                km += (rows.at(c).distance - currentStepDistance);
-            } else {
-                p.meters = (rows.at(c).distance) * 1000.0;
-                km += (rows.at(c).distance);
-            }
-            p.inclination = avgInclinationNext100Meters(c);
-            next300.append(p);
-
-        } else {
-            return next300;
-        }
-        c++;
+    for (int32_t c = currentStep; c < last; c++) {
+        MetersByInclination p;
+        if (c == currentStep)
+            p.meters = (rows.at(c).distance - currentStepDistance) * 1000.0;
+        else
+            p.meters = (rows.at(c).distance) * 1000.0;
+        p.inclination = avgInclinationNext100Meters(c);
+        next300.append(p);
     }
     return next300;
 }
 
 // speed in Km/h
 double trainprogram::avgSpeedFromGpxStep(int gpxStep, int seconds) {
-    int start = gpxStep;
-    if (gpxStep >= rows.length())
+    const int32_t n = rows.length();
+    if (gpxStep >= n || totals.length() != n + 1)
         return 0.0;
-    double km = (rows.at(gpxStep).distance);
-    int timesum = 0;
-    if (gpxStep > 0)
-        timesum = (QTime(0, 0, 0).secsTo(rows.at(gpxStep).gpxElapsed) -
-                   QTime(0, 0, 0).secsTo(rows.at(gpxStep - 1).gpxElapsed));
-    else
-        timesum = QTime(0, 0, 0).secsTo(rows.at(gpxStep).gpxElapsed);
-    int c = gpxStep + 1;
-    while (1) {
-        if ((timesum >= seconds) || (c >= rows.length())) {
-            return (km / ((double)timesum) * 3600.0);
-        }
-        km += (rows.at(c).distance);
-        if (c > 0)
-            timesum = (timesum + QTime(0, 0, 0).secsTo(rows.at(c).gpxElapsed) -
-                       QTime(0, 0, 0).secsTo(rows.at(c - 1).gpxElapsed));
-        c++;
+
+    // the window ends with the first row that reaches the given seconds from the end of the previous row
+    int32_t base = gpxStep > 0 ? totals.at(gpxStep - 1).gpxSeconds : 0;
+    int32_t target = base + seconds;
+    int32_t last = gpxStep;
+    if (gpxSecondsSorted) {
+        last = std::lower_bound(totals.constBegin() + gpxStep, totals.constBegin() + n, target,
+                                [](const cumulative &c, int32_t t) { return c.gpxSeconds < t; }) -
+               totals.constBegin();
+    } else {
+        while (last < n && totals.at(last).gpxSeconds < target)
+            last++;
     }
+    if (last >= n)
+        last = n - 1;
+
+    double km = totals.at(last + 1).distance - totals.at(gpxStep).distance;
+    int timesum = totals.at(last).gpxSeconds - base;
     return (km / ((double)timesum) * 3600.0);
 }
 
@@ -360,32 +422,15 @@ double trainprogram::TimeRateFromGPX(double gpxsecs, double videosecs, double cu
 // Calculate the Median Inclination for a given Step. Median is built from the given Step -2 Steps and +2 Steps (5 Steps
 // in total)
 double trainprogram::medianInclination(int step) {
-    QList<double> inclinations;
-    inclinations.reserve(5);
+    double inclinations[5];
     if (rows.length() == 0)
         return 0;
-    if ((step > 1) && (rows.length() > step - 2))
-        inclinations.append(rows.at(step - 2).inclination);
-    else
-        inclinations.append(0);
-    if ((step > 0) && (rows.length() > step - 1))
-        inclinations.append(rows.at(step - 1).inclination);
-    else
-        inclinations.append(0);
-    if (rows.length() > step)
-        inclinations.append(rows.at(step).inclination);
-    else
-        inclinations.append(0);
-    if (rows.length() > step + 1)
-        inclinations.append(rows.at(step + 1).inclination);
-    else
-        inclinations.append(0);
-    if (rows.length() > step + 2)
-        inclinations.append(rows.at(step + 2).inclination);
-    else
-        inclinations.append(0);
-    std::sort(inclinations.begin(), inclinations.end());
-    return (inclinations.at(2));
+    for (int i = 0; i < 5; i++) {
+        int s = step - 2 + i;
+        inclinations[i] = (s >= 0 && s < rows.length()) ? rows.at(s).inclination : 0;
+    }
+    std::sort(inclinations, inclinations + 5);
+    return (inclinations[2]);
 }
 
 // Calculates a weighted Inclination for a given Step. Inclination is calculated for the given Step + windowsize Steps
@@ -425,79 +470,32 @@ double trainprogram::weightedInclination(int step) {
 }
 
 double trainprogram::avgInclinationNext100Meters(int step) {
-    int c = step;
-    double km = 0;
-    double avg = 0;
-    int sum = 0;
-
-    while (1) {
-        if (c < rows.length()) {
-            if (km > 0.1) {
-                if (sum == 1) {
-                    return rows.at(currentStep).inclination;
-                }
-                return avg / (double)sum;
-            }
-            if (c == currentStep)
-                km += (rows.at(c).distance - currentStepDistance);
-            else
-                km += (rows.at(c).distance);
-            avg += rows.at(c).inclination;
-            sum++;
-
-        } else {
-            if (sum == 1) {
-                return rows.at(currentStep).inclination;
-            }
-            return avg / (double)sum;
-        }
-        c++;
-    }
+    int32_t last = rowAfterDistance(step, 0.1, true);
+    int sum = last - step;
     if (sum == 1) {
         return rows.at(currentStep).inclination;
     }
+    double avg = sum > 0 ? totals.at(last).inclination - totals.at(step).inclination : 0;
     return avg / (double)sum;
 }
 
 double trainprogram::avgAzimuthNext300Meters() {
-    int c = currentStep;
-    double km = 0;
-    double sinTotal = 0;
-    double cosTotal = 0;
+    int32_t c = currentStep;
 
     if (!isnan(rows.at(c).latitude) && !isnan(rows.at(c).longitude)) {
-        while (1) {
-            if (c < rows.length()) {
-                if (km > 0.3) {
-                    double averageDirection = atan(sinTotal / cosTotal) * (180 / M_PI);
-
-                    if (cosTotal < 0) {
-                        averageDirection += 180;
-                    } else if (sinTotal < 0) {
-                        averageDirection += 360;
-                    }
-                    return averageDirection;
-                }
-
-                for (double i = 0; i < rows.at(c).distance; i += 0.001) {
-                    sinTotal += sin(rows.at(c).azimuth * (M_PI / 180));
-                    cosTotal += cos(rows.at(c).azimuth * (M_PI / 180));
-                }
-
-                km += rows.at(c).distance;
-
-            } else {
-                double averageDirection = atan(sinTotal / cosTotal) * (180 / M_PI);
-
-                if (cosTotal < 0) {
-                    averageDirection += 180;
-                } else if (sinTotal < 0) {
-                    averageDirection += 360;
-                }
-                return averageDirection;
-            }
-            c++;
+        int32_t last = rowAfterDistance(c, 0.3, false);
+        if (totals.at(last).unknownAzimuth != totals.at(c).unknownAzimuth)
+            return NAN;
+        double sinTotal = totals.at(last).azimuthSin - totals.at(c).azimuthSin;
+        double cosTotal = totals.at(last).azimuthCos - totals.at(c).azimuthCos;
+        double averageDirection = atan(sinTotal / cosTotal) * (180 / M_PI);
+
+        if (cosTotal < 0) {
+            averageDirection += 180;
+        } else if (sinTotal < 0) {
+            averageDirection += 360;
         }
+        return averageDirection;
     }
     return 0;
 }
@@ -505,6 +503,7 @@ double trainprogram::avgAzimuthNext300Meters() {
 void trainprogram::clearRows() {
     QMutexLocker(&this->schedulerMutex);
     rows.clear();
+    buildIndex();
 }
 
 void trainprogram::pelotonOCRprocessPendingDatagrams() {
@@ -805,16 +804,7 @@ void trainprogram::scheduler() {
     qDebug() << QStringLiteral("trainprogram elapsed ") + QString::number(ticks) + QStringLiteral("current row len") +
                     QString::number(currentRowLen);
 
-    uint32_t calculatedLine;
-    uint32_t calculatedElapsedTime = 0;
-    for (calculatedLine = 0; calculatedLine < static_cast<uint32_t>(rows.length()); calculatedLine++) {
-
-        calculatedElapsedTime += calculateTimeForRow(calculatedLine);
-
-        if (calculatedElapsedTime > static_cast<uint32_t>(ticks)) {
-            break;
-        }
-    }
+    int32_t calculatedLine = rowAtTime(static_cast<uint32_t>(ticks));
 
     bool distanceEvaluation = false;
     int sameIteration = 0;
@@ -1345,34 +1335,23 @@ double trainprogram::currentTargetMets() {
 }
 
 QTime trainprogram::currentRowElapsedTime() {
-    uint32_t calculatedLine;
-    uint32_t calculatedElapsedTime = 0;
-
     if (rows.length() == 0)
         return QTime(0, 0, 0);
 
-    for (calculatedLine = 0; calculatedLine < static_cast<uint32_t>(rows.length()); calculatedLine++) {
-
-        uint32_t currentLine = calculateTimeForRow(calculatedLine);
-        calculatedElapsedTime += currentLine;
-        uint32_t rampElapsed = 0;
+    int32_t calculatedLine = rowAtTime(static_cast<uint32_t>(ticks));
+    if (calculatedLine >= rows.length())
+        return QTime(0, 0, 0);
 
-        if (calculatedElapsedTime > static_cast<uint32_t>(ticks)) {
-            if (rows.at(calculatedLine).rampElapsed != QTime(0, 0, 0)) {
-                rampElapsed = (rows.at(calculatedLine).rampElapsed.second() +
-                               (rows.at(calculatedLine).rampElapsed.minute() * 60) +
-                               (rows.at(calculatedLine).rampElapsed.hour() * 3600));
-            }
-            return QTime(0, 0, 0).addSecs(rampElapsed + ticks - (calculatedElapsedTime - currentLine));
-        }
+    uint32_t rampElapsed = 0;
+    if (rows.at(calculatedLine).rampElapsed != QTime(0, 0, 0)) {
+        rampElapsed = (rows.at(calculatedLine).rampElapsed.second() +
+                       (rows.at(calculatedLine).rampElapsed.minute() * 60) +
+                       (rows.at(calculatedLine).rampElapsed.hour() * 3600));
     }
-    return QTime(0, 0, 0);
+    return QTime(0, 0, 0).addSecs(rampElapsed + ticks - totals.at(calculatedLine).time);
 }
 
 QTime trainprogram::currentRowRemainingTime() {
-    uint32_t calculatedLine;
-    uint32_t calculatedElapsedTime = 0;
-
     if (rows.length() == 0)
         return QTime(0, 0, 0);
 
@@ -1385,38 +1364,28 @@ QTime trainprogram::currentRowRemainingTime() {
         int hours = seconds / 3600;
         return QTime(hours, (seconds / 60) - (hours * 60), seconds % 60);
     } else {
-        for (calculatedLine = 0; calculatedLine < static_cast<uint32_t>(rows.length()); calculatedLine++) {
-
-            uint32_t currentLine = calculateTimeForRow(calculatedLine);
-            calculatedElapsedTime += currentLine;
-
-            if (calculatedElapsedTime > static_cast<uint32_t>(ticks)) {
-                if (rows.at(calculatedLine).rampDuration != QTime(0, 0, 0)) {
-                    calculatedElapsedTime += ((rows.at(calculatedLine).rampDuration.second() +
-                                               (rows.at(calculatedLine).rampDuration.minute() * 60) +
-                                               (rows.at(calculatedLine).rampDuration.hour() * 3600))) -
-                                             1;
-                }
-                int seconds = calculatedElapsedTime - ticks;
-                int hours = seconds / 3600;
-                return QTime(hours, (seconds / 60) - (hours * 60), seconds % 60);
-            }
+        int32_t calculatedLine = rowAtTime(static_cast<uint32_t>(ticks));
+        if (calculatedLine < rows.length()) {
+            uint32_t calculatedElapsedTime = totals.at(calculatedLine + 1).time;
+            if (rows.at(calculatedLine).rampDuration != QTime(0, 0, 0)) {
+                calculatedElapsedTime += ((rows.at(calculatedLine).rampDuration.second() +
+                                           (rows.at(calculatedLine).rampDuration.minute() * 60) +
+                                           (rows.at(calculatedLine).rampDuration.hour() * 3600))) -
+                                         1;
+            }
+            int seconds = calculatedElapsedTime - ticks;
+            int hours = seconds / 3600;
+            return QTime(hours, (seconds / 60) - (hours * 60), seconds % 60);
         }
     }
     return QTime(0, 0, 0);
 }
 
 QTime trainprogram::remainingTime() {
-    uint32_t calculatedLine;
-    uint32_t calculatedTotalTime = 0;
-
     if (rows.length() == 0)
         return QTime(0, 0, 0);
 
-    for (calculatedLine = 0; calculatedLine < static_cast<uint32_t>(rows.length()); calculatedLine++) {
-        calculatedTotalTime += calculateTimeForRow(calculatedLine);
-    }
-    return QTime(0, 0, 0).addSecs(calculatedTotalTime - ticks);
+    return QTime(0, 0, 0).addSecs(totals.last().time - ticks);
 }
 
 QTime trainprogram::duration() {
@@ -7,6 +7,7 @@
 #include <QSet>
 #include <QTime>
 #include <QTimer>
+#include <QVector>
 
 class trainrow {
   public:
@@ -83,13 +84,18 @@ class trainprogram : public QObject {
     int TotalGPXSecs();
     double weightedInclination(int step);
     double medianInclination(int step);
+    double avgAzimuthNext300Meters();
+    QList<MetersByInclination> inclinationNext300Meters();
+    QList<MetersByInclination> avgInclinationNext300Meters();
+    double avgInclinationNext100Meters(int step);
+
+    /**
+     * @brief buildIndex Rebuilds the cumulative totals of the rows and powerRows. To be called every time the
+     * duration, distance, inclination or azimuth of the rows change.
+     */
+    void buildIndex();
     bool overridePowerForCurrentRow(double power);
-    bool powerzoneWorkout() {
-        foreach(trainrow r, rows) {
-            if(r.power != -1) return true;
-        }
-        return false;
-    }
+    bool powerzoneWorkout() { return powerRows; }
 
     QList<trainrow> rows;
     QList<trainrow> loadedRows; // rows as loaded
@@ -131,17 +137,67 @@ private slots:
 
   private:
     mutable QRecursiveMutex schedulerMutex;
-    double avgAzimuthNext300Meters();
-    QList<MetersByInclination> inclinationNext300Meters();
-    QList<MetersByInclination> avgInclinationNext300Meters();
-    double avgInclinationNext100Meters(int step);
     uint32_t calculateTimeForRow(int32_t row);
     uint32_t calculateTimeForRowMergingRamps(int32_t row);
     double calculateDistanceForRow(int32_t row);
+
+    /**
+     * @brief The cumulative struct The totals of the rows before a row, so that the sum over any range of rows is a
+     * subtraction. totals has one more item than rows, whose totals cover the whole program.
+     */
+    struct cumulative {
+        /**
+         * @brief time The second at which the row starts, from the timed rows. Unit: seconds
+         */
+        uint32_t time = 0;
+
+        /**
+         * @brief distance Unit: km
+         */
+        double distance = 0;
+        double inclination = 0;
+
+        /**
+         * @brief azimuthSin The sines and cosines of the azimuths, one for each meter of the rows, as
+         * avgAzimuthNext300Meters() weighs them.
+         */
+        double azimuthSin = 0;
+        double azimuthCos = 0;
+
+        /**
+         * @brief unknownAzimuth The rows with a distance and no azimuth.
+         */
+        int32_t unknownAzimuth = 0;
+
+        /**
+         * @brief gpxSeconds The gpxElapsed of the row, not a total. Unit: seconds
+         */
+        int32_t gpxSeconds = 0;
+    };
+
+    /**
+     * @brief rowAtTime The timed row that is running at the given second of the workout, found with a binary search
+     * of the totals.
+     * @return rows.length() if the timed rows are over.
+     */
+    int32_t rowAtTime(uint32_t seconds) const;
+
+    /**
+     * @brief rowAfterDistance The row after the look-ahead window that starts at step and covers more than km, i.e.
+     * the window is [step, result). The part of the current row already run is left out of the window if
+     * fromCurrentPosition is true.
+     * @return rows.length() if the program ends first.
+     */
+    int32_t rowAfterDistance(int32_t step, double km, bool fromCurrentPosition) const;
+
+    QVector<cumulative> totals;
+    bool distanceSorted = true;
+    bool gpxSecondsSorted = true;
+    bool powerRows = false;
     bluetooth *bluetoothManager;
     bool started = false;
     int32_t ticks = 0;
-    uint16_t currentStep = 0;
+    int32_t currentStep = 0;
     int32_t offset = 0;
     double lastOdometer = 0;
     double currentStepDistance = 0;
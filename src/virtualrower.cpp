@@ -1,4 +1,5 @@
 #include "virtualrower.h"
+#include "gattlayout.h"
 #include "qsettings.h"
 #include "rower.h"
 
@@ -8,6 +9,15 @@
 #include <QtMath>
 #include <chrono>
 
+// flags, stroke rate, stroke count, total distance, instantaneous pace, instantaneous power, total energy, energy
+// per hour, energy per minute, heart rate, Bkool FTMS protocol HRM offset 1280 fix
+typedef gattlayout<uint16_t, uint8_t, uint16_t, gattuint24, uint16_t, uint16_t, uint16_t, uint16_t, uint8_t, uint8_t,
+                   uint8_t>
+    rowerData;
+static const uint16_t rowerDataFlags = 0x032C; // distance, pace, power, energy, heart rate
+// flags (8 bit heart rate value), heart rate
+typedef gattlayout<uint8_t, uint8_t> heartRateMeasurement;
+
 using namespace std::chrono_literals;
 
 virtualrower::virtualrower(bluetoothdevice *t, bool noWriteResistance, bool noHeartService) {
@@ -383,32 +393,13 @@ void virtualrower::rowerProvider() {
 
     if (!heart_only) {
 
-        value.append((char)0x2C);
-        value.append((char)0x03);
-
-        value.append((char)((uint8_t)(Rower->currentCadence().value() * 2) & 0xFF)); // Stroke Rate
-
-        value.append((char)((uint16_t)(((rower *)Rower)->currentStrokesCount().value()) & 0xFF));        // Stroke Count
-        value.append((char)(((uint16_t)(((rower *)Rower)->currentStrokesCount().value()) >> 8) & 0xFF)); // Stroke Count
-
-        value.append((char)(((uint16_t)(((rower *)Rower)->odometer() * 1000.0)) & 0xFF));       // Distance
-        value.append((char)(((uint16_t)(((rower *)Rower)->odometer() * 1000.0) >> 8) & 0xFF));  // Distance
-        value.append((char)(((uint16_t)(((rower *)Rower)->odometer() * 1000.0) >> 16) & 0xFF)); // Distance
-
-        value.append((char)(((uint16_t)QTime(0, 0, 0).secsTo(((rower *)Rower)->currentPace())) & 0xFF));      // pace
-        value.append((char)(((uint16_t)QTime(0, 0, 0).secsTo(((rower *)Rower)->currentPace())) >> 8) & 0xFF); // pace
-
-        value.append((char)(((uint16_t)Rower->wattsMetric().value()) & 0xFF));      // watts
-        value.append((char)(((uint16_t)Rower->wattsMetric().value()) >> 8) & 0xFF); // watts
-
-        value.append((char)((uint16_t)(Rower->calories().value()) & 0xFF));        // calories
-        value.append((char)(((uint16_t)(Rower->calories().value()) >> 8) & 0xFF)); // calories
-        value.append((char)((uint16_t)(Rower->calories().value()) & 0xFF));        // calories
-        value.append((char)(((uint16_t)(Rower->calories().value()) >> 8) & 0xFF)); // calories
-        value.append((char)((uint16_t)(Rower->calories().value()) & 0xFF));        // calories
-
-        value.append(char(Rower->currentHeart().value())); // Actual value.
-        value.append((char)0);                             // Bkool FTMS protocol HRM offset 1280 fix
+        uint16_t calories = (uint16_t)Rower->calories().value();
+        rowerData::append(value, rowerDataFlags, (uint8_t)(Rower->currentCadence().value() * 2),
+                          (uint16_t)((rower *)Rower)->currentStrokesCount().value(),
+                          (uint32_t)(((rower *)Rower)->odometer() * 1000.0),
+                          (uint16_t)QTime(0, 0, 0).secsTo(((rower *)Rower)->currentPace()),
+                          (uint16_t)Rower->wattsMetric().value(), calories, calories, (uint8_t)calories,
+                          (uint8_t)(int)Rower->currentHeart().value(), 0);
 
         if (!serviceFIT) {
             qDebug() << QStringLiteral("serviceFIT not available");
@@ -443,8 +434,7 @@ void virtualrower::rowerProvider() {
         }
 
         QByteArray valueHR;
-        valueHR.append(char(0));                                   // Flags that specify the format of the value.
-        valueHR.append(char(Rower->metrics_override_heartrate())); // Actual value.
+        heartRateMeasurement::append(valueHR, 0x00, Rower->metrics_override_heartrate());
         QLowEnergyCharacteristic characteristicHR = serviceHR->characteristic(QBluetoothUuid::HeartRateMeasurement);
 
         Q_ASSERT(characteristicHR.isValid());
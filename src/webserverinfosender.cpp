@@ -1,4 +1,7 @@
 #include "webserverinfosender.h"
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 12, 0))
+#include <QCborValue>
+#endif
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
@@ -56,6 +59,62 @@ bool WebServerInfoSender::send(const QString &data) {
         return false;
 }
 
+bool WebServerInfoSender::sendUpdate(const QString &data) {
+    if (isRunning() && !data.isEmpty()) {
+        bool rv = true;
+        for (QWebSocket *client : qAsConst(sendToClients)) {
+            if (!subscriptions.contains(client))
+                rv = client->sendTextMessage(data) > 0;
+        }
+        return rv;
+    } else
+        return false;
+}
+
+bool WebServerInfoSender::reply(const QString &data) {
+    if (!requester)
+        return send(data);
+    return !data.isEmpty() && requester->sendTextMessage(data) > 0;
+}
+
+bool WebServerInfoSender::subscribe(const QStringList &fields, bool binary) {
+    if (!requester || !sendToClients.contains(requester))
+        return false;
+    subscription s;
+    s.fields = fields;
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 12, 0))
+    s.binary = binary;
+#else
+    Q_UNUSED(binary)
+#endif
+    subscriptions.insert(requester, s);
+    return true;
+}
+
+void WebServerInfoSender::publish(const QJsonObject &workout, int cursor) {
+    if (!isRunning())
+        return;
+    QHash<QWebSocket *, subscription>::iterator it;
+    for (it = subscriptions.begin(); it != subscriptions.end(); ++it) {
+        subscription &s = it.value();
+        QJsonObject delta = TemplateInfoSender::delta(workout, s.fields, s.last);
+        if (delta.isEmpty())
+            continue;
+
+        QJsonObject main;
+        main[QStringLiteral("msg")] = QStringLiteral("delta");
+        main[QStringLiteral("cursor")] = cursor;
+        main[QStringLiteral("content")] = delta;
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 12, 0))
+        if (s.binary) {
+            it.key()->sendBinaryMessage(QCborValue::fromJsonValue(main).toCbor());
+            continue;
+        }
+#endif
+        it.key()->sendTextMessage(QString::fromUtf8(QJsonDocument(main).toJson(QJsonDocument::Compact)));
+    }
+}
+
 void WebServerInfoSender::innerStop() {
     if (innerTcpServer) {
         if (isRunning())
@@ -64,6 +123,8 @@ void WebServerInfoSender::innerStop() {
         clients.clear();
         sendToClients.clear();
         reply2Req.clear();
+        subscriptions.clear();
+        requester = nullptr;
         innerTcpServer = 0;
         httpServer = 0;
     }
@@ -172,7 +233,9 @@ void WebServerInfoSender::processTextMessage(QString message) {
         pClient->sendTextMessage(message);
     }*/
     //qDebug() << QStringLiteral("Message received:") << message;
+    requester = qobject_cast<QWebSocket *>(sender());
     emit onDataReceived(message.toUtf8());
+    requester = nullptr;
 }
 
 void WebServerInfoSender::processFetcherRequest(QString data) {
@@ -241,6 +304,9 @@ void WebServerInfoSender::socketDisconnected() {
     qDebug() << QStringLiteral("socketDisconnected:") << pClient;
     if (pClient) {
         clients.removeAll(pClient);
+        subscriptions.remove(pClient);
+        if (requester == pClient)
+            requester = nullptr;
         if (!sendToClients.removeAll(pClient)) {
             QMutableHashIterator<QNetworkReply *, QPair<QJsonObject, QWebSocket *>> i(reply2Req);
             while (i.hasNext()) {
@@ -261,5 +327,7 @@ void WebServerInfoSender::processBinaryMessage(QByteArray message) {
         pClient->sendBinaryMessage(message);
     }*/
     //qDebug() << QStringLiteral("Binary Message received:") << message.toHex();
+    requester = qobject_cast<QWebSocket *>(sender());
     emit onDataReceived(message);
+    requester = nullptr;
 }
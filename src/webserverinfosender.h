@@ -23,8 +23,16 @@ class WebServerInfoSender : public TemplateInfoSender {
     virtual ~WebServerInfoSender();
     virtual bool isRunning() const;
     virtual bool send(const QString &data);
+    virtual bool reply(const QString &data);
+    virtual bool subscribe(const QStringList &fields, bool binary);
+    virtual void publish(const QJsonObject &workout, int cursor);
 
   private:
+    struct subscription {
+        QStringList fields;
+        bool binary = false;
+        QJsonObject last;
+    };
     QHttpServer *httpServer = 0;
     QStringList folders;
     bool listen();
@@ -33,6 +41,7 @@ class WebServerInfoSender : public TemplateInfoSender {
 
   protected:
     virtual void innerStop();
+    virtual bool sendUpdate(const QString &data);
     int port = 0;
     QTcpServer *innerTcpServer = 0;
     virtual bool init();
@@ -41,6 +50,8 @@ class WebServerInfoSender : public TemplateInfoSender {
     QList<QWebSocket *> sendToClients;
     QHash<QString, QString> relative2Absolute;
     QHash<QNetworkReply *, QPair<QJsonObject, QWebSocket *>> reply2Req;
+    QHash<QWebSocket *, subscription> subscriptions;
+    QWebSocket *requester = nullptr;
   private slots:
     void acceptError(QAbstractSocket::SocketError socketError);
     void watchdogEvent();
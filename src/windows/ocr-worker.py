@@ -0,0 +1,53 @@
+# ocr-worker.py - persistent OCR worker for the Zwift OCR scripts
+#
+# Keeps python, the imports and the PaddleOCR models loaded between frames:
+# the zwift-*.py scripts are run in this process and the PaddleOCR instance
+# they create is reused.
+#
+# Protocol, one line per message on stdin / stdout:
+#   request:  <id> <script>
+#   response: <id> <what the script printed>
+# "ready" is printed once the worker accepts requests, the worker exits when
+# stdin is closed.
+
+# imports
+import contextlib
+import io
+import runpy
+import sys
+import paddleocr
+
+_PaddleOCR = paddleocr.PaddleOCR
+_instances = {}
+
+def cached_paddleocr(**kwargs):
+    key = tuple(sorted(kwargs.items()))
+    if key not in _instances:
+        _instances[key] = _PaddleOCR(**kwargs)
+    return _instances[key]
+
+paddleocr.PaddleOCR = cached_paddleocr
+
+# Load the models the scripts use before accepting requests
+cached_paddleocr(lang='en', use_gpu=False, enable_mkldnn=True, use_angle_cls=False, table=False, layout=False, show_log=False)
+
+out = sys.stdout
+print("ready", file=out, flush=True)
+
+for line in sys.stdin:
+    parts = line.split()
+    if len(parts) < 2:
+        continue
+    request_id, script = parts[0], parts[1]
+
+    captured = io.StringIO()
+    try:
+        sys.argv = [script] + parts[2:]
+        with contextlib.redirect_stdout(captured):
+            runpy.run_path(script, run_name="__main__")
+        result = " ".join(captured.getvalue().split())
+    except Exception as e:
+        print(f"{script}: {e}", file=sys.stderr, flush=True)
+        result = "None"
+
+    print(f"{request_id} {result}", file=out, flush=True)
@@ -8,6 +8,7 @@
 #include <QtGui/qguiapplication.h>
 #endif
 #include "bluetoothdevice.h"
+#include "ocrworker.h"
 #include <QDateTime>
 #include <QObject>
 #include <QString>
@@ -32,7 +33,7 @@ class windows_zwift_incline_paddleocr_thread : public QThread {
   private:
     double inclination = 0;
     bluetoothdevice *device;
-    QString runPython(QString command);
+    QString runPython(ocrworker &worker, const QString &script);
 };
 
 #endif // WINDOWS_ZWIFT_INCLINE_PADDLEOCR_THREAD_H
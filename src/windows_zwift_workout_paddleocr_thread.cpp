@@ -13,6 +13,9 @@
 
 using namespace std::chrono_literals;
 
+// the worker answers with the inference time, not with the python startup one
+static const int ocrTimeout = 10000;
+
 windows_zwift_workout_paddleocr_thread::windows_zwift_workout_paddleocr_thread(bluetoothdevice *device) {
     this->device = device;
     emit debug("windows_zwift_workout_paddleocr_thread created!");
@@ -21,8 +24,10 @@ windows_zwift_workout_paddleocr_thread::windows_zwift_workout_paddleocr_thread(b
 void windows_zwift_workout_paddleocr_thread::run() {
     float lastInclination = -100;
     float lastSpeed = -100;
+    // one python process for the whole session, the OCR models are loaded only once
+    ocrworker worker(QStringLiteral("python\\x64\\python.exe"), QStringList() << QStringLiteral("ocr-worker.py"));
     while (1) {
-        QString ret = runPython("zwift-workout.py");
+        QString ret = runPython(worker, "zwift-workout.py");
         if (ret.length() > 0) {
             QStringList list = ret.split(";");
             if (list.length() >= 2) {
@@ -45,20 +50,20 @@ void windows_zwift_workout_paddleocr_thread::run() {
     }
 }
 
-QString windows_zwift_workout_paddleocr_thread::runPython(QString command) {
+QString windows_zwift_workout_paddleocr_thread::runPython(ocrworker &worker, const QString &script) {
+    QString out;
 #ifdef Q_OS_WINDOWS
-    QProcess process;
-    qDebug() << "run >> " << command;
-    process.start("python\\x64\\python.exe", QStringList(command.split(' ')));
-    process.waitForFinished(-1); // will wait forever until finished
+    qDebug() << "run >> " << script;
+    if (worker.request(script, out, ocrTimeout))
+        emit debug("python << OUT " + out);
+    else
+        emit debug("python << no answer to " + script);
 
-    QString out = process.readAllStandardOutput();
-    QString err = process.readAllStandardError();
-
-    emit debug("python << OUT " + out);
-    emit debug("python << ERR " + err);
+    if (worker.stats().requests > 0 && worker.stats().requests % 100 == 0)
+        emit debug("python ocr worker " + worker.stats().toString());
 #else
-    QString out;
+    Q_UNUSED(worker);
+    Q_UNUSED(script);
 #endif
     return out;
 }
@@ -9,6 +9,7 @@
 #include <QtGui/qguiapplication.h>
 #endif
 #include "bluetoothdevice.h"
+#include "ocrworker.h"
 #include <QDateTime>
 #include <QObject>
 #include <QString>
@@ -35,7 +36,7 @@ class windows_zwift_workout_paddleocr_thread : public QThread {
     double inclination = 0;
     double speed = 0;
     bluetoothdevice *device;
-    QString runPython(QString command);
+    QString runPython(ocrworker &worker, const QString &script);
 };
 
 #endif // WINDOWS_ZWIFT_WORKOUT_PADDLEOCR_THREAD_H
@@ -144,12 +144,17 @@ void zwiftworkout::convertTag(double thresholdSecPerKm, const QString &sportType
             }
 
         } else {
+            // a ramp becomes one row per second: the settings are read once and the ramp is logged once, as both
+            // dominated the load time of the long workouts
+            double ftp = settings.value(QZSettings::ftp, QZSettings::default_ftp).toDouble();
+            qDebug() << "TrainRow ramp" << Duration << PowerLow << PowerHigh << Pace << Cadence;
+            list.reserve(list.length() + Duration);
             for (uint32_t i = 0; i < Duration; i++) {
                 trainrow row;
                 if (!durationAsDistance(sportType, durationType)) {
                     row.duration = QTime(0, 0, 1, 0);
-                    row.rampDuration = QTime((Duration - i) / 3600, (Duration - i) / 60, (Duration - i) % 60, 0);
-                    row.rampElapsed = QTime(i / 3600, i / 60, i % 60, 0);
+                    row.rampDuration = QTime(0, 0, 0, 0).addSecs(Duration - i);
+                    row.rampElapsed = QTime(0, 0, 0, 0).addSecs(i);
                 } else {
                     row.distance = 0.001;
                 }
@@ -157,8 +162,7 @@ void zwiftworkout::convertTag(double thresholdSecPerKm, const QString &sportType
                     row.cadence = Cadence;
                 if (PowerHigh > PowerLow) {
                     if (!sportType.toLower().contains(QStringLiteral("run"))) {
-                        row.power = (PowerLow + (((PowerHigh - PowerLow) / Duration) * i)) *
-                                    settings.value(QZSettings::ftp, QZSettings::default_ftp).toDouble();
+                        row.power = (PowerLow + (((PowerHigh - PowerLow) / Duration) * i)) * ftp;
                     } else {
                         double speed = speedFromPace(Pace);
                         row.speed = (double)qFloor(((((60.0 / speed) * 60.0) * (PowerLow + (((PowerHigh - PowerLow) / Duration) * i))) * 10.0)) / 10.0;
@@ -166,15 +170,13 @@ void zwiftworkout::convertTag(double thresholdSecPerKm, const QString &sportType
                     }
                 } else {
                     if (!sportType.toLower().contains(QStringLiteral("run"))) {
-                        row.power = (PowerLow - (((PowerLow - PowerHigh) / Duration) * i)) *
-                                    settings.value(QZSettings::ftp, QZSettings::default_ftp).toDouble();
+                        row.power = (PowerLow - (((PowerLow - PowerHigh) / Duration) * i)) * ftp;
                     } else {
                         double speed = speedFromPace(Pace);
                         row.speed = (double)qFloor(((((60.0 / speed) * 60.0) * ((PowerLow - (((PowerLow - PowerHigh) / Duration) * i)))) * 10.0)) / 10.0;
                         row.forcespeed = 1;
                     }
                 }
-                qDebug() << "TrainRow" << row.toString();
                 list.append(row);
             }
         }
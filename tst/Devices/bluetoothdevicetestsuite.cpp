@@ -74,6 +74,8 @@ void BluetoothDeviceTestSuite<T>::testDeviceDetection(BluetoothDeviceTestData *
         EXPECT_TRUE(testData->get_isExpectedDevice(device)) << formattedFailMessage;
 
         EXPECT_EQ(device, signalReceiver.get_device()) << "Connection signal not received";
+        // the UI builds its tiles from bluetooth::device() when deviceConnected is emitted
+        EXPECT_EQ(device, signalReceiver.get_deviceAtConnection()) << "No active device when deviceConnected was emitted";
     } else {
         EXPECT_FALSE(testData->get_isExpectedDevice(device)) << this->formatString(failMessage, device);
     }
@@ -1,7 +1,8 @@
 #include "bluetoothsignalreceiver.h"
 
 
-BluetoothSignalReceiver::BluetoothSignalReceiver(bluetooth &b, QObject *parent) : QObject(parent) {
+BluetoothSignalReceiver::BluetoothSignalReceiver(bluetooth &b, QObject *parent) : QObject(parent), bt(b) {
+    connect(&b, &bluetooth::deviceConnected, this, &BluetoothSignalReceiver::deviceConnected);
     connect(&b, &bluetooth::bluetoothDeviceConnected, this, &BluetoothSignalReceiver::bluetoothDeviceConnected);
     connect(&b, &bluetooth::bluetoothDeviceDisconnected, this, &BluetoothSignalReceiver::bluetoothDeviceDisconnected);
 }
@@ -10,7 +11,14 @@ BluetoothSignalReceiver::~BluetoothSignalReceiver() {}
 
 bluetoothdevice *BluetoothSignalReceiver::get_device() const { return this->device; }
 
+bluetoothdevice *BluetoothSignalReceiver::get_deviceAtConnection() const { return this->deviceAtConnection; }
+
 void BluetoothSignalReceiver::bluetoothDeviceConnected(bluetoothdevice *b) { this->device = b;}
 
 void BluetoothSignalReceiver::bluetoothDeviceDisconnected() { this->device = nullptr; }
 
+void BluetoothSignalReceiver::deviceConnected(const QBluetoothDeviceInfo &b) {
+    Q_UNUSED(b);
+    this->deviceAtConnection = this->bt.device();
+}
+
@@ -13,7 +13,9 @@ class BluetoothSignalReceiver : public QObject
     Q_OBJECT
 
  private:
+    bluetooth& bt;
     bluetoothdevice* device = nullptr;
+    bluetoothdevice* deviceAtConnection = nullptr;
 
 
 public:
@@ -22,9 +24,15 @@ public:
 
     bluetoothdevice * get_device() const;
 
+    /**
+     * @brief The active device of the bluetooth object when it emitted deviceConnected.
+     */
+    bluetoothdevice * get_deviceAtConnection() const;
+
 public Q_SLOTS:
     void bluetoothDeviceConnected(bluetoothdevice *b);
     void bluetoothDeviceDisconnected();
+    void deviceConnected(const QBluetoothDeviceInfo &b);
 };
 
 #endif // BLUETOOTHSIGNALRECEIVER_H
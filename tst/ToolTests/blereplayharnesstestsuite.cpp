@@ -0,0 +1,93 @@
+#include "blereplayharnesstestsuite.h"
+
+#include "Tools/blereplayharness.h"
+#include "Tools/testsettings.h"
+#include "ftmsbike.h"
+#include "qzsettingscache.h"
+
+BLEReplayHarnessTestSuite::BLEReplayHarnessTestSuite()
+{
+
+}
+
+void BLEReplayHarnessTestSuite::test_plainCapture() {
+    BLEReplayHarness::Packet packet;
+
+    EXPECT_TRUE(BLEReplayHarness::parseLine("1500 2ad2 64 02 c4 09", packet));
+    EXPECT_EQ(packet.timestamp, 1500);
+    EXPECT_EQ(packet.uuid, QBluetoothUuid((quint16)0x2AD2));
+    EXPECT_EQ(packet.value, QByteArray::fromHex("6402c409"));
+
+    EXPECT_TRUE(BLEReplayHarness::parseLine("1600 0x2ACD 0c 00", packet));
+    EXPECT_EQ(packet.uuid, QBluetoothUuid((quint16)0x2ACD));
+
+    EXPECT_TRUE(BLEReplayHarness::parseLine("1700 00002ad2-0000-1000-8000-00805f9b34fb 01", packet));
+    EXPECT_EQ(packet.uuid, QBluetoothUuid((quint16)0x2AD2));
+    EXPECT_EQ(packet.value, QByteArray::fromHex("01"));
+
+    EXPECT_FALSE(BLEReplayHarness::parseLine("# 1500 2ad2 64 02", packet));
+    EXPECT_FALSE(BLEReplayHarness::parseLine("1500 2ad2", packet));
+    EXPECT_FALSE(BLEReplayHarness::parseLine("not a packet", packet));
+
+    BLEReplayHarness harness;
+    harness.loadLines({"# comment 1500 2ad2 64 02", "1500 2ad2 64 02", "", "1600 2ad2 65 02"});
+    EXPECT_EQ(harness.capture().size(), 2);
+}
+
+void BLEReplayHarnessTestSuite::test_debugLog() {
+    BLEReplayHarness::Packet packet;
+
+    EXPECT_TRUE(BLEReplayHarness::parseLine(
+        "Fri Oct 16 10:00:00 2026 1792144800000 Debug: ../src/ftmsbike.cpp void ftmsbike::parseNotification() "
+        "QUuid(\"{00002ad2-0000-1000-8000-00805f9b34fb}\") \" << \" \"64 02 c4 09\"",
+        packet));
+    EXPECT_EQ(packet.timestamp, 1792144800000);
+    EXPECT_EQ(packet.uuid, QBluetoothUuid((quint16)0x2AD2));
+    EXPECT_EQ(packet.value, QByteArray::fromHex("6402c409"));
+
+    // the packet length written before the bytes is skipped
+    EXPECT_TRUE(BLEReplayHarness::parseLine(
+        "Fri Oct 16 10:00:01 2026 1792144801000 Debug: ../src/homeform.cpp void homeform::deviceDebug() "
+        " << {00002acd-0000-1000-8000-00805f9b34fb} 4 0c 00 f4 01",
+        packet));
+    EXPECT_EQ(packet.timestamp, 1792144801000);
+    EXPECT_EQ(packet.uuid, QBluetoothUuid((quint16)0x2ACD));
+    EXPECT_EQ(packet.value, QByteArray::fromHex("0c00f401"));
+
+    // writes aren't notifications
+    EXPECT_FALSE(BLEReplayHarness::parseLine(
+        "Fri Oct 16 10:00:02 2026 1792144802000 Debug: ../src/ftmsbike.cpp void ftmsbike::writeCharacteristic() "
+        "\" >> \" \"05 28 00\"",
+        packet));
+}
+
+void BLEReplayHarnessTestSuite::test_ftmsBikeReplay() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+    testSettings.qsettings.clear();
+    qzsettingscache::instance()->invalidate();
+
+    // indoor bike data: speed 25 km/h, cadence 90 rpm, resistance 20, power 200 W, heart rate 140 bpm
+    BLEReplayHarness harness;
+    harness.loadLines({"0 2ad2 64 02 c4 09 b4 00 14 00 c8 00 8c",
+                       "250 2ad2 64 02 c4 09 b4 00 14 00 c8 00 8c",
+                       "500 2ad2 64 02 c4 09 b4 00 14 00 c8 00 8c"});
+    ASSERT_EQ(harness.capture().size(), 3);
+
+    ftmsbike device(false, false, 0, 1.0);
+    BLEReplayHarness::Report report = harness.run(&device);
+
+    EXPECT_EQ(report.packets, 3);
+    EXPECT_EQ(report.replayed, 3);
+    EXPECT_EQ(report.latencies.size(), 3);
+    EXPECT_GE(report.max(), report.percentile(0.5));
+    EXPECT_DOUBLE_EQ(report.speed, 25.0);
+    EXPECT_DOUBLE_EQ(report.cadence, 90.0);
+    EXPECT_DOUBLE_EQ(report.resistance, 20.0);
+    EXPECT_DOUBLE_EQ(report.watt, 200.0);
+    EXPECT_DOUBLE_EQ(report.heart, 140.0);
+    RecordProperty("report", report.toString().toStdString());
+
+    testSettings.deactivate();
+    qzsettingscache::instance()->invalidate();
+}
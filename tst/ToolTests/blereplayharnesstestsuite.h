@@ -0,0 +1,39 @@
+#ifndef BLEREPLAYHARNESSTESTSUITE_H
+#define BLEREPLAYHARNESSTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class BLEReplayHarnessTestSuite: public testing::Test {
+
+public:
+    BLEReplayHarnessTestSuite();
+
+    /**
+     * @brief Test the parsing of the plain capture lines.
+     */
+    void test_plainCapture();
+
+    /**
+     * @brief Test the parsing of the notification lines of a debug log.
+     */
+    void test_debugLog();
+
+    /**
+     * @brief Test that a capture replayed into an FTMS bike produces the expected metrics.
+     */
+    void test_ftmsBikeReplay();
+};
+
+TEST_F(BLEReplayHarnessTestSuite, TestPlainCapture) {
+    this->test_plainCapture();
+}
+
+TEST_F(BLEReplayHarnessTestSuite, TestDebugLog) {
+    this->test_debugLog();
+}
+
+TEST_F(BLEReplayHarnessTestSuite, TestFTMSBikeReplay) {
+    this->test_ftmsBikeReplay();
+}
+
+#endif // BLEREPLAYHARNESSTESTSUITE_H
@@ -0,0 +1,163 @@
+#include "blewritequeuetestsuite.h"
+
+#include "blewritequeue.h"
+
+#include <QElapsedTimer>
+
+static int argc = 1;
+static char arg0[] = "qdomyos-zwift-tests";
+static char *argv[] = {arg0, nullptr};
+
+template <typename Condition> static bool waitFor(Condition condition, int timeout) {
+    QElapsedTimer timer;
+    timer.start();
+    while (!condition()) {
+        if (timer.elapsed() > timeout)
+            return false;
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    }
+    return true;
+}
+
+/**
+ * @brief The FakeWriteQueue class A write queue toward plain objects standing for the GATT services: the payloads
+ * are recorded instead of being written, and the acknowledges are fed by the test.
+ */
+class FakeWriteQueue : public blewritequeue {
+  public:
+    QList<QByteArray> sent;
+
+    void push(QObject *target, const QByteArray &data, int coalesceKey = -1, completion_t done = nullptr,
+              WRITE_MODE mode = WRITE_WITH_RESPONSE) {
+        append(target, QLowEnergyCharacteristic(), data, QString(), true, false, coalesceKey, done, mode);
+    }
+
+    void written(QObject *target, const QBluetoothUuid &uuid = QBluetoothUuid()) { acknowledge(target, uuid, false); }
+
+  protected:
+    void write(QObject *target, const QLowEnergyCharacteristic &characteristic, const QByteArray &data,
+               QLowEnergyService::WriteMode mode) override {
+        Q_UNUSED(target)
+        Q_UNUSED(characteristic)
+        Q_UNUSED(mode)
+        sent.append(data);
+    }
+};
+
+BleWriteQueueTestSuite::BleWriteQueueTestSuite() {
+    if (!QCoreApplication::instance())
+        app.reset(new QCoreApplication(argc, argv));
+}
+
+void BleWriteQueueTestSuite::test_ordering() {
+    FakeWriteQueue queue;
+    QObject service, other;
+    QList<int> done;
+
+    for (int i = 0; i < 3; i++) {
+        queue.push(&service, QByteArray(1, (char)i), -1, [&done, i](bool written) {
+            if (written)
+                done.append(i);
+        });
+    }
+    ASSERT_EQ(1, queue.sent.count());
+    EXPECT_EQ(3, queue.depth());
+
+    // not the request in flight
+    queue.written(&other);
+    queue.written(&service, QBluetoothUuid(quint16(0x2AD9)));
+    EXPECT_TRUE(done.isEmpty());
+
+    for (int i = 1; i < 3; i++) {
+        queue.written(&service);
+        ASSERT_TRUE(waitFor([&queue, i]() { return queue.sent.count() == i + 1; }, 1000));
+    }
+    queue.written(&service);
+
+    EXPECT_EQ(QList<QByteArray>({QByteArray(1, 0), QByteArray(1, 1), QByteArray(1, 2)}), queue.sent);
+    EXPECT_EQ(QList<int>({0, 1, 2}), done);
+    EXPECT_EQ(0, queue.depth());
+    EXPECT_EQ(3, queue.maxDepth());
+    EXPECT_EQ(3u, queue.written());
+
+    // without response the requests are pipelined, still in order
+    queue.sent.clear();
+    for (int i = 0; i < 3; i++) {
+        queue.push(&service, QByteArray(1, (char)i), -1, nullptr, blewritequeue::WRITE_WITHOUT_RESPONSE);
+    }
+    ASSERT_TRUE(waitFor([&queue]() { return queue.depth() == 0; }, 1000));
+    EXPECT_EQ(QList<QByteArray>({QByteArray(1, 0), QByteArray(1, 1), QByteArray(1, 2)}), queue.sent);
+}
+
+void BleWriteQueueTestSuite::test_coalescing() {
+    FakeWriteQueue queue;
+    QObject service;
+    QList<bool> first, second;
+
+    queue.push(&service, QByteArray("a"));
+    queue.push(&service, QByteArray("b"), 5, [&first](bool written) { first.append(written); });
+    queue.push(&service, QByteArray("c"), 5, [&second](bool written) { second.append(written); });
+    EXPECT_EQ(QList<bool>({false}), first);
+    EXPECT_EQ(2, queue.depth());
+    EXPECT_EQ(1u, queue.coalesced());
+
+    queue.written(&service);
+    ASSERT_TRUE(waitFor([&queue]() { return queue.sent.count() == 2; }, 1000));
+    queue.written(&service);
+    EXPECT_EQ(QList<QByteArray>({QByteArray("a"), QByteArray("c")}), queue.sent);
+    EXPECT_EQ(QList<bool>({true}), second);
+}
+
+void BleWriteQueueTestSuite::test_timeout() {
+    FakeWriteQueue queue;
+    QObject service;
+    QList<bool> done;
+
+    queue.setTimeout(20);
+    queue.push(&service, QByteArray("a"), -1, [&done](bool written) { done.append(written); });
+    queue.push(&service, QByteArray("b"), -1, [&done](bool written) { done.append(written); });
+    ASSERT_TRUE(waitFor([&queue]() { return queue.sent.count() == 2; }, 1000));
+    EXPECT_EQ(QList<bool>({false}), done);
+    EXPECT_EQ(1u, queue.timeouts());
+
+    // the next acknowledge completes the second request
+    queue.written(&service);
+    EXPECT_EQ(QList<bool>({false, true}), done);
+    EXPECT_EQ(1u, queue.written());
+}
+
+void BleWriteQueueTestSuite::test_retry() {
+    FakeWriteQueue queue;
+    QObject service;
+    int attempts = 0;
+    QList<bool> results;
+
+    // the driver sends the setpoint again when it timed out, three attempts at most
+    blewritequeue::completion_t done = [&](bool written) {
+        results.append(written);
+        if (!written && attempts < 3) {
+            attempts++;
+            queue.push(&service, QByteArray("a"), -1, done);
+        }
+    };
+
+    queue.setTimeout(20);
+    attempts = 1;
+    queue.push(&service, QByteArray("a"), -1, done);
+    ASSERT_TRUE(waitFor([&queue]() { return queue.sent.count() == 2; }, 1000));
+    queue.written(&service);
+    EXPECT_EQ(QList<bool>({false, true}), results);
+    EXPECT_EQ(QList<QByteArray>({QByteArray("a"), QByteArray("a")}), queue.sent);
+    EXPECT_EQ(0, queue.depth());
+
+    // never acknowledged: the request gives up after the last attempt
+    queue.sent.clear();
+    results.clear();
+    attempts = 1;
+    queue.push(&service, QByteArray("a"), -1, done);
+    ASSERT_TRUE(waitFor([&results]() { return results.count() == 3; }, 1000));
+    EXPECT_EQ(QList<bool>({false, false, false}), results);
+    EXPECT_EQ(3, queue.sent.count());
+    EXPECT_EQ(0, queue.depth());
+    EXPECT_EQ(4u, queue.timeouts());
+}
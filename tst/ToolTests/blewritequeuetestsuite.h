@@ -0,0 +1,55 @@
+#ifndef BLEWRITEQUEUETESTSUITE_H
+#define BLEWRITEQUEUETESTSUITE_H
+
+#include "gtest/gtest.h"
+
+#include <QCoreApplication>
+#include <QScopedPointer>
+
+class BleWriteQueueTestSuite: public testing::Test {
+    // the queue timers need an event loop
+    QScopedPointer<QCoreApplication> app;
+
+public:
+    BleWriteQueueTestSuite();
+
+    /**
+     * @brief Test that the requests are sent in order, one at a time until acknowledged, and that an acknowledge
+     * from another service or characteristic doesn't complete the request in flight.
+     */
+    void test_ordering();
+
+    /**
+     * @brief Test that an unsent request is replaced by a newer one with the same coalesce key.
+     */
+    void test_coalescing();
+
+    /**
+     * @brief Test that a request never acknowledged completes as not written after the timeout, and that the
+     * queue moves on to the next one.
+     */
+    void test_timeout();
+
+    /**
+     * @brief Test that a request enqueued again from its completion callback, after a timeout, is sent again.
+     */
+    void test_retry();
+};
+
+TEST_F(BleWriteQueueTestSuite, TestOrdering) {
+    this->test_ordering();
+}
+
+TEST_F(BleWriteQueueTestSuite, TestCoalescing) {
+    this->test_coalescing();
+}
+
+TEST_F(BleWriteQueueTestSuite, TestTimeout) {
+    this->test_timeout();
+}
+
+TEST_F(BleWriteQueueTestSuite, TestRetry) {
+    this->test_retry();
+}
+
+#endif // BLEWRITEQUEUETESTSUITE_H
@@ -0,0 +1,143 @@
+#include "chartseriestestsuite.h"
+
+#include "chartseries.h"
+
+#include <QList>
+#include <algorithm>
+#include <cmath>
+
+// a ride: a slow wave, noise and a few sprints
+static QVector<double> ride(int samples) {
+    QVector<double> values;
+    values.reserve(samples);
+    quint32 seed = 1;
+    for (int i = 0; i < samples; i++) {
+        seed = seed * 1103515245 + 12345;
+        double v = 180 + (80 * sin(i / 300.0)) + ((seed >> 16) % 40);
+        if (i % 997 == 500)
+            v = 900;
+        values.append(v);
+    }
+    return values;
+}
+
+ChartSeriesTestSuite::ChartSeriesTestSuite()
+{
+
+}
+
+void ChartSeriesTestSuite::test_allSamples() {
+    chartseries series;
+    EXPECT_TRUE(series.points(100).isEmpty());
+
+    QVector<double> values = ride(100);
+    for (double v : values)
+        series.append(v);
+    ASSERT_EQ(series.size(), 100);
+
+    QVector<QPointF> points = series.points(100, 1000.0);
+    ASSERT_EQ(points.size(), 100);
+    for (int i = 0; i < points.size(); i++) {
+        EXPECT_DOUBLE_EQ(points.at(i).x(), i * 1000.0);
+        EXPECT_DOUBLE_EQ(points.at(i).y(), values.at(i));
+    }
+
+    series.clear();
+    EXPECT_EQ(series.size(), 0);
+    series.append(5);
+    EXPECT_EQ(series.points(1).size(), 1);
+}
+
+void ChartSeriesTestSuite::test_peaks() {
+    const int samples = 3 * 3600;
+    QVector<double> values = ride(samples);
+    chartseries series;
+    for (double v : values)
+        series.append(v);
+
+    for (int maxPoints : {8, 100, 1440, 4000, 10799}) {
+        QVector<QPointF> points = series.points(maxPoints);
+        ASSERT_LE(points.size(), maxPoints);
+        EXPECT_GE(points.size(), maxPoints / 4);
+        EXPECT_DOUBLE_EQ(points.first().x(), 0);
+        EXPECT_DOUBLE_EQ(points.last().x(), samples - 1);
+
+        // the points are samples, in order
+        for (int i = 0; i < points.size(); i++) {
+            int index = (int)points.at(i).x();
+            ASSERT_DOUBLE_EQ(points.at(i).y(), values.at(index));
+            if (i > 0)
+                ASSERT_GT(points.at(i).x(), points.at(i - 1).x());
+        }
+
+        // the extremes of the ride are there
+        double max = *std::max_element(values.constBegin(), values.constEnd());
+        double min = *std::min_element(values.constBegin(), values.constEnd());
+        double pointsMax = -1, pointsMin = 1e9;
+        int sprints = 0;
+        for (const QPointF &p : points) {
+            pointsMax = std::max(pointsMax, p.y());
+            pointsMin = std::min(pointsMin, p.y());
+            if (p.y() == 900)
+                sprints++;
+        }
+        EXPECT_DOUBLE_EQ(pointsMax, max);
+        EXPECT_DOUBLE_EQ(pointsMin, min);
+        // every sprint as long as they are in different buckets
+        if (maxPoints >= 100)
+            EXPECT_EQ(sprints, (samples + 497) / 997);
+    }
+}
+
+void ChartSeriesTestSuite::test_incremental() {
+    QVector<double> values = ride(5000);
+    chartseries recording;
+    for (int i = 0; i < values.size(); i++) {
+        recording.append(values.at(i));
+        if (i % 777 == 0 || i == values.size() - 1) {
+            // what a chart opened at this point would get
+            chartseries once;
+            for (int j = 0; j <= i; j++)
+                once.append(values.at(j));
+            QVector<QPointF> a = recording.points(400);
+            QVector<QPointF> b = once.points(400);
+            ASSERT_EQ(a.size(), b.size()) << i;
+            for (int j = 0; j < a.size(); j++)
+                ASSERT_EQ(a.at(j), b.at(j)) << i;
+        }
+    }
+}
+
+void ChartSeriesTestSuite::test_benchmark() {
+    const int samples = 3 * 3600;
+    const int width = 1000;
+    QVector<double> values = ride(samples);
+
+    chartseries series;
+    Benchmark benchmark;
+    for (double v : values)
+        series.append(v);
+    qint64 appended = benchmark.lap();
+
+    // what the chart did: every point, through a QList copy of the series
+    benchmark.restart();
+    QList<double> l;
+    l.reserve(samples);
+    for (double v : values)
+        l.append(v);
+    QVector<QPointF> all;
+    all.reserve(samples);
+    for (int i = 0; i < l.size(); i++)
+        all.append(QPointF(i * 1000.0, l.at(i)));
+    qint64 copied = benchmark.lap();
+
+    benchmark.restart();
+    QVector<QPointF> points = series.points(width * 4, 1000.0);
+    qint64 downsampled = benchmark.lap();
+
+    EXPECT_LE(points.size(), width * 4);
+    benchmark.record("append_ns", appended, samples);
+    benchmark.record("all_points_us", copied, 1000);
+    benchmark.record("points", points.size());
+    benchmark.record("points_us", downsampled, 1000);
+}
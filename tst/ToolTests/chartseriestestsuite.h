@@ -0,0 +1,51 @@
+#ifndef CHARTSERIESTESTSUITE_H
+#define CHARTSERIESTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+#include "Tools/benchmark.h"
+
+class ChartSeriesTestSuite: public testing::Test {
+
+public:
+    ChartSeriesTestSuite();
+
+    /**
+     * @brief Test that all the samples are given when they fit.
+     */
+    void test_allSamples();
+
+    /**
+     * @brief Test that the downsampled series fits, is in order, and keeps the first, last, minimum and maximum
+     * samples of every bucket.
+     */
+    void test_peaks();
+
+    /**
+     * @brief Test that the series built while recording is the one built at once over the same samples.
+     */
+    void test_incremental();
+
+    /**
+     * @brief Measure the points of a 3 hours workout against copying the whole series.
+     */
+    void test_benchmark();
+};
+
+TEST_F(ChartSeriesTestSuite, TestAllSamples) {
+    this->test_allSamples();
+}
+
+TEST_F(ChartSeriesTestSuite, TestPeaks) {
+    this->test_peaks();
+}
+
+TEST_F(ChartSeriesTestSuite, TestIncremental) {
+    this->test_incremental();
+}
+
+BENCHMARK_F(ChartSeriesTestSuite, TestBenchmark) {
+    this->test_benchmark();
+}
+
+#endif // CHARTSERIESTESTSUITE_H
@@ -0,0 +1,124 @@
+#include "computrainertestsuite.h"
+
+#include "Computrainer.h"
+#include "Tools/computrainersimulator.h"
+
+#include <QElapsedTimer>
+#include <QThread>
+
+template <typename Condition> static bool waitFor(Condition condition, int timeout) {
+    QElapsedTimer timer;
+    timer.start();
+    while (!condition()) {
+        if (timer.elapsed() > timeout)
+            return false;
+        QThread::yieldCurrentThread();
+    }
+    return true;
+}
+
+ComputrainerTestSuite::ComputrainerTestSuite()
+{
+
+}
+
+void ComputrainerTestSuite::test_telemetry() {
+#ifdef Q_OS_LINUX
+    ComputrainerSimulator simulator;
+    ASSERT_TRUE(simulator.open());
+
+    Computrainer computrainer(nullptr, simulator.portName());
+    computrainer.start();
+
+    // the first command is sent as soon as the port is set up
+    ASSERT_TRUE(simulator.waitForCommand(2000));
+
+    simulator.sendTelemetry(CT_POWER, 250);
+    simulator.sendTelemetry(CT_HEARTRATE, 140);
+    simulator.sendTelemetry(CT_CADENCE, 90);
+    simulator.sendTelemetry(CT_SPEED, 926);
+    simulator.sendTelemetry(CT_SENSOR, 2048 + 1024, CT_F1);
+
+    // the messages are handled in order
+    ASSERT_TRUE(waitFor([&computrainer]() { return computrainer.isHRConnected(); }, 2000));
+    ComputrainerTelemetry telemetry = computrainer.telemetry();
+    EXPECT_EQ(telemetry.power, 250);
+    EXPECT_EQ(telemetry.heartRate, 140);
+    EXPECT_EQ(telemetry.cadence, 90);
+    EXPECT_NEAR(telemetry.speed, 30.0, 0.01);
+    EXPECT_TRUE(telemetry.cadConnected);
+    EXPECT_EQ(computrainer.takeButtons(), CT_F1);
+    EXPECT_EQ(computrainer.takeButtons(), 0);
+
+    // a partial message puts the driver out of sync until the next complete one
+    const uint8_t garbage[] = {0x01, 0x02, 0x03};
+    simulator.sendRaw(garbage, sizeof(garbage));
+    simulator.sendTelemetry(CT_POWER, 300);
+    EXPECT_TRUE(waitFor([&computrainer]() { return computrainer.telemetry().power == 300; }, 2000));
+
+    computrainer.stop();
+    EXPECT_TRUE(computrainer.wait(2000));
+#endif
+}
+
+void ComputrainerTestSuite::test_commands() {
+#ifdef Q_OS_LINUX
+    ComputrainerSimulator simulator;
+    ASSERT_TRUE(simulator.open());
+
+    Computrainer computrainer(nullptr, simulator.portName());
+    computrainer.setMode(CT_ERGOMODE, 200);
+    computrainer.start();
+
+    ASSERT_TRUE(simulator.waitForCommand(2000));
+    EXPECT_EQ(simulator.mode(), CT_ERGOMODE);
+    EXPECT_EQ(simulator.load(), 200);
+
+    // a change is sent right away, not at the next keep alive
+    computrainer.setLoad(275);
+    EXPECT_TRUE(waitFor([&simulator]() { return simulator.waitForCommand(100) && simulator.load() == 275; },
+                        CT_KEEPALIVETIMEOUT / 2));
+
+    computrainer.setMode(CT_SSMODE, 275, -2.5);
+    EXPECT_TRUE(waitFor(
+        [&simulator]() { return simulator.waitForCommand(100) && simulator.mode() == CT_SSMODE; }, 2000));
+    EXPECT_DOUBLE_EQ(simulator.gradient(), -2.5);
+
+    computrainer.setGradient(4.2);
+    EXPECT_TRUE(waitFor([&simulator]() { return simulator.waitForCommand(100) && simulator.gradient() > 0; }, 2000));
+    EXPECT_DOUBLE_EQ(simulator.gradient(), 4.2);
+
+    // without telemetry the commands keep the CT alive
+    int commands = simulator.commands();
+    EXPECT_TRUE(simulator.waitForCommand(CT_KEEPALIVETIMEOUT * 2));
+    EXPECT_EQ(simulator.commands(), commands + 1);
+
+    EXPECT_EQ(simulator.crcErrors(), 0);
+#endif
+}
+
+void ComputrainerTestSuite::test_latency() {
+#ifdef Q_OS_LINUX
+    ComputrainerSimulator simulator;
+    ASSERT_TRUE(simulator.open());
+
+    Computrainer computrainer(nullptr, simulator.portName());
+    computrainer.start();
+    ASSERT_TRUE(simulator.waitForCommand(2000));
+
+    const int messages = 200;
+    QVector<qint64> latencies;
+    Benchmark benchmark;
+    for (int i = 0; i < messages; i++) {
+        int power = 100 + i;
+        benchmark.restart();
+        simulator.sendTelemetry(CT_POWER, power);
+        if (!waitFor([&computrainer, power]() { return computrainer.telemetry().power == power; }, 1000))
+            break;
+        latencies.append(benchmark.lap());
+    }
+    ASSERT_EQ(latencies.size(), messages);
+
+    benchmark.recordLatencies(latencies);
+#endif
+}
@@ -0,0 +1,41 @@
+#ifndef COMPUTRAINERTESTSUITE_H
+#define COMPUTRAINERTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+#include "Tools/benchmark.h"
+
+class ComputrainerTestSuite: public testing::Test {
+
+public:
+    ComputrainerTestSuite();
+
+    /**
+     * @brief Test that the telemetry sent by the simulator is published, also after a loss of sync.
+     */
+    void test_telemetry();
+
+    /**
+     * @brief Test that the load and gradient changes are sent to the simulator.
+     */
+    void test_commands();
+
+    /**
+     * @brief Measure the time from a telemetry message being written to the port to it being published.
+     */
+    void test_latency();
+};
+
+TEST_F(ComputrainerTestSuite, TestTelemetry) {
+    this->test_telemetry();
+}
+
+TEST_F(ComputrainerTestSuite, TestCommands) {
+    this->test_commands();
+}
+
+BENCHMARK_F(ComputrainerTestSuite, TestLatency) {
+    this->test_latency();
+}
+
+#endif // COMPUTRAINERTESTSUITE_H
@@ -0,0 +1,145 @@
+#include "csafetestsuite.h"
+
+#include "csafe.h"
+
+static const csafe::command poll[] = {csafe::CSAFE_PM_GET_WORKTIME, csafe::CSAFE_PM_GET_WORKDISTANCE,
+                                      csafe::CSAFE_GETCADENCE_CMD,  csafe::CSAFE_GETPOWER_CMD,
+                                      csafe::CSAFE_GETCALORIES_CMD, csafe::CSAFE_GETHRCUR_CMD};
+static const int pollCount = sizeof(poll) / sizeof(poll[0]);
+
+static QStringList pollNames() {
+    QStringList names;
+    for (int i = 0; i < pollCount; i++)
+        names << csafe::name(poll[i]);
+    return names;
+}
+
+// frames a response the way the monitor does: report id, start flag, stuffed data, checksum and stop flag
+static QVector<quint8> frame(const QVector<quint8> &data) {
+    QVector<quint8> f;
+    f << 0x04 << 0xF1;
+    quint8 checksum = 0;
+    for (quint8 b : data) {
+        checksum ^= b;
+        if (b >= 0xF0 && b <= 0xF3)
+            f << 0xF3 << (b & 0x3);
+        else
+            f << b;
+    }
+    f << checksum << 0xF2;
+    while (f.size() < 64)
+        f << 0;
+    return f;
+}
+
+static QVector<quint8> pollResponse() {
+    QVector<quint8> data;
+    data << 0x81;                                                   // status
+    data << 0x1A << 0x0E;                                           // PM wrapper
+    data << 0xA0 << 0x05 << 0x10 << 0x27 << 0x00 << 0x00 << 0x00;   // work time
+    data << 0xA3 << 0x05 << 0xF1 << 0x03 << 0x00 << 0x00 << 0x24;   // work distance, stuffed
+    data << 0xA7 << 0x03 << 0x1C << 0x00 << 0x00;                   // cadence
+    data << 0xB4 << 0x03 << 0xC8 << 0x00 << 0x58;                   // power
+    data << 0xA3 << 0x02 << 0x2C << 0x01;                           // calories
+    data << 0xB0 << 0x01 << 0x8C;                                   // heart rate
+    return frame(data);
+}
+
+CSafeTestSuite::CSafeTestSuite()
+{
+
+}
+
+void CSafeTestSuite::test_encode() {
+    quint8 buffer[csafe::maxFrameSize];
+    int size = csafe::encode(poll, pollCount, buffer, sizeof(buffer));
+
+    QByteArray expected = QByteArray::fromHex("04f11a02a0a3a7b4a3b01bf2");
+    expected.append(QByteArray(63 - expected.size(), 0));
+    EXPECT_EQ(QByteArray((const char *)buffer, size), expected);
+
+    csafe legacy;
+    EXPECT_EQ(legacy.write(pollNames()), expected);
+
+    // a long command, with its arguments
+    const csafe::command horizontal[] = {csafe::CSAFE_SETHORIZONTAL_CMD};
+    const int arguments[] = {2000, 33};
+    size = csafe::encode(horizontal, 1, buffer, sizeof(buffer), arguments);
+    expected = QByteArray::fromHex("01f12103d00721d4f2");
+    expected.append(QByteArray(21 - expected.size(), 0));
+    EXPECT_EQ(QByteArray((const char *)buffer, size), expected);
+    EXPECT_EQ(legacy.write(QStringList() << "CSAFE_SETHORIZONTAL_CMD" << "2000" << "33"), expected);
+
+    // the buffer is too small for the report
+    EXPECT_EQ(csafe::encode(poll, pollCount, buffer, 21), 0);
+}
+
+void CSafeTestSuite::test_decode() {
+    QVector<quint8> rx = pollResponse();
+
+    csafe::response response;
+    ASSERT_TRUE(csafe::decode(rx.constData(), rx.size(), response));
+    EXPECT_EQ(response.status, 0x81);
+    EXPECT_EQ(response.count, pollCount);
+    EXPECT_EQ(response.value(csafe::CSAFE_PM_GET_WORKTIME), 10000);
+    EXPECT_EQ(response.value(csafe::CSAFE_PM_GET_WORKDISTANCE), 0x03F1);
+    EXPECT_EQ(response.value(csafe::CSAFE_PM_GET_WORKDISTANCE, 1), 0x24);
+    EXPECT_EQ(response.value(csafe::CSAFE_GETCADENCE_CMD), 28);
+    EXPECT_EQ(response.value(csafe::CSAFE_GETPOWER_CMD), 200);
+    EXPECT_EQ(response.value(csafe::CSAFE_GETPOWER_CMD, 1), 0x58);
+    EXPECT_EQ(response.value(csafe::CSAFE_GETCALORIES_CMD), 300);
+    EXPECT_EQ(response.value(csafe::CSAFE_GETHRCUR_CMD), 140);
+    EXPECT_EQ(response.find(csafe::CSAFE_GETPACE_CMD), nullptr);
+    EXPECT_EQ(response.value(csafe::CSAFE_GETPACE_CMD, 0, -2), -2);
+    EXPECT_EQ(response.value(csafe::CSAFE_GETHRCUR_CMD, 1, -2), -2);
+
+    // the wrapped commands are reported under their own names
+    csafe legacy;
+    QVariantMap map = legacy.read(rx);
+    EXPECT_EQ(map.value("CSAFE_GETSTATUS_CMD").toList().value(0).toInt(), 0x81);
+    EXPECT_EQ(map.value("CSAFE_PM_GET_WORKTIME").toList().value(0).toInt(), 10000);
+    EXPECT_EQ(map.value("CSAFE_PM_GET_WORKDISTANCE").toList().value(0).toInt(), 0x03F1);
+    EXPECT_EQ(map.value("CSAFE_GETHRCUR_CMD").toList().value(0).toInt(), 140);
+    EXPECT_FALSE(map.contains("CSAFE_SETUSERCFG1_CMD"));
+
+    // checksum error
+    rx[5] ^= 0x01;
+    EXPECT_FALSE(csafe::decode(rx.constData(), rx.size(), response));
+    EXPECT_TRUE(legacy.read(rx).isEmpty());
+
+    // no start flag, or an empty transmission
+    QVector<quint8> empty(64, 0);
+    EXPECT_FALSE(csafe::decode(empty.constData(), empty.size(), response));
+    EXPECT_FALSE(csafe::decode(empty.constData(), 0, response));
+    EXPECT_TRUE(legacy.read(QVector<quint8>()).isEmpty());
+}
+
+void CSafeTestSuite::test_benchmark() {
+    const int iterations = 10000;
+    const QVector<quint8> rx = pollResponse();
+    int check = 0;
+
+    Benchmark benchmark;
+    for (int i = 0; i < iterations; i++) {
+        quint8 buffer[csafe::maxFrameSize];
+        csafe::response response;
+        check += csafe::encode(poll, pollCount, buffer, sizeof(buffer));
+        if (csafe::decode(rx.constData(), rx.size(), response))
+            check += response.value(csafe::CSAFE_GETPOWER_CMD);
+    }
+    qint64 table = benchmark.lap();
+
+    csafe legacy;
+    const QStringList names = pollNames();
+    benchmark.restart();
+    for (int i = 0; i < iterations; i++) {
+        check += legacy.write(names).size();
+        check += legacy.read(rx).value("CSAFE_GETPOWER_CMD").toList().value(0).toInt();
+    }
+    qint64 strings = benchmark.lap();
+
+    EXPECT_EQ(check, 2 * iterations * (63 + 200));
+
+    benchmark.record("frame_ns", table, iterations);
+    benchmark.record("string_interface_ns", strings, iterations);
+}
@@ -0,0 +1,41 @@
+#ifndef CSAFETESTSUITE_H
+#define CSAFETESTSUITE_H
+
+#include "gtest/gtest.h"
+
+#include "Tools/benchmark.h"
+
+class CSafeTestSuite: public testing::Test {
+
+public:
+    CSafeTestSuite();
+
+    /**
+     * @brief Test that the frames built from the command table match the ones of the string interface.
+     */
+    void test_encode();
+
+    /**
+     * @brief Test the decoding of a response, with wrapped commands and byte stuffing.
+     */
+    void test_decode();
+
+    /**
+     * @brief Measure the encode and decode time of the rower polling frame, against the string interface.
+     */
+    void test_benchmark();
+};
+
+TEST_F(CSafeTestSuite, TestEncode) {
+    this->test_encode();
+}
+
+TEST_F(CSafeTestSuite, TestDecode) {
+    this->test_decode();
+}
+
+BENCHMARK_F(CSafeTestSuite, TestBenchmark) {
+    this->test_benchmark();
+}
+
+#endif // CSAFETESTSUITE_H
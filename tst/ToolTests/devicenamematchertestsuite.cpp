@@ -0,0 +1,63 @@
+#include "devicenamematchertestsuite.h"
+
+#include "devicenamematcher.h"
+
+#include <QFile>
+#include <QRegularExpression>
+
+DeviceNameMatcherTestSuite::DeviceNameMatcherTestSuite() {}
+
+void DeviceNameMatcherTestSuite::test_rules() {
+    devicenamematcher matcher;
+    matcher.addPrefix(QStringLiteral("DOMYOS"));
+    matcher.addPrefix(QStringLiteral("DOM"));
+    matcher.addSuffix(QStringLiteral("ROW"));
+    matcher.addSubstring(QStringLiteral("CARE"));
+    matcher.addExact(QStringLiteral("RE"));
+
+    EXPECT_TRUE(matcher.matches(QStringLiteral("DOMYOS-BIKE")));
+    EXPECT_TRUE(matcher.matches(QStringLiteral("dom")));
+    EXPECT_TRUE(matcher.matches(QStringLiteral("XROW")));
+    EXPECT_TRUE(matcher.matches(QStringLiteral("MYCARE1")));
+    EXPECT_TRUE(matcher.matches(QStringLiteral("re")));
+
+    EXPECT_FALSE(matcher.matches(QStringLiteral("DO")));
+    EXPECT_FALSE(matcher.matches(QStringLiteral("ROWX")));
+    EXPECT_FALSE(matcher.matches(QStringLiteral("REX")));
+    EXPECT_FALSE(matcher.matches(QString()));
+}
+
+void DeviceNameMatcherTestSuite::test_chainCovered() {
+    QFile file(QStringLiteral(BLUETOOTH_SOURCE));
+    ASSERT_TRUE(file.open(QIODevice::ReadOnly | QIODevice::Text));
+    const QString source = QString::fromUtf8(file.readAll());
+
+    // the name based branches run from the trie walk to the fitmetria fan, which is matched on its own
+    int begin = source.indexOf(QStringLiteral("skip with a single trie walk"));
+    int end = source.indexOf(QStringLiteral("if (fitmetriaFanfitEnabled)"), begin);
+    ASSERT_GE(begin, 0);
+    ASSERT_GT(end, begin);
+    const QString chain = source.mid(begin, end - begin);
+
+    const devicenamematcher &drivers = devicenamematcher::drivers();
+    int rules = 0;
+    const QString literal = QStringLiteral("\\((?:(?:QStringLiteral|QLatin1String)\\()?\"([^\"]*)\"");
+    const QStringList kinds = {QStringLiteral("startsWith"), QStringLiteral("endsWith"), QStringLiteral("contains"),
+                               QStringLiteral("compare")};
+    for (const QString &kind : kinds) {
+        QRegularExpressionMatchIterator it = QRegularExpression(kind + literal).globalMatch(chain);
+        while (it.hasNext()) {
+            const QString rule = it.next().captured(1);
+            QString name = rule;
+            if (kind == QStringLiteral("endsWith"))
+                name = QStringLiteral("X") + rule;
+            else if (kind == QStringLiteral("contains"))
+                name = QStringLiteral("X") + rule + QStringLiteral("X");
+            EXPECT_TRUE(drivers.matches(name)) << kind.toStdString() << " " << rule.toStdString();
+            rules++;
+        }
+    }
+
+    // guards against the markers or the regular expressions no longer finding the chain
+    EXPECT_GT(rules, 100);
+}
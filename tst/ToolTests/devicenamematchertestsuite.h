@@ -0,0 +1,31 @@
+#ifndef DEVICENAMEMATCHERTESTSUITE_H
+#define DEVICENAMEMATCHERTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class DeviceNameMatcherTestSuite: public testing::Test {
+
+public:
+    DeviceNameMatcherTestSuite();
+
+    /**
+     * @brief Test the prefix, suffix, substring and exact rules, case insensitive.
+     */
+    void test_rules();
+
+    /**
+     * @brief Test that every name rule of the bluetooth::deviceDiscovered chain is in the drivers() table,
+     * so a device added to the chain but not to the table makes this test fail instead of being skipped.
+     */
+    void test_chainCovered();
+};
+
+TEST_F(DeviceNameMatcherTestSuite, TestRules) {
+    this->test_rules();
+}
+
+TEST_F(DeviceNameMatcherTestSuite, TestChainCovered) {
+    this->test_chainCovered();
+}
+
+#endif // DEVICENAMEMATCHERTESTSUITE_H
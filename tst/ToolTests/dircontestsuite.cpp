@@ -0,0 +1,246 @@
+#include "dircontestsuite.h"
+
+#include "dirconpacket.h"
+#include "dirconprocessor.h"
+#include "qzsettings.h"
+
+#include <QElapsedTimer>
+#include <QTcpSocket>
+#include <QVector>
+#include <algorithm>
+
+static int argc = 1;
+static char arg0[] = "qdomyos-zwift-tests";
+static char *argv[] = {arg0, nullptr};
+
+template <typename Condition> static bool waitFor(Condition condition, int timeout) {
+    QElapsedTimer timer;
+    timer.start();
+    while (!condition()) {
+        if (timer.elapsed() > timeout)
+            return false;
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    }
+    return true;
+}
+
+static QByteArray value(quint32 v) {
+    QByteArray b;
+    b.append((char)(v & 0xFF)).append((char)((v >> 8) & 0xFF));
+    b.append((char)((v >> 16) & 0xFF)).append((char)((v >> 24) & 0xFF));
+    return b;
+}
+
+static quint32 toValue(const QByteArray &b) {
+    return ((quint8)b.at(0)) | ((quint8)b.at(1)) << 8 | ((quint8)b.at(2)) << 16 | ((quint32)(quint8)b.at(3)) << 24;
+}
+
+/**
+ * @brief The LoopbackClient class A DIRCON client, e.g. Zwift, connected to the processor over the loopback interface.
+ */
+class LoopbackClient {
+  public:
+    QTcpSocket socket;
+    QByteArray buffer;
+    int responses = 0;
+    // the values received, by characteristic
+    QMap<quint16, QVector<quint32>> notifications;
+
+    bool connectTo(quint16 port) {
+        socket.connectToHost(QHostAddress::LocalHost, port);
+        return waitFor([this]() { return socket.state() == QAbstractSocket::ConnectedState; }, 2000);
+    }
+
+    void subscribe(quint16 uuid) {
+        DirconPacket pkt;
+        pkt.isRequest = true;
+        pkt.Identifier = DPKT_MSGID_ENABLE_CHARACTERISTIC_NOTIFICATIONS;
+        pkt.uuid = uuid;
+        pkt.additional_data = QByteArray(1, 1);
+        socket.write(pkt.encode(responses + 1));
+    }
+
+    void read() {
+        buffer.append(socket.readAll());
+        while (true) {
+            DirconPacket pkt;
+            int size = pkt.parse(buffer, 0);
+            if (size == DPKT_PARSE_WAIT)
+                break;
+            if (size < 0)
+                size = -size + DPKT_PARSE_ERROR;
+            else if (pkt.Identifier == DPKT_MSGID_UNSOLICITED_CHARACTERISTIC_NOTIFICATION)
+                notifications[pkt.uuid].append(toValue(pkt.additional_data));
+            else
+                responses++;
+            buffer.remove(0, size);
+        }
+    }
+
+    bool received(quint16 uuid, quint32 v) const {
+        return !notifications.value(uuid).isEmpty() && notifications.value(uuid).last() == v;
+    }
+};
+
+static DirconProcessor *buildProcessor() {
+    QList<DirconProcessorService *> services;
+    DirconProcessorService *service =
+        new DirconProcessorService(QStringLiteral("FITNESS_MACHINE_CYCLE"), 0x1826, 0);
+    service->chars.append(
+        new DirconProcessorCharacteristic(0x2AD2, DPKT_CHAR_PROP_FLAG_NOTIFY, QByteArray(1, 0), nullptr, service));
+    service->chars.append(
+        new DirconProcessorCharacteristic(0x2A63, DPKT_CHAR_PROP_FLAG_NOTIFY, QByteArray(1, 0), nullptr, service));
+    services.append(service);
+    // port 0: any free port
+    return new DirconProcessor(services, QStringLiteral("Wahoo KICKR 0000"), 0, QStringLiteral("0"),
+                               QStringLiteral("00:11:22:33:44:55"));
+}
+
+static bool connectClients(DirconProcessor *processor, QList<LoopbackClient *> &clients, const QList<quint16> &uuids) {
+    for (LoopbackClient *c : clients) {
+        if (!c->connectTo(processor->port()))
+            return false;
+        for (quint16 uuid : uuids)
+            c->subscribe(uuid);
+    }
+    return waitFor(
+        [&clients, &uuids]() {
+            for (LoopbackClient *c : clients) {
+                c->read();
+                if (c->responses < uuids.size())
+                    return false;
+            }
+            return true;
+        },
+        2000);
+}
+
+DirconTestSuite::DirconTestSuite() : testSettings("Roberto Viola", "QDomyos-Zwift Testing")
+{
+    if (!QCoreApplication::instance())
+        app.reset(new QCoreApplication(argc, argv));
+    testSettings.activate();
+    testSettings.qsettings.clear();
+    // only the subscribed characteristics are notified
+    testSettings.qsettings.setValue(QZSettings::wahoo_rgt_dircon, true);
+}
+
+void DirconTestSuite::test_fanOut() {
+    QScopedPointer<DirconProcessor> processor(buildProcessor());
+    ASSERT_TRUE(processor->init(false));
+    EXPECT_FALSE(processor->hasClients());
+
+    LoopbackClient a, b, c, idle;
+    QList<LoopbackClient *> subscribed = {&a, &b, &c};
+    ASSERT_TRUE(connectClients(processor.data(), subscribed, {0x2AD2}));
+    ASSERT_TRUE(idle.connectTo(processor->port()));
+    EXPECT_TRUE(processor->hasClients());
+
+    const int ticks = 100;
+    for (int i = 0; i < ticks; i++) {
+        ASSERT_TRUE(processor->sendCharacteristicNotification(0x2AD2, value(i)));
+        ASSERT_TRUE(waitFor(
+            [&subscribed, i]() {
+                for (LoopbackClient *c : subscribed) {
+                    c->read();
+                    if (!c->received(0x2AD2, i))
+                        return false;
+                }
+                return true;
+            },
+            2000));
+    }
+
+    // the other characteristic isn't subscribed
+    ASSERT_TRUE(processor->sendCharacteristicNotification(0x2A63, value(1)));
+    waitFor([]() { return false; }, 50);
+    idle.read();
+    EXPECT_TRUE(idle.notifications.isEmpty());
+
+    for (LoopbackClient *c : subscribed) {
+        c->read();
+        EXPECT_EQ(c->notifications.size(), 1);
+        QVector<quint32> values = c->notifications.value(0x2AD2);
+        ASSERT_EQ(values.size(), ticks);
+        for (int i = 0; i < ticks; i++)
+            EXPECT_EQ(values.at(i), (quint32)i);
+    }
+}
+
+void DirconTestSuite::test_backpressure() {
+    QScopedPointer<DirconProcessor> processor(buildProcessor());
+    ASSERT_TRUE(processor->init(false));
+
+    LoopbackClient a, b;
+    QList<LoopbackClient *> clients = {&a, &b};
+    ASSERT_TRUE(connectClients(processor.data(), clients, {0x2AD2, 0x2A63}));
+
+    // without the event loop nothing is sent, so the backlog of the clients fills up right away
+    const int ticks = 5000;
+    for (int i = 0; i < ticks; i++) {
+        QByteArray power = DirconPacket::encodeNotification(0x2A63, value(i * 2));
+        QByteArray bike = DirconPacket::encodeNotification(0x2AD2, value(i));
+        ASSERT_TRUE(processor->sendEncodedNotification(0x2A63, power));
+        ASSERT_TRUE(processor->sendEncodedNotification(0x2AD2, bike));
+    }
+
+    ASSERT_TRUE(waitFor(
+        [&clients, ticks]() {
+            for (LoopbackClient *c : clients) {
+                c->read();
+                if (!c->received(0x2AD2, ticks - 1) || !c->received(0x2A63, (ticks - 1) * 2))
+                    return false;
+            }
+            return true;
+        },
+        5000));
+
+    const int packetSize = DirconPacket::encodeNotification(0x2AD2, value(0)).size();
+    for (LoopbackClient *c : clients) {
+        for (quint16 uuid : {0x2AD2, 0x2A63}) {
+            QVector<quint32> values = c->notifications.value(uuid);
+            EXPECT_TRUE(std::is_sorted(values.constBegin(), values.constEnd()));
+            EXPECT_EQ(std::adjacent_find(values.constBegin(), values.constEnd()), values.constEnd());
+            // what was queued before the backlog was full, plus the latest value
+            EXPECT_LE(values.size(), DP_CLIENT_MAX_BACKLOG / packetSize + 2);
+        }
+    }
+}
+
+void DirconTestSuite::test_load() {
+    QScopedPointer<DirconProcessor> processor(buildProcessor());
+    ASSERT_TRUE(processor->init(false));
+
+    const int clientCount = 4;
+    LoopbackClient loopback[clientCount];
+    QList<LoopbackClient *> clients;
+    for (int i = 0; i < clientCount; i++)
+        clients.append(&loopback[i]);
+    ASSERT_TRUE(connectClients(processor.data(), clients, {0x2AD2, 0x2A63}));
+
+    const int ticks = 1000;
+    QVector<qint64> latencies;
+    Benchmark benchmark;
+    for (int i = 0; i < ticks; i++) {
+        benchmark.restart();
+        // one encoding per tick, as the manager does, written to all the clients
+        processor->sendEncodedNotification(0x2AD2, DirconPacket::encodeNotification(0x2AD2, value(i)));
+        processor->sendEncodedNotification(0x2A63, DirconPacket::encodeNotification(0x2A63, value(i)));
+        if (!waitFor(
+                [&clients, i]() {
+                    for (LoopbackClient *c : clients) {
+                        c->read();
+                        if (!c->received(0x2AD2, i) || !c->received(0x2A63, i))
+                            return false;
+                    }
+                    return true;
+                },
+                1000))
+            break;
+        latencies.append(benchmark.lap());
+    }
+    ASSERT_EQ(latencies.size(), ticks);
+
+    benchmark.record("clients", clientCount);
+    benchmark.recordLatencies(latencies);
+}
@@ -0,0 +1,48 @@
+#ifndef DIRCONTESTSUITE_H
+#define DIRCONTESTSUITE_H
+
+#include "gtest/gtest.h"
+#include "Tools/benchmark.h"
+#include "Tools/testsettings.h"
+
+#include <QCoreApplication>
+#include <QScopedPointer>
+
+class DirconTestSuite: public testing::Test {
+    TestSettings testSettings;
+    // the sockets need an event loop
+    QScopedPointer<QCoreApplication> app;
+
+public:
+    DirconTestSuite();
+
+    /**
+     * @brief Test that a notification reaches all the clients that subscribed to it, in order, and only them.
+     */
+    void test_fanOut();
+
+    /**
+     * @brief Test that the notifications to clients that are behind are coalesced to the latest value of each
+     * characteristic, and that the latest value is always delivered.
+     */
+    void test_backpressure();
+
+    /**
+     * @brief Measure the delivery latency of the notifications to several clients over the loopback interface.
+     */
+    void test_load();
+};
+
+TEST_F(DirconTestSuite, TestFanOut) {
+    this->test_fanOut();
+}
+
+TEST_F(DirconTestSuite, TestBackpressure) {
+    this->test_backpressure();
+}
+
+BENCHMARK_F(DirconTestSuite, TestLoad) {
+    this->test_load();
+}
+
+#endif // DIRCONTESTSUITE_H
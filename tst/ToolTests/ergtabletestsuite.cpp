@@ -0,0 +1,165 @@
+#include "ergtabletestsuite.h"
+
+#include "ergtable.h"
+
+#include <cmath>
+#include <cstdlib>
+
+// the curve of the proform bikes, up to level 16
+static double proformCurve(double resistance, double cadence) {
+    static const double coefficients[16][3] = {
+        {-13.5, 0.999, 0.00993}, {-17.7, 1.2, 0.0116},  {-17.5, 1.24, 0.014},  {-20.9, 1.43, 0.016},
+        {-27.9, 1.75, 0.0172},   {-26.7, 1.9, 0.0201},  {-33.5, 2.23, 0.0225}, {-36.5, 2.5, 0.0262},
+        {-38.0, 2.62, 0.0305},   {-41.2, 2.85, 0.0327}, {-43.4, 3.01, 0.0359}, {-46.8, 3.23, 0.0364},
+        {-49.0, 3.39, 0.0371},   {-53.4, 3.55, 0.0383}, {-49.9, 3.37, 0.0429}, {-47.1, 3.25, 0.0464}};
+    if (cadence == 0)
+        return 0;
+    int level = qBound(1, (int)resistance, 16) - 1;
+    return coefficients[level][0] + (coefficients[level][1] * cadence) + (coefficients[level][2] * pow(cadence, 2));
+}
+
+// the curve of the domyos and mcf bikes
+static double exponentialCurve(double resistance, double cadence) {
+    return ((10.39 + 1.45 * (resistance - 1.0)) * (exp(0.028 * cadence)));
+}
+
+// what the drivers did for every power request
+static resistance_t scan(const ergtable::model &curve, resistance_t maxResistance, double power, double cadence) {
+    for (resistance_t i = 1; i < maxResistance; i++) {
+        if (curve(i, cadence) <= power && curve(i + 1, cadence) >= power)
+            return i;
+    }
+    if (power < curve(1, cadence))
+        return 1;
+    return maxResistance;
+}
+
+ErgTableTestSuite::ErgTableTestSuite()
+{
+
+}
+
+void ErgTableTestSuite::test_matchesScan() {
+    const ergtable::model curves[] = {proformCurve, exponentialCurve};
+    const resistance_t ranges[] = {16, 14};
+    for (int i = 0; i < 2; i++) {
+        ergtable table;
+        table.setModel(curves[i]);
+        table.setRange(1, ranges[i]);
+        for (int cadence = 30; cadence <= 130; cadence++) {
+            for (int power = 0; power <= 800; power += 2) {
+                resistance_t expected = scan(curves[i], ranges[i], power, cadence);
+                resistance_t r = table.resistance(power, cadence);
+                if (cadence % 5 == 0)
+                    ASSERT_EQ(r, expected) << "cadence " << cadence << " power " << power;
+                else
+                    ASSERT_LE(std::abs(r - expected), 1) << "cadence " << cadence << " power " << power;
+            }
+        }
+        EXPECT_DOUBLE_EQ(table.watts(5, 90), curves[i](5, 90));
+        EXPECT_NEAR(table.watts(5, 92), curves[i](5, 92), 1.0);
+    }
+}
+
+void ErgTableTestSuite::test_bounds() {
+    ergtable table;
+    EXPECT_FALSE(table.hasModel());
+    EXPECT_EQ(table.resistance(200, 90), 1);
+
+    // the power goes down after level 5
+    table.setModel([](double resistance, double cadence) { return cadence * (resistance <= 5 ? resistance : 1); });
+    table.setRange(1, 10);
+    EXPECT_EQ(table.resistance(0, 90), 1);
+    EXPECT_EQ(table.resistance(300, 90), 3);
+    EXPECT_EQ(table.resistance(10000, 90), 10);
+    for (resistance_t r = 2; r <= 10; r++)
+        EXPECT_GE(table.watts(r, 90), table.watts(r - 1, 90));
+    EXPECT_DOUBLE_EQ(table.watts(0, 90), table.watts(1, 90));
+    EXPECT_DOUBLE_EQ(table.watts(20, 90), table.watts(10, 90));
+
+    // above the last row the cadence is the one of the last row
+    EXPECT_DOUBLE_EQ(table.watts(2, 250), 400);
+
+    // a new range builds the table again
+    table.setRange(1, 3);
+    EXPECT_EQ(table.resistance(10000, 90), 3);
+}
+
+void ErgTableTestSuite::test_correction() {
+    ergtable table;
+    table.setModel(exponentialCurve);
+    table.setRange(1, 14);
+    table.setCorrection(1.1, 10);
+    EXPECT_DOUBLE_EQ(table.watts(5, 80), (exponentialCurve(5, 80) * 1.1) + 10);
+    for (int power = 20; power <= 500; power += 5) {
+        ergtable::model corrected = [](double resistance, double cadence) {
+            return (exponentialCurve(resistance, cadence) * 1.1) + 10;
+        };
+        EXPECT_EQ(table.resistance(power, 80), scan(corrected, 14, power, 80)) << power;
+    }
+}
+
+void ErgTableTestSuite::test_observe() {
+    ergtable table;
+    table.setModel(exponentialCurve);
+    table.setRange(1, 14);
+
+    // nothing is learned before the table exists
+    table.observe(5, 90, 300);
+    EXPECT_DOUBLE_EQ(table.watts(5, 90), exponentialCurve(5, 90));
+
+    for (int i = 0; i < 100; i++)
+        table.observe(5, 90, 300);
+    EXPECT_NEAR(table.watts(5, 90), 300, 1.0);
+    // the levels above can't give less
+    EXPECT_GE(table.watts(6, 90), table.watts(5, 90));
+    EXPECT_DOUBLE_EQ(table.watts(4, 90), exponentialCurve(4, 90));
+    EXPECT_EQ(table.resistance(295, 90), 4);
+
+    // between two rows both learn, in proportion
+    double before = table.watts(8, 62);
+    table.observe(8, 62, before + 40, 1.0);
+    EXPECT_NEAR(table.watts(8, 62), before + 40, 0.001);
+
+    // a reading far from the curve moves the table up to maxDrift only
+    for (int i = 0; i < 100; i++)
+        table.observe(10, 90, 2000);
+    EXPECT_NEAR(table.watts(10, 90), exponentialCurve(10, 90) * (1.0 + ergtable::maxDrift), 0.001);
+    for (int i = 0; i < 100; i++)
+        table.observe(10, 90, 0);
+    EXPECT_NEAR(table.watts(10, 90), exponentialCurve(10, 90) * (1.0 - ergtable::maxDrift), 0.001);
+
+    // out of the range or not pedaling: ignored
+    double stopped = table.watts(5, 0);
+    table.observe(5, 0, 500);
+    table.observe(20, 90, 500);
+    EXPECT_DOUBLE_EQ(table.watts(5, 0), stopped);
+
+    table.invalidate();
+    EXPECT_DOUBLE_EQ(table.watts(5, 90), exponentialCurve(5, 90));
+}
+
+void ErgTableTestSuite::test_benchmark() {
+    const resistance_t maxResistance = 16;
+    const int count = 100000;
+    ergtable table;
+    table.setModel(proformCurve);
+    table.setRange(1, maxResistance);
+    table.resistance(0, 0);
+
+    Benchmark benchmark;
+    int total = 0;
+    for (int i = 0; i < count; i++)
+        total += scan(proformCurve, maxResistance, i % 600, 60 + (i % 50));
+    qint64 scanned = benchmark.lap();
+
+    benchmark.restart();
+    for (int i = 0; i < count; i++)
+        total -= table.resistance(i % 600, 60 + (i % 50));
+    qint64 looked = benchmark.lap();
+
+    // the cadences aren't all on a row, a few lookups can be one level apart
+    EXPECT_LT(std::abs(total), count / 10);
+    benchmark.record("scan_ns", scanned, count);
+    benchmark.record("table_ns", looked, count);
+}
@@ -0,0 +1,60 @@
+#ifndef ERGTABLETESTSUITE_H
+#define ERGTABLETESTSUITE_H
+
+#include "gtest/gtest.h"
+
+#include "Tools/benchmark.h"
+
+class ErgTableTestSuite: public testing::Test {
+
+public:
+    ErgTableTestSuite();
+
+    /**
+     * @brief Test that the table gives the level the drivers found scanning the curve, exactly on the cadence rows and
+     * within one level between them.
+     */
+    void test_matchesScan();
+
+    /**
+     * @brief Test the lowest and highest levels, and that a curve going down along the resistance is made monotonic.
+     */
+    void test_bounds();
+
+    /**
+     * @brief Test the watt_gain and watt_offset correction in both directions.
+     */
+    void test_correction();
+
+    /**
+     * @brief Test that the power meter readings move the table towards them and keep it monotonic.
+     */
+    void test_observe();
+
+    /**
+     * @brief Measure a lookup against the scan of the curve.
+     */
+    void test_benchmark();
+};
+
+TEST_F(ErgTableTestSuite, TestMatchesScan) {
+    this->test_matchesScan();
+}
+
+TEST_F(ErgTableTestSuite, TestBounds) {
+    this->test_bounds();
+}
+
+TEST_F(ErgTableTestSuite, TestCorrection) {
+    this->test_correction();
+}
+
+TEST_F(ErgTableTestSuite, TestObserve) {
+    this->test_observe();
+}
+
+BENCHMARK_F(ErgTableTestSuite, TestBenchmark) {
+    this->test_benchmark();
+}
+
+#endif // ERGTABLETESTSUITE_H
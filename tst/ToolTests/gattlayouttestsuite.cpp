@@ -0,0 +1,194 @@
+#include "gattlayouttestsuite.h"
+
+#include "bike.h"
+#include "characteristicnotifier2a37.h"
+#include "characteristicnotifier2a5b.h"
+#include "characteristicnotifier2a63.h"
+#include "characteristicnotifier2acd.h"
+#include "characteristicnotifier2ad2.h"
+#include "gattlayout.h"
+#include "treadmill.h"
+
+#include <QSettings>
+#include <QtMath>
+
+class GattTestBike : public bike {
+  public:
+    void set(double speed, double cadence, double resistance, double watt, double heart, double crankRevs,
+             uint16_t crankTime) {
+        Speed.setValue(speed, false);
+        Cadence.setValue(cadence, false);
+        Resistance.setValue(resistance, false);
+        m_watt.setValue(watt, false);
+        Heart.setValue(heart, false);
+        CrankRevs = crankRevs;
+        LastCrankEventTime = crankTime;
+    }
+};
+
+class GattTestTreadmill : public treadmill {
+  public:
+    void set(double speed, double inclination, double heart) {
+        Speed.setValue(speed, false);
+        Inclination.setValue(inclination, false);
+        Heart.setValue(heart, false);
+    }
+};
+
+// the indoor bike data of a bike as the 0x2AD2 notifier used to build it
+static QByteArray legacy2AD2(bluetoothdevice *Bike) {
+    QByteArray value;
+    double normalizeWattage = Bike->wattsMetric().value();
+    if (normalizeWattage < 0)
+        normalizeWattage = 0;
+    uint16_t normalizeSpeed = (uint16_t)qRound(Bike->currentSpeed().value() * 100);
+    value.append((char)0x64);
+    value.append((char)0x02);
+    value.append((char)(normalizeSpeed & 0xFF));
+    value.append((char)(normalizeSpeed >> 8) & 0xFF);
+    value.append((char)((uint16_t)(Bike->currentCadence().value() * 2) & 0xFF));
+    value.append((char)(((uint16_t)(Bike->currentCadence().value() * 2) >> 8) & 0xFF));
+    value.append((char)Bike->currentResistance().value());
+    value.append((char)(0));
+    value.append((char)(((uint16_t)normalizeWattage) & 0xFF));
+    value.append((char)(((uint16_t)normalizeWattage) >> 8) & 0xFF);
+    value.append(char(Bike->currentHeart().value()));
+    value.append((char)0);
+    return value;
+}
+
+// the same with the settings read the way the notifier did for every notification
+static QByteArray legacy2AD2WithSettings(bluetoothdevice *Bike) {
+    QSettings settings;
+    bool virtual_device_rower =
+        settings.value(QZSettings::virtual_device_rower, QZSettings::default_virtual_device_rower).toBool();
+    if (virtual_device_rower && Bike->deviceType() == bluetoothdevice::ROWING)
+        return QByteArray();
+    return legacy2AD2(Bike);
+}
+
+static QByteArray legacy2A63(bluetoothdevice *Bike) {
+    QByteArray value;
+    double normalizeWattage = Bike->wattsMetric().value();
+    if (normalizeWattage < 0)
+        normalizeWattage = 0;
+    value.append((char)0x20);
+    value.append((char)0x00);
+    value.append((char)(((uint16_t)normalizeWattage) & 0xFF));
+    value.append((char)(((uint16_t)normalizeWattage) >> 8) & 0xFF);
+    value.append((char)(((uint16_t)Bike->currentCrankRevolutions()) & 0xFF));
+    value.append((char)(((uint16_t)Bike->currentCrankRevolutions()) >> 8) & 0xFF);
+    value.append((char)(Bike->lastCrankEventTime() & 0xff));
+    value.append((char)(Bike->lastCrankEventTime() >> 8) & 0xFF);
+    return value;
+}
+
+static QByteArray legacy2ACD(bluetoothdevice *Bike) {
+    QByteArray value;
+    value.append(0x08);
+    value.append((char)0x01);
+    uint16_t normalizeSpeed = (uint16_t)qRound(Bike->currentSpeed().value() * 100);
+    value.append((char)(normalizeSpeed & 0xFF));
+    value.append((char)((normalizeSpeed >> 8) & 0xFF));
+    uint16_t normalizeIncline = (uint32_t)qRound(Bike->currentInclination().value() * 10);
+    value.append((char)(normalizeIncline & 0xFF));
+    value.append((char)((normalizeIncline >> 8) & 0xFF));
+    double ramp = qRadiansToDegrees(qAtan(Bike->currentInclination().value() / 100));
+    int16_t normalizeRamp = (int32_t)qRound(ramp * 10);
+    value.append((char)(normalizeRamp & 0xFF));
+    value.append((char)((normalizeRamp >> 8) & 0xFF));
+    value.append(Bike->currentHeart().value());
+    return value;
+}
+
+GattLayoutTestSuite::GattLayoutTestSuite()
+{
+
+}
+
+void GattLayoutTestSuite::test_layout() {
+    typedef gattlayout<uint16_t, uint8_t, uint16_t, gattuint24, int16_t, uint32_t, int8_t> mixed;
+    static_assert(mixed::size == 15, "the sizes of the fields add up");
+    static_assert(gattlayout<>::size == 0, "an empty layout is empty");
+
+    QByteArray value("prefix");
+    mixed::append(value, 0x032C, 0xAB, 0x1234, 0xFFABCDEF, -2, 0x01020304, -1);
+    EXPECT_EQ(value, QByteArray("prefix") + QByteArray::fromHex("2c03ab3412efcdabfeff04030201ff"));
+
+    char buffer[mixed::size + 1];
+    buffer[mixed::size] = 0x55;
+    mixed::write(buffer, 0, 0, 0, 0, 0, 0, 0);
+    EXPECT_EQ(QByteArray(buffer, sizeof(buffer)), QByteArray(mixed::size, 0) + QByteArray(1, 0x55));
+}
+
+void GattLayoutTestSuite::test_notifiers() {
+    GattTestBike bike;
+    CharacteristicNotifier2AD2 notif2AD2(&bike);
+    CharacteristicNotifier2A63 notif2A63(&bike);
+    CharacteristicNotifier2A37 notif2A37(&bike);
+
+    for (int i = 0; i < 500; i++) {
+        bike.set(i * 0.13, i * 0.37, i % 40, i * 2.9 - 50, 60 + i % 140, i * 1.5, (uint16_t)(i * 997));
+        QByteArray value;
+        ASSERT_EQ(notif2AD2.notify(value), CN_OK);
+        ASSERT_EQ(value, legacy2AD2(&bike)) << i;
+
+        value.clear();
+        ASSERT_EQ(notif2A63.notify(value), CN_OK);
+        ASSERT_EQ(value, legacy2A63(&bike)) << i;
+
+        value.clear();
+        ASSERT_EQ(notif2A37.notify(value), CN_OK);
+        ASSERT_EQ(value, QByteArray(1, 0) + QByteArray(1, (char)bike.metrics_override_heartrate())) << i;
+    }
+
+    // the crank only measurement, or the wheel one with the revolutions counted from the speed
+    CharacteristicNotifier2A5B notif2A5B(&bike);
+    bike.set(36, 90, 10, 200, 120, 1234.0, 0xBEEF);
+    QByteArray value;
+    ASSERT_EQ(notif2A5B.notify(value), CN_OK);
+    QByteArray crank = QByteArray::fromHex("d204efbe");
+    if (value.size() == 5) {
+        EXPECT_EQ(value, QByteArray::fromHex("02") + crank);
+    } else {
+        // 36 km/h on a 2 m wheel: 5 revolutions per second, a revolution every 1024 / 5 ticks
+        EXPECT_EQ(value, QByteArray::fromHex("0301000000cc00") + crank);
+    }
+
+    GattTestTreadmill treadmill;
+    CharacteristicNotifier2ACD notif2ACD(&treadmill);
+    for (int i = 0; i < 500; i++) {
+        treadmill.set(i * 0.05, i * 0.1 - 10, 60 + i % 140);
+        value.clear();
+        ASSERT_EQ(notif2ACD.notify(value), CN_OK);
+        ASSERT_EQ(value, legacy2ACD(&treadmill)) << i;
+    }
+    value.clear();
+    EXPECT_EQ(CharacteristicNotifier2ACD(&bike).notify(value), CN_INVALID);
+    EXPECT_TRUE(value.isEmpty());
+}
+
+void GattLayoutTestSuite::test_benchmark() {
+    const int count = 20000;
+    GattTestBike bike;
+    bike.set(32.5, 85, 12, 215, 132, 100, 1024);
+    CharacteristicNotifier2AD2 notif2AD2(&bike);
+    int total = 0;
+
+    Benchmark benchmark;
+    for (int i = 0; i < count; i++)
+        total += legacy2AD2WithSettings(&bike).size();
+    qint64 legacy = benchmark.lap();
+
+    benchmark.restart();
+    for (int i = 0; i < count; i++) {
+        QByteArray value;
+        notif2AD2.notify(value);
+        total -= value.size();
+    }
+    qint64 layout = benchmark.lap();
+
+    EXPECT_EQ(total, 0);
+    benchmark.record("byte_by_byte_ns", legacy, count);
+    benchmark.record("layout_ns", layout, count);
+}
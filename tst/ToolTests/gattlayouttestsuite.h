@@ -0,0 +1,41 @@
+#ifndef GATTLAYOUTTESTSUITE_H
+#define GATTLAYOUTTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+#include "Tools/benchmark.h"
+
+class GattLayoutTestSuite: public testing::Test {
+
+public:
+    GattLayoutTestSuite();
+
+    /**
+     * @brief Test the size of a layout and the little endian encoding of each field type.
+     */
+    void test_layout();
+
+    /**
+     * @brief Test that the notifiers send the same bytes as when they built the values byte by byte.
+     */
+    void test_notifiers();
+
+    /**
+     * @brief Measure the indoor bike data notification against building it byte by byte.
+     */
+    void test_benchmark();
+};
+
+TEST_F(GattLayoutTestSuite, TestLayout) {
+    this->test_layout();
+}
+
+TEST_F(GattLayoutTestSuite, TestNotifiers) {
+    this->test_notifiers();
+}
+
+BENCHMARK_F(GattLayoutTestSuite, TestBenchmark) {
+    this->test_benchmark();
+}
+
+#endif // GATTLAYOUTTESTSUITE_H
@@ -0,0 +1,178 @@
+#include "gpxtestsuite.h"
+
+#include "gpx.h"
+#include "qzsettings.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QStandardPaths>
+#include <QTemporaryFile>
+#include <QTextStream>
+
+// a recorded route going north: a point every 2 seconds, about 111 meters apart, climbing 0.5 meters each
+static QString recordedRoute(int points) {
+    QString gpx;
+    QTextStream out(&gpx);
+    out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+           "<gpx version=\"1.1\" creator=\"test\" xmlns=\"http://www.topografix.com/GPX/1/1\">\n"
+           "<metadata><name>test</name><author><name>test</name></author>"
+           "<video>https://example.com/route.mp4</video></metadata>\n"
+           "<trk><name>test</name><trkseg>\n";
+    QDateTime start(QDate(2023, 5, 1), QTime(10, 0, 0), Qt::UTC);
+    for (int i = 0; i < points; i++) {
+        out << "<trkpt lat=\"" << QString::number(45.0 + i * 0.001, 'f', 6) << "\" lon=\"7.0\">"
+            << "<ele>" << 100 + i * 0.5 << "</ele>"
+            << "<time>" << start.addSecs(i * 2).toString(Qt::ISODate) << "</time>"
+            << "<extensions><power>200</power></extensions></trkpt>\n";
+    }
+    out << "</trkseg></trk></gpx>\n";
+    return gpx;
+}
+
+static QDir cacheDir() {
+    return QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QStringLiteral("/gpx"));
+}
+
+static void clearCache() {
+    if (QStandardPaths::isTestModeEnabled())
+        cacheDir().removeRecursively();
+}
+
+static bool samePoints(const QList<gpx_altitude_point_for_treadmill> &a,
+                       const QList<gpx_altitude_point_for_treadmill> &b) {
+    if (a.length() != b.length())
+        return false;
+    for (int i = 0; i < a.length(); i++) {
+        if (a.at(i).seconds != b.at(i).seconds || a.at(i).distance != b.at(i).distance ||
+            a.at(i).inclination != b.at(i).inclination || a.at(i).elevation != b.at(i).elevation ||
+            a.at(i).latitude != b.at(i).latitude || a.at(i).longitude != b.at(i).longitude ||
+            (a.at(i).azimuth != b.at(i).azimuth && !(isnan(a.at(i).azimuth) && isnan(b.at(i).azimuth))))
+            return false;
+    }
+    return true;
+}
+
+static bool writeRoute(QTemporaryFile &file, const QString &content) {
+    if (!file.open())
+        return false;
+    file.write(content.toUtf8());
+    file.close();
+    return true;
+}
+
+GPXTestSuite::GPXTestSuite() : testSettings("Roberto Viola", "QDomyos-Zwift Testing")
+{
+    // the default loop and treadmill settings
+    testSettings.activate();
+    testSettings.qsettings.clear();
+    // the processed routes are cached in the test directories
+    QStandardPaths::setTestModeEnabled(true);
+}
+
+void GPXTestSuite::test_open() {
+    QTemporaryFile file(QDir::tempPath() + QStringLiteral("/XXXXXX.gpx"));
+    ASSERT_TRUE(writeRoute(file, recordedRoute(10)));
+
+    gpx g;
+    QList<gpx_altitude_point_for_treadmill> points = g.open(file.fileName());
+    EXPECT_EQ(g.getVideoURL(), QStringLiteral("https://example.com/route.mp4"));
+
+    // the route ends 1 km from its start, so it isn't closed in a circuit
+    ASSERT_EQ(points.length(), 10);
+    EXPECT_EQ(points.at(0).seconds, 0u);
+    EXPECT_DOUBLE_EQ(points.at(0).distance, 0);
+    EXPECT_FLOAT_EQ(points.at(0).elevation, 100);
+    for (int i = 1; i < points.length(); i++) {
+        EXPECT_EQ(points.at(i).seconds, (uint64_t)i * 2);
+        EXPECT_NEAR(points.at(i).distance, 0.111, 0.001);
+        EXPECT_NEAR(points.at(i).inclination, 0.5 / (points.at(i).distance * 1000) * 100, 0.001);
+        EXPECT_FLOAT_EQ(points.at(i).elevation, 100 + i * 0.5);
+        EXPECT_NEAR(points.at(i).latitude, 45.0 + i * 0.001, 1e-9);
+        EXPECT_DOUBLE_EQ(points.at(i).longitude, 7.0);
+    }
+}
+
+void GPXTestSuite::test_routes() {
+    QDir dir(QStringLiteral(GPX_ROUTES_DIR));
+    const QStringList files = dir.entryList(QStringList() << QStringLiteral("*.gpx"), QDir::Files);
+    ASSERT_FALSE(files.isEmpty());
+
+    for (const QString &f : files) {
+        QFile route(dir.filePath(f));
+        ASSERT_TRUE(route.open(QIODevice::ReadOnly | QIODevice::Text));
+        int trkpt = QString::fromUtf8(route.readAll()).count(QStringLiteral("<trkpt"));
+
+        gpx g;
+        QList<gpx_altitude_point_for_treadmill> points = g.open(dir.filePath(f));
+        // the points at the same position of the previous one are dropped, a circuit gets its start again at the end
+        EXPECT_GT(points.length(), trkpt / 2) << f.toStdString();
+        EXPECT_LE(points.length(), trkpt + 1) << f.toStdString();
+    }
+}
+
+void GPXTestSuite::test_cache() {
+    clearCache();
+    QTemporaryFile file(QDir::tempPath() + QStringLiteral("/XXXXXX.gpx"));
+    ASSERT_TRUE(writeRoute(file, recordedRoute(100)));
+
+    gpx parsed;
+    QList<gpx_altitude_point_for_treadmill> points = parsed.open(file.fileName());
+    ASSERT_EQ(points.length(), 100);
+    const QStringList caches = cacheDir().entryList(QStringList() << QStringLiteral("*.route"), QDir::Files);
+    ASSERT_EQ(caches.length(), 1);
+
+    gpx cached;
+    EXPECT_TRUE(samePoints(cached.open(file.fileName()), points));
+    EXPECT_EQ(cached.getVideoURL(), parsed.getVideoURL());
+    EXPECT_TRUE(isnan(points.at(0).azimuth));
+    EXPECT_NEAR(points.at(1).azimuth, 0, 0.001); // north
+
+    // a truncated cache is ignored and written again
+    QFile cache(cacheDir().filePath(caches.first()));
+    qint64 size = cache.size();
+    ASSERT_TRUE(cache.resize(size - 10));
+    gpx damaged;
+    EXPECT_TRUE(samePoints(damaged.open(file.fileName()), points));
+    EXPECT_EQ(QFileInfo(cache.fileName()).size(), size);
+
+    // the loop setting changes the route, so it's cached apart
+    testSettings.qsettings.setValue(QZSettings::gpx_loop, true);
+    gpx loop;
+    EXPECT_EQ(loop.open(file.fileName()).length(), 199);
+    EXPECT_EQ(cacheDir().entryList(QStringList() << QStringLiteral("*.route"), QDir::Files).length(), 2);
+    testSettings.qsettings.setValue(QZSettings::gpx_loop, false);
+
+    // only the newest routes are kept
+    for (int i = 0; i < gpx::maxCachedRoutes + 5; i++) {
+        QTemporaryFile other(QDir::tempPath() + QStringLiteral("/XXXXXX.gpx"));
+        ASSERT_TRUE(writeRoute(other, recordedRoute(10 + i)));
+        gpx g;
+        EXPECT_EQ(g.open(other.fileName()).length(), 10 + i);
+    }
+    EXPECT_EQ(cacheDir().entryList(QStringList() << QStringLiteral("*.route"), QDir::Files).length(),
+              (int)gpx::maxCachedRoutes);
+    clearCache();
+}
+
+void GPXTestSuite::test_benchmark() {
+    const int count = 50000;
+    clearCache();
+    QTemporaryFile file(QDir::tempPath() + QStringLiteral("/XXXXXX.gpx"));
+    ASSERT_TRUE(writeRoute(file, recordedRoute(count)));
+
+    Benchmark benchmark;
+    gpx g;
+    QList<gpx_altitude_point_for_treadmill> points = g.open(file.fileName());
+    qint64 parsed = benchmark.lap();
+
+    gpx c;
+    QList<gpx_altitude_point_for_treadmill> cached = c.open(file.fileName());
+    qint64 fromCache = benchmark.lap();
+
+    EXPECT_EQ(points.length(), count);
+    EXPECT_TRUE(samePoints(points, cached));
+    benchmark.record("parse_ms", parsed, 1000000);
+    benchmark.record("cache_ms", fromCache, 1000000);
+    clearCache();
+}
@@ -0,0 +1,52 @@
+#ifndef GPXTESTSUITE_H
+#define GPXTESTSUITE_H
+
+#include "gtest/gtest.h"
+#include "Tools/benchmark.h"
+#include "Tools/testsettings.h"
+
+class GPXTestSuite: public testing::Test {
+    TestSettings testSettings;
+
+public:
+    GPXTestSuite();
+
+    /**
+     * @brief Test the reading of the track points, their elevation and time, and of the video of the metadata.
+     */
+    void test_open();
+
+    /**
+     * @brief Test that the bundled routes are read in full.
+     */
+    void test_routes();
+
+    /**
+     * @brief Test that a route opened again comes from the cache, that a damaged cache is rebuilt and that the cache is
+     * pruned.
+     */
+    void test_cache();
+
+    /**
+     * @brief Measure the loading time of a recorded route of 50000 points, parsed and from the cache.
+     */
+    void test_benchmark();
+};
+
+TEST_F(GPXTestSuite, TestOpen) {
+    this->test_open();
+}
+
+TEST_F(GPXTestSuite, TestRoutes) {
+    this->test_routes();
+}
+
+TEST_F(GPXTestSuite, TestCache) {
+    this->test_cache();
+}
+
+BENCHMARK_F(GPXTestSuite, TestBenchmark) {
+    this->test_benchmark();
+}
+
+#endif // GPXTESTSUITE_H
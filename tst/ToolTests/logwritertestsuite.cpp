@@ -0,0 +1,226 @@
+#include "logwritertestsuite.h"
+
+#include "logwriter.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QProcess>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+#include <QThread>
+#include <QVector>
+
+static const QMessageLogContext appContext(nullptr, 0, nullptr, "default");
+static const QMessageLogContext qtContext(nullptr, 0, nullptr, "qt.test");
+
+static QStringList readLines(const QString &fileName) {
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return QStringList();
+    return QString::fromUtf8(file.readAll()).split(QLatin1Char('\n'), Qt::SkipEmptyParts);
+}
+
+// an empty array if gzip isn't installed or the data isn't valid
+static QByteArray gunzip(const QByteArray &gz) {
+    QString program = QStandardPaths::findExecutable(QStringLiteral("gzip"));
+    if (program.isEmpty())
+        return QByteArray();
+    QProcess gzip;
+    gzip.start(program, QStringList() << QStringLiteral("-dc"));
+    if (!gzip.waitForStarted())
+        return QByteArray();
+    gzip.write(gz);
+    gzip.closeWriteChannel();
+    if (!gzip.waitForFinished() || gzip.exitCode() != 0)
+        return QByteArray();
+    return gzip.readAllStandardOutput();
+}
+
+static bool hasGzip() { return !QStandardPaths::findExecutable(QStringLiteral("gzip")).isEmpty(); }
+
+class LogProducer : public QThread {
+  public:
+    LogProducer(logwriter *writer, int id, int count) : writer(writer), id(id), count(count) {}
+
+  protected:
+    void run() override {
+        for (int i = 0; i < count; i++)
+            writer->append(QtDebugMsg, appContext, QStringLiteral("producer %1 message %2").arg(id).arg(i));
+    }
+
+  private:
+    logwriter *writer;
+    int id;
+    int count;
+};
+
+LogWriterTestSuite::LogWriterTestSuite()
+{
+
+}
+
+void LogWriterTestSuite::test_lossless() {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    QString fileName = dir.filePath(QStringLiteral("debug.log"));
+
+    logwriter writer(fileName);
+    writer.setEcho(false);
+    // the producers are much faster than the writer, so they have to wait
+    writer.setHighWaterMark(100);
+    writer.start();
+
+    const int producers = 4;
+    const int count = 20000;
+    QVector<LogProducer *> threads;
+    for (int p = 0; p < producers; p++) {
+        threads.append(new LogProducer(&writer, p, count));
+        threads.last()->start();
+    }
+    for (LogProducer *t : threads) {
+        EXPECT_TRUE(t->wait(30000));
+        delete t;
+    }
+    writer.stop();
+
+    QStringList lines = readLines(fileName);
+    ASSERT_EQ(lines.size(), producers * count);
+    QVector<int> next(producers, 0);
+    for (const QString &line : lines) {
+        int at = line.indexOf(QStringLiteral("Debug:   producer "));
+        ASSERT_GE(at, 0) << line.toStdString();
+        QStringList fields = line.mid(at).split(QLatin1Char(' '), Qt::SkipEmptyParts);
+        ASSERT_EQ(fields.size(), 5);
+        int p = fields.at(2).toInt();
+        ASSERT_EQ(fields.at(4).toInt(), next[p]++);
+    }
+}
+
+void LogWriterTestSuite::test_rotation() {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    QString fileName = dir.filePath(QStringLiteral("debug.log"));
+
+    logwriter writer(fileName, 10000, 0, true);
+    writer.setEcho(false);
+    writer.start();
+    const int count = 1000;
+    for (int i = 0; i < count; i++)
+        writer.append(QtDebugMsg, appContext, QStringLiteral("message %1").arg(i));
+    writer.stop();
+
+    // the closed parts are gzipped, the last one is still being written
+    QStringList parts = QDir(dir.path()).entryList(QDir::Files, QDir::Name);
+    ASSERT_GT(parts.size(), 2);
+    EXPECT_TRUE(parts.contains(QStringLiteral("debug.log.gz")));
+    EXPECT_TRUE(parts.contains(QStringLiteral("debug-2.log.gz")));
+    EXPECT_EQ(writer.currentFileName(), dir.filePath(QStringLiteral("debug-%1.log").arg(parts.size())));
+
+    // the gzip header and the CRC-32 of the content
+    QByteArray empty = logwriter::gzip(QByteArray());
+    EXPECT_EQ(empty.left(3), QByteArray("\x1f\x8b\x08", 3));
+    EXPECT_EQ(logwriter::crc32(QByteArrayLiteral("123456789")), 0xCBF43926);
+    if (!hasGzip())
+        return;
+
+    QStringList lines;
+    for (int part = 1; part <= parts.size(); part++) {
+        QString name = part == 1 ? fileName : dir.filePath(QStringLiteral("debug-%1.log").arg(part));
+        if (part < parts.size()) {
+            QFile gz(name + QStringLiteral(".gz"));
+            ASSERT_TRUE(gz.open(QIODevice::ReadOnly));
+            QByteArray data = gunzip(gz.readAll());
+            EXPECT_GT(data.size(), 0);
+            EXPECT_LE(data.size(), 10000);
+            lines += QString::fromUtf8(data).split(QLatin1Char('\n'), Qt::SkipEmptyParts);
+        } else {
+            lines += readLines(name);
+        }
+    }
+    ASSERT_EQ(lines.size(), count);
+    for (int i = 0; i < count; i++)
+        EXPECT_TRUE(lines.at(i).endsWith(QStringLiteral("message %1").arg(i)));
+    EXPECT_EQ(gunzip(empty), QByteArray());
+}
+
+void LogWriterTestSuite::test_rateLimit() {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    QString fileName = dir.filePath(QStringLiteral("debug.log"));
+
+    logwriter writer(fileName);
+    writer.setEcho(false);
+    writer.setRateLimit(5);
+    writer.start();
+
+    // start at the beginning of a second, so the burst doesn't span two of them
+    QThread::msleep(1000 - QDateTime::currentMSecsSinceEpoch() % 1000);
+    for (int i = 0; i < 50; i++) {
+        writer.append(QtWarningMsg, qtContext, QStringLiteral("flood %1").arg(i));
+        writer.append(QtDebugMsg, appContext, QStringLiteral("app %1").arg(i));
+    }
+    QThread::msleep(1000);
+    writer.append(QtWarningMsg, qtContext, QStringLiteral("later"));
+    writer.stop();
+
+    QStringList lines = readLines(fileName);
+    EXPECT_EQ(lines.filter(QStringLiteral("flood")).size(), 5);
+    EXPECT_EQ(lines.filter(QStringLiteral("app")).size(), 50);
+    EXPECT_EQ(lines.filter(QStringLiteral("45 lines of qt.test suppressed")).size(), 1);
+    EXPECT_EQ(lines.filter(QStringLiteral("later")).size(), 1);
+}
+
+void LogWriterTestSuite::test_afterStop() {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    QString fileName = dir.filePath(QStringLiteral("debug.log"));
+
+    logwriter writer(fileName);
+    writer.setEcho(false);
+    writer.start();
+    writer.append(QtDebugMsg, appContext, QStringLiteral("before"));
+    writer.stop();
+    EXPECT_TRUE(writer.isFinished());
+
+    writer.append(QtDebugMsg, appContext, QStringLiteral("after"));
+    QStringList lines = readLines(fileName);
+    ASSERT_EQ(lines.size(), 2);
+    EXPECT_TRUE(lines.at(0).endsWith(QStringLiteral("before")));
+    EXPECT_TRUE(lines.at(1).endsWith(QStringLiteral("after")));
+}
+
+void LogWriterTestSuite::test_benchmark() {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const int count = 20000;
+    const QString msg = QStringLiteral("ftmsbike << 14 \"44 02 00 00 00 00 00 00 00 00 00 00 00 00\"");
+
+    // what the message handler used to do for every line
+    QString fileName = dir.filePath(QStringLiteral("direct.log"));
+    Benchmark benchmark;
+    for (int i = 0; i < count; i++) {
+        QString txt = QDateTime::currentDateTime().toString() + QStringLiteral(" ") +
+                      QString::number(QDateTime::currentMSecsSinceEpoch()) + QStringLiteral(" ") +
+                      QStringLiteral("Debug: %1 %2 %3\n").arg(QString(), QString(), msg);
+        QFile outFile(fileName);
+        outFile.open(QIODevice::WriteOnly | QIODevice::Append);
+        outFile.write(txt.toUtf8());
+    }
+    qint64 direct = benchmark.lap();
+
+    logwriter writer(dir.filePath(QStringLiteral("queued.log")));
+    writer.setEcho(false);
+    writer.start();
+    benchmark.restart();
+    for (int i = 0; i < count; i++)
+        writer.append(QtDebugMsg, appContext, msg);
+    qint64 queued = benchmark.lap();
+    writer.stop();
+    qint64 written = queued + benchmark.lap();
+
+    EXPECT_EQ(readLines(dir.filePath(QStringLiteral("queued.log"))).size(), count);
+    benchmark.record("file_per_line_ns", direct, count);
+    benchmark.record("queued_ns", queued, count);
+    benchmark.record("written_ms", written, 1000000);
+}
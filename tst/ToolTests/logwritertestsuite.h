@@ -0,0 +1,59 @@
+#ifndef LOGWRITERTESTSUITE_H
+#define LOGWRITERTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+#include "Tools/benchmark.h"
+
+class LogWriterTestSuite: public testing::Test {
+
+public:
+    LogWriterTestSuite();
+
+    /**
+     * @brief Test that no message is lost or reordered when several threads log past the high water mark.
+     */
+    void test_lossless();
+
+    /**
+     * @brief Test that the log continues in new parts past the maximum size, and that the closed parts are gzipped.
+     */
+    void test_rotation();
+
+    /**
+     * @brief Test that the Qt categories are rate limited, and the application one isn't.
+     */
+    void test_rateLimit();
+
+    /**
+     * @brief Test that what is logged after stop() is written right away.
+     */
+    void test_afterStop();
+
+    /**
+     * @brief Measure how long logging a message takes the caller, compared to opening the file for every line.
+     */
+    void test_benchmark();
+};
+
+TEST_F(LogWriterTestSuite, TestLossless) {
+    this->test_lossless();
+}
+
+TEST_F(LogWriterTestSuite, TestRotation) {
+    this->test_rotation();
+}
+
+TEST_F(LogWriterTestSuite, TestRateLimit) {
+    this->test_rateLimit();
+}
+
+TEST_F(LogWriterTestSuite, TestAfterStop) {
+    this->test_afterStop();
+}
+
+BENCHMARK_F(LogWriterTestSuite, TestBenchmark) {
+    this->test_benchmark();
+}
+
+#endif // LOGWRITERTESTSUITE_H
@@ -0,0 +1,97 @@
+#include "metrictestsuite.h"
+
+#include "bike.h"
+#include "metric.h"
+
+#include <type_traits>
+
+class MetricTestBike : public bike {
+  public:
+    void setSpeed(double speed) { Speed.setValue(speed, false); }
+};
+
+MetricTestSuite::MetricTestSuite()
+{
+
+}
+
+void MetricTestSuite::test_snapshot() {
+    static_assert(std::is_trivially_copyable<metric::snapshot>::value, "a snapshot is a plain struct");
+
+    metric m;
+    m.setValue(10, false);
+    m.setValue(20, false);
+    m.setValue(0, false);
+    m.setValue(30, false);
+    m.setLap(false);
+    m.setValue(5, false);
+
+    metric::snapshot s = m.toSnapshot();
+    EXPECT_EQ(s.value, 5);
+    EXPECT_EQ(s.average, 16.25);
+    EXPECT_EQ(s.min, 5);
+    EXPECT_EQ(s.max, 30);
+    EXPECT_EQ(s.lapValue, m.lapValue());
+    EXPECT_EQ(s.lapAverage, 5);
+    EXPECT_EQ(s.lapMin, 5);
+    EXPECT_EQ(s.lapMax, 5);
+    EXPECT_EQ(s.rate1s, m.rate1s());
+
+    // a snapshot doesn't follow the metric
+    m.setValue(50, false);
+    EXPECT_EQ(s.value, 5);
+    EXPECT_EQ(m.toSnapshot().max, 50);
+}
+
+void MetricTestSuite::test_deviceGetters() {
+    MetricTestBike device;
+    const metric &speed = device.currentSpeed();
+    EXPECT_EQ(&speed, &device.currentSpeed());
+
+    device.setSpeed(25);
+    EXPECT_EQ(speed.value(), 25);
+    device.setSpeed(35);
+    EXPECT_EQ(speed.value(), 35);
+    EXPECT_EQ(speed.average(), 30);
+
+    device.setMetricColor(bluetoothdevice::SPEED_COLOR, QStringLiteral("red"));
+    device.setMetricColor(bluetoothdevice::PELOTON_RESISTANCE_COLOR, QStringLiteral("limegreen"));
+    EXPECT_EQ(device.currentSpeed().color(), QStringLiteral("red"));
+    EXPECT_EQ(device.pelotonResistance().color(), QStringLiteral("limegreen"));
+}
+
+void MetricTestSuite::test_benchmark() {
+    const int count = 100000;
+    metric m;
+    m.addWindow(30000);
+    m.addWindow(60000);
+    m.setColor(QStringLiteral("limegreen"));
+    for (int i = 0; i < 100; i++)
+        m.setValue(100 + i, false);
+    const metric &ref = m;
+    double total = 0;
+
+    Benchmark benchmark;
+    for (int i = 0; i < count; i++) {
+        metric copy = m;
+        total += copy.value() + copy.average() + copy.max();
+    }
+    qint64 copied = benchmark.lap();
+
+    benchmark.restart();
+    for (int i = 0; i < count; i++) {
+        metric::snapshot s = m.toSnapshot();
+        total -= s.value + s.average + s.max;
+    }
+    qint64 snapshots = benchmark.lap();
+
+    benchmark.restart();
+    for (int i = 0; i < count; i++)
+        total += ref.value() + ref.average() + ref.max();
+    qint64 referenced = benchmark.lap();
+
+    EXPECT_DOUBLE_EQ(total, count * (199 + 149.5 + 199));
+    benchmark.record("copy_ns", copied, count);
+    benchmark.record("snapshot_ns", snapshots, count);
+    benchmark.record("const_reference_ns", referenced, count);
+}
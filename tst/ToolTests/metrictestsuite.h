@@ -0,0 +1,41 @@
+#ifndef METRICTESTSUITE_H
+#define METRICTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+#include "Tools/benchmark.h"
+
+class MetricTestSuite: public testing::Test {
+
+public:
+    MetricTestSuite();
+
+    /**
+     * @brief Test that a snapshot holds the same statistics as the metric, laps included.
+     */
+    void test_snapshot();
+
+    /**
+     * @brief Test that the device getters hand out the metrics they own, and that the color set through them stays.
+     */
+    void test_deviceGetters();
+
+    /**
+     * @brief Measure a copy of a metric against a snapshot and a read through the const reference.
+     */
+    void test_benchmark();
+};
+
+TEST_F(MetricTestSuite, TestSnapshot) {
+    this->test_snapshot();
+}
+
+TEST_F(MetricTestSuite, TestDeviceGetters) {
+    this->test_deviceGetters();
+}
+
+BENCHMARK_F(MetricTestSuite, TestBenchmark) {
+    this->test_benchmark();
+}
+
+#endif // METRICTESTSUITE_H
@@ -0,0 +1,94 @@
+#include "ocrworkertestsuite.h"
+
+#include "ocrworker.h"
+
+// a stand-in for ocr-worker.py: it answers "<id> result <command>" after a log line,
+// sleeps on "slow" and exits on "crash"
+static const char *stubWorker = "echo loading; echo ready; "
+                                "while read id command; do "
+                                "  case \"$command\" in "
+                                "    slow) sleep 1 ;; "
+                                "    crash) exit 1 ;; "
+                                "  esac; "
+                                "  echo \"log $id\"; "
+                                "  echo \"$id result $command\"; "
+                                "done";
+
+static ocrworker *createStubWorker() {
+    return new ocrworker(QStringLiteral("sh"), QStringList() << QStringLiteral("-c") << QLatin1String(stubWorker),
+                         5000);
+}
+
+OCRWorkerTestSuite::OCRWorkerTestSuite()
+{
+
+}
+
+void OCRWorkerTestSuite::test_requests() {
+#ifdef Q_OS_UNIX
+    QScopedPointer<ocrworker> worker(createStubWorker());
+    QString result;
+
+    EXPECT_FALSE(worker->isRunning());
+    ASSERT_TRUE(worker->request(QStringLiteral("zwift-incline.py"), result, 2000));
+    EXPECT_EQ(result, QStringLiteral("result zwift-incline.py"));
+    EXPECT_TRUE(worker->isRunning());
+
+    const int requests = 100;
+    for (int i = 0; i < requests; i++) {
+        ASSERT_TRUE(worker->request(QStringLiteral("frame%1").arg(i), result, 2000));
+        EXPECT_EQ(result, QStringLiteral("result frame%1").arg(i));
+    }
+
+    const ocrworker::statistics &stats = worker->stats();
+    EXPECT_EQ(stats.starts, 1);
+    EXPECT_EQ(stats.requests, requests + 1);
+    EXPECT_EQ(stats.responses, requests + 1);
+    EXPECT_EQ(stats.timeouts, 0);
+    EXPECT_LE(stats.maxLatency, 2000);
+    RecordProperty("stats", stats.toString().toStdString());
+#endif
+}
+
+void OCRWorkerTestSuite::test_timeout() {
+#ifdef Q_OS_UNIX
+    QScopedPointer<ocrworker> worker(createStubWorker());
+    QString result;
+
+    EXPECT_FALSE(worker->request(QStringLiteral("slow"), result, 200));
+    EXPECT_EQ(worker->stats().timeouts, 1);
+    EXPECT_FALSE(worker->isRunning());
+
+    ASSERT_TRUE(worker->request(QStringLiteral("fast"), result, 2000));
+    EXPECT_EQ(result, QStringLiteral("result fast"));
+    EXPECT_EQ(worker->stats().starts, 2);
+    EXPECT_EQ(worker->stats().responses, 1);
+#endif
+}
+
+void OCRWorkerTestSuite::test_crash() {
+#ifdef Q_OS_UNIX
+    QScopedPointer<ocrworker> worker(createStubWorker());
+    QString result;
+
+    EXPECT_FALSE(worker->request(QStringLiteral("crash"), result, 2000));
+    EXPECT_EQ(worker->stats().timeouts, 0);
+    EXPECT_FALSE(worker->isRunning());
+
+    ASSERT_TRUE(worker->request(QStringLiteral("again"), result, 2000));
+    EXPECT_EQ(result, QStringLiteral("result again"));
+    EXPECT_EQ(worker->stats().starts, 2);
+#endif
+}
+
+void OCRWorkerTestSuite::test_notReady() {
+#ifdef Q_OS_UNIX
+    ocrworker silent(QStringLiteral("sh"), QStringList() << QStringLiteral("-c") << QStringLiteral("echo loading"), 1000);
+    QString result;
+    EXPECT_FALSE(silent.request(QStringLiteral("frame"), result, 1000));
+    EXPECT_EQ(silent.stats().requests, 0);
+
+    ocrworker missing(QStringLiteral("qz-missing-ocr-worker"), QStringList(), 1000);
+    EXPECT_FALSE(missing.start());
+#endif
+}
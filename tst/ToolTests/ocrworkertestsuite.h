@@ -0,0 +1,48 @@
+#ifndef OCRWORKERTESTSUITE_H
+#define OCRWORKERTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class OCRWorkerTestSuite: public testing::Test {
+
+public:
+    OCRWorkerTestSuite();
+
+    /**
+     * @brief Test that the requests are answered by the same worker process, and measure their latency.
+     */
+    void test_requests();
+
+    /**
+     * @brief Test that a request without an answer in time kills the worker, and that the next one starts it again.
+     */
+    void test_timeout();
+
+    /**
+     * @brief Test that a worker that exits is started again by the next request.
+     */
+    void test_crash();
+
+    /**
+     * @brief Test that a worker that never becomes ready isn't used.
+     */
+    void test_notReady();
+};
+
+TEST_F(OCRWorkerTestSuite, TestRequests) {
+    this->test_requests();
+}
+
+TEST_F(OCRWorkerTestSuite, TestTimeout) {
+    this->test_timeout();
+}
+
+TEST_F(OCRWorkerTestSuite, TestCrash) {
+    this->test_crash();
+}
+
+TEST_F(OCRWorkerTestSuite, TestNotReady) {
+    this->test_notReady();
+}
+
+#endif // OCRWORKERTESTSUITE_H
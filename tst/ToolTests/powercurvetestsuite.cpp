@@ -0,0 +1,88 @@
+#include "powercurvetestsuite.h"
+
+#include "powercurve.h"
+
+#include <QVector>
+
+// the window of a duration spans duration + 1 samples and is divided by the duration, like metric::powerPeak did
+static double bruteForce(const QVector<double> &watts, int seconds) {
+    if (seconds <= 0 || seconds >= watts.size())
+        return -1;
+    double best = -1;
+    for (int first = 0; first + seconds < watts.size(); first++) {
+        double total = 0;
+        for (int i = first; i <= first + seconds; i++)
+            total += watts.at(i);
+        if (total / seconds > best)
+            best = total / seconds;
+    }
+    return best;
+}
+
+// a deterministic ride: an endurance base with sprints and a few threshold blocks
+static QVector<double> ride(int seconds) {
+    QVector<double> watts;
+    quint32 seed = 12345;
+    for (int i = 0; i < seconds; i++) {
+        seed = seed * 1103515245 + 12345;
+        double w = 150 + (seed >> 16) % 60;
+        if (i % 300 < 12)
+            w += 500;
+        else if (i % 900 > 600)
+            w += 120;
+        watts.append(w);
+    }
+    return watts;
+}
+
+PowerCurveTestSuite::PowerCurveTestSuite() {}
+
+void PowerCurveTestSuite::test_maxMean() {
+    const QVector<double> watts = ride(1300);
+    powercurve curve;
+    QVector<double> recorded;
+
+    for (int i = 0; i < watts.size(); i++) {
+        curve.append(i, watts.at(i));
+        recorded.append(watts.at(i));
+        if (i % 250 != 249 && i != watts.size() - 1)
+            continue;
+
+        for (int seconds : powercurve::ladder()) {
+            double expected = bruteForce(recorded, seconds);
+            if (expected < 0)
+                EXPECT_EQ(-1, curve.best(seconds)) << seconds << " s after " << i << " s";
+            else
+                EXPECT_NEAR(expected, curve.best(seconds), 1e-6) << seconds << " s after " << i << " s";
+        }
+        EXPECT_NEAR(bruteForce(recorded, 7), curve.best(7), 1e-6) << "7 s after " << i << " s";
+    }
+
+    QList<QPointF> points = curve.curve();
+    ASSERT_FALSE(points.isEmpty());
+    for (const QPointF &p : points) {
+        EXPECT_NEAR(bruteForce(watts, (int)p.x()), p.y(), 1e-6) << p.x() << " s";
+    }
+    EXPECT_EQ(1200, (int)points.last().x());
+}
+
+void PowerCurveTestSuite::test_shortWorkout() {
+    powercurve curve;
+    EXPECT_EQ(-1, curve.best(1));
+    EXPECT_TRUE(curve.curve().isEmpty());
+
+    for (int i = 0; i < 30; i++)
+        curve.append(i, 200);
+    EXPECT_EQ(30, curve.samples());
+    EXPECT_EQ(-1, curve.best(60));
+    for (const QPointF &p : curve.curve())
+        EXPECT_LT(p.x(), 30);
+    EXPECT_EQ(20, (int)curve.curve().last().x());
+
+    curve.clear();
+    EXPECT_EQ(0, curve.samples());
+    EXPECT_TRUE(curve.curve().isEmpty());
+    curve.append(0, 100);
+    curve.append(1, 300);
+    EXPECT_NEAR(400, curve.best(1), 1e-6);
+}
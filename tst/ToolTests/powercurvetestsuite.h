@@ -0,0 +1,31 @@
+#ifndef POWERCURVETESTSUITE_H
+#define POWERCURVETESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class PowerCurveTestSuite: public testing::Test {
+
+public:
+    PowerCurveTestSuite();
+
+    /**
+     * @brief Test the incremental curve against a brute force max-mean over the 1 Hz samples, while the workout
+     * is recorded, for the ladder durations and one computed on demand.
+     */
+    void test_maxMean();
+
+    /**
+     * @brief Test that the durations longer than the workout are left out, and that clear() starts over.
+     */
+    void test_shortWorkout();
+};
+
+TEST_F(PowerCurveTestSuite, TestMaxMean) {
+    this->test_maxMean();
+}
+
+TEST_F(PowerCurveTestSuite, TestShortWorkout) {
+    this->test_shortWorkout();
+}
+
+#endif // POWERCURVETESTSUITE_H
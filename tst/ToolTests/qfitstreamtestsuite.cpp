@@ -0,0 +1,104 @@
+#include "qfitstreamtestsuite.h"
+
+#include "qfitstream.h"
+
+#include "fit_crc.hpp"
+
+#include <QDateTime>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <cstring>
+
+// a bike workout of the given length, pedaling from the first second
+static void fillSession(sessionstore &session, const QDateTime &start, int seconds, uint16_t watt = 150) {
+    session.clear();
+    for (int i = 0; i < seconds; i++) {
+        session.append(SessionLine(25.0, 0, i * 0.007, watt + i % 20, 10, 0, 120, 0, 80, i * 0.2, 0, i, false, 0, 0,
+                                   0, 0, QGeoCoordinate(), 0, 0, 0, start.addSecs(i)));
+    }
+}
+
+static QByteArray readAll(const QString &filename) {
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly))
+        return QByteArray();
+    return file.readAll();
+}
+
+static QByteArray writeOnce(const QString &filename, const sessionstore &session) {
+    qfitstream stream(filename, bluetoothdevice::BIKE);
+    EXPECT_TRUE(stream.append(session));
+    return readAll(filename);
+}
+
+QFitStreamTestSuite::QFitStreamTestSuite() {}
+
+void QFitStreamTestSuite::test_crcShift() {
+    const FIT_UINT16 states[] = {0, 1, 0x1234, 0xFFFF};
+    const quint64 counts[] = {0, 1, 2, 7, 64, 1000, 4097};
+    for (FIT_UINT16 state : states) {
+        for (quint64 count : counts) {
+            EXPECT_EQ(qfitstream::crcAppend(state, std::string(count, '\0')), qfitstream::crcShift(state, count))
+                << "state " << state << " count " << count;
+        }
+    }
+}
+
+void QFitStreamTestSuite::test_fileCrc() {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString filename = dir.filePath(QStringLiteral("stream.fit"));
+    const QDateTime start(QDate(2023, 5, 1), QTime(10, 0, 0), Qt::UTC);
+
+    sessionstore session;
+    qfitstream stream(filename, bluetoothdevice::BIKE);
+    for (int seconds : {10, 11, 60, 300}) {
+        fillSession(session, start, seconds);
+        ASSERT_TRUE(stream.append(session));
+        EXPECT_EQ(seconds, stream.written());
+
+        QByteArray bytes = readAll(filename);
+        ASSERT_GT(bytes.size(), FIT_FILE_HDR_SIZE + 2);
+        FIT_FILE_HDR header;
+        memcpy(&header, bytes.constData(), FIT_FILE_HDR_SIZE);
+        EXPECT_EQ((FIT_UINT32)(bytes.size() - FIT_FILE_HDR_SIZE - 2), header.data_size);
+        EXPECT_EQ(header.crc, fit::CRC::Calc16(bytes.constData(), FIT_STRUCT_OFFSET(crc, FIT_FILE_HDR)));
+
+        // the CRC of the whole file, its own CRC included, is zero
+        EXPECT_EQ(0, fit::CRC::Calc16(bytes.constData(), bytes.size())) << "after " << seconds << " seconds";
+    }
+
+    EXPECT_EQ(writeOnce(dir.filePath(QStringLiteral("once.fit")), session), readAll(filename));
+}
+
+void QFitStreamTestSuite::test_restart() {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString filename = dir.filePath(QStringLiteral("stream.fit"));
+    const QDateTime start(QDate(2023, 5, 1), QTime(10, 0, 0), Qt::UTC);
+
+    sessionstore session;
+    qfitstream stream(filename, bluetoothdevice::BIKE);
+    fillSession(session, start, 30);
+    ASSERT_TRUE(stream.append(session));
+
+    // a second workout, already longer than the first when the next checkpoint is taken
+    fillSession(session, start.addSecs(3600), 40);
+    ASSERT_TRUE(stream.append(session));
+    EXPECT_EQ(40, stream.written());
+    EXPECT_EQ(writeOnce(dir.filePath(QStringLiteral("second.fit")), session), readAll(filename));
+
+    // a third workout started within the same second: only the explicit reset tells it apart
+    fillSession(session, start.addSecs(3600), 50, 250);
+    stream.reset();
+    EXPECT_EQ(0, stream.written());
+    ASSERT_TRUE(stream.append(session));
+    EXPECT_EQ(writeOnce(dir.filePath(QStringLiteral("third.fit")), session), readAll(filename));
+
+    // a shorter workout
+    fillSession(session, start.addSecs(7200), 20);
+    ASSERT_TRUE(stream.append(session));
+    EXPECT_EQ(20, stream.written());
+    EXPECT_EQ(writeOnce(dir.filePath(QStringLiteral("fourth.fit")), session), readAll(filename));
+}
@@ -0,0 +1,40 @@
+#ifndef QFITSTREAMTESTSUITE_H
+#define QFITSTREAMTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class QFitStreamTestSuite: public testing::Test {
+
+public:
+    QFitStreamTestSuite();
+
+    /**
+     * @brief Test that shifting a CRC over zero bytes matches feeding them one by one.
+     */
+    void test_crcShift();
+
+    /**
+     * @brief Test that the file written over several checkpoints has a valid header size and file CRC, and is
+     * identical to the file written in one go.
+     */
+    void test_fileCrc();
+
+    /**
+     * @brief Test that a new workout rewrites the file, when it is longer than the previous one or after reset().
+     */
+    void test_restart();
+};
+
+TEST_F(QFitStreamTestSuite, TestCrcShift) {
+    this->test_crcShift();
+}
+
+TEST_F(QFitStreamTestSuite, TestFileCrc) {
+    this->test_fileCrc();
+}
+
+TEST_F(QFitStreamTestSuite, TestRestart) {
+    this->test_restart();
+}
+
+#endif // QFITSTREAMTESTSUITE_H
@@ -0,0 +1,59 @@
+#include "qzsettingscachetestsuite.h"
+
+#include "qzsettings.h"
+#include "qzsettingscache.h"
+
+static int argc = 1;
+static char arg0[] = "qdomyos-zwift-tests";
+static char *argv[] = {arg0, nullptr};
+
+QzSettingsCacheTestSuite::QzSettingsCacheTestSuite() : testSettings("Roberto Viola", "QDomyos-Zwift Testing")
+{
+    if (!QCoreApplication::instance())
+        app.reset(new QCoreApplication(argc, argv));
+    testSettings.activate();
+    testSettings.qsettings.clear();
+    // the cache is a singleton: start every test from the cleared settings
+    qzsettingscache::instance()->invalidate();
+    qzsettingscache::get();
+}
+
+void QzSettingsCacheTestSuite::test_defaults() {
+    const qzsettingscache::snapshot &s = qzsettingscache::get();
+    EXPECT_EQ(QZSettings::default_continuous_moving, s.continuous_moving);
+    EXPECT_DOUBLE_EQ(QZSettings::default_ftp, s.ftp);
+    EXPECT_FLOAT_EQ(QZSettings::default_weight, s.weight);
+    EXPECT_EQ(QZSettings::default_miles_unit, s.miles_unit);
+    EXPECT_EQ(QZSettings::default_power_sensor_name, s.power_sensor_name);
+}
+
+void QzSettingsCacheTestSuite::test_invalidate() {
+    int changed = 0;
+    QMetaObject::Connection connection =
+        QObject::connect(qzsettingscache::instance(), &qzsettingscache::changed, [&changed]() { changed++; });
+
+    testSettings.qsettings.setValue(QZSettings::continuous_moving, !QZSettings::default_continuous_moving);
+    testSettings.qsettings.setValue(QZSettings::ftp, 275.0);
+
+    // still the snapshot taken before the writes
+    EXPECT_EQ(QZSettings::default_continuous_moving, qzsettingscache::get().continuous_moving);
+    EXPECT_DOUBLE_EQ(QZSettings::default_ftp, qzsettingscache::get().ftp);
+    EXPECT_EQ(0, changed);
+
+    qzsettingscache::instance()->invalidate();
+    EXPECT_EQ(!QZSettings::default_continuous_moving, qzsettingscache::get().continuous_moving);
+    EXPECT_DOUBLE_EQ(275.0, qzsettingscache::get().ftp);
+    EXPECT_EQ(1, changed);
+
+    QObject::disconnect(connection);
+}
+
+void QzSettingsCacheTestSuite::test_invalidateLater() {
+    testSettings.qsettings.setValue(QZSettings::ftp, 310.0);
+
+    qzsettingscache::instance()->invalidateLater();
+    EXPECT_DOUBLE_EQ(QZSettings::default_ftp, qzsettingscache::get().ftp);
+
+    QCoreApplication::processEvents();
+    EXPECT_DOUBLE_EQ(310.0, qzsettingscache::get().ftp);
+}
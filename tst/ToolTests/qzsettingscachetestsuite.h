@@ -0,0 +1,46 @@
+#ifndef QZSETTINGSCACHETESTSUITE_H
+#define QZSETTINGSCACHETESTSUITE_H
+
+#include "gtest/gtest.h"
+#include "Tools/testsettings.h"
+
+#include <QCoreApplication>
+#include <QScopedPointer>
+
+class QzSettingsCacheTestSuite: public testing::Test {
+    TestSettings testSettings;
+    // invalidateLater() needs an event loop
+    QScopedPointer<QCoreApplication> app;
+
+public:
+    QzSettingsCacheTestSuite();
+
+    /**
+     * @brief Test that the missing keys read as their QZSettings defaults.
+     */
+    void test_defaults();
+
+    /**
+     * @brief Test that a settings write is seen after invalidate(), and only then, with one changed() signal.
+     */
+    void test_invalidate();
+
+    /**
+     * @brief Test that invalidateLater() takes effect once the event loop runs.
+     */
+    void test_invalidateLater();
+};
+
+TEST_F(QzSettingsCacheTestSuite, TestDefaults) {
+    this->test_defaults();
+}
+
+TEST_F(QzSettingsCacheTestSuite, TestInvalidate) {
+    this->test_invalidate();
+}
+
+TEST_F(QzSettingsCacheTestSuite, TestInvalidateLater) {
+    this->test_invalidateLater();
+}
+
+#endif // QZSETTINGSCACHETESTSUITE_H
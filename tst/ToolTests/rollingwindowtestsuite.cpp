@@ -0,0 +1,117 @@
+#include "rollingwindowtestsuite.h"
+
+#include "metric.h"
+#include "rollingwindow.h"
+
+#include <QThread>
+#include <QVector>
+
+struct naiveSample {
+    qint64 timestamp;
+    double value;
+};
+
+// the samples a window bounded by spanMs and maxSamples holds at nowMs
+static QVector<double> naiveWindow(const QVector<naiveSample> &samples, qint64 spanMs, int maxSamples, qint64 nowMs) {
+    QVector<double> values;
+    int first = maxSamples > 0 ? qMax(0, samples.size() - maxSamples) : 0;
+    for (int i = first; i < samples.size(); i++) {
+        if (spanMs <= 0 || nowMs - samples.at(i).timestamp < spanMs)
+            values.append(samples.at(i).value);
+    }
+    return values;
+}
+
+RollingWindowTestSuite::RollingWindowTestSuite() {}
+
+void RollingWindowTestSuite::test_eviction() {
+    rollingwindow w(1000);
+    w.append(0, 10);
+    w.append(400, 20);
+    w.append(900, 30);
+
+    EXPECT_EQ(3, w.count(900));
+    EXPECT_DOUBLE_EQ(20, w.average(900));
+    EXPECT_DOUBLE_EQ(10, w.min(900));
+
+    // read only: the samples expire without an append
+    EXPECT_EQ(2, w.count(1000));
+    EXPECT_DOUBLE_EQ(25, w.average(1000));
+    EXPECT_DOUBLE_EQ(20, w.min(1000));
+    EXPECT_EQ(1, w.count(1400));
+    EXPECT_DOUBLE_EQ(30, w.min(1400));
+    EXPECT_EQ(0, w.count(1900));
+    EXPECT_DOUBLE_EQ(0, w.average(1900));
+    EXPECT_DOUBLE_EQ(0, w.max(1900));
+
+    // an append evicts them
+    w.append(2000, 5);
+    EXPECT_EQ(1, w.count(2000));
+    EXPECT_DOUBLE_EQ(5, w.sum(2000));
+    EXPECT_DOUBLE_EQ(5, w.min(2000));
+    EXPECT_DOUBLE_EQ(5, w.max(2000));
+
+    w.clear();
+    EXPECT_EQ(0, w.count(2000));
+}
+
+void RollingWindowTestSuite::test_naive() {
+    struct bounds {
+        qint64 spanMs;
+        int maxSamples;
+    };
+    const bounds cases[] = {{3000, 0}, {0, 5}, {10000, 20}, {500, 0}};
+
+    for (const bounds &b : cases) {
+        rollingwindow w(b.spanMs, b.maxSamples);
+        QVector<naiveSample> samples;
+        quint32 seed = 42;
+        qint64 now = 0;
+
+        for (int i = 0; i < 2000; i++) {
+            seed = seed * 1103515245 + 12345;
+            now += (seed >> 16) % 700;
+            double value = (double)((seed >> 8) % 500) - 100;
+            w.append(now, value);
+            samples.append({now, value});
+
+            // read at the time of the append and a bit later
+            for (qint64 later : {(qint64)0, (qint64)((seed >> 4) % 1500)}) {
+                qint64 read = now + later;
+                QVector<double> values = naiveWindow(samples, b.spanMs, b.maxSamples, read);
+                double sum = 0, min = 0, max = 0;
+                for (int j = 0; j < values.size(); j++) {
+                    sum += values.at(j);
+                    min = j == 0 ? values.at(j) : qMin(min, values.at(j));
+                    max = j == 0 ? values.at(j) : qMax(max, values.at(j));
+                }
+                ASSERT_EQ(values.size(), w.count(read)) << "span " << b.spanMs << " sample " << i;
+                EXPECT_NEAR(sum, w.sum(read), 1e-6) << "span " << b.spanMs << " sample " << i;
+                EXPECT_NEAR(values.isEmpty() ? 0 : sum / values.size(), w.average(read), 1e-6)
+                    << "span " << b.spanMs << " sample " << i;
+                EXPECT_EQ(min, w.min(read)) << "span " << b.spanMs << " sample " << i;
+                EXPECT_EQ(max, w.max(read)) << "span " << b.spanMs << " sample " << i;
+            }
+        }
+    }
+}
+
+void RollingWindowTestSuite::test_metricWindow() {
+    metric m;
+    m.addWindow(100);
+    m.addWindow(100000);
+    m.setValue(50, false);
+    m.setValue(150, false);
+
+    EXPECT_DOUBLE_EQ(100, m.averageOver(100));
+    EXPECT_DOUBLE_EQ(150, m.maxOver(100));
+    EXPECT_DOUBLE_EQ(0, m.averageOver(1000));
+
+    qint64 start = metric::monotonicMs();
+    while (metric::monotonicMs() - start < 150)
+        QThread::msleep(10);
+
+    EXPECT_DOUBLE_EQ(0, m.averageOver(100));
+    EXPECT_DOUBLE_EQ(100, m.averageOver(100000));
+    EXPECT_DOUBLE_EQ(50, m.minOver(100000));
+}
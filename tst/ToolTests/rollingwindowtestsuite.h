@@ -0,0 +1,41 @@
+#ifndef ROLLINGWINDOWTESTSUITE_H
+#define ROLLINGWINDOWTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class RollingWindowTestSuite: public testing::Test {
+
+public:
+    RollingWindowTestSuite();
+
+    /**
+     * @brief Test that the samples leave a time window once they are span milliseconds old, both on append and
+     * when the window is only read.
+     */
+    void test_eviction();
+
+    /**
+     * @brief Test count, sum, average, min and max against a naive recomputation over all the samples, for time,
+     * count and mixed bounds.
+     */
+    void test_naive();
+
+    /**
+     * @brief Test that the metric windows follow the monotonic clock: a sample older than the span is not read.
+     */
+    void test_metricWindow();
+};
+
+TEST_F(RollingWindowTestSuite, TestEviction) {
+    this->test_eviction();
+}
+
+TEST_F(RollingWindowTestSuite, TestNaive) {
+    this->test_naive();
+}
+
+TEST_F(RollingWindowTestSuite, TestMetricWindow) {
+    this->test_metricWindow();
+}
+
+#endif // ROLLINGWINDOWTESTSUITE_H
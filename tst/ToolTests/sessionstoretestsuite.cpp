@@ -0,0 +1,137 @@
+#include "sessionstoretestsuite.h"
+
+#include "sessionstore.h"
+
+#include <math.h>
+
+static const QDateTime start(QDate(2023, 5, 1), QTime(10, 0, 0), Qt::UTC);
+
+// a line whose fields all depend on i; every 7th line has no coordinate, every 11th no altitude, every 13th no time
+static SessionLine line(int i) {
+    QGeoCoordinate coordinate;
+    if (i % 7 != 0) {
+        if (i % 11 == 0)
+            coordinate = QGeoCoordinate(45.0 + i * 0.0001, 7.0 - i * 0.0001);
+        else
+            coordinate = QGeoCoordinate(45.0 + i * 0.0001, 7.0 - i * 0.0001, 100 + i * 0.5);
+    }
+    return SessionLine(20.0 + i * 0.01, (int8_t)(i % 30 - 10), i * 0.005, (uint16_t)(100 + i % 300),
+                       (resistance_t)(i % 40), (int8_t)(i % 100), (uint8_t)(60 + i % 120), 3.0 + i * 0.001,
+                       (uint8_t)(i % 110), i * 0.2, i * 0.1, (uint32_t)i, i % 60 == 0, (uint32_t)(i / 2), 20.5,
+                       30.5, 8.25, coordinate, 90.0 + i % 10, 250.0 - i % 10, 80.0 + i % 5,
+                       i % 13 == 0 ? QDateTime() : start.addSecs(i));
+}
+
+static void expectLine(const SessionLine &expected, const SessionLine &actual, int i) {
+    EXPECT_DOUBLE_EQ(expected.speed, actual.speed) << i;
+    EXPECT_EQ(expected.inclination, actual.inclination) << i;
+    EXPECT_DOUBLE_EQ(expected.distance, actual.distance) << i;
+    EXPECT_EQ(expected.watt, actual.watt) << i;
+    EXPECT_EQ(expected.resistance, actual.resistance) << i;
+    EXPECT_EQ(expected.peloton_resistance, actual.peloton_resistance) << i;
+    EXPECT_EQ(expected.heart, actual.heart) << i;
+    EXPECT_DOUBLE_EQ(expected.pace, actual.pace) << i;
+    EXPECT_EQ(expected.cadence, actual.cadence) << i;
+    EXPECT_EQ(expected.time, actual.time) << i;
+    EXPECT_DOUBLE_EQ(expected.calories, actual.calories) << i;
+    EXPECT_DOUBLE_EQ(expected.elevationGain, actual.elevationGain) << i;
+    EXPECT_EQ(expected.elapsedTime, actual.elapsedTime) << i;
+    EXPECT_EQ(expected.lapTrigger, actual.lapTrigger) << i;
+    EXPECT_EQ(expected.totalStrokes, actual.totalStrokes) << i;
+    EXPECT_DOUBLE_EQ(expected.avgStrokesRate, actual.avgStrokesRate) << i;
+    EXPECT_DOUBLE_EQ(expected.maxStrokesRate, actual.maxStrokesRate) << i;
+    EXPECT_DOUBLE_EQ(expected.avgStrokesLength, actual.avgStrokesLength) << i;
+    EXPECT_EQ(expected.coordinate.isValid(), actual.coordinate.isValid()) << i;
+    EXPECT_EQ(expected.coordinate, actual.coordinate) << i;
+    EXPECT_EQ(isnan(expected.coordinate.altitude()), isnan(actual.coordinate.altitude())) << i;
+    EXPECT_DOUBLE_EQ(expected.instantaneousStrideLengthCM, actual.instantaneousStrideLengthCM) << i;
+    EXPECT_DOUBLE_EQ(expected.groundContactMS, actual.groundContactMS) << i;
+    EXPECT_DOUBLE_EQ(expected.verticalOscillationMM, actual.verticalOscillationMM) << i;
+}
+
+SessionStoreTestSuite::SessionStoreTestSuite() {}
+
+void SessionStoreTestSuite::test_append() {
+    const int lines = 2 * sessioncolumn<double>::chunkSize + 100;
+    sessionstore session;
+    EXPECT_TRUE(session.isEmpty());
+
+    for (int i = 0; i < lines; i++)
+        session.append(line(i));
+    ASSERT_EQ(lines, session.count());
+
+    for (int i = 0; i < lines; i++)
+        expectLine(line(i), session.at(i), i);
+}
+
+void SessionStoreTestSuite::test_columns() {
+    const int lines = sessioncolumn<double>::chunkSize + 10;
+    sessionstore session;
+    for (int i = 0; i < lines; i++)
+        session.append(line(i));
+
+    const QList<double> watt = session.watt().toList();
+    const QList<double> heart = session.heart().toList();
+    const QList<double> cadence = session.cadence().toList();
+    const QList<double> resistance = session.resistance().toList();
+    const QList<double> pelotonResistance = session.pelotonResistance().toList();
+    ASSERT_EQ(lines, watt.size());
+    ASSERT_EQ(lines, heart.size());
+    ASSERT_EQ(lines, cadence.size());
+    ASSERT_EQ(lines, resistance.size());
+    ASSERT_EQ(lines, pelotonResistance.size());
+
+    for (int i = 0; i < lines; i++) {
+        SessionLine l = line(i);
+        EXPECT_EQ(l.watt, watt.at(i)) << i;
+        EXPECT_EQ(l.heart, heart.at(i)) << i;
+        EXPECT_EQ(l.cadence, cadence.at(i)) << i;
+        EXPECT_EQ(l.resistance, resistance.at(i)) << i;
+        EXPECT_EQ(l.peloton_resistance, pelotonResistance.at(i)) << i;
+        EXPECT_DOUBLE_EQ(l.speed, session.speed().at(i)) << i;
+        EXPECT_EQ(l.elapsedTime, session.elapsedTime().at(i)) << i;
+    }
+}
+
+void SessionStoreTestSuite::test_compatibility() {
+    sessionstore session;
+    for (int i = 1; i <= 100; i++)
+        session.append(line(i));
+
+    EXPECT_FALSE(session.isEmpty());
+    EXPECT_EQ(100, session.count());
+    EXPECT_EQ(100, session.length());
+    EXPECT_EQ(100, session.size());
+    expectLine(line(1), session.first(), 1);
+    expectLine(line(1), session.constFirst(), 1);
+    expectLine(line(100), session.last(), 100);
+    EXPECT_EQ(start.addSecs(1), session.constFirst().time);
+
+    int i = 1;
+    for (const SessionLine &l : session) {
+        expectLine(line(i), l, i);
+        i++;
+    }
+    EXPECT_EQ(101, i);
+
+    QList<SessionLine> list = session.toList();
+    ASSERT_EQ(100, list.size());
+    for (int j = 0; j < list.size(); j++)
+        expectLine(line(j + 1), list.at(j), j + 1);
+
+    // a copy handed to an exporter doesn't see the later samples
+    sessionstore snapshot = session;
+    session.append(line(101));
+    EXPECT_EQ(100, snapshot.count());
+    EXPECT_EQ(101, session.count());
+    expectLine(line(100), snapshot.last(), 100);
+
+    session.clear();
+    EXPECT_TRUE(session.isEmpty());
+    EXPECT_EQ(0, session.watt().size());
+    EXPECT_TRUE(session.watt().toList().isEmpty());
+    EXPECT_EQ(100, snapshot.count());
+
+    session.append(line(5));
+    expectLine(line(5), session.first(), 5);
+}
@@ -0,0 +1,41 @@
+#ifndef SESSIONSTORETESTSUITE_H
+#define SESSIONSTORETESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class SessionStoreTestSuite: public testing::Test {
+
+public:
+    SessionStoreTestSuite();
+
+    /**
+     * @brief Test that every field of the appended lines is read back by at(), across several chunks, with and
+     * without a coordinate, an altitude and a time.
+     */
+    void test_append();
+
+    /**
+     * @brief Test that the columns the charts read hold the values of the lines, in order.
+     */
+    void test_columns();
+
+    /**
+     * @brief Test the QList<SessionLine> style accessors homeform and the exporters use, that a copy is a snapshot
+     * not affected by the later appends, and clear().
+     */
+    void test_compatibility();
+};
+
+TEST_F(SessionStoreTestSuite, TestAppend) {
+    this->test_append();
+}
+
+TEST_F(SessionStoreTestSuite, TestColumns) {
+    this->test_columns();
+}
+
+TEST_F(SessionStoreTestSuite, TestCompatibility) {
+    this->test_compatibility();
+}
+
+#endif // SESSIONSTORETESTSUITE_H
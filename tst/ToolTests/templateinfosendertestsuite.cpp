@@ -0,0 +1,106 @@
+#include "templateinfosendertestsuite.h"
+
+#include "templateinfosenderbuilder.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+
+static QList<QByteArray> rows(int count) {
+    QList<QByteArray> l;
+    for (int i = 0; i < count; i++) {
+        QJsonObject row;
+        row[QStringLiteral("elapsed_s")] = i;
+        row[QStringLiteral("watts")] = 100 + i;
+        l.append(QJsonDocument(row).toJson(QJsonDocument::Compact));
+    }
+    return l;
+}
+
+static QJsonObject range(int from, int count) {
+    QJsonObject r;
+    r[QStringLiteral("from")] = from;
+    r[QStringLiteral("count")] = count;
+    return r;
+}
+
+// the reply parsed back, checking it holds the rows [from, from + count) of the session
+static void expectReply(const QByteArray &reply, int from, int count, int total) {
+    QJsonParseError error;
+    QJsonObject main = QJsonDocument::fromJson(reply, &error).object();
+    ASSERT_EQ(QJsonParseError::NoError, error.error) << reply.toStdString();
+    EXPECT_EQ(QStringLiteral("R_getsessionarray"), main[QStringLiteral("msg")].toString());
+    EXPECT_EQ(from + count, main[QStringLiteral("cursor")].toInt());
+    EXPECT_EQ(total, main[QStringLiteral("total")].toInt());
+    QJsonArray content = main[QStringLiteral("content")].toArray();
+    ASSERT_EQ(count, content.size());
+    for (int i = 0; i < count; i++) {
+        EXPECT_EQ(from + i, content.at(i).toObject()[QStringLiteral("elapsed_s")].toInt());
+        EXPECT_EQ(100 + from + i, content.at(i).toObject()[QStringLiteral("watts")].toInt());
+    }
+}
+
+TemplateInfoSenderTestSuite::TemplateInfoSenderTestSuite() {}
+
+void TemplateInfoSenderTestSuite::test_sessionArray() {
+    const QList<QByteArray> session = rows(50);
+
+    expectReply(TemplateInfoSenderBuilder::sessionArray(session, QJsonValue()), 0, 50, 50);
+    expectReply(TemplateInfoSenderBuilder::sessionArray(QList<QByteArray>(), QJsonValue()), 0, 0, 0);
+
+    // a client reading the history in pages, from the cursor of the previous reply
+    int cursor = 0;
+    for (int page = 0; page < 3; page++) {
+        QByteArray reply = TemplateInfoSenderBuilder::sessionArray(session, range(cursor, 20));
+        int count = qMin(20, 50 - cursor);
+        expectReply(reply, cursor, count, 50);
+        cursor = QJsonDocument::fromJson(reply).object()[QStringLiteral("cursor")].toInt();
+    }
+    EXPECT_EQ(50, cursor);
+
+    // without count, up to the end
+    QJsonObject from;
+    from[QStringLiteral("from")] = 45;
+    expectReply(TemplateInfoSenderBuilder::sessionArray(session, from), 45, 5, 50);
+
+    // out of the session
+    expectReply(TemplateInfoSenderBuilder::sessionArray(session, range(60, 10)), 50, 0, 50);
+    expectReply(TemplateInfoSenderBuilder::sessionArray(session, range(-5, 10)), 0, 5, 50);
+    expectReply(TemplateInfoSenderBuilder::sessionArray(session, range(10, -3)), 10, 0, 50);
+}
+
+void TemplateInfoSenderTestSuite::test_delta() {
+    QJsonObject workout;
+    workout[QStringLiteral("watts")] = 150;
+    workout[QStringLiteral("heart")] = 120;
+    workout[QStringLiteral("cadence")] = 85;
+
+    const QStringList fields = {QStringLiteral("watts"), QStringLiteral("heart")};
+    QJsonObject last;
+
+    // the first delta holds every subscribed field
+    QJsonObject delta = TemplateInfoSender::delta(workout, fields, last);
+    EXPECT_EQ(2, delta.size());
+    EXPECT_EQ(150, delta[QStringLiteral("watts")].toInt());
+    EXPECT_EQ(120, delta[QStringLiteral("heart")].toInt());
+    EXPECT_FALSE(delta.contains(QStringLiteral("cadence")));
+
+    EXPECT_TRUE(TemplateInfoSender::delta(workout, fields, last).isEmpty());
+
+    // a field not subscribed doesn't produce a delta
+    workout[QStringLiteral("cadence")] = 90;
+    EXPECT_TRUE(TemplateInfoSender::delta(workout, fields, last).isEmpty());
+
+    workout[QStringLiteral("heart")] = 121;
+    delta = TemplateInfoSender::delta(workout, fields, last);
+    EXPECT_EQ(1, delta.size());
+    EXPECT_EQ(121, delta[QStringLiteral("heart")].toInt());
+
+    // no fields subscribes to all of them
+    QJsonObject all;
+    delta = TemplateInfoSender::delta(workout, QStringList(), all);
+    EXPECT_EQ(3, delta.size());
+    workout[QStringLiteral("cadence")] = 91;
+    delta = TemplateInfoSender::delta(workout, QStringList(), all);
+    EXPECT_EQ(1, delta.size());
+    EXPECT_EQ(91, delta[QStringLiteral("cadence")].toInt());
+}
@@ -0,0 +1,31 @@
+#ifndef TEMPLATEINFOSENDERTESTSUITE_H
+#define TEMPLATEINFOSENDERTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class TemplateInfoSenderTestSuite: public testing::Test {
+
+public:
+    TemplateInfoSenderTestSuite();
+
+    /**
+     * @brief Test the history replies: the whole session without a range, a range with the cursor to continue from,
+     * and the ranges out of the session.
+     */
+    void test_sessionArray();
+
+    /**
+     * @brief Test that a subscriber gets only the subscribed fields changed since its previous delta.
+     */
+    void test_delta();
+};
+
+TEST_F(TemplateInfoSenderTestSuite, TestSessionArray) {
+    this->test_sessionArray();
+}
+
+TEST_F(TemplateInfoSenderTestSuite, TestDelta) {
+    this->test_delta();
+}
+
+#endif // TEMPLATEINFOSENDERTESTSUITE_H
@@ -0,0 +1,222 @@
+#include "trainprogramtestsuite.h"
+
+#include "gpx.h"
+#include "qzsettings.h"
+#include "trainprogram.h"
+#include "zwiftworkout.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QScopedPointer>
+#include <QStandardPaths>
+
+// the rows homeform builds from a GPX file. The bundled routes have no timestamps, so the points are given one every
+// 3 seconds to have something for avgSpeedFromGpxStep to work on
+static QList<trainrow> loadRoute(const QString &fileName) {
+    gpx g;
+    QList<trainrow> list;
+    auto points = g.open(fileName);
+    for (int i = 1; i < points.size(); i++) {
+        const gpx_altitude_point_for_treadmill &last = points.at(i - 1);
+        const gpx_altitude_point_for_treadmill &p = points.at(i);
+        trainrow r;
+        r.azimuth = p.azimuth;
+        r.distance = p.distance;
+        r.altitude = last.elevation;
+        r.inclination = p.inclination;
+        r.latitude = last.latitude;
+        r.longitude = last.longitude;
+        r.gpxElapsed = QTime(0, 0, 0).addSecs(i * 3);
+        list.append(r);
+    }
+    return list;
+}
+
+static QStringList routes() {
+    QStringList files;
+    QDir dir(QStringLiteral(GPX_ROUTES_DIR));
+    for (const QString &f : dir.entryList(QStringList() << QStringLiteral("*.gpx"), QDir::Files))
+        files << dir.filePath(f);
+    return files;
+}
+
+// the row by row scans the queries replaced, from the first row of the program
+static double scanAvgInclinationNext100Meters(const QList<trainrow> &rows, int step) {
+    double km = 0;
+    double avg = 0;
+    int sum = 0;
+    for (int c = step; c < rows.length() && km <= 0.1; c++) {
+        km += rows.at(c).distance;
+        avg += rows.at(c).inclination;
+        sum++;
+    }
+    if (sum == 1)
+        return rows.at(0).inclination;
+    return avg / (double)sum;
+}
+
+static double scanAvgSpeedFromGpxStep(const QList<trainrow> &rows, int step, int seconds) {
+    if (step >= rows.length())
+        return 0.0;
+    double km = rows.at(step).distance;
+    int timesum = QTime(0, 0, 0).secsTo(rows.at(step).gpxElapsed);
+    if (step > 0)
+        timesum -= QTime(0, 0, 0).secsTo(rows.at(step - 1).gpxElapsed);
+    for (int c = step + 1; timesum < seconds && c < rows.length(); c++) {
+        km += rows.at(c).distance;
+        timesum += rows.at(c - 1).gpxElapsed.secsTo(rows.at(c).gpxElapsed);
+    }
+    return (km / ((double)timesum) * 3600.0);
+}
+
+TrainProgramTestSuite::TrainProgramTestSuite() : testSettings("Roberto Viola", "QDomyos-Zwift Testing")
+{
+    testSettings.activate();
+    testSettings.qsettings.clear();
+    // the processed routes are cached in the test directories
+    QStandardPaths::setTestModeEnabled(true);
+}
+
+void TrainProgramTestSuite::test_timeIndex() {
+    QList<trainrow> rows;
+    trainrow warmup;
+    warmup.duration = QTime(0, 5, 0);
+    warmup.power = 100;
+    rows << warmup;
+    trainrow distance; // a distance step has no duration, so the time index skips it
+    distance.distance = 1;
+    rows << distance;
+    trainrow interval;
+    interval.duration = QTime(1, 0, 0);
+    rows << interval;
+
+    QScopedPointer<trainprogram> program(new trainprogram(rows, nullptr));
+    EXPECT_TRUE(program->powerzoneWorkout());
+    EXPECT_EQ(program->remainingTime(), QTime(1, 5, 0));
+    EXPECT_EQ(program->currentRowElapsedTime(), QTime(0, 0, 0));
+
+    program->increaseElapsedTime(310);
+    EXPECT_EQ(program->remainingTime(), QTime(0, 59, 50));
+    EXPECT_EQ(program->currentRowElapsedTime(), QTime(0, 0, 10));
+
+    program->clearRows();
+    EXPECT_FALSE(program->powerzoneWorkout());
+    EXPECT_EQ(program->remainingTime(), QTime(0, 0, 0));
+}
+
+void TrainProgramTestSuite::test_longRamp() {
+    testSettings.qsettings.setValue(QZSettings::ftp, 200.0);
+    const QList<trainrow> rows = zwiftworkout::loadJSON(QStringLiteral(
+        "{\"sportType\": \"bike\", \"workout\": ["
+        "{\"type\": \"Warmup\", \"Duration\": 5400, \"PowerLow\": 0.5, \"PowerHigh\": 0.75},"
+        "{\"type\": \"SteadyState\", \"Duration\": 600, \"Power\": 0.8}]}"));
+
+    // one row per second of the ramp, the times are valid past the first hour
+    ASSERT_EQ(rows.length(), 5401);
+    EXPECT_EQ(rows.at(0).rampDuration, QTime(1, 30, 0));
+    EXPECT_EQ(rows.at(4000).rampElapsed, QTime(1, 6, 40));
+    EXPECT_EQ(rows.at(5399).rampDuration, QTime(0, 0, 1));
+    EXPECT_NEAR(rows.at(0).power, 100, 1e-6);
+    EXPECT_NEAR(rows.at(2700).power, 125, 1);
+
+    QScopedPointer<trainprogram> program(new trainprogram(rows, nullptr));
+    EXPECT_TRUE(program->powerzoneWorkout());
+    EXPECT_EQ(program->remainingTime(), QTime(1, 40, 0));
+
+    // the rows of a ramp are merged in the elapsed and remaining times of the running row
+    program->increaseElapsedTime(4000);
+    EXPECT_EQ(program->currentRowElapsedTime(), QTime(1, 6, 40));
+    EXPECT_EQ(program->currentRowRemainingTime(), QTime(0, 23, 20));
+    EXPECT_EQ(program->remainingTime(), QTime(0, 33, 20));
+
+    program->increaseElapsedTime(1500);
+    EXPECT_EQ(program->currentRowElapsedTime(), QTime(0, 1, 40));
+    EXPECT_EQ(program->currentRowRemainingTime(), QTime(0, 8, 20));
+
+    QList<trainrow> seconds;
+    trainrow second;
+    second.duration = QTime(0, 0, 1);
+    for (int i = 0; i < 70000; i++)
+        seconds << second;
+    program.reset(new trainprogram(seconds, nullptr));
+    EXPECT_FALSE(program->powerzoneWorkout());
+    program->increaseElapsedTime(69000);
+    EXPECT_EQ(program->currentRowRemainingTime(), QTime(0, 0, 1));
+    EXPECT_EQ(program->remainingTime(), QTime(0, 16, 40));
+}
+
+void TrainProgramTestSuite::test_lookAhead() {
+    const QStringList files = routes();
+    ASSERT_FALSE(files.isEmpty());
+
+    for (const QString &file : files) {
+        const QList<trainrow> rows = loadRoute(file);
+        ASSERT_FALSE(rows.isEmpty()) << file.toStdString();
+        QScopedPointer<trainprogram> program(new trainprogram(rows, nullptr));
+
+        for (int step = 0; step <= rows.length(); step++) {
+            double expected = scanAvgInclinationNext100Meters(rows, step);
+            double actual = program->avgInclinationNext100Meters(step);
+            if (step < rows.length())
+                ASSERT_NEAR(actual, expected, 1e-6) << file.toStdString() << " step " << step;
+            else
+                EXPECT_TRUE(isnan(actual));
+
+            for (int seconds : {1, 60, 600})
+                ASSERT_NEAR(program->avgSpeedFromGpxStep(step, seconds), scanAvgSpeedFromGpxStep(rows, step, seconds),
+                            1e-6)
+                    << file.toStdString() << " step " << step << " seconds " << seconds;
+        }
+
+        QList<MetersByInclination> next300 = program->avgInclinationNext300Meters();
+        double meters = 0;
+        for (int i = 0; i < next300.length(); i++) {
+            EXPECT_NEAR(next300.at(i).inclination, scanAvgInclinationNext100Meters(rows, i), 1e-6);
+            meters += next300.at(i).meters;
+        }
+        EXPECT_GT(meters, 300);
+        EXPECT_LE(meters - next300.last().meters, 300);
+        EXPECT_EQ(program->inclinationNext300Meters().length(), next300.length());
+
+        double sinTotal = 0;
+        double cosTotal = 0;
+        for (int i = 0; i < next300.length(); i++) {
+            for (double m = 0; m < rows.at(i).distance; m += 0.001) {
+                sinTotal += sin(rows.at(i).azimuth * (M_PI / 180));
+                cosTotal += cos(rows.at(i).azimuth * (M_PI / 180));
+            }
+        }
+        double azimuth = atan2(sinTotal, cosTotal) * (180 / M_PI);
+        if (azimuth < 0)
+            azimuth += 360;
+        EXPECT_NEAR(program->avgAzimuthNext300Meters(), azimuth, 1e-6) << file.toStdString();
+    }
+}
+
+void TrainProgramTestSuite::test_benchmark() {
+    for (const QString &file : routes()) {
+        const QList<trainrow> rows = loadRoute(file);
+        Benchmark benchmark(QFileInfo(file).completeBaseName().toStdString() + "_");
+
+        QScopedPointer<trainprogram> program(new trainprogram(rows, nullptr));
+        qint64 load = benchmark.lap();
+
+        double check = 0;
+        benchmark.restart();
+        for (int step = 0; step < rows.length(); step++)
+            check += program->avgInclinationNext100Meters(step) + program->avgSpeedFromGpxStep(step, 60);
+        qint64 indexed = benchmark.lap();
+
+        benchmark.restart();
+        for (int step = 0; step < rows.length(); step++)
+            check -= scanAvgInclinationNext100Meters(rows, step) + scanAvgSpeedFromGpxStep(rows, step, 60);
+        qint64 scanned = benchmark.lap();
+
+        EXPECT_NEAR(check, 0, 1e-3);
+
+        benchmark.record("points", rows.length());
+        benchmark.record("index_us", load, 1000);
+        benchmark.record("lookahead_ns", indexed, rows.length());
+        benchmark.record("scan_ns", scanned, rows.length());
+    }
+}
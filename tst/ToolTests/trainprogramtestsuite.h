@@ -0,0 +1,53 @@
+#ifndef TRAINPROGRAMTESTSUITE_H
+#define TRAINPROGRAMTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+#include "Tools/benchmark.h"
+#include "Tools/testsettings.h"
+
+class TrainProgramTestSuite: public testing::Test {
+    TestSettings testSettings;
+
+public:
+    TrainProgramTestSuite();
+
+    /**
+     * @brief Test that the time index finds the running row and the remaining time of a workout.
+     */
+    void test_timeIndex();
+
+    /**
+     * @brief Test the rows of a ramp longer than an hour and the time index over them, and over more rows than a
+     * uint16_t step could reach.
+     */
+    void test_longRamp();
+
+    /**
+     * @brief Test that the look-ahead queries of the bundled GPX routes match a scan of the rows.
+     */
+    void test_lookAhead();
+
+    /**
+     * @brief Measure the look-ahead queries of every point of the bundled GPX routes, against a scan of the rows.
+     */
+    void test_benchmark();
+};
+
+TEST_F(TrainProgramTestSuite, TestTimeIndex) {
+    this->test_timeIndex();
+}
+
+TEST_F(TrainProgramTestSuite, TestLongRamp) {
+    this->test_longRamp();
+}
+
+TEST_F(TrainProgramTestSuite, TestLookAhead) {
+    this->test_lookAhead();
+}
+
+BENCHMARK_F(TrainProgramTestSuite, TestBenchmark) {
+    this->test_benchmark();
+}
+
+#endif // TRAINPROGRAMTESTSUITE_H
@@ -0,0 +1,31 @@
+#include "benchmark.h"
+
+#include <algorithm>
+
+Benchmark::Benchmark(const std::string &prefix) : prefix(prefix) { timer.start(); }
+
+void Benchmark::restart() { timer.restart(); }
+
+qint64 Benchmark::lap() {
+    qint64 elapsed = timer.nsecsElapsed();
+    timer.restart();
+    return elapsed;
+}
+
+void Benchmark::record(const std::string &name, qint64 value, qint64 count) const {
+    testing::Test::RecordProperty(prefix + name, (int)(value / count));
+}
+
+void Benchmark::recordLatencies(QVector<qint64> latencies) const {
+    if (latencies.isEmpty())
+        return;
+
+    std::sort(latencies.begin(), latencies.end());
+    qint64 total = 0;
+    for (qint64 l : latencies)
+        total += l;
+    record("mean_ns", total, latencies.size());
+    record("p50_ns", latencies[latencies.size() / 2]);
+    record("p99_ns", latencies[latencies.size() * 99 / 100]);
+    record("max_ns", latencies.last());
+}
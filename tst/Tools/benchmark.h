@@ -0,0 +1,57 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <QElapsedTimer>
+#include <QVector>
+#include <QtGlobal>
+#include <string>
+
+#include "gtest/gtest.h"
+
+/**
+ * @brief BENCHMARK_F Declares a benchmark of a test suite. Benchmarks are disabled in the unit run, they run with
+ * --gtest_also_run_disabled_tests and their timings end up in the test properties (see Benchmark).
+ */
+#define BENCHMARK_F(test_suite, test_name) TEST_F(test_suite, DISABLED_##test_name)
+
+/**
+ * @brief The Benchmark class times the steps of a benchmark and records the timings as properties of the running
+ * test, rather than printing them: --gtest_output=xml writes them to the report, where they can be compared between
+ * runs.
+ */
+class Benchmark {
+  public:
+    /**
+     * @brief Benchmark Starts the timer.
+     * @param prefix Prepended to the property names, to tell apart the cases of a test (e.g. a route name).
+     */
+    explicit Benchmark(const std::string &prefix = std::string());
+
+    /**
+     * @brief restart Restarts the timer, discarding the time elapsed so far.
+     */
+    void restart();
+
+    /**
+     * @brief lap The nanoseconds elapsed since the timer was started or since the previous lap, and restarts it.
+     */
+    qint64 lap();
+
+    /**
+     * @brief record Records value / count, e.g. the time of a call out of the time of count calls.
+     * @param name The property name, with its unit (e.g. "table_ns").
+     */
+    void record(const std::string &name, qint64 value, qint64 count = 1) const;
+
+    /**
+     * @brief recordLatencies Records the mean, the median, the 99th percentile and the max of the latencies, in
+     * nanoseconds, as mean_ns, p50_ns, p99_ns and max_ns.
+     */
+    void recordLatencies(QVector<qint64> latencies) const;
+
+  private:
+    std::string prefix;
+    QElapsedTimer timer;
+};
+
+#endif // BENCHMARK_H
@@ -0,0 +1,186 @@
+#include "blereplayharness.h"
+#include "bluetoothdevice.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QRegularExpression>
+#include <QTextStream>
+#include <QThread>
+#include <algorithm>
+
+static const QRegularExpression plainLine(
+    QStringLiteral("^\\s*(\\d+)\\s+(?:0x)?(\\{?[0-9a-fA-F]{8}-[0-9a-fA-F]{4}-[0-9a-fA-F]{4}-[0-9a-fA-F]{4}-[0-9a-fA-F]{12}\\}?|"
+                   "[0-9a-fA-F]{4})\\s+((?:[0-9a-fA-F]{2}\\s*)+)$"));
+static const QRegularExpression logUuid(
+    QStringLiteral("\\{?[0-9a-fA-F]{8}-[0-9a-fA-F]{4}-[0-9a-fA-F]{4}-[0-9a-fA-F]{4}-[0-9a-fA-F]{12}\\}?"));
+static const QRegularExpression logTimestamp(QStringLiteral("\\s(\\d{12,14})\\s"));
+
+static QBluetoothUuid toUuid(const QString &s) {
+    if (s.length() == 4)
+        return QBluetoothUuid((quint16)s.toUShort(nullptr, 16));
+    QString full = s;
+    if (!full.startsWith(QLatin1Char('{')))
+        full = QLatin1Char('{') + full + QLatin1Char('}');
+    return QBluetoothUuid(full);
+}
+
+static bool toBytes(QStringList tokens, QByteArray &value, bool skipLength = false) {
+    if (skipLength) {
+        bool isLength = false;
+        if (tokens.size() > 1 && tokens.first().toInt(&isLength) == tokens.size() - 1 && isLength)
+            tokens.removeFirst();
+    }
+
+    value.clear();
+    value.reserve(tokens.size());
+    for (const QString &t : tokens) {
+        bool ok = false;
+        uint b = t.toUInt(&ok, 16);
+        if (!ok || t.length() != 2)
+            return false;
+        value.append((char)b);
+    }
+    return !value.isEmpty();
+}
+
+bool BLEReplayHarness::parseLine(const QString &line, Packet &packet) {
+    QRegularExpressionMatch m = plainLine.match(line);
+    if (m.hasMatch()) {
+        packet.timestamp = m.captured(1).toLongLong();
+        packet.uuid = toUuid(m.captured(2));
+        return toBytes(m.captured(3).split(QLatin1Char(' '), Qt::SkipEmptyParts), packet.value);
+    }
+
+    int arrow = line.indexOf(QStringLiteral("<<"));
+    if (arrow < 0)
+        return false;
+
+    QString head = line.left(arrow);
+    QRegularExpressionMatch uuid;
+    QRegularExpressionMatchIterator i = logUuid.globalMatch(head);
+    while (i.hasNext())
+        uuid = i.next();
+    if (!uuid.hasMatch())
+        return false;
+
+    QRegularExpressionMatch timestamp = logTimestamp.match(head);
+    packet.timestamp = timestamp.hasMatch() ? timestamp.captured(1).toLongLong() : 0;
+    packet.uuid = toUuid(uuid.captured(0));
+
+    // qDebug() quotes the bytes, while the drivers that log through the debug signal (e.g. horizontreadmill) write
+    // them unquoted after the packet length
+    QString tail = line.mid(arrow + 2);
+    bool quoted = tail.contains(QLatin1Char('"'));
+    tail.remove(QLatin1Char('"'));
+    return toBytes(tail.split(QLatin1Char(' '), Qt::SkipEmptyParts), packet.value, !quoted);
+}
+
+bool BLEReplayHarness::load(const QString &fileName) {
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return false;
+
+    QTextStream stream(&file);
+    QStringList lines;
+    while (!stream.atEnd())
+        lines.append(stream.readLine());
+    loadLines(lines);
+    return true;
+}
+
+void BLEReplayHarness::loadLines(const QStringList &lines) {
+    for (const QString &line : lines) {
+        if (line.trimmed().startsWith(QLatin1Char('#')))
+            continue;
+        Packet p;
+        if (parseLine(line, p))
+            packets.append(p);
+    }
+}
+
+BLEReplayHarness::Report BLEReplayHarness::run(bluetoothdevice *device, bool wallClock) const {
+    Report report;
+    report.packets = packets.size();
+    report.latencies.reserve(packets.size());
+
+    QElapsedTimer clock;
+    clock.start();
+    QElapsedTimer parse;
+
+    for (const Packet &p : packets) {
+        if (wallClock) {
+            qint64 due = p.timestamp - packets.first().timestamp;
+            while (clock.elapsed() < due) {
+                if (QCoreApplication::instance())
+                    QCoreApplication::processEvents(QEventLoop::AllEvents, due - clock.elapsed());
+                QThread::msleep(1);
+            }
+        }
+
+        parse.start();
+        bool replayed = device->replayNotification(p.uuid, p.value);
+        qint64 ns = parse.nsecsElapsed();
+        if (!replayed)
+            break;
+        report.replayed++;
+        report.latencies.append(ns);
+    }
+
+    report.speed = device->currentSpeed().value();
+    report.cadence = device->currentCadence().value();
+    report.watt = device->wattsMetric().value();
+    report.heart = device->currentHeart().value();
+    report.resistance = device->currentResistance().value();
+    report.inclination = device->currentInclination().value();
+    report.distance = device->odometer();
+    report.calories = device->calories().value();
+    return report;
+}
+
+qint64 BLEReplayHarness::Report::total() const {
+    qint64 t = 0;
+    for (qint64 l : latencies)
+        t += l;
+    return t;
+}
+
+qint64 BLEReplayHarness::Report::max() const {
+    if (latencies.isEmpty())
+        return 0;
+    return *std::max_element(latencies.constBegin(), latencies.constEnd());
+}
+
+double BLEReplayHarness::Report::mean() const {
+    if (latencies.isEmpty())
+        return 0;
+    return (double)total() / latencies.size();
+}
+
+qint64 BLEReplayHarness::Report::percentile(double p) const {
+    if (latencies.isEmpty())
+        return 0;
+    QVector<qint64> sorted = latencies;
+    std::sort(sorted.begin(), sorted.end());
+    int i = qBound(0, (int)(p * sorted.size()), sorted.size() - 1);
+    return sorted.at(i);
+}
+
+QString BLEReplayHarness::Report::toString() const {
+    return QStringLiteral("packets %1/%2 latency ns mean %3 p50 %4 p99 %5 max %6 | speed %7 cadence %8 watt %9 "
+                          "heart %10 resistance %11 inclination %12 distance %13 calories %14")
+        .arg(replayed)
+        .arg(packets)
+        .arg(mean(), 0, 'f', 0)
+        .arg(percentile(0.5))
+        .arg(percentile(0.99))
+        .arg(max())
+        .arg(speed)
+        .arg(cadence)
+        .arg(watt)
+        .arg(heart)
+        .arg(resistance)
+        .arg(inclination)
+        .arg(distance)
+        .arg(calories);
+}
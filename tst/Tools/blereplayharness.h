@@ -0,0 +1,100 @@
+#ifndef BLEREPLAYHARNESS_H
+#define BLEREPLAYHARNESS_H
+
+#include <QBluetoothUuid>
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class bluetoothdevice;
+
+/**
+ * @brief The BLEReplayHarness class replays a recorded stream of characteristic notifications into a device driver,
+ * through bluetoothdevice::replayNotification, and measures how long the driver takes to parse each packet.
+ *
+ * Two capture formats are understood, line by line:
+ * - plain captures: "<milliseconds> <uuid> <hex bytes>", where the uuid is either a 16 bit value (e.g. 2ad2) or a
+ *   full uuid, and lines starting with # are comments.
+ * - qdomyos-zwift debug logs: the "<<" lines the drivers write for every notification, with the timestamp taken from
+ *   the milliseconds since epoch field of the log.
+ * Any other line is ignored, so a whole debug log can be loaded as it is.
+ */
+class BLEReplayHarness {
+  public:
+    struct Packet {
+        qint64 timestamp = 0;
+        QBluetoothUuid uuid;
+        QByteArray value;
+    };
+
+    /**
+     * @brief The Report struct The outcome of a replay.
+     */
+    struct Report {
+        int packets = 0;
+
+        /**
+         * @brief replayed The packets the driver accepted. 0 if the driver doesn't support the replay.
+         */
+        int replayed = 0;
+
+        /**
+         * @brief latencies The parse time of each replayed packet. Unit: nanoseconds
+         */
+        QVector<qint64> latencies;
+
+        double speed = 0;
+        double cadence = 0;
+        double watt = 0;
+        double heart = 0;
+        double resistance = 0;
+        double inclination = 0;
+        double distance = 0;
+        double calories = 0;
+
+        qint64 total() const;
+        qint64 max() const;
+        double mean() const;
+
+        /**
+         * @brief percentile The latency below which the given fraction (0..1) of the packets were parsed.
+         * Unit: nanoseconds
+         */
+        qint64 percentile(double p) const;
+
+        QString toString() const;
+    };
+
+    /**
+     * @brief parseLine Parses a capture line in either of the supported formats.
+     * @return false if the line doesn't hold a notification.
+     */
+    static bool parseLine(const QString &line, Packet &packet);
+
+    /**
+     * @brief load Appends the notifications of the capture file.
+     * @return false if the file can't be read.
+     */
+    bool load(const QString &fileName);
+
+    /**
+     * @brief loadLines Appends the notifications of the capture lines.
+     */
+    void loadLines(const QStringList &lines);
+
+    void append(const Packet &packet) { packets.append(packet); }
+    const QVector<Packet> &capture() const { return packets; }
+
+    /**
+     * @brief run Feeds the capture to the device.
+     * @param wallClock If true, the packets are spaced as they were recorded and the event loop (if any) is run in
+     * between, so the driver timers fire; otherwise they're replayed back to back at maximum speed.
+     */
+    Report run(bluetoothdevice *device, bool wallClock = false) const;
+
+  private:
+    QVector<Packet> packets;
+};
+
+#endif // BLEREPLAYHARNESS_H
@@ -0,0 +1,128 @@
+#include "computrainersimulator.h"
+#include "Computrainer.h"
+
+#include <QElapsedTimer>
+
+#ifdef Q_OS_LINUX
+#include <poll.h>
+#endif
+
+ComputrainerSimulator::~ComputrainerSimulator() {
+#ifdef Q_OS_LINUX
+    if (master != -1)
+        close(master);
+#endif
+}
+
+bool ComputrainerSimulator::open() {
+#ifdef Q_OS_LINUX
+    master = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (master == -1)
+        return false;
+    if (grantpt(master) == -1 || unlockpt(master) == -1)
+        return false;
+
+    // no echo or line editing before the driver sets the port up
+    struct termios settings;
+    tcgetattr(master, &settings);
+    cfmakeraw(&settings);
+    tcsetattr(master, TCSANOW, &settings);
+
+    slaveName = QString::fromLocal8Bit(ptsname(master));
+    return true;
+#else
+    return false;
+#endif
+}
+
+void ComputrainerSimulator::encodeTelemetry(int type, int value, int buttons, uint8_t *message) {
+    // the inverse of Computrainer::unpackTelemetry, without spinscan data
+    message[0] = 0;
+    message[1] = 0;
+    message[2] = 0;
+    message[3] = (buttons >> 1) & 127;
+    message[4] = ((type & 15) << 3) | ((value >> 9) & 7);
+    message[5] = (value >> 1) & 127;
+    message[6] = 128 | ((buttons & 1) << 2) | ((value >> 7) & 2) | (value & 1);
+}
+
+bool ComputrainerSimulator::sendTelemetry(int type, int value, int buttons) {
+    uint8_t message[7];
+    encodeTelemetry(type, value, buttons, message);
+    return sendRaw(message, sizeof(message));
+}
+
+bool ComputrainerSimulator::sendRaw(const uint8_t *bytes, int size) {
+#ifdef Q_OS_LINUX
+    return master != -1 && write(master, bytes, size) == size;
+#else
+    Q_UNUSED(bytes);
+    Q_UNUSED(size);
+    return false;
+#endif
+}
+
+bool ComputrainerSimulator::waitForCommand(int timeout) {
+#ifdef Q_OS_LINUX
+    if (master == -1)
+        return false;
+
+    QElapsedTimer timer;
+    timer.start();
+    while (timer.elapsed() < timeout) {
+        struct pollfd pfd;
+        pfd.fd = master;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        if (poll(&pfd, 1, timeout - timer.elapsed()) <= 0)
+            continue;
+
+        int rc = read(master, pending + pendingLength, sizeof(pending) - pendingLength);
+        if (rc <= 0)
+            continue;
+        pendingLength += rc;
+
+        if (pendingLength == sizeof(pending)) {
+            pendingLength = 0;
+            decodeCommand(pending);
+            return true;
+        }
+    }
+#else
+    Q_UNUSED(timeout);
+#endif
+    return false;
+}
+
+void ComputrainerSimulator::decodeCommand(const uint8_t *command) {
+    commandCount++;
+
+    // the value is in the packet that sets it, the last one in ERG mode and the first one in spinscan mode
+    const uint8_t *packet;
+    switch (command[3]) {
+    case 0x0A:
+        lastMode = CT_ERGOMODE;
+        packet = command + 49;
+        break;
+    case 0x16:
+        lastMode = CT_SSMODE;
+        packet = command;
+        break;
+    default:
+        lastMode = CT_CALIBRATE;
+        return;
+    }
+
+    int value = ((packet[4] & 7) << 9) | (packet[5] << 1) | ((packet[6] & 2) << 7) | (packet[6] & 1);
+    if (value & 2048)
+        value -= 4096; // negative gradients
+
+    int crc = (packet[0] << 1) | ((packet[6] & 32) ? 1 : 0);
+    if (crc != (0xff & (107 - (value & 0xff) - (value >> 8))))
+        crcErrorCount++;
+
+    if (lastMode == CT_ERGOMODE)
+        lastLoad = value;
+    else
+        lastGradient = (value < 0 ? -(~value) : value) / 10.0;
+}
@@ -0,0 +1,92 @@
+#ifndef COMPUTRAINERSIMULATOR_H
+#define COMPUTRAINERSIMULATOR_H
+
+#include <QString>
+#include <QtGlobal>
+#include <stdint.h>
+
+/**
+ * @brief The ComputrainerSimulator class plays the CompuTrainer side of the serial protocol on a pseudo terminal, so
+ * the Computrainer driver can be run and timed without the hardware. The driver opens portName() as if it was the
+ * serial port, the simulator writes telemetry messages to it and decodes the control commands the driver sends.
+ * Pseudo terminals are only used on Linux, elsewhere open() fails.
+ */
+class ComputrainerSimulator {
+  public:
+    ~ComputrainerSimulator();
+
+    /**
+     * @brief open Creates the pseudo terminal.
+     */
+    bool open();
+
+    /**
+     * @brief portName The device the driver has to open.
+     */
+    QString portName() const { return slaveName; }
+
+    /**
+     * @brief encodeTelemetry Packs a telemetry message the way the CT does.
+     * @param type A message type, e.g. CT_POWER.
+     * @param value The 12 bit value of the message (8 bit for the heart rate and the cadence).
+     * @param message The 7 bytes of the message.
+     */
+    static void encodeTelemetry(int type, int value, int buttons, uint8_t *message);
+
+    /**
+     * @brief sendTelemetry Writes a telemetry message to the driver.
+     */
+    bool sendTelemetry(int type, int value, int buttons = 0);
+
+    /**
+     * @brief sendRaw Writes arbitrary bytes to the driver, e.g. to put it out of sync.
+     */
+    bool sendRaw(const uint8_t *bytes, int size);
+
+    /**
+     * @brief waitForCommand Reads what the driver sent until a whole command (56 bytes) is decoded.
+     * @param timeout Unit: milliseconds
+     */
+    bool waitForCommand(int timeout);
+
+    /**
+     * @brief commands The commands decoded so far.
+     */
+    int commands() const { return commandCount; }
+
+    /**
+     * @brief crcErrors The commands whose value didn't match its checksum.
+     */
+    int crcErrors() const { return crcErrorCount; }
+
+    /**
+     * @brief mode The mode of the last command: CT_ERGOMODE, CT_SSMODE or CT_CALIBRATE.
+     */
+    int mode() const { return lastMode; }
+
+    /**
+     * @brief load The load of the last ERG mode command. Unit: watts
+     */
+    int load() const { return lastLoad; }
+
+    /**
+     * @brief gradient The gradient of the last spinscan mode command. Unit: percent
+     */
+    double gradient() const { return lastGradient; }
+
+  private:
+    void decodeCommand(const uint8_t *command);
+
+    int master = -1;
+    QString slaveName;
+    uint8_t pending[56];
+    int pendingLength = 0;
+
+    int commandCount = 0;
+    int crcErrorCount = 0;
+    int lastMode = 0;
+    int lastLoad = 0;
+    double lastGradient = 0;
+};
+
+#endif // COMPUTRAINERSIMULATOR_H
@@ -22,7 +22,30 @@ SOURCES += \
         Devices/bluetoothdevicetestsuite.cpp \
         Devices/bluetoothsignalreceiver.cpp \
         Devices/devicediscoveryinfo.cpp \
+        ToolTests/blereplayharnesstestsuite.cpp \
+        ToolTests/blewritequeuetestsuite.cpp \
+        ToolTests/chartseriestestsuite.cpp \
+        ToolTests/computrainertestsuite.cpp \
+        ToolTests/csafetestsuite.cpp \
+        ToolTests/devicenamematchertestsuite.cpp \
+        ToolTests/dircontestsuite.cpp \
+        ToolTests/ergtabletestsuite.cpp \
+        ToolTests/gattlayouttestsuite.cpp \
+        ToolTests/gpxtestsuite.cpp \
+        ToolTests/logwritertestsuite.cpp \
+        ToolTests/metrictestsuite.cpp \
+        ToolTests/ocrworkertestsuite.cpp \
+        ToolTests/powercurvetestsuite.cpp \
+        ToolTests/qfitstreamtestsuite.cpp \
+        ToolTests/qzsettingscachetestsuite.cpp \
+        ToolTests/rollingwindowtestsuite.cpp \
+        ToolTests/sessionstoretestsuite.cpp \
+        ToolTests/templateinfosendertestsuite.cpp \
         ToolTests/testsettingstestsuite.cpp \
+        ToolTests/trainprogramtestsuite.cpp \
+        Tools/benchmark.cpp \
+        Tools/blereplayharness.cpp \
+        Tools/computrainersimulator.cpp \
         Tools/testsettings.cpp \
         main.cpp
 
@@ -34,7 +57,11 @@ win32:CONFIG(release, debug|release): LIBS += -L$$OUT_PWD/../src/release/ -lqdom
 else:win32:CONFIG(debug, debug|release): LIBS += -L$$OUT_PWD/../src/debug/ -lqdomyos-zwift
 else:unix: LIBS += -L$$OUT_PWD/../src/ -lqdomyos-zwift
 
+DEFINES += GPX_ROUTES_DIR=\\\"$$PWD/../src/gpx\\\"
+DEFINES += BLUETOOTH_SOURCE=\\\"$$PWD/../src/bluetooth.cpp\\\"
+
 INCLUDEPATH += $$PWD/../src
+INCLUDEPATH += $$PWD/../src/fit-sdk
 DEPENDPATH += $$PWD/../src
 
 win32-g++:CONFIG(release, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../src/release/libqdomyos-zwift.a
@@ -133,5 +160,28 @@ HEADERS += \
     Devices/iConceptBike/iconceptbiketestdata.h \
     Devices/iConceptElliptical/iconceptellipticaltestdata.h \
     Devices/YpooElliptical/ypooellipticaltestdata.h \
+    ToolTests/blereplayharnesstestsuite.h \
+    ToolTests/blewritequeuetestsuite.h \
+    ToolTests/chartseriestestsuite.h \
+    ToolTests/computrainertestsuite.h \
+    ToolTests/csafetestsuite.h \
+    ToolTests/devicenamematchertestsuite.h \
+    ToolTests/dircontestsuite.h \
+    ToolTests/ergtabletestsuite.h \
+    ToolTests/gattlayouttestsuite.h \
+    ToolTests/gpxtestsuite.h \
+    ToolTests/logwritertestsuite.h \
+    ToolTests/metrictestsuite.h \
+    ToolTests/ocrworkertestsuite.h \
+    ToolTests/powercurvetestsuite.h \
+    ToolTests/qfitstreamtestsuite.h \
+    ToolTests/qzsettingscachetestsuite.h \
+    ToolTests/rollingwindowtestsuite.h \
+    ToolTests/sessionstoretestsuite.h \
+    ToolTests/templateinfosendertestsuite.h \
     ToolTests/testsettingstestsuite.h \
+    ToolTests/trainprogramtestsuite.h \
+    Tools/benchmark.h \
+    Tools/blereplayharness.h \
+    Tools/computrainersimulator.h \
     Tools/testsettings.h